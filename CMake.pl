@@ -8,7 +8,8 @@ use strict;
 ## EXECUTABLES
 my @masterprog=("fullBuild","ess","muBeam","photonMod2","t1Real",
 		"sns","reactor","t1MarkII","t1Eng","t3Expt",
-		"filter","singleItem","testMain"); 
+		"filter","singleItem","snapShot","testMain",
+		"benchMain"); 
 
 
 
@@ -204,6 +205,22 @@ $gM->addDepUnit("singleItem", ["singleItemBuild","visit","src","simMC",
 			       "work","xml","poly","support","weights",
 			       "md5","global","attachComp","visit","poly"]);
 
+$gM->addDepUnit("snapShot", ["visit","src","simMC",
+			     "construct","physics","input","process",
+			     "transport","scatMat","endf","crystal",
+			     "source","monte","funcBase","log","monte",
+			     "tally","geometry","mersenne","src","world",
+			     "work","xml","poly","support","weights",
+			     "md5","global","attachComp","visit","poly"]);
+
+$gM->addDepUnit("benchMain",["geometry","monte","src","simMC",
+			     "construct","physics","input","process",
+			     "transport","scatMat","endf","crystal",
+			     "source","monte","funcBase","log","monte",
+			     "tally","geometry","mersenne","src","world",
+			     "work","xml","poly","support","weights",
+			     "md5","global","attachComp","visit","poly"]);
+
 $gM->addDepUnit("ts1layer", ["build","visit","chip","moderator","build",
 			     "zoom","src","physics","input","process",
 			     "monte","funcBase","log","monte","tally",
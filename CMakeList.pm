@@ -21,6 +21,7 @@ sub new
     optimise => "",
     debug => "",
     noregex => 0,
+    nozlib => 0,
     
     incLib => undef,           ## Array of all our includes used
     srcDir => undef,           ## Array of all our cxx directories
@@ -194,6 +195,9 @@ sub setParameters
 	  $self->{optimise}.=" -O2 " if ($Ostr eq "-O");
 	  push(@{$self->{definitions}},"NO_REGEX") if ($Ostr eq "-NR");
 	  $self->{noregex}=1 if ($Ostr eq "-NR");
+	  push(@{$self->{definitions}},"NO_NAMESTACK") if ($Ostr eq "-NS");
+	  push(@{$self->{definitions}},"NO_ZLIB") if ($Ostr eq "-NZ");
+	  $self->{nozlib}=1 if ($Ostr eq "-NZ");
 	  $self->{optimise}.=" -pg " if ($Ostr eq "-p"); ## Gprof
 	  $self->{gcov}=1 if ($Ostr eq "-C");
 	  $self->{debug}="" if ($Ostr eq "-g");
@@ -304,6 +308,9 @@ sub writeExcutables
 	print $DX "target_link_libraries(",$item," boost_regex)\n";
       }
       print $DX "target_link_libraries(",$item," stdc++)\n ";
+      print $DX "target_link_libraries(",$item," pthread)\n";
+      print $DX "target_link_libraries(",$item," z)\n"
+	if (!$self->{nozlib});
       print $DX "target_link_libraries(",$item," gsl)\n";
       print $DX "target_link_libraries(",$item," gslcblas)\n";
     }
@@ -0,0 +1,150 @@
+/*********************************************************************
+  CombLayer : MCNP(X) Input builder
+
+ * File:   Main/benchMain.cxx
+ *
+ * Copyright (c) 2004-2016 by Stuart Ansell
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ *
+ ****************************************************************************/
+#include <fstream>
+#include <iomanip>
+#include <iostream>
+#include <sstream>
+#include <cmath>
+#include <complex>
+#include <vector>
+#include <set>
+#include <map>
+#include <string>
+#include <algorithm>
+#include <memory>
+#include <tuple>
+#include <chrono>
+
+#include "Exception.h"
+#include "FileReport.h"
+#include "NameStack.h"
+#include "RegMethod.h"
+#include "GTKreport.h"
+#include "OutputLog.h"
+#include "BaseVisit.h"
+#include "BaseModVisit.h"
+#include "support.h"
+#include "MatrixBase.h"
+#include "Matrix.h"
+#include "Vec3D.h"
+#include "Surface.h"
+#include "Quadratic.h"
+#include "Plane.h"
+#include "Sphere.h"
+#include "Cylinder.h"
+#include "Line.h"
+#include "HeadRule.h"
+#include "SurInter.h"
+
+///\cond STATIC
+namespace ELog
+{
+  ELog::OutputLog<EReport> EM;
+  ELog::OutputLog<FileReport> FM("Spectrum.log");
+  ELog::OutputLog<FileReport> RN("Renumber.txt");   ///< Renumber
+  ELog::OutputLog<StreamReport> CellM;
+}
+///\endcond STATIC
+
+/*!
+  Timing of the closed form surface intersections
+  [SurInter::processPoint] against the general solver
+  [SurInter::makePoint]. Not part of testMain as the
+  times depend on the machine.
+  Usage : benchMain [nLoop]
+*/
+
+int
+main(int argc,char* argv[])
+{
+  ELog::RegMethod RControl("","main");
+
+  size_t nLoop(10000);
+  if (argc>1 &&
+      (!StrFunc::convert(std::string(argv[1]),nLoop) || !nLoop))
+    {
+      ELog::EM<<"Usage : benchMain [nLoop]"<<ELog::endCrit;
+      return -1;
+    }
+
+  Geometry::Plane TA(1,0),TB(2,0);
+  Geometry::Sphere SA(11,0),SB(12,0),SC(13,0);
+  Geometry::Cylinder CX(21,0),CY(22,0),CZ(23,0),CZA(24,0),CZB(25,0);
+  TA.setSurface("pz 1");
+  TB.setSurface("px 0.5");
+  SA.setSurface("so 5");
+  SB.setSurface("s 3 0 0 4");
+  SC.setSurface("s 0 3 0 4.5");
+  CX.setSurface("cx 4");
+  CY.setSurface("cy 4");
+  CZ.setSurface("cz 4");
+  CZA.setSurface("c/z 2 0 4");
+  CZB.setSurface("cz 3");
+
+  typedef std::tuple<const Geometry::Quadratic*,const Geometry::Quadratic*,
+		     const Geometry::Quadratic*,std::string> TTYPE;
+  const std::vector<TTYPE> Tests=
+    {
+      TTYPE(&TA,&SA,&SB,"plane/sphere/sphere"),
+      TTYPE(&SA,&SB,&SC,"sphere/sphere/sphere"),
+      TTYPE(&TA,&CX,&CY,"orthogonal cylinders"),
+      TTYPE(&TA,&CZ,&CZA,"parallel cylinders"),
+      TTYPE(&TA,&CZ,&CZB,"coaxial cylinders"),
+      TTYPE(&TB,&CY,&SA,"cylinder in plane + sphere")
+    };
+
+  try
+    {
+      for(const TTYPE& tc : Tests)
+	{
+	  std::chrono::steady_clock::time_point TStart=
+	    std::chrono::steady_clock::now();
+	  size_t nSpecial(0);
+	  for(size_t i=0;i<nLoop;i++)
+	    nSpecial+=SurInter::processPoint(std::get<0>(tc),std::get<1>(tc),
+					     std::get<2>(tc)).size();
+	  const double TSpecial=std::chrono::duration<double,std::micro>
+	    (std::chrono::steady_clock::now()-TStart).count();
+
+	  TStart=std::chrono::steady_clock::now();
+	  size_t nGeneral(0);
+	  for(size_t i=0;i<nLoop;i++)
+	    nGeneral+=SurInter::makePoint(std::get<0>(tc),std::get<1>(tc),
+					  std::get<2>(tc)).size();
+	  const double TGeneral=std::chrono::duration<double,std::micro>
+	    (std::chrono::steady_clock::now()-TStart).count();
+
+	  ELog::EM<<std::get<3>(tc)
+		  <<" : "<<TSpecial/static_cast<double>(nLoop)<<" / "
+		  <<TGeneral/static_cast<double>(nLoop)
+		  <<" us per triple ["<<nSpecial/nLoop<<" / "
+		  <<nGeneral/nLoop<<" points]"<<ELog::endDiag;
+	}
+    }
+  catch (ColErr::ExBase& A)
+    {
+      ELog::EM<<"EXCEPTION FAILURE :: "
+	      <<A.what()<<ELog::endCrit;
+      return -1;
+    }
+  return 0;
+}
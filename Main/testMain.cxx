@@ -180,6 +180,7 @@
 #include "testVolumes.h"
 #include "testWorkData.h"
 #include "testWrapper.h"
+#include "testWWG.h"
 #include "testXML.h"
 
 //
@@ -422,7 +423,8 @@ globalTest(const int type,const int extra)
       "testRules",
       "testSimulation",
       "testSource",
-      "testTally"
+      "testTally",
+      "testWWG"
     };
   const size_t TSize(TestName.size());
 
@@ -524,6 +526,12 @@ globalTest(const int type,const int extra)
 	  testTally A;
 	  X=A.applyTest(extra);
 	}
+      cnt++;
+      if(index==cnt)
+	{
+	  testWWG A;
+	  X=A.applyTest(extra);
+	}
 
     } while (!X && type!=index && index<static_cast<int>(TSize));
     
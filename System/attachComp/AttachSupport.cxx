@@ -45,6 +45,7 @@
 #include "MatrixBase.h"
 #include "Matrix.h"
 #include "Vec3D.h"
+#include "BoundBox.h"
 #include "support.h"
 #include "Surface.h"
 #include "Quadratic.h"
@@ -598,6 +599,11 @@ checkIntersect(const ContainedComp& CC,const MonteCarlo::Object& CellObj,
 {
   ELog::RegMethod RegA("AttachSupport","checkInsert");
   //  ELog::debugMethod DegA;
+
+  // All intersection points must be within both boxes
+  if (!CC.getOuterBox().overlap(CellObj.getBoundBox()))
+    return 0;
+
   const std::vector<Geometry::Surface*>& SVec=CC.getSurfaces(); 
   std::vector<Geometry::Vec3D> Out;
   std::vector<Geometry::Vec3D>::const_iterator vc;
@@ -49,6 +49,7 @@
 #include "Matrix.h"
 #include "Vec3D.h"
 #include "Surface.h"
+#include "BoundBox.h"
 #include "SurInter.h"
 #include "Rules.h"
 #include "HeadRule.h"
@@ -545,6 +546,16 @@ ContainedComp::isOuterValid(const Geometry::Vec3D& V) const
   return (outerSurf.isValid(V)) ? 0 : 1;
 }
 
+Geometry::BoundBox
+ContainedComp::getOuterBox() const
+  /*!
+    Calculate the bounding box of the outer surface
+    \return Bounding box [unbounded if no outer surface]
+  */
+{
+  return outerSurf.calcBoundBox();
+}
+
 void 
 ContainedComp::addInsertCell(const std::vector<int>& CVec)
   /*!
@@ -622,12 +633,22 @@ ContainedComp::insertObjects(Simulation& System)
 {
   ELog::RegMethod RegA("ContainedComp","insertObjects");
   if (!hasOuterSurf()) return;
-  
+
+  // cells that cannot touch the outer surface need no exclusion
+  const Geometry::BoundBox OuterBox=getOuterBox();
+  // exclude rule is built once for all the cells
+  HeadRule ExcludeRule;
+  ExcludeRule.procString(getExclude());
   for(const int CN : insertCells)
     {
       MonteCarlo::Qhull* outerObj=System.findQhull(CN);
       if (outerObj)
-	outerObj->addSurfString(getExclude());
+	{
+	  // populate sets the cell box 
+	  outerObj->populate();
+	  if (OuterBox.overlap(outerObj->getBoundBox()))
+	    outerObj->addIntersection(ExcludeRule);
+	}
       else
 	ELog::EM<<"Failed to find outerObject: "<<CN<<ELog::endErr;
     }
@@ -27,6 +27,7 @@ class Simulation;
 namespace Geometry
 {
   class Line;
+  class BoundBox;
 }
 
 namespace attachSystem
@@ -86,6 +87,7 @@ class ContainedComp
   int isOuterValid(const Geometry::Vec3D&) const;
   int isOuterValid(const Geometry::Vec3D&,const std::set<int>&) const;
   int isOuterValid(const Geometry::Vec3D&,const int) const;
+  Geometry::BoundBox getOuterBox() const;
 
   // line in
   bool isOuterLine(const Geometry::Vec3D&,const Geometry::Vec3D&) const;
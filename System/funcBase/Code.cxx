@@ -28,6 +28,7 @@
 #include <vector>
 #include <map>
 #include <iterator>
+#include <algorithm>
 
 #include "Exception.h"
 #include "FileReport.h"
@@ -689,6 +690,33 @@ Code::typeConvert(const double& D)
   return D;
 }
 
+int
+Code::varIndex(std::vector<int>& VIndex) const
+  /*!
+    Collect the index of the variables that are read 
+    by the code [unique]
+    \param VIndex :: Variable indexes [added to]
+    \return 0 if the code sets a variable / 1 otherwize
+  */
+{
+  int pureFlag(1);
+  for(size_t IP=0;IP<ByteCode.size();IP++)
+    {
+      if (ByteCode[IP]==Opcodes::cEqual)
+	{
+	  pureFlag=0;
+	  IP++;
+	}
+      else if (ByteCode[IP]>=Opcodes::varBegin)
+	{
+	  const int index(ByteCode[IP]-Opcodes::varBegin);
+	  if (std::find(VIndex.begin(),VIndex.end(),index)==VIndex.end())
+	    VIndex.push_back(index);
+	}
+    }
+  return pureFlag;
+}
+
 void
 Code::writeCompact(std::ostream& OX) const
   /*!
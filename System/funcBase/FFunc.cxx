@@ -46,17 +46,21 @@
 //-----------------------------------------
 
 FFunc::FFunc(varList* VA,const int I,const Code& CObj) :
-  FItem(VA,I),BaseUnit(CObj)
+  FItem(VA,I),BaseUnit(CObj),cacheFlag(0),cacheDbl(0.0)
   /*!
     Standard constructor
     \param VA :: VarList pointer
     \param I :: Index Item
     \param CObj :: Code Item to allow evaluation
   */
-{}
+{
+  std::vector<int> Index;
+  cacheable=BaseUnit.varIndex(Index);
+}
 
 FFunc::FFunc(const FFunc& A) :
-  FItem(A),BaseUnit(A.BaseUnit)
+  FItem(A),BaseUnit(A.BaseUnit),cacheable(A.cacheable),
+  cacheFlag(0),cacheDbl(0.0)
   /*!
     Standard copy constructor
     \param A :: FFunc object to copy
@@ -75,6 +79,8 @@ FFunc::operator=(const FFunc& A)
     {
       FItem::operator=(A);
       BaseUnit=A.BaseUnit;
+      cacheable=A.cacheable;
+      cacheFlag=0;
     }
   return *this;
 }
@@ -104,22 +110,69 @@ FFunc::setValue(const Code& AC)
   */
 {
   BaseUnit=AC;
+  std::vector<int> Index;
+  cacheable=BaseUnit.varIndex(Index);
+  cacheFlag=0;
   return;
 }
 
+std::vector<int>
+FFunc::getDependencies() const
+  /*!
+    Get the variables that the code reads
+    \return variable indexes
+  */
+{
+  std::vector<int> Index;
+  BaseUnit.varIndex(Index);
+  return Index;
+}
+
+double
+FFunc::evalDouble() const
+  /*!
+    Evaluate the code as a double. The value is kept 
+    until the varList clears it on a change to a variable
+    that the code depends on.
+    \return value
+  */
+{
+  if (!(cacheFlag & 1))
+    {
+      Code BC(BaseUnit);
+      cacheDbl=BC.Eval<double>(VListPtr);
+      if (cacheable) cacheFlag|=1;
+    }
+  return cacheDbl;
+}
+
 int
 FFunc::getValue(Geometry::Vec3D& V) const
   /*!
     Get the values. Note that this
     uses varlist
     \param V :: Outsyste m
-    \return 1 if appropiate eval / 0 otherwise
+    \return 1 if appropiate eval / 0 otherwise [double result]
   */
 {
   ELog::RegMethod RegA("FFunc","getValue(Vec3D)");
 
-  Code BC(BaseUnit);
-  V=BC.Eval<Geometry::Vec3D>(FItem::VListPtr);
+  if (cacheFlag & 1) return 0;
+  if (!(cacheFlag & 2))
+    {
+      Code BC(BaseUnit);
+      try
+	{
+	  cacheVec=BC.Eval<Geometry::Vec3D>(FItem::VListPtr);
+	}
+      catch (ColErr::TypeConvError<double,Geometry::Vec3D>&)
+	{
+	  // double code : let selectValue read it as a double
+	  return 0;
+	}
+      if (cacheable) cacheFlag|=2;
+    }
+  V=cacheVec;
   const_cast<int&>(active)++;
   return 1;
 }
@@ -132,8 +185,7 @@ FFunc::getValue(double& V) const
     \return 1 if appropiate eval / 0 otherwise
   */
 {
-  Code BC(BaseUnit);
-  V=BC.Eval<double>(FItem::VListPtr);
+  V=evalDouble();
   const_cast<int&>(active)++;
   return 1;
 }
@@ -146,8 +198,7 @@ FFunc::getValue(int& V) const
     \return Code expression 
   */
 {
-  Code BC(BaseUnit);
-  V=static_cast<int>(BC.Eval<double>(VListPtr));
+  V=static_cast<int>(evalDouble());
   const_cast<int&>(active)++;
   return 1;
 }
@@ -160,8 +211,7 @@ FFunc::getValue(long int& V) const
     \return Code expression 
   */
 {
-  Code BC(BaseUnit);
-  V=static_cast<long int>(BC.Eval<double>(VListPtr));
+  V=static_cast<long int>(evalDouble());
   const_cast<int&>(active)++;
   return 1;
 }
@@ -175,8 +225,7 @@ FFunc::getValue(size_t& V) const
     \return Code expression 
   */
 {
-  Code BC(BaseUnit);
-  V=static_cast<size_t>(BC.Eval<double>(VListPtr));
+  V=static_cast<size_t>(evalDouble());
   const_cast<int&>(active)++;
   return 1;
 }
@@ -189,8 +238,7 @@ FFunc::getValue(std::string& V) const
     \return Code expression 
   */
 {
-  Code BC(BaseUnit);
-  double Val=BC.Eval<double>(VListPtr);
+  const double Val=evalDouble();
   std::stringstream cx;
   cx<<Val;
   V=cx.str();
@@ -109,6 +109,20 @@ FuncDataBase::findItem(const std::string& Key) const
    return VList.findVar(Key);
 }
 
+const FItem*
+FuncDataBase::findItem(const std::string& Prefix,const long int Index,
+		       const std::string& Suffix) const
+  /*!
+    Finds a variable item named Prefix+Index+Suffix
+    \param Prefix :: Front of name
+    \param Index :: Index number
+    \param Suffix :: Back of name
+    \return FItem pointer (or 0 on failure to find)
+  */
+{
+   return VList.findVar(Prefix,Index,Suffix);
+}
+
 int
 FuncDataBase::hasVariable(const std::string& Key) const
   /*!
@@ -141,6 +155,43 @@ FuncDataBase::EvalVar(const std::string& Key) const
   return Out;
 }
 
+template<typename T>
+int
+FuncDataBase::tryEval(const std::string& Key,T& Out) const
+  /*!
+    Finds the value of a variable item if it exists
+    [single lookup for hasVariable + EvalVar]
+    \param Key :: string to search
+    \param Out :: Value of variable [unchanged if not found]
+    \return 1 if variable found / 0 otherwise
+  */
+{
+  const FItem* FI=findItem(Key);
+  if (!FI) return 0;
+  FI->getValue(Out);
+  return 1;
+}
+
+template<typename T>
+int
+FuncDataBase::tryEval(const std::string& Prefix,const long int Index,
+		      const std::string& Suffix,T& Out) const
+  /*!
+    Finds the value of the variable Prefix+Index+Suffix
+    if it exists. The name is not constructed.
+    \param Prefix :: Front of name
+    \param Index :: Index number
+    \param Suffix :: Back of name
+    \param Out :: Value of variable [unchanged if not found]
+    \return 1 if variable found / 0 otherwise
+  */
+{
+  const FItem* FI=findItem(Prefix,Index,Suffix);
+  if (!FI) return 0;
+  FI->getValue(Out);
+  return 1;
+}
+
 template<typename T>
 T
 FuncDataBase::EvalDefVar(const std::string& Key,const T& def) const
@@ -1126,6 +1177,27 @@ template int FuncDataBase::EvalVar(const std::string&) const;
 template size_t FuncDataBase::EvalVar(const std::string&) const;
 template std::string FuncDataBase::EvalVar(const std::string&) const;
 
+template int FuncDataBase::tryEval(const std::string&,double&) const;
+template int FuncDataBase::tryEval(const std::string&,int&) const;
+template int FuncDataBase::tryEval(const std::string&,long int&) const;
+template int FuncDataBase::tryEval(const std::string&,size_t&) const;
+template int FuncDataBase::tryEval(const std::string&,std::string&) const;
+template int FuncDataBase::tryEval(const std::string&,
+				   Geometry::Vec3D&) const;
+
+template int FuncDataBase::tryEval(const std::string&,const long int,
+				   const std::string&,double&) const;
+template int FuncDataBase::tryEval(const std::string&,const long int,
+				   const std::string&,int&) const;
+template int FuncDataBase::tryEval(const std::string&,const long int,
+				   const std::string&,long int&) const;
+template int FuncDataBase::tryEval(const std::string&,const long int,
+				   const std::string&,size_t&) const;
+template int FuncDataBase::tryEval(const std::string&,const long int,
+				   const std::string&,std::string&) const;
+template int FuncDataBase::tryEval(const std::string&,const long int,
+				   const std::string&,Geometry::Vec3D&) const;
+
 template double FuncDataBase::EvalDefVar(const std::string&,
 					 const double&) const;
 template int FuncDataBase::EvalDefVar(const std::string&,const int&) const;
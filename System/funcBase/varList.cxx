@@ -44,28 +44,28 @@
 #include "FItem.h"
 #include "varList.h"
 
+const size_t varList::hashSeed
+  (static_cast<size_t>(14695981039346656037ULL));
+
 varList::varList() :
-  varNum(0)
+  varNum(0),nHash(0)
   /*!
     Default constructor
   */
 {}
 
 varList::varList(const varList& A) :
-  varNum(A.varNum)
+  varNum(A.varNum),nHash(0),depMap(A.depMap)
   /*!
     Standard Copy constructor.
     Makes a memory copy of the FItem*
     \param A :: varList to copy
   */
 {
+  rehash(A.hashTable.size());
   std::map<std::string,FItem*>::const_iterator vc;
   for(vc=A.varName.begin();vc!=A.varName.end();vc++)
-    {
-      FItem* Ptr=vc->second->clone();
-      varName.insert(std::pair<std::string,FItem*>(vc->first,Ptr));
-      varItem.insert(std::pair<int,FItem*>(Ptr->getIndex(),Ptr));
-    }
+    insertItem(vc->first,vc->second->clone());
   return;
 }
 
@@ -82,13 +82,11 @@ varList::operator=(const varList& A)
     {
       varNum=A.varNum;
       deleteMem();
+      depMap=A.depMap;
+      rehash(A.hashTable.size());
       std::map<std::string,FItem*>::const_iterator vc;
       for(vc=A.varName.begin();vc!=A.varName.end();vc++)
-        {
-	  FItem* Ptr=vc->second->clone();
-	  varName.insert(std::pair<std::string,FItem*>(vc->first,Ptr));
-	  varItem.insert(std::pair<int,FItem*>(Ptr->getIndex(),Ptr));
-	}
+	insertItem(vc->first,vc->second->clone());
     }
   return *this;
 }
@@ -113,6 +111,226 @@ varList::deleteMem()
     delete vc->second;
   varItem.erase(varItem.begin(),varItem.end());
   varName.erase(varName.begin(),varName.end());
+  depMap.clear();
+  hashTable.clear();
+  nHash=0;
+  return;
+}
+
+size_t
+varList::hashAdd(size_t H,const char* Str,const size_t Len)
+  /*!
+    Accumulate a FNV-1a hash over a set of characters
+    \param H :: Current hash value
+    \param Str :: Characters to add
+    \param Len :: Number of characters
+    \return new hash 
+  */
+{
+  for(size_t i=0;i<Len;i++)
+    {
+      H^=static_cast<unsigned char>(Str[i]);
+      H*=static_cast<size_t>(1099511628211ULL);
+    }
+  return H;
+}
+
+size_t
+varList::indexDigits(const long int Index,char* Buffer)
+  /*!
+    Write the decimal form of Index into a buffer
+    [same as operator<<]. 
+    \param Index :: Index to write
+    \param Buffer :: Output buffer [min 21 chars]
+    \return number of characters written
+  */
+{
+  char Rev[24];
+  size_t nRev(0);
+  unsigned long int UI=(Index<0) ?
+    0UL-static_cast<unsigned long int>(Index) :
+    static_cast<unsigned long int>(Index);
+  do
+    {
+      Rev[nRev++]=static_cast<char>('0'+(UI % 10));
+      UI/=10;
+    } while(UI);
+
+  size_t nOut(0);
+  if (Index<0)
+    Buffer[nOut++]='-';
+  while(nRev)
+    Buffer[nOut++]=Rev[--nRev];
+  return nOut;
+}
+
+void
+varList::rehash(const size_t minSize)
+  /*!
+    Rebuild the hash table from the variable names
+    \param minSize :: Minimum table size 
+  */
+{
+  size_t N(64);
+  while(N<minSize || N<4*varName.size())
+    N*=2;
+
+  const hashSlot emptySlot={0,0};
+  hashTable.assign(N,emptySlot);
+  nHash=0;
+  for(varStore::value_type& vc : varName)
+    {
+      const size_t H=hashAdd(hashSeed,vc.first.c_str(),vc.first.size());
+      size_t index(H & (N-1));
+      while(hashTable[index].key)
+	index=(index+1) & (N-1);
+      hashTable[index].hash=H;
+      hashTable[index].key=&vc;
+      nHash++;
+    }
+  return;
+}
+
+void
+varList::insertItem(const std::string& Name,FItem* Ptr)
+  /*!
+    Insert a new item into the name/index/hash tables.
+    The name must not already exist.
+    \param Name :: Variable name
+    \param Ptr :: Item [managed]
+  */
+{
+  std::pair<varStore::iterator,bool> vc=
+    varName.insert(varStore::value_type(Name,Ptr));
+  varItem.insert(std::pair<int,FItem*>(Ptr->getIndex(),Ptr));
+
+  if (2*(nHash+1)>hashTable.size())
+    {
+      rehash(2*hashTable.size());
+      return;
+    }
+  
+  const size_t mask(hashTable.size()-1);
+  const size_t H=hashAdd(hashSeed,Name.c_str(),Name.size());
+  size_t index(H & mask);
+  while(hashTable[index].key)
+    index=(index+1) & mask;
+  hashTable[index].hash=H;
+  hashTable[index].key=&(*vc.first);
+  nHash++;
+  return;
+}
+
+varList::varStore::value_type*
+varList::findSlot(const std::string& Key) const
+  /*!
+    Find the interned name/item 
+    \param Key :: Full variable name
+    \return name/item pair [0 if not found]
+  */
+{
+  if (hashTable.empty()) return 0;
+
+  const size_t mask(hashTable.size()-1);
+  const size_t H=hashAdd(hashSeed,Key.c_str(),Key.size());
+  for(size_t index=(H & mask);hashTable[index].key;
+      index=(index+1) & mask)
+    {
+      const hashSlot& HS(hashTable[index]);
+      if (HS.hash==H && HS.key->first==Key)
+	return HS.key;
+    }
+  return 0;
+}
+
+varList::varStore::value_type*
+varList::findSlot(const std::string& Prefix,const long int Index,
+		  const std::string& Suffix) const
+  /*!
+    Find the interned name/item of Prefix+Index+Suffix
+    without constructing the name.
+    \param Prefix :: Front of name
+    \param Index :: Number [as written by operator<<]
+    \param Suffix :: Back of name
+    \return name/item pair [0 if not found]
+  */
+{
+  if (hashTable.empty()) return 0;
+
+  char Digits[24];
+  const size_t nD=indexDigits(Index,Digits);
+  const size_t nP(Prefix.size());
+  const size_t nS(Suffix.size());
+  
+  size_t H=hashAdd(hashSeed,Prefix.c_str(),nP);
+  H=hashAdd(H,Digits,nD);
+  H=hashAdd(H,Suffix.c_str(),nS);
+  
+  const size_t mask(hashTable.size()-1);
+  for(size_t index=(H & mask);hashTable[index].key;
+      index=(index+1) & mask)
+    {
+      const hashSlot& HS(hashTable[index]);
+      if (HS.hash==H)
+	{
+	  const std::string& Name(HS.key->first);
+	  if (Name.size()==nP+nD+nS &&
+	      !Name.compare(0,nP,Prefix) &&
+	      !Name.compare(nP,nD,Digits,nD) &&
+	      !Name.compare(nP+nD,nS,Suffix))
+	    return HS.key;
+	}
+    }
+  return 0;
+}
+
+void
+varList::linkVar(const FItem* FPtr)
+  /*!
+    Register the variables that an item reads so that
+    a change to them clears the cached value of the item
+    \param FPtr :: Item to register
+  */
+{
+  const int I=FPtr->getIndex();
+  const std::vector<int> DVec=FPtr->getDependencies();
+  for(const int D : DVec)
+    {
+      std::vector<int>& Dep=depMap[D];
+      if (std::find(Dep.begin(),Dep.end(),I)==Dep.end())
+	Dep.push_back(I);
+    }
+  return;
+}
+
+void
+varList::invalidate(const int Key)
+  /*!
+    Clear the cache of all the items that depend 
+    (directly or indirectly) on the variable
+    \param Key :: Variable index that has changed
+  */
+{
+  std::vector<int> Stack;
+  std::vector<int> Done;
+  Stack.push_back(Key);
+  while(!Stack.empty())
+    {
+      const int I=Stack.back();
+      Stack.pop_back();
+      std::map<int,std::vector<int>>::const_iterator mc=depMap.find(I);
+      if (mc==depMap.end()) continue;
+      for(const int D : mc->second)
+	{
+	  if (std::find(Done.begin(),Done.end(),D)!=Done.end())
+	    continue;
+	  Done.push_back(D);
+	  FItem* DPtr=findVar(D);
+	  if (DPtr)
+	    DPtr->clearCache();
+	  Stack.push_back(D);
+	}
+    }
   return;
 }
 
@@ -125,12 +343,25 @@ varList::findVar(const std::string& Key) const
     \retval FItem pointer
   */
 {
-  std::map<std::string,FItem*>::const_iterator vc;
-  vc=varName.find(Key);
-  if (vc!=varName.end())
-    return vc->second;
+  const varStore::value_type* VPtr=findSlot(Key);
+  return (VPtr) ? VPtr->second : 0;
+}
 
-  return 0;
+const FItem*
+varList::findVar(const std::string& Prefix,const long int Index,
+		 const std::string& Suffix) const
+  /*!
+    Returns a pointer to the FItem* instance of 
+    the name Prefix+Index+Suffix.
+    \param Prefix :: Front of name
+    \param Index :: Number
+    \param Suffix :: Back of name
+    \retval 0 :: If no such function name exists,
+    \retval FItem pointer
+  */
+{
+  const varStore::value_type* VPtr=findSlot(Prefix,Index,Suffix);
+  return (VPtr) ? VPtr->second : 0;
 }
 
 const FItem*
@@ -176,12 +407,8 @@ varList::findVar(const std::string& Key)
     \retval FItem pointer
   */
 {
-  std::map<std::string,FItem*>::iterator vc;
-  vc=varName.find(Key);
-  if (vc!=varName.end())
-    return vc->second;
-
-  return 0;
+  varStore::value_type* VPtr=findSlot(Key);
+  return (VPtr) ? VPtr->second : 0;
 }
 
 
@@ -204,23 +431,24 @@ varList::copyVar(const std::string& Key,const std::string& other)
   if (bc==varName.end())
     throw ColErr::InContainerError<std::string>(other,"Var item not found");
 
+  FItem* Ptr=bc->second->clone();
+  Ptr->setIndex(varNum);
+  varNum++;
+
   ac=varName.find(Key);
   if (ac!=varName.end())
     {
+      // replace in place to keep the interned name 
       const int I=ac->second->getIndex();
       delete ac->second;
-
-      std::map<int,FItem*>::iterator ic;
-      ic=varItem.find(I);
-      varName.erase(ac);
-      varItem.erase(ic);
+      varItem.erase(I);
+      ac->second=Ptr;
+      varItem.insert(std::pair<int,FItem*>(Ptr->getIndex(),Ptr));
+      invalidate(I);
     }
-  FItem* Ptr=bc->second->clone();
-  Ptr->setIndex(varNum);
-  varNum++;
-    // Now insert into master lists
-  varName.insert(std::pair<std::string,FItem*>(Key,Ptr));
-  varItem.insert(std::pair<int,FItem*>(Ptr->getIndex(),Ptr));
+  else
+    insertItem(Key,Ptr);
+  linkVar(Ptr);
 
   return;
 }
@@ -292,7 +520,11 @@ varList::setValue(const int Key,const T& Value)
 {
   FItem* FPtr=findVar(Key);
   if (FPtr)
-    FPtr->setValue(Value);
+    {
+      FPtr->setValue(Value);
+      invalidate(Key);
+      linkVar(FPtr);
+    }
   return;
 }
 
@@ -307,31 +539,28 @@ varList::addVar(const std::string& Name,const T& Value)
     \param Value :: current value
   */
 {
-  std::map<std::string,FItem*>::iterator vc;
-  vc=varName.find(Name);
+  varStore::value_type* VPtr=findSlot(Name);
   FItem* Ptr(0);
-  if (vc!=varName.end())
+  if (VPtr)
     {
       // Note that the variable number is re-used 
       // despite the change in variable.
-      const int I=vc->second->getIndex();
+      const int I=VPtr->second->getIndex();
 
-      delete vc->second;
-      std::map<int,FItem*>::iterator ac;
-      ac=varItem.find(I);
-      varName.erase(vc);
-      varItem.erase(ac);
+      delete VPtr->second;
       Ptr=createFType<T>(I,Value);
+      VPtr->second=Ptr;
+      varItem[I]=Ptr;
+      invalidate(I);
     }
   else
   // Need to make a completely new item
     {
       Ptr=createFType(varNum,Value);
       varNum++;
+      insertItem(Name,Ptr);
     }
-  // Now insert into master lists
-  varName.insert(std::pair<std::string,FItem*>(Name,Ptr));
-  varItem.insert(std::pair<int,FItem*>(Ptr->getIndex(),Ptr));
+  linkVar(Ptr);
   return;
 }
 
@@ -345,13 +574,14 @@ varList::setVar(const std::string& Name,const T& Value)
     \param Value :: current value
   */
 {
-  std::map<std::string,FItem*>::iterator vc;
-  vc=varName.find(Name);
-  if (vc==varName.end())
+  varStore::value_type* VPtr=findSlot(Name);
+  if (!VPtr)
     throw ColErr::InContainerError<std::string>(Name,"varList::setVar");
   try
     {
-      vc->second->setValue(Value);
+      VPtr->second->setValue(Value);
+      invalidate(VPtr->second->getIndex());
+      linkVar(VPtr->second);
     }
   catch (ColErr::ExBase&)
     {
@@ -115,6 +115,8 @@ class Code
   /// Apply - to the values 
   void minusImmed() { Immed.back()*=-1.0; }
   
+  int varIndex(std::vector<int>&) const;
+
   void writeCompact(std::ostream&) const;
   void printByteCode(std::ostream&) const;
 
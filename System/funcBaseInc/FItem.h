@@ -67,6 +67,12 @@ class FItem
 
   /// Accessor to active
   int isActive() const { return active; }
+  /// Remove any cached value
+  virtual void clearCache() {}
+  /// Variables [index] read by the item
+  virtual std::vector<int> getDependencies() const
+    { return std::vector<int>(); }
+
   ///\cond ABSTRACT
 
   virtual int getValue(Geometry::Vec3D&) const= 0;
@@ -140,6 +146,13 @@ class FFunc : public FItem
 
   Code BaseUnit;    ///< Code unit of a compile Function
 
+  int cacheable;                   ///< Code does not set variables
+  mutable int cacheFlag;           ///< Cached [1 : double / 2 : Vec3D]
+  mutable double cacheDbl;         ///< Cached double value
+  mutable Geometry::Vec3D cacheVec;  ///< Cached Vec3D value
+
+  double evalDouble() const;
+
  public:
 
   FFunc(varList*,const int,const Code&);
@@ -149,6 +162,8 @@ class FFunc : public FItem
   virtual ~FFunc();
 
   void setValue(const Code&);
+  virtual void clearCache() { cacheFlag=0; }
+  virtual std::vector<int> getDependencies() const;
 
   virtual int getValue(Geometry::Vec3D&) const;  
   virtual int getValue(int&) const;     
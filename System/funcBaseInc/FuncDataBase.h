@@ -77,6 +77,8 @@ class FuncDataBase
   
   //  int hasItem(const std::string&) const;
   const FItem* findItem(const std::string&) const;
+  const FItem* findItem(const std::string&,const long int,
+			const std::string&) const;
   //  void setFuncParser(const std::string&,const FuncDataBase&);
   
   int Parse(const std::string&);
@@ -85,6 +87,11 @@ class FuncDataBase
   template<typename T>
   T EvalVar(const std::string&) const;      
   template<typename T>
+  int tryEval(const std::string&,T&) const;
+  template<typename T>
+  int tryEval(const std::string&,const long int,
+	      const std::string&,T&) const;
+  template<typename T>
   T EvalDefVar(const std::string&,const T&) const;      
   template<typename T>
   T EvalPair(const std::string&,const std::string&) const;      
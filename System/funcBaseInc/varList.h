@@ -31,6 +31,9 @@
 
   This class holds the variable name + number 
   relative to the actual variable type object. 
+  Names are interned in varName and indexed by an
+  open-addressing hash table [linear probe] so that
+  lookups do not search the ordered map.
 */
 
 class FItem;
@@ -43,12 +46,35 @@ class varList
 
  private:
 
+  /// Hash table slot [key==0 : empty]
+  struct hashSlot
+  {
+    size_t hash;                   ///< Full hash value of name
+    varStore::value_type* key;     ///< Interned name/item  
+  };
+
+  static const size_t hashSeed;            ///< Initial hash value
+
   int varNum;                              ///< Current max var
+  size_t nHash;                            ///< Number of filled slots
+  std::vector<hashSlot> hashTable;         ///< Name hash [power of 2]
 
   varStore varName;    ///< Var by name
   std::map<int,FItem*> varItem;            ///< Var by number
+  /// Var index : function indexes that read it
+  std::map<int,std::vector<int>> depMap;
 
   void deleteMem();
+  void linkVar(const FItem*);
+  void invalidate(const int);
+
+  static size_t hashAdd(size_t,const char*,const size_t);
+  static size_t indexDigits(const long int,char*);
+  void rehash(const size_t);
+  void insertItem(const std::string&,FItem*);
+  varStore::value_type* findSlot(const std::string&) const;
+  varStore::value_type* findSlot(const std::string&,const long int,
+				 const std::string&) const;
 
  public:
 
@@ -61,6 +87,8 @@ class varList
   const FItem* findVar(const int) const;
   FItem* findVar(const std::string&);
   FItem* findVar(const int);
+  const FItem* findVar(const std::string&,const long int,
+		       const std::string&) const;
 
   void copyVar(const std::string&,const std::string&);
   
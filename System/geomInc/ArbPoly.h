@@ -91,6 +91,8 @@ class ArbPoly : public Surface
   void print() const;
   void write(std::ostream&) const;        
   virtual void writeFLUKA(std::ostream&) const;        
+  virtual void writeBinary(std::ostream&) const;
+  virtual void readBinary(std::istream&);
 
 };
 
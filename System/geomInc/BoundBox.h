@@ -0,0 +1,89 @@
+/********************************************************************* 
+  CombLayer : MCNP(X) Input builder
+ 
+ * File:   geomInc/BoundBox.h
+ *
+ * Copyright (c) 2004-2016 by Stuart Ansell
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>. 
+ *
+ ****************************************************************************/
+#ifndef Geometry_BoundBox_h
+#define Geometry_BoundBox_h
+
+namespace Geometry
+{
+
+/*!
+  \class BoundBox
+  \brief Axis aligned bounding box
+  \author S. Ansell
+  \date May 2016
+  \version 1.0
+
+  Holds a conservative axis-aligned box. Unbounded
+  directions are set to +/- boxInf. An empty box
+  has LowPt > HighPt on at least one axis.
+*/
+
+class BoundBox
+{
+ private:
+
+  Geometry::Vec3D LowPt;        ///< Low corner
+  Geometry::Vec3D HighPt;       ///< High corner
+
+ public:
+
+  static const double boxInf;   ///< Effective infinity
+
+  BoundBox();
+  BoundBox(const Geometry::Vec3D&,const Geometry::Vec3D&);
+  BoundBox(const BoundBox&);
+  BoundBox& operator=(const BoundBox&);
+  ~BoundBox() {}    ///< Destructor
+
+  static BoundBox emptyBox();
+
+  /// Access low corner
+  const Geometry::Vec3D& getLow() const { return LowPt; }
+  /// Access high corner
+  const Geometry::Vec3D& getHigh() const { return HighPt; }
+
+  void setLow(const size_t,const double);
+  void setHigh(const size_t,const double);
+
+  bool isEmpty() const;
+  bool isFinite() const;
+  bool isValid(const Geometry::Vec3D&) const;
+  bool overlap(const BoundBox&) const;
+  bool cutPlane(const Geometry::Vec3D&,const double) const;
+  bool cutLine(const Geometry::Vec3D&,const Geometry::Vec3D&) const;
+
+  void addPoint(const Geometry::Vec3D&);
+  void unionBox(const BoundBox&);
+  void intersectBox(const BoundBox&);
+  void pad(const double);
+
+  Geometry::Vec3D getCentre() const;
+  size_t longAxis() const;
+
+  void write(std::ostream&) const;
+};
+
+std::ostream& operator<<(std::ostream&,const BoundBox&);
+
+}  // NAMESPACE Geometry
+
+#endif
@@ -98,6 +98,8 @@ class Cone : public Quadratic
   int getCutFlag() const { return cutFlag; }
 
   void write(std::ostream&) const;
+  virtual void writeBinary(std::ostream&) const;
+  virtual void readBinary(std::istream&);
 };
 
 }  // NAMESPACE Geometry
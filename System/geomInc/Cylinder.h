@@ -98,6 +98,8 @@ class Cylinder : public Quadratic
 
   virtual void write(std::ostream&) const;
   virtual void writeFLUKA(std::ostream&) const;
+  virtual void writeBinary(std::ostream&) const;
+  virtual void readBinary(std::istream&);
   virtual void print() const;
 
 };
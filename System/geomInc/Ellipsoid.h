@@ -113,6 +113,7 @@ class Ellipsoid : public Quadratic
   void displace(const Geometry::Vec3D&);
 
   virtual void write(std::ostream&) const;
+  virtual void writeBinary(std::ostream&) const;
   virtual void print() const;
 
 };
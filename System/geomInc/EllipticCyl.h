@@ -108,6 +108,8 @@ class EllipticCyl : public Quadratic
   void displace(const Geometry::Vec3D&);
 
   virtual void write(std::ostream&) const;
+  virtual void writeBinary(std::ostream&) const;
+  virtual void readBinary(std::istream&);
   virtual void print() const;
 
 };
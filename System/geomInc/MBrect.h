@@ -93,6 +93,8 @@ class MBrect : public Surface
   void print() const;
   void write(std::ostream&) const;       
   virtual void writeFLUKA(std::ostream&) const;       
+  virtual void writeBinary(std::ostream&) const;
+  virtual void readBinary(std::istream&);
 
 };
 
@@ -113,6 +113,8 @@ class Plane : public Quadratic
   void print() const;
   void write(std::ostream&) const;  
   virtual void writeFLUKA(std::ostream&) const;
+  virtual void writeBinary(std::ostream&) const;
+  virtual void readBinary(std::istream&);
 };
 
 std::ostream&
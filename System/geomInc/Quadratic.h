@@ -96,6 +96,8 @@ class Quadratic : public Surface
   void normalizeGEQ(const size_t);
   virtual void write(std::ostream&) const;
   virtual void writeFLUKA(std::ostream&) const;
+  virtual void writeBinary(std::ostream&) const;
+  virtual void readBinary(std::istream&);
   virtual void print() const;
   
   virtual void writeXML(const std::string&) const;
@@ -86,6 +86,8 @@ class Sphere : public Quadratic
 
   void writeFLUKA(std::ostream&) const;
   void write(std::ostream&) const; 
+  virtual void writeBinary(std::ostream&) const;
+  virtual void readBinary(std::istream&);
 
 };
 
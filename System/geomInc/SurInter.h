@@ -27,6 +27,7 @@ class HeadRule;
 namespace Geometry
 {
   class Intersect;
+  class Line;
   
   class Surface;
   class Quadratic;
@@ -95,6 +96,19 @@ std::vector<Geometry::Vec3D>
 makePoint(const Geometry::Quadratic*,const Geometry::Quadratic*,
 	  const Geometry::Quadratic*);
 
+// Closed form kernels:
+int
+radicalPlane(const Geometry::Quadratic&,const Geometry::Quadratic&,
+	     Geometry::Plane&);
+
+size_t
+cylinderLines(const Geometry::Plane&,const Geometry::Cylinder&,
+	      std::vector<Geometry::Line>&);
+
+int
+specialPoint(const Geometry::Quadratic*,const Geometry::Quadratic*,
+	     const Geometry::Quadratic*,std::vector<Geometry::Vec3D>&);
+
 int 
 getMidPoint(const Geometry::Surface*,const Geometry::Surface*, 
 	    const Geometry::Surface*,Geometry::Vec3D&);
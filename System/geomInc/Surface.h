@@ -99,6 +99,9 @@ class Surface
   virtual void writeFLUKA(std::ostream&) const =0;
   /// \endcond ABSTRACT
 
+  virtual void writeBinary(std::ostream&) const;
+  virtual void readBinary(std::istream&);
+
   virtual void rotate(const Geometry::Quaternion&);
 
   void writeHeader(std::ostream&) const;
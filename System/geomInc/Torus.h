@@ -102,6 +102,8 @@ class Torus : public Surface
 
   void write(std::ostream&) const;
   virtual void writeFLUKA(std::ostream&) const;
+  virtual void writeBinary(std::ostream&) const;
+  virtual void readBinary(std::istream&);
 
 };
 
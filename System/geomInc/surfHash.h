@@ -0,0 +1,105 @@
+/********************************************************************* 
+  CombLayer : MCNP(X) Input builder
+ 
+ * File:   geomInc/surfHash.h
+ *
+ * Copyright (c) 2004-2016 by Stuart Ansell
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>. 
+ *
+ ****************************************************************************/
+#ifndef ModelSupport_surfHash_h
+#define ModelSupport_surfHash_h
+
+namespace Geometry
+{
+  class Surface;
+}
+
+namespace ModelSupport
+{
+
+/*!
+  \class surfHash
+  \version 1.0
+  \author S. Ansell
+  \date June 2016
+  \brief Spatial hash of surfaces for equal/opposite searches
+
+  Surfaces are placed in buckets by type and by a few 
+  quantised features (e.g. |D| and |n| of a plane) that 
+  can only differ by keyTol between equal or opposite
+  surfaces. A search probes every bucket within keyTol
+  and returns the candidates that are still in the 
+  surface map. The final test is always the surface
+  operator== so the hash only removes non-matches.
+  
+  Surfaces that are placed in the map before they are
+  finished [createSurf etc] are held as pending and 
+  indexed at the next search.
+*/
+
+class surfHash
+{
+ private:
+
+  /// Bucket key : type + quantised features
+  typedef std::vector<long int> KTYPE;
+  /// Surface number : surface at time of indexing
+  typedef std::pair<int,const Geometry::Surface*> ITEM;
+
+  /// Hash functor of a bucket key
+  struct keyHash
+  {
+    size_t operator()(const KTYPE&) const;
+  };
+
+  /// Bucket storage
+  typedef std::unordered_map<KTYPE,std::vector<ITEM>,keyHash> BTYPE;
+
+  static const double cellSize;     ///< Quantisation width
+  static const double keyTol;       ///< Max feature change of equal surf
+  
+  int valid;                        ///< Index includes all the map
+  std::set<int> Pending;            ///< Surfaces to index at next search
+  BTYPE Buckets;                    ///< Hash buckets
+
+  static long int features(const Geometry::Surface*,std::vector<double>&);
+  static long int quantise(const double);
+  
+  void insert(const int,const Geometry::Surface*);
+  void update(const std::map<int,Geometry::Surface*>&);
+  
+ public:
+
+  surfHash();
+  surfHash(const surfHash&);
+  surfHash& operator=(const surfHash&);
+  ~surfHash() {}       ///< Destructor
+
+  void clearAll();
+  /// Force a full re-index at the next search
+  void invalidate() { valid=0; }
+  /// Index a surface at the next search
+  void addPending(const int SN) { Pending.insert(SN); }
+  void addSurface(const int,const Geometry::Surface*);
+
+  std::map<int,Geometry::Surface*> 
+    candidates(const std::map<int,Geometry::Surface*>&,
+	       const Geometry::Surface*);
+};
+
+}
+
+#endif
@@ -29,6 +29,7 @@ namespace Geometry
 
 namespace ModelSupport
 {
+  class surfHash;
 
 /*!
   \class surfIndex 
@@ -36,6 +37,10 @@ namespace ModelSupport
   \author S. Ansell
   \date December 2009
   \brief Storage for all the surfaces in the problem
+
+  Equal and opposite surface searches use a hash
+  of the surfaces [surfHash]. Any code that changes 
+  surfaces in the map in place must call clearHash.
 */
 
 class surfIndex
@@ -49,6 +54,7 @@ class surfIndex
   int uniqNum;                      ///< uniq number
   STYPE SMap;                       ///< Index of kept surfaces
   std::map<int,int> holdMap;        ///< Hold/Write map :: surfaceN : write/no-write flag
+  surfHash* HPtr;                   ///< Hash for equal surfaces
   
   surfIndex();
 
@@ -105,6 +111,8 @@ class surfIndex
 		    std::map<int,Geometry::Surface*>&) const;
   void removeOpposite(const int);
   int findOpposite(const Geometry::Surface*) const;
+  STYPE equalCandidates(const Geometry::Surface*) const;
+  void clearHash();
 
   int readOutputSurfaces(const std::string&);
 };
@@ -54,6 +54,7 @@
 #include "Quadratic.h"
 #include "Plane.h"
 #include "Line.h"
+#include "binaryIO.h"
 #include "ArbPoly.h"
 
 namespace Geometry
@@ -663,12 +664,47 @@ ArbPoly::write(std::ostream& OX) const
 void
 ArbPoly::writeFLUKA(std::ostream&) const
   /*!
-    Write out the cone class in an mcnpx
-    format.
+    No FLUKA form of the surface
     \param  :: Output Stream (required for multiple std::endl)
+    \throw AbsObjMethod :: unsupported output
   */
 {
-  ELog::EM<<"Unsupported output"<<ELog::endErr;
+  throw ColErr::AbsObjMethod("ArbPoly::writeFLUKA : Unsupported output");
+}
+
+void
+ArbPoly::writeBinary(std::ostream& OX) const
+  /*!
+    Write the ArbPoly state to a binary stream 
+    \param OX :: Output stream
+  */
+{
+  Surface::writeBinary(OX);
+  StrFunc::writeBin(OX,nSurface);
+  StrFunc::writeBin(OX,CVec);
+  StrFunc::writeBin(OX,CIndex.size());
+  for(const std::vector<size_t>& CI : CIndex)
+    StrFunc::writeBin(OX,CI);
+  return;
+}
+
+void
+ArbPoly::readBinary(std::istream& IX)
+  /*!
+    Read the ArbPoly state from a binary stream 
+    written by writeBinary
+    \param IX :: Input stream
+  */
+{
+  Surface::readBinary(IX);
+  StrFunc::readBin(IX,nSurface);
+  StrFunc::readBin(IX,CVec);
+  size_t nIndex;
+  StrFunc::readBin(IX,nIndex);
+  CIndex.resize(nIndex);
+  for(std::vector<size_t>& CI : CIndex)
+    StrFunc::readBin(IX,CI);
+  makeSides();
   return;
 }
 
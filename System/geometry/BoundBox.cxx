@@ -0,0 +1,365 @@
+/********************************************************************* 
+  CombLayer : MCNP(X) Input builder
+ 
+ * File:   geometry/BoundBox.cxx
+ *
+ * Copyright (c) 2004-2016 by Stuart Ansell
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>. 
+ *
+ ****************************************************************************/
+#include <fstream>
+#include <iomanip>
+#include <iostream>
+#include <cmath>
+#include <complex>
+#include <vector>
+#include <string>
+#include <algorithm>
+
+#include "Exception.h"
+#include "MatrixBase.h"
+#include "Matrix.h"
+#include "Vec3D.h"
+#include "BoundBox.h"
+
+namespace Geometry
+{
+
+const double BoundBox::boxInf(1e38);
+
+std::ostream&
+operator<<(std::ostream& OX,const BoundBox& A)
+  /*!
+    Write out the box to a stream
+    \param OX :: Output stream
+    \param A :: BoundBox to write
+    \return Current state of stream
+  */
+{
+  A.write(OX);
+  return OX;
+}
+
+BoundBox::BoundBox() :
+  LowPt(-boxInf,-boxInf,-boxInf),
+  HighPt(boxInf,boxInf,boxInf)
+  /*!
+    Constructor : Unbounded box
+  */
+{}
+
+BoundBox::BoundBox(const Geometry::Vec3D& LP,
+		   const Geometry::Vec3D& HP) :
+  LowPt(LP),HighPt(HP)
+  /*!
+    Constructor
+    \param LP :: Low point
+    \param HP :: High point
+  */
+{}
+
+BoundBox::BoundBox(const BoundBox& A) :
+  LowPt(A.LowPt),HighPt(A.HighPt)
+  /*!
+    Copy constructor
+    \param A :: BoundBox to copy
+  */
+{}
+
+BoundBox&
+BoundBox::operator=(const BoundBox& A)
+  /*!
+    Assignment operator
+    \param A :: BoundBox to copy
+    \return *this
+  */
+{
+  if (this!=&A)
+    {
+      LowPt=A.LowPt;
+      HighPt=A.HighPt;
+    }
+  return *this;
+}
+
+BoundBox
+BoundBox::emptyBox()
+  /*!
+    Construct a box that contains nothing
+    (the identity for unionBox)
+    \return Empty box
+  */
+{
+  return BoundBox(Geometry::Vec3D(boxInf,boxInf,boxInf),
+		  Geometry::Vec3D(-boxInf,-boxInf,-boxInf));
+}
+
+void
+BoundBox::setLow(const size_t Index,const double V)
+  /*!
+    Set a low component of the box
+    \param Index :: Axis index [0-2]
+    \param V :: Value
+  */
+{
+  if (Index>2)
+    throw ColErr::IndexError<size_t>(Index,3,"BoundBox::setLow");
+  LowPt[Index]=V;
+  return;
+}
+
+void
+BoundBox::setHigh(const size_t Index,const double V)
+  /*!
+    Set a high component of the box
+    \param Index :: Axis index [0-2]
+    \param V :: Value
+  */
+{
+  if (Index>2)
+    throw ColErr::IndexError<size_t>(Index,3,"BoundBox::setHigh");
+  HighPt[Index]=V;
+  return;
+}
+
+bool
+BoundBox::isEmpty() const
+  /*!
+    Determine if the box has no volume
+    \return true if any axis is inverted
+  */
+{
+  return (LowPt[0]>HighPt[0] ||
+	  LowPt[1]>HighPt[1] ||
+	  LowPt[2]>HighPt[2]);
+}
+
+bool
+BoundBox::isFinite() const
+  /*!
+    Determine if the box is bounded on all sides
+    \return true if bounded
+  */
+{
+  for(size_t i=0;i<3;i++)
+    if (LowPt[i]<=-boxInf || HighPt[i]>=boxInf)
+      return 0;
+  return 1;
+}
+
+bool
+BoundBox::isValid(const Geometry::Vec3D& Pt) const
+  /*!
+    Determine if the point is within/on the box
+    \param Pt :: Point to test
+    \return true if within the box
+  */
+{
+  return (Pt[0]>=LowPt[0] && Pt[0]<=HighPt[0] &&
+	  Pt[1]>=LowPt[1] && Pt[1]<=HighPt[1] &&
+	  Pt[2]>=LowPt[2] && Pt[2]<=HighPt[2]);
+}
+
+bool
+BoundBox::overlap(const BoundBox& A) const
+  /*!
+    Determine if two boxes share a common volume/surface
+    \param A :: Box to test
+    \return true if overlapping
+  */
+{
+  for(size_t i=0;i<3;i++)
+    if (A.HighPt[i]<LowPt[i] || A.LowPt[i]>HighPt[i])
+      return 0;
+  return 1;
+}
+
+bool
+BoundBox::cutPlane(const Geometry::Vec3D& N,const double D) const
+  /*!
+    Determine if a plane (N.x=D) passes through the box.
+    Planes not normal to an unbounded axis always cut.
+    \param N :: Plane normal
+    \param D :: Plane distance
+    \return true if plane cuts/touches the box
+  */
+{
+  if (isEmpty()) return 0;
+  double minV(0.0),maxV(0.0);
+  for(size_t i=0;i<3;i++)
+    {
+      if (N[i]==0.0) continue;
+      if (LowPt[i]<=-boxInf || HighPt[i]>=boxInf)
+	return 1;
+      const double A(N[i]*LowPt[i]);
+      const double B(N[i]*HighPt[i]);
+      minV+=std::min(A,B);
+      maxV+=std::max(A,B);
+    }
+  return (D>=minV && D<=maxV);
+}
+
+bool
+BoundBox::cutLine(const Geometry::Vec3D& Org,
+		  const Geometry::Vec3D& Dir) const
+  /*!
+    Determine if an infinite line passes through the box
+    \param Org :: Point on line
+    \param Dir :: Line direction
+    \return true if line cuts/touches the box
+  */
+{
+  if (isEmpty()) return 0;
+  double tMin(-boxInf);
+  double tMax(boxInf);
+  for(size_t i=0;i<3;i++)
+    {
+      if (Dir[i]==0.0)
+	{
+	  if (Org[i]<LowPt[i] || Org[i]>HighPt[i])
+	    return 0;
+	}
+      else
+	{
+	  double tA=(LowPt[i]-Org[i])/Dir[i];
+	  double tB=(HighPt[i]-Org[i])/Dir[i];
+	  if (tA>tB) std::swap(tA,tB);
+	  tMin=std::max(tMin,tA);
+	  tMax=std::min(tMax,tB);
+	  if (tMin>tMax) return 0;
+	}
+    }
+  return 1;
+}
+
+void
+BoundBox::addPoint(const Geometry::Vec3D& Pt)
+  /*!
+    Expand the box to include the point
+    \param Pt :: Point to include
+  */
+{
+  for(size_t i=0;i<3;i++)
+    {
+      LowPt[i]=std::min(LowPt[i],Pt[i]);
+      HighPt[i]=std::max(HighPt[i],Pt[i]);
+    }
+  return;
+}
+
+void
+BoundBox::unionBox(const BoundBox& A)
+  /*!
+    Expand this box to contain box A
+    \param A :: Box to add
+  */
+{
+  if (A.isEmpty()) return;
+  if (isEmpty())
+    {
+      *this=A;
+      return;
+    }
+  for(size_t i=0;i<3;i++)
+    {
+      LowPt[i]=std::min(LowPt[i],A.LowPt[i]);
+      HighPt[i]=std::max(HighPt[i],A.HighPt[i]);
+    }
+  return;
+}
+
+void
+BoundBox::intersectBox(const BoundBox& A)
+  /*!
+    Reduce this box to the common volume with box A
+    \param A :: Box to intersect
+  */
+{
+  for(size_t i=0;i<3;i++)
+    {
+      LowPt[i]=std::max(LowPt[i],A.LowPt[i]);
+      HighPt[i]=std::min(HighPt[i],A.HighPt[i]);
+    }
+  return;
+}
+
+void
+BoundBox::pad(const double D)
+  /*!
+    Increase the box by D on all finite sides
+    \param D :: Distance to pad by
+  */
+{
+  if (isEmpty()) return;
+  for(size_t i=0;i<3;i++)
+    {
+      if (LowPt[i]>-boxInf)
+	LowPt[i]-=D;
+      if (HighPt[i]<boxInf)
+	HighPt[i]+=D;
+    }
+  return;
+}
+
+Geometry::Vec3D
+BoundBox::getCentre() const
+  /*!
+    Calculate the centre of the box. Unbounded
+    directions are taken as zero.
+    \return Centre point
+  */
+{
+  Geometry::Vec3D Out;
+  for(size_t i=0;i<3;i++)
+    {
+      if (LowPt[i]>-boxInf && HighPt[i]<boxInf)
+	Out[i]=(LowPt[i]+HighPt[i])/2.0;
+    }
+  return Out;
+}
+
+size_t
+BoundBox::longAxis() const
+  /*!
+    Determine the longest axis of the box
+    \return axis index [0-2]
+  */
+{
+  size_t index(0);
+  double maxLen(HighPt[0]-LowPt[0]);
+  for(size_t i=1;i<3;i++)
+    {
+      const double L(HighPt[i]-LowPt[i]);
+      if (L>maxLen)
+	{
+	  maxLen=L;
+	  index=i;
+	}
+    }
+  return index;
+}
+
+void
+BoundBox::write(std::ostream& OX) const
+  /*!
+    Write out the box
+    \param OX :: Output stream
+  */
+{
+  OX<<"["<<LowPt<<"] : ["<<HighPt<<"]";
+  return;
+}
+
+}  // NAMESPACE Geometry
@@ -48,6 +48,7 @@
 #include "Line.h"
 #include "Surface.h"
 #include "Quadratic.h"
+#include "binaryIO.h"
 #include "Cone.h"
 
 namespace Geometry
@@ -458,4 +459,37 @@ Cone::write(std::ostream& OX) const
   return;
 }
 
+void
+Cone::writeBinary(std::ostream& OX) const
+  /*!
+    Write the cone state to a binary stream 
+    \param OX :: Output stream
+  */
+{
+  Quadratic::writeBinary(OX);
+  StrFunc::writeBin(OX,Centre);
+  StrFunc::writeBin(OX,Normal);
+  StrFunc::writeBin(OX,alpha);
+  StrFunc::writeBin(OX,cangle);
+  StrFunc::writeBin(OX,cutFlag);
+  return;
+}
+
+void
+Cone::readBinary(std::istream& IX)
+  /*!
+    Read the cone state from a binary stream 
+    written by writeBinary
+    \param IX :: Input stream
+  */
+{
+  Quadratic::readBinary(IX);
+  StrFunc::readBin(IX,Centre);
+  StrFunc::readBin(IX,Normal);
+  StrFunc::readBin(IX,alpha);
+  StrFunc::readBin(IX,cangle);
+  StrFunc::readBin(IX,cutFlag);
+  return;
+}
+
 }  // NAMESPACE Geometry
@@ -49,6 +49,7 @@
 #include "Plane.h"
 #include "Cylinder.h"
 #include "Line.h"
+#include "binaryIO.h"
 #include "CylCan.h"
 
 namespace Geometry
@@ -467,16 +468,48 @@ CylCan::write(std::ostream& OX) const
 void
 CylCan::writeFLUKA(std::ostream&) const
   /*!
-    Write out the cone class in an mcnpx
-    format.
+    No FLUKA form of the surface
     \param  :: Output Stream (required for multiple std::endl)
+    \throw AbsObjMethod :: unsupported output
   */
 {
-  ELog::EM<<"Unsupported output"<<ELog::endErr;
-  return;
+  throw ColErr::AbsObjMethod("CylCan::writeFLUKA : Unsupported output");
 }
 
 
   
   
+
+void
+CylCan::writeBinary(std::ostream& OX) const
+  /*!
+    Write the CylCan state to a binary stream 
+    \param OX :: Output stream
+  */
+{
+  Surface::writeBinary(OX);
+  StrFunc::writeBin(OX,OPt);
+  StrFunc::writeBin(OX,unitD);
+  StrFunc::writeBin(OX,length);
+  StrFunc::writeBin(OX,radius);
+  return;
+}
+
+void
+CylCan::readBinary(std::istream& IX)
+  /*!
+    Read the CylCan state from a binary stream 
+    written by writeBinary
+    \param IX :: Input stream
+  */
+{
+  Surface::readBinary(IX);
+  StrFunc::readBin(IX,OPt);
+  StrFunc::readBin(IX,unitD);
+  StrFunc::readBin(IX,length);
+  StrFunc::readBin(IX,radius);
+  makeSides();
+  return;
+}
+
 }  // NAMESPACE Geometry
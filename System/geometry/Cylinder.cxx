@@ -51,6 +51,7 @@
 #include "masterWrite.h"
 #include "Quadratic.h"
 #include "Plane.h"
+#include "binaryIO.h"
 #include "Cylinder.h"
 
 #include "Debug.h"
@@ -574,5 +575,36 @@ Cylinder::print() const
 }
 
 
+void
+Cylinder::writeBinary(std::ostream& OX) const
+  /*!
+    Write the cylinder state to a binary stream 
+    \param OX :: Output stream
+  */
+{
+  Quadratic::writeBinary(OX);
+  StrFunc::writeBin(OX,Centre);
+  StrFunc::writeBin(OX,Normal);
+  StrFunc::writeBin(OX,Nvec);
+  StrFunc::writeBin(OX,Radius);
+  return;
+}
+
+void
+Cylinder::readBinary(std::istream& IX)
+  /*!
+    Read the cylinder state from a binary stream 
+    written by writeBinary
+    \param IX :: Input stream
+  */
+{
+  Quadratic::readBinary(IX);
+  StrFunc::readBin(IX,Centre);
+  StrFunc::readBin(IX,Normal);
+  StrFunc::readBin(IX,Nvec);
+  StrFunc::readBin(IX,Radius);
+  return;
+}
+
 }   // NAMESPACE Geometry
 
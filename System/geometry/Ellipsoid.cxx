@@ -39,6 +39,7 @@
 #include "RegMethod.h"
 #include "OutputLog.h"
 #include "support.h"
+#include "stringCombine.h"
 #include "BaseVisit.h"
 #include "BaseModVisit.h"
 #include "MatrixBase.h"
@@ -532,6 +533,20 @@ Ellipsoid::write(std::ostream& OX) const
   return;
 }
 
+void
+Ellipsoid::writeBinary(std::ostream&) const
+  /*! 
+    The snapshot has no ellipsoid form : the Quadratic 
+    state would lose the centre and axes and the 
+    surfaceFactory cannot create an Ellipsoid.
+    \throw AbsObjMethod :: no snapshot form
+  */
+{
+  throw ColErr::AbsObjMethod
+    ("Ellipsoid::writeBinary : no snapshot form [surface "+
+     StrFunc::makeString(getName())+"]");
+}
+
 void
 Ellipsoid::print() const
  /*!
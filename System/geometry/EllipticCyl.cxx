@@ -49,6 +49,7 @@
 #include "Surface.h"
 #include "Quadratic.h"
 #include "Plane.h"
+#include "binaryIO.h"
 #include "EllipticCyl.h"
 
 #include "Debug.h"
@@ -584,5 +585,40 @@ EllipticCyl::print() const
 }
 
 
+void
+EllipticCyl::writeBinary(std::ostream& OX) const
+  /*!
+    Write the ellipticcyl state to a binary stream 
+    \param OX :: Output stream
+  */
+{
+  Quadratic::writeBinary(OX);
+  StrFunc::writeBin(OX,Centre);
+  StrFunc::writeBin(OX,Normal);
+  StrFunc::writeBin(OX,LAxis);
+  StrFunc::writeBin(OX,CAxis);
+  StrFunc::writeBin(OX,ARadius);
+  StrFunc::writeBin(OX,BRadius);
+  return;
+}
+
+void
+EllipticCyl::readBinary(std::istream& IX)
+  /*!
+    Read the ellipticcyl state from a binary stream 
+    written by writeBinary
+    \param IX :: Input stream
+  */
+{
+  Quadratic::readBinary(IX);
+  StrFunc::readBin(IX,Centre);
+  StrFunc::readBin(IX,Normal);
+  StrFunc::readBin(IX,LAxis);
+  StrFunc::readBin(IX,CAxis);
+  StrFunc::readBin(IX,ARadius);
+  StrFunc::readBin(IX,BRadius);
+  return;
+}
+
 }   // NAMESPACE Geometry
 
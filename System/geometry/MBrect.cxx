@@ -51,6 +51,7 @@
 #include "Plane.h"
 #include "Line.h"
 #include "Triple.h"
+#include "binaryIO.h"
 #include "MBrect.h"
 
 namespace Geometry
@@ -614,12 +615,41 @@ MBrect::write(std::ostream& OX) const
 void
 MBrect::writeFLUKA(std::ostream&) const
   /*!
-    Write out the cone class in an mcnpx
-    format.
+    No FLUKA form of the surface
     \param  :: Output Stream (required for multiple std::endl)
+    \throw AbsObjMethod :: unsupported output
   */
 {
-  ELog::EM<<"Unsupported output"<<ELog::endErr;
+  throw ColErr::AbsObjMethod("MBrect::writeFLUKA : Unsupported output");
+}
+
+void
+MBrect::writeBinary(std::ostream& OX) const
+  /*!
+    Write the MBrect state to a binary stream 
+    \param OX :: Output stream
+  */
+{
+  Surface::writeBinary(OX);
+  StrFunc::writeBin(OX,Corner);
+  for(size_t i=0;i<3;i++)
+    StrFunc::writeBin(OX,LVec[i]);
+  return;
+}
+
+void
+MBrect::readBinary(std::istream& IX)
+  /*!
+    Read the MBrect state from a binary stream 
+    written by writeBinary
+    \param IX :: Input stream
+  */
+{
+  Surface::readBinary(IX);
+  StrFunc::readBin(IX,Corner);
+  for(size_t i=0;i<3;i++)
+    StrFunc::readBin(IX,LVec[i]);
+  makeSides();
   return;
 }
 
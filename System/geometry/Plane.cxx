@@ -49,6 +49,7 @@
 #include "Quaternion.h"
 #include "Surface.h"
 #include "Quadratic.h"
+#include "binaryIO.h"
 #include "Plane.h"
 
 namespace Geometry
@@ -695,4 +696,31 @@ Plane::write(std::ostream& OX) const
   return;
 }
 
+void
+Plane::writeBinary(std::ostream& OX) const
+  /*!
+    Write the plane state to a binary stream 
+    \param OX :: Output stream
+  */
+{
+  Quadratic::writeBinary(OX);
+  StrFunc::writeBin(OX,NormV);
+  StrFunc::writeBin(OX,Dist);
+  return;
+}
+
+void
+Plane::readBinary(std::istream& IX)
+  /*!
+    Read the plane state from a binary stream 
+    written by writeBinary
+    \param IX :: Input stream
+  */
+{
+  Quadratic::readBinary(IX);
+  StrFunc::readBin(IX,NormV);
+  StrFunc::readBin(IX,Dist);
+  return;
+}
+
 } // NAMESPACE Geometry
@@ -51,6 +51,7 @@
 #include "PolyFunction.h"
 #include "PolyVar.h"
 #include "Surface.h"
+#include "binaryIO.h"
 #include "Quadratic.h"
 #include "Plane.h"
 
@@ -616,4 +617,30 @@ Quadratic::writeXML(const std::string&) const
 }
 
   
+
+void
+Quadratic::writeBinary(std::ostream& OX) const
+  /*!
+    Write the quadratic state to a binary stream 
+    \param OX :: Output stream
+  */
+{
+  Surface::writeBinary(OX);
+  StrFunc::writeBin(OX,BaseEqn);
+  return;
+}
+
+void
+Quadratic::readBinary(std::istream& IX)
+  /*!
+    Read the quadratic state from a binary stream 
+    written by writeBinary
+    \param IX :: Input stream
+  */
+{
+  Surface::readBinary(IX);
+  StrFunc::readBin(IX,BaseEqn);
+  return;
+}
+
 }   // NAMESPACE Geometry
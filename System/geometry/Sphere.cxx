@@ -48,6 +48,7 @@
 #include "masterWrite.h"
 #include "Quadratic.h"
 #include "Plane.h"
+#include "binaryIO.h"
 #include "Sphere.h"
 
 namespace Geometry
@@ -376,4 +377,31 @@ Sphere::write(std::ostream& OX) const
   return;
 }
 
+void
+Sphere::writeBinary(std::ostream& OX) const
+  /*!
+    Write the sphere state to a binary stream 
+    \param OX :: Output stream
+  */
+{
+  Quadratic::writeBinary(OX);
+  StrFunc::writeBin(OX,Centre);
+  StrFunc::writeBin(OX,Radius);
+  return;
+}
+
+void
+Sphere::readBinary(std::istream& IX)
+  /*!
+    Read the sphere state from a binary stream 
+    written by writeBinary
+    \param IX :: Input stream
+  */
+{
+  Quadratic::readBinary(IX);
+  StrFunc::readBin(IX,Centre);
+  StrFunc::readBin(IX,Radius);
+  return;
+}
+
 }  // NAMESPACE Geometry
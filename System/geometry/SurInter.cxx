@@ -287,7 +287,8 @@ processPoint(const Geometry::Surface* ASPtr,
 	Lx.intersect(Out,*QVec[nonPlane]);
       return Out;
     }
-  Out=makePoint(QVec[0],QVec[1],QVec[2]);
+  if (!specialPoint(QVec[0],QVec[1],QVec[2],Out))
+    Out=makePoint(QVec[0],QVec[1],QVec[2]);
   return Out;
 }
 
@@ -400,6 +401,164 @@ makePoint(const Geometry::Quadratic* A,const Geometry::Quadratic* B,
   return SV.getAnswers();
 }
 
+int
+radicalPlane(const Geometry::Quadratic& A,const Geometry::Quadratic& B,
+	     Geometry::Plane& RPlane)
+  /*!
+    If the second order terms of A and B are in proportion
+    (A2 = k B2) then A-kB is linear and the common points of 
+    A and B lie on the plane A-kB=0. This is the radical plane
+    of two spheres and the common plane of two parallel 
+    cylinders.
+    \param A :: Quadratic surface
+    \param B :: Quadratic surface
+    \param RPlane :: Plane to set [if 1 returned]
+    \retval 1 :: plane found
+    \retval 0 :: no proportion / identical surfaces
+    \retval -1 :: no common point
+  */
+{
+  const std::vector<double>& AE=A.copyBaseEqn();
+  const std::vector<double>& BE=B.copyBaseEqn();
+
+  size_t index(0);
+  double scale(0.0);
+  for(size_t i=0;i<6;i++)
+    {
+      if (fabs(BE[i])>fabs(BE[index])) index=i;
+      scale=std::max(scale,fabs(AE[i]));
+    }
+  if (fabs(BE[index])<Geometry::zeroTol || scale<Geometry::zeroTol)
+    return 0;
+  
+  const double k=AE[index]/BE[index];
+  for(size_t i=0;i<6;i++)
+    if (fabs(AE[i]-k*BE[i])>Geometry::zeroTol*scale)
+      return 0;
+
+  const Geometry::Vec3D N(AE[6]-k*BE[6],AE[7]-k*BE[7],AE[8]-k*BE[8]);
+  const double C(AE[9]-k*BE[9]);
+  const double NL=N.abs();
+  if (NL<Geometry::zeroTol*scale)
+    return (fabs(C)<Geometry::zeroTol*scale) ? 0 : -1;
+  
+  RPlane.setPlane(N/NL,-C/NL);
+  return 1;
+}
+
+size_t
+cylinderLines(const Geometry::Plane& Pln,const Geometry::Cylinder& Cyl,
+	      std::vector<Geometry::Line>& LOut)
+  /*!
+    Calculate the lines of a plane and a cylinder that has 
+    its axis parallel to the plane. 
+    \param Pln :: Plane 
+    \param Cyl :: Cylinder [axis perpendicular to plane normal]
+    \param LOut :: Lines found [added to]
+    \return number of lines [0/1/2]
+  */
+{
+  const Geometry::Vec3D& N=Pln.getNormal();
+  const Geometry::Vec3D& A=Cyl.getNormal();
+  const double R=Cyl.getRadius();
+
+  // signed distance of axis from plane
+  const double S=Pln.getDistance()-N.dotProd(Cyl.getCentre());
+  if (fabs(S)>R+Geometry::zeroTol)
+    return 0;
+
+  const Geometry::Vec3D Base=Cyl.getCentre()+N*S;
+  if (fabs(fabs(S)-R)<Geometry::zeroTol)
+    {
+      LOut.push_back(Geometry::Line(Base,A));
+      return 1;
+    }
+  const double H=sqrt(R*R-S*S);
+  const Geometry::Vec3D W=A*N;
+  LOut.push_back(Geometry::Line(Base-W*H,A));
+  LOut.push_back(Geometry::Line(Base+W*H,A));
+  return 2;
+}
+
+int
+specialPoint(const Geometry::Quadratic* A,const Geometry::Quadratic* B,
+	     const Geometry::Quadratic* C,std::vector<Geometry::Vec3D>& Out)
+  /*!
+    Closed form intersection of three surfaces for the cases 
+    that reduce to a line and a quadratic:
+     - pairs of quadratics with proportional second order terms
+       (spheres / parallel cylinders) are replaced by a plane
+     - a plane and a cylinder with its axis in the plane
+       give at most two lines.
+    \param A :: Quadratic pointer
+    \param B :: Quadratic pointer
+    \param C :: Quadratic pointer 
+    \param Out :: Points found [added to]
+    \return 1 if the case was processed / 0 if not special
+  */
+{
+  ELog::RegMethod RegA("SurInter","specialPoint");
+
+  std::vector<const Geometry::Plane*> PL;
+  std::vector<const Geometry::Quadratic*> QL;
+  for(const Geometry::Quadratic* QPtr : {A,B,C})
+    {
+      const Geometry::Plane* PPtr=
+	dynamic_cast<const Geometry::Plane*>(QPtr);
+      if (PPtr)
+	PL.push_back(PPtr);
+      else
+	QL.push_back(QPtr);
+    }
+
+  // Replace proportional pairs by their plane
+  Geometry::Plane RPlane[2];
+  size_t nR(0);
+  size_t i(0);
+  while(PL.size()<2 && i+1<QL.size())
+    {
+      int flag(0);
+      size_t j;
+      for(j=i+1;j<QL.size() && !flag;j++)
+	flag=radicalPlane(*QL[i],*QL[j],RPlane[nR]);
+      if (flag<0) return 1;       // no common points
+      if (flag)
+	{
+	  PL.push_back(&RPlane[nR++]);
+	  QL.erase(QL.begin()+static_cast<long int>(j-1));
+	}
+      else
+	i++;
+    }
+
+  if (PL.size()==2)
+    {
+      Geometry::Line Lx;
+      if (Lx.setLine(*PL[0],*PL[1]))
+	Lx.intersect(Out,*QL[0]);
+      return 1;
+    }
+  
+  if (PL.size()==1)
+    {
+      const Geometry::Vec3D& N=PL[0]->getNormal();
+      for(size_t index=0;index<2;index++)
+	{
+	  const Geometry::Cylinder* CPtr=
+	    dynamic_cast<const Geometry::Cylinder*>(QL[index]);
+	  if (CPtr && fabs(CPtr->getNormal().dotProd(N))<Geometry::parallelTol)
+	    {
+	      std::vector<Geometry::Line> LVec;
+	      cylinderLines(*PL[0],*CPtr,LVec);
+	      for(const Geometry::Line& Lx : LVec)
+		Lx.intersect(Out,*QL[1-index]);
+	      return 1;
+	    }
+	}
+    }
+  return 0;
+}
+
 
 int
 getMidPoint(const Geometry::Surface* ASPtr,const Geometry::Surface* BSPtr,
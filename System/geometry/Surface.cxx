@@ -45,6 +45,7 @@
 #include "BaseModVisit.h"
 #include "Transform.h"
 #include "Line.h"
+#include "binaryIO.h"
 #include "Surface.h"
 
 namespace Geometry
@@ -245,4 +246,29 @@ Surface::writeXML(const std::string&) const
 }
 
   
+void
+Surface::writeBinary(std::ostream& OX) const
+  /*!
+    Write the surface state to a binary stream 
+    \param OX :: Output stream
+  */
+{
+  StrFunc::writeBin(OX,Name);
+  StrFunc::writeBin(OX,TransN);
+  return;
+}
+
+void
+Surface::readBinary(std::istream& IX)
+  /*!
+    Read the surface state from a binary stream 
+    written by writeBinary
+    \param IX :: Input stream
+  */
+{
+  StrFunc::readBin(IX,Name);
+  StrFunc::readBin(IX,TransN);
+  return;
+}
+
 }  // NAMESPACE Geomtry
@@ -45,6 +45,7 @@
 #include "Surface.h"
 #include "Quadratic.h"
 #include "Plane.h"
+#include "binaryIO.h"
 #include "Torus.h"
 
 namespace Geometry
@@ -405,12 +406,46 @@ Torus::write(std::ostream& OX) const
 void
 Torus::writeFLUKA(std::ostream&) const
   /*!
-    Write out the cone class in an mcnpx
-    format.
+    No FLUKA form of the surface
     \param  :: Output Stream (required for multiple std::endl)
+    \throw AbsObjMethod :: unsupported output
+  */
+{
+  throw ColErr::AbsObjMethod("Torus::writeFLUKA : Unsupported output");
+}
+
+void
+Torus::writeBinary(std::ostream& OX) const
+  /*!
+    Write the torus state to a binary stream 
+    \param OX :: Output stream
+  */
+{
+  Surface::writeBinary(OX);
+  StrFunc::writeBin(OX,Centre);
+  for(size_t i=0;i<4;i++)
+    StrFunc::writeBin(OX,RotPhase[i]);
+  StrFunc::writeBin(OX,Normal);
+  StrFunc::writeBin(OX,Iradius);
+  StrFunc::writeBin(OX,Oradius);
+  return;
+}
+
+void
+Torus::readBinary(std::istream& IX)
+  /*!
+    Read the torus state from a binary stream 
+    written by writeBinary
+    \param IX :: Input stream
   */
 {
-  ELog::EM<<"Unsupported output"<<ELog::endErr;
+  Surface::readBinary(IX);
+  StrFunc::readBin(IX,Centre);
+  for(size_t i=0;i<4;i++)
+    StrFunc::readBin(IX,RotPhase[i]);
+  StrFunc::readBin(IX,Normal);
+  StrFunc::readBin(IX,Iradius);
+  StrFunc::readBin(IX,Oradius);
   return;
 }
 
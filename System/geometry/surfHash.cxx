@@ -0,0 +1,341 @@
+/********************************************************************* 
+  CombLayer : MCNP(X) Input builder
+ 
+ * File:   geometry/surfHash.cxx
+ *
+ * Copyright (c) 2004-2016 by Stuart Ansell
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>. 
+ *
+ ****************************************************************************/
+#include <fstream>
+#include <iomanip>
+#include <iostream>
+#include <sstream>
+#include <cmath>
+#include <vector>
+#include <map>
+#include <set>
+#include <list>
+#include <string>
+#include <algorithm>
+#include <functional>
+#include <unordered_map>
+
+#include "Exception.h"
+#include "FileReport.h"
+#include "GTKreport.h"
+#include "NameStack.h"
+#include "RegMethod.h"
+#include "OutputLog.h"
+#include "MatrixBase.h"
+#include "Matrix.h"
+#include "Vec3D.h"
+#include "Triple.h"
+#include "Quaternion.h"
+#include "BaseVisit.h"
+#include "BaseModVisit.h"
+#include "Surface.h"
+#include "Quadratic.h"
+#include "ArbPoly.h"
+#include "CylCan.h"
+#include "Cylinder.h"
+#include "Cone.h"
+#include "EllipticCyl.h"
+#include "General.h"
+#include "MBrect.h"
+#include "NullSurface.h"
+#include "Plane.h"
+#include "Sphere.h"
+#include "Torus.h"
+#include "surfHash.h"
+
+namespace ModelSupport
+{
+
+const double surfHash::cellSize(1e-3);
+const double surfHash::keyTol(1e-6);
+
+size_t
+surfHash::keyHash::operator()(const KTYPE& Key) const
+  /*!
+    Combine the key values into a hash
+    \param Key :: Bucket key
+    \return hash value
+  */
+{
+  std::hash<long int> HF;
+  size_t H(0);
+  for(const long int K : Key)
+    H^=HF(K)+0x9e3779b9+(H<<6)+(H>>2);
+  return H;
+}
+
+surfHash::surfHash() : valid(1)
+  /*!
+    Constructor
+  */
+{}
+
+surfHash::surfHash(const surfHash& A) :
+  valid(A.valid),Pending(A.Pending),Buckets(A.Buckets)
+  /*!
+    Copy constructor
+    \param A :: surfHash to copy
+  */
+{}
+
+surfHash&
+surfHash::operator=(const surfHash& A)
+  /*!
+    Assignment operator
+    \param A :: surfHash to copy
+    \return *this
+  */
+{
+  if (this!=&A)
+    {
+      valid=A.valid;
+      Pending=A.Pending;
+      Buckets=A.Buckets;
+    }
+  return *this;
+}
+
+void
+surfHash::clearAll()
+  /*!
+    Remove everything [surface map is empty]
+  */
+{
+  valid=1;
+  Pending.clear();
+  Buckets.clear();
+  return;
+}
+
+long int
+surfHash::quantise(const double V)
+  /*!
+    Convert a feature value to a cell index
+    \param V :: Value
+    \return cell index [clamped]
+  */
+{
+  const double R=std::floor(V/cellSize);
+  if (R>1e15) return static_cast<long int>(1e15);
+  if (R<-1e15) return static_cast<long int>(-1e15);
+  return static_cast<long int>(R);
+}
+
+long int
+surfHash::features(const Geometry::Surface* SPtr,
+		   std::vector<double>& F)
+  /*!
+    Calculate the hashed features of a surface. Each 
+    feature can differ by at most keyTol between two 
+    surfaces that are equal [or opposite planes] 
+    by the surface operator==.
+    \param SPtr :: Surface
+    \param F :: Features 
+    \return type index
+  */
+{
+  F.clear();
+
+  const Geometry::Plane* PPtr=
+    dynamic_cast<const Geometry::Plane*>(SPtr);
+  if (PPtr)
+    {
+      // absolute values : opposite planes share a bucket
+      const Geometry::Vec3D& N=PPtr->getNormal();
+      F={std::abs(PPtr->getDistance()),
+	 std::abs(N[0]),std::abs(N[1]),std::abs(N[2])};
+      return 1;
+    }
+  const Geometry::Cylinder* CPtr=
+    dynamic_cast<const Geometry::Cylinder*>(SPtr);
+  if (CPtr)
+    {
+      // centre can move along the axis : not used
+      const Geometry::Vec3D& N=CPtr->getNormal();
+      F={CPtr->getRadius(),std::abs(N[0]),std::abs(N[1]),std::abs(N[2])};
+      return 2;
+    }
+  const Geometry::Sphere* SpPtr=
+    dynamic_cast<const Geometry::Sphere*>(SPtr);
+  if (SpPtr)
+    {
+      const Geometry::Vec3D& C=SpPtr->getCentre();
+      F={SpPtr->getRadius(),C[0],C[1],C[2]};
+      return 3;
+    }
+  const Geometry::Cone* KPtr=
+    dynamic_cast<const Geometry::Cone*>(SPtr);
+  if (KPtr)
+    {
+      const Geometry::Vec3D C=KPtr->getCentre();
+      F={KPtr->getCosAngle(),C[0],C[1],C[2]};
+      return 4;
+    }
+  const Geometry::Torus* TPtr=
+    dynamic_cast<const Geometry::Torus*>(SPtr);
+  if (TPtr)
+    {
+      const Geometry::Vec3D C=TPtr->getCentre();
+      F={TPtr->getORad(),C[0],C[1],C[2]};
+      return 5;
+    }
+  const Geometry::CylCan* CCPtr=
+    dynamic_cast<const Geometry::CylCan*>(SPtr);
+  if (CCPtr)
+    {
+      // origin can be at either end
+      F={CCPtr->getRadius(),CCPtr->getLength()};
+      return 6;
+    }
+  // Quadratic::operator== allows a sign change
+  const Geometry::General* GPtr=
+    dynamic_cast<const Geometry::General*>(SPtr);
+  const Geometry::EllipticCyl* EPtr=
+    dynamic_cast<const Geometry::EllipticCyl*>(SPtr);
+  if (GPtr || EPtr)
+    {
+      const std::vector<double>& BE=(GPtr) ?
+	GPtr->copyBaseEqn() : EPtr->copyBaseEqn();
+      F={std::abs(BE[0]),std::abs(BE[1]),std::abs(BE[2]),std::abs(BE[9])};
+      return (GPtr) ? 7 : 8;
+    }
+  // No features : one bucket per type
+  if (dynamic_cast<const Geometry::ArbPoly*>(SPtr))
+    return 9;
+  if (dynamic_cast<const Geometry::MBrect*>(SPtr))
+    return 10;
+  if (dynamic_cast<const Geometry::NullSurface*>(SPtr))
+    return 11;
+  return 0;
+}
+
+void
+surfHash::insert(const int SN,const Geometry::Surface* SPtr)
+  /*!
+    Place a surface in its bucket
+    \param SN :: Surface number [map key]
+    \param SPtr :: Surface
+  */
+{
+  std::vector<double> F;
+  KTYPE Key;
+  Key.push_back(features(SPtr,F));
+  for(const double V : F)
+    Key.push_back(quantise(V));
+  Buckets[Key].push_back(ITEM(SN,SPtr));
+  return;
+}
+
+void
+surfHash::addSurface(const int SN,const Geometry::Surface* SPtr)
+  /*!
+    Index a finished surface 
+    \param SN :: Surface number [map key]
+    \param SPtr :: Surface
+  */
+{
+  if (valid)
+    insert(SN,SPtr);
+  return;
+}
+
+void
+surfHash::update(const std::map<int,Geometry::Surface*>& SMap)
+  /*!
+    Bring the index up to date with the surface map
+    \param SMap :: Surface map
+  */
+{
+  if (!valid)
+    {
+      Buckets.clear();
+      for(const std::map<int,Geometry::Surface*>::value_type& SV : SMap)
+	insert(SV.first,SV.second);
+      valid=1;
+    }
+  else
+    {
+      for(const int SN : Pending)
+	{
+	  std::map<int,Geometry::Surface*>::const_iterator mc=SMap.find(SN);
+	  if (mc!=SMap.end())
+	    insert(SN,mc->second);
+	}
+    }
+  Pending.clear();
+  return;
+}
+
+std::map<int,Geometry::Surface*>
+surfHash::candidates(const std::map<int,Geometry::Surface*>& SMap,
+		     const Geometry::Surface* SPtr)
+  /*!
+    Find the surfaces in the map that may be equal 
+    or opposite to SPtr. Every bucket within keyTol of 
+    the features is searched. Items that are no longer
+    in the map are ignored.
+    \param SMap :: Surface map
+    \param SPtr :: Surface to test
+    \return candidate surfaces [number order]
+  */
+{
+  ELog::RegMethod RegA("surfHash","candidates");
+
+  update(SMap);
+
+  std::vector<double> F;
+  const long int typeIndex=features(SPtr,F);
+  
+  std::vector<long int> lowCell;
+  std::vector<size_t> splitIndex;      // features near a cell edge
+  for(size_t i=0;i<F.size();i++)
+    {
+      lowCell.push_back(quantise(F[i]-keyTol));
+      if (quantise(F[i]+keyTol)!=lowCell.back())
+	splitIndex.push_back(i);
+    }
+
+  std::map<int,Geometry::Surface*> Out;
+  KTYPE Key(F.size()+1);
+  Key[0]=typeIndex;
+  const size_t NProbe(1UL << splitIndex.size());
+  for(size_t probe=0;probe<NProbe;probe++)
+    {
+      for(size_t i=0;i<F.size();i++)
+	Key[i+1]=lowCell[i];
+      for(size_t j=0;j<splitIndex.size();j++)
+	if ((probe >> j) & 1)
+	  Key[splitIndex[j]+1]++;
+
+      BTYPE::const_iterator bc=Buckets.find(Key);
+      if (bc!=Buckets.end())
+	for(const ITEM& IT : bc->second)
+	  {
+	    std::map<int,Geometry::Surface*>::const_iterator mc=
+	      SMap.find(IT.first);
+	    if (mc!=SMap.end() && mc->second==IT.second)
+	      Out.insert(*mc);
+	  }
+    }
+  return Out;
+}
+
+} // NAMESPACE ModelSupport
@@ -26,10 +26,13 @@
 #include <cmath>
 #include <vector>
 #include <map>
+#include <set>
 #include <list>
 #include <stack>
 #include <string>
 #include <algorithm>
+#include <functional>
+#include <unordered_map>
 
 #ifndef NO_REGEX
 #include <boost/regex.hpp>
@@ -66,13 +69,14 @@
 #include "surfaceFactory.h"
 #include "surfRegister.h"
 #include "surfIndex.h"
+#include "surfHash.h"
 
 #include "Debug.h"
 
 namespace ModelSupport
 {
 
-surfIndex::surfIndex() : uniqNum(1)
+surfIndex::surfIndex() : uniqNum(1),HPtr(new surfHash)
   /*!
     Constructor
   */
@@ -97,6 +101,7 @@ surfIndex::~surfIndex()
   STYPE::iterator mc;
   for(mc=SMap.begin();mc!=SMap.end();mc++)
     delete mc->second;
+  delete HPtr;
 }
 
 void
@@ -109,6 +114,7 @@ surfIndex::reset()
   for(mc=SMap.begin();mc!=SMap.end();mc++)
     delete mc->second;
   SMap.erase(SMap.begin(),SMap.end());
+  HPtr->clearAll();
   return;
 }
 
@@ -147,7 +153,10 @@ surfIndex::addSurface(Geometry::Surface* SPtr)
   Geometry::Surface* NewPtr=ModelSupport::equalSurface(SPtr);
   // Now find if we have copy
   if (NewPtr==SPtr)
-    SMap.insert(STYPE::value_type(SPtr->getName(),SPtr));
+    {
+      SMap.insert(STYPE::value_type(SPtr->getName(),SPtr));
+      HPtr->addSurface(SPtr->getName(),SPtr);
+    }
   else
     delete SPtr;
 
@@ -188,6 +197,7 @@ surfIndex::insertSurface(Geometry::Surface* SPtr)
     }
 
   SMap.insert(STYPE::value_type(SPtr->getName(),SPtr));
+  HPtr->addPending(SPtr->getName());
 
   return;
 }
@@ -205,14 +215,38 @@ surfIndex::findOpposite(const Geometry::Surface* SPtr)  const
     dynamic_cast<const Geometry::Plane*>(SPtr);
   if (PPtr)
     {
-      STYPE::const_iterator mc;
-      for(mc=SMap.begin();mc!=SMap.end();mc++)
-	if (ModelSupport::oppositeSurfaces(PPtr,mc->second)) 
-	  return mc->first;
+      // opposite planes share a hash bucket
+      const STYPE CMap=HPtr->candidates(SMap,PPtr);
+      for(const STYPE::value_type& CV : CMap)
+	if (ModelSupport::oppositeSurfaces(PPtr,CV.second)) 
+	  return CV.first;
     }
   return 0;
 }
 
+surfIndex::STYPE
+surfIndex::equalCandidates(const Geometry::Surface* SPtr) const
+  /*!
+    Get the surfaces that might be equal to SPtr 
+    [same type and hash bucket]
+    \param SPtr :: Surface to test
+    \return map of candidates
+  */
+{
+  return HPtr->candidates(SMap,SPtr);
+}
+
+void
+surfIndex::clearHash()
+  /*!
+    Surfaces have been changed in place : the hash
+    is rebuilt at the next search
+  */
+{
+  HPtr->invalidate();
+  return;
+}
+
 void
 surfIndex::removeOpposite(const int SN)
   /*!
@@ -294,11 +328,13 @@ surfIndex::createSurf(const int surfN)
       delete mp->second;
       outPtr=new T(surfN,0);
       mp->second=outPtr;
+      HPtr->addPending(surfN);
       ELog::EM<<"Reasigned exiting surface"<<surfN<<ELog::endWarn;
       return outPtr;
     }
   outPtr=new T(surfN,0);
   SMap.insert(STYPE::value_type(surfN,outPtr));
+  HPtr->addPending(surfN);
   return outPtr;
 }
 
@@ -381,6 +417,7 @@ surfIndex::createSurface(const int SN,const int TN,const std::string& SLine)
         {
 	  SMap.insert(STYPE::value_type(SN,SPtr));
 	}
+      HPtr->addPending(SN);
     }
   catch (const ColErr::ExBase& A)
     {
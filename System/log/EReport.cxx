@@ -31,6 +31,8 @@
 namespace ELog
 {
 
+int EReport::errFlag(0);
+
 void 
 EReport::process(const std::string& M,const int)
   /*!
@@ -39,8 +41,7 @@ EReport::process(const std::string& M,const int)
     \param  :: Index of severity [ignored]
   */
 {
-  const int storeFlag(1);  // To be sorted out later
-  std::ostream& DX( (storeFlag) ? std::cout : std::cerr);
+  std::ostream& DX( (errFlag) ? std::cerr : std::cout);
   DX<<M<<std::endl;
   return;
 }
@@ -30,88 +30,38 @@ namespace ELog
 {
 
 NameStack::NameStack() :
-  indentLevel(0)
+  topPtr(0),depth(0),extraLevel(0),indentLevel(0)
   /*!
     Constructor
   */
 {}
 
-NameStack::NameStack(const NameStack& A) :
-  key(A.key),Class(A.Class),Method(A.Method),
-  Extra(A.Extra),extraLevel(A.extraLevel),
-  indentLevel(A.indentLevel)
-  /*!
-    Copy Constructor
-    \param A :: NameStack to copy
-  */
-{}
-
-NameStack&
-NameStack::operator=(const NameStack& A) 
-  /*!
-    Assignment operator
-    \param A :: NameStack to copy
-    \return *this
-  */
-{
-  if (this!=&A)
-    {
-      key=A.key;
-      Class=A.Class;
-      Method=A.Method;
-      Extra=A.Extra;
-      extraLevel=A.extraLevel;
-      indentLevel=A.indentLevel;
-    }
-  return *this;
-}
-
 void
 NameStack::clear()
  /*!
    Clear the stack
  */
 {
-  key.erase(key.begin(),key.end());
-  Class.clear();
-  Method.clear();
+  topPtr=0;
+  depth=0;
   Extra.clear();
   extraLevel=0;
   indentLevel=0;
   return;
 }
 
-void
-NameStack::addComp(const std::string& CN,
-		   const std::string& MN)
-  /*!
-    Adds a component to the class names series
-    \param CN :: Class name
-    \param MN :: Method name
-  */
-{
-  Class.push_back(CN);
-  Method.push_back(MN);
-  return;
-}
-  
-void
-NameStack::popBack() 
+std::string
+NameStack::itemName(const NameItem& NI)
   /*!
-    Pop back a item
+    Build the full name of an item
+    \param NI :: Item
+    \return Class::Method
   */
 {
-  if (!Class.empty())
-    {
-      if (extraLevel==Class.size())
-	{
-	  Extra.clear();
-	  extraLevel=0;
-	}
-      Class.pop_back();
-      Method.pop_back();
-    }
-  return;
+  std::string Out(NI.CName);
+  Out+="::";
+  Out+=NI.MName;
+  return Out;
 }
 
 void
@@ -122,7 +72,7 @@ NameStack::setExtra(const std::string& A)
    */
 {
   Extra=A;
-  extraLevel=Class.size();
+  extraLevel=depth;
   return;
 }
 
@@ -143,8 +93,7 @@ NameStack::getBase() const
     \return BaseItem
   */
 {
-  return (Class.empty()) ?  
-    "" : Class.back()+"::"+Method.back();
+  return (topPtr) ? itemName(*topPtr) : "";
 }
 
 std::string
@@ -156,17 +105,20 @@ NameStack::getItem(const long int Index) const
     \return BaseItem
   */
 {
-  if (Class.empty()) return "";
+  if (!topPtr) return "";
   if (!Index) 
-    return Class.back()+"::"+Method.back();
+    return itemName(*topPtr);
   
-  const size_t CSize=Class.size();
- 
   const size_t itx( (Index<0) 
-		    ? (CSize-static_cast<size_t>(1-Index)) 
+		    ? (depth-static_cast<size_t>(1-Index)) 
 		    : static_cast<size_t>(Index));
+  if (itx>=depth) return "";
 
-  return (itx<CSize) ? Class[itx]+"::"+Method[itx] : "";
+  // walk down from the top
+  const NameItem* NPtr(topPtr);
+  for(size_t i=depth-1;i>itx;i--)
+    NPtr=NPtr->prevPtr;
+  return itemName(*NPtr);
 } 
 
 std::string
@@ -176,13 +128,17 @@ NameStack::getFull() const
     \return BaseItem
   */
 {
-  std::vector<std::string>::const_iterator vc(Class.begin());
-  std::vector<std::string>::const_iterator ac(Method.begin());
-  std::string Out=*vc+"::"+*ac;
-  for(ac++,vc++;vc!=Class.end();vc++,ac++)
+  std::vector<const NameItem*> Items;
+  for(const NameItem* NPtr=topPtr;NPtr;NPtr=NPtr->prevPtr)
+    Items.push_back(NPtr);
+
+  std::string Out;
+  std::vector<const NameItem*>::const_reverse_iterator vc;
+  for(vc=Items.rbegin();vc!=Items.rend();vc++)
     {
-      Out+="#";
-      Out+=*vc+"::"+*ac;
+      if (vc!=Items.rbegin())
+	Out+="#";
+      Out+=itemName(**vc);
     }
   if (!Extra.empty())
     {
@@ -199,15 +155,21 @@ NameStack::getFullTree() const
     \return BaseItem
   */
 {
-  std::vector<std::string>::const_iterator vc(Class.begin());
-  std::vector<std::string>::const_iterator ac(Method.begin());
-  size_t indent(2);
-  std::string Out=*vc+"::"+*ac;
-  for(ac++,vc++;vc!=Class.end();vc++,ac++,indent+=2)
+  std::vector<const NameItem*> Items;
+  for(const NameItem* NPtr=topPtr;NPtr;NPtr=NPtr->prevPtr)
+    Items.push_back(NPtr);
+
+  size_t indent(0);
+  std::string Out;
+  std::vector<const NameItem*>::const_reverse_iterator vc;
+  for(vc=Items.rbegin();vc!=Items.rend();vc++,indent+=2)
     {
-      Out+='\n';
-      Out+=std::string(indent,' ');
-      Out+=*vc+"::"+*ac;
+      if (indent)
+	{
+	  Out+='\n';
+	  Out+=std::string(indent,' ');
+	}
+      Out+=itemName(**vc);
     }
   if (!Extra.empty())
     {
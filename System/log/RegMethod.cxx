@@ -3,7 +3,7 @@
  
  * File:   log/RegMethod.cxx
  *
- * Copyright (c) 2004-2015 by Stuart Ansell
+ * Copyright (c) 2004-2016 by Stuart Ansell
  *
  * This program is free software: you can redistribute it and/or modify
  * it under the terms of the GNU General Public License as published by
@@ -33,25 +33,45 @@
 namespace ELog
 {
 
-NameStack RegMethod::Base;
+thread_local NameStack RegMethod::Base;
+
+void
+RegMethod::setNames(const std::string& CN,const std::string& MN)
+  /*!
+    Copy the names [they are not literals] and add 
+    the item to the stack
+    \param CN :: Class name
+    \param MN :: Method name
+  */
+{
+  ownName=new std::string[2];
+  ownName[0]=CN;
+  ownName[1]=MN;
+  Item.CName=ownName[0].c_str();
+  Item.MName=ownName[1].c_str();
+  Base.addComp(Item);
+  return;
+}
+
+#ifndef NO_NAMESTACK
 
 RegMethod::RegMethod(const std::string& CN,
 		     const std::string& MN) :
-  indentLevel(0)
+  ownName(0),indentLevel(0)
   /*!
-    Constructor add name to stack
+    Constructor add name to stack. The names
+    are copied since they are not literals.
     \param CN :: Class name
     \param MN :: Method name
   */
 {
-  Base.addComp(CN,MN);
-
+  setNames(CN,MN);
 }
 
 RegMethod::RegMethod(const std::string& CN,
 		     const std::string& MN,
 		     const int param) :
-  indentLevel(0)
+  ownName(0),indentLevel(0)
   /*!
     Constructor add name to stack
     \param CN :: Class name
@@ -61,40 +81,90 @@ RegMethod::RegMethod(const std::string& CN,
 {
   std::ostringstream cx;
   cx<<"<"<<param<<">";
-  Base.addComp(CN+cx.str(),MN);
+  setNames(CN+cx.str(),MN);
 }
 
-RegMethod::~RegMethod() 
+void
+RegMethod::setTrack(const std::string& ES)
   /*!
-    Destructor removes one from the stack
+    Add an extra string to the output in the case
+    of an exception
+    \param ES :: Extra string
   */
 {
-  Base.popBack();
-  if (indentLevel) 
-    Base.addIndent(-indentLevel);
+  Base.setExtra(ES);
+  return;
+}
+
+void
+RegMethod::clearTrack()
+  /*!
+    Clear the extra track
+   */
+{
+  Base.clearExtra();
+  return;
+}
+
+#else
+
+RegMethod::RegMethod(const std::string& CN,
+		     const std::string& MN) :
+  ownName(0),indentLevel(0),regFlag(Base.getDepth()<coarseDepth)
+  /*!
+    Constructor add name to stack [top levels only]
+    \param CN :: Class name
+    \param MN :: Method name
+  */
+{
+  if (regFlag)
+    setNames(CN,MN);
+}
+
+RegMethod::RegMethod(const std::string& CN,
+		     const std::string& MN,
+		     const int param) :
+  ownName(0),indentLevel(0),regFlag(Base.getDepth()<coarseDepth)
+  /*!
+    Constructor add name to stack [top levels only]
+    \param CN :: Class name
+    \param MN :: Method name
+    \param param :: Index for type
+  */
+{
+  if (regFlag)
+    {
+      std::ostringstream cx;
+      cx<<"<"<<param<<">";
+      setNames(CN+cx.str(),MN);
+    }
 }
 
 void
 RegMethod::setTrack(const std::string& ES)
   /*!
     Add an extra string to the output in the case
-    of an exception
+    of an exception [if registered]
     \param ES :: Extra string
   */
 {
-  Base.setExtra(ES);
+  if (regFlag)
+    Base.setExtra(ES);
   return;
 }
 
 void
 RegMethod::clearTrack()
   /*!
-    Clear the extra track
+    Clear the extra track [if registered]
    */
 {
-  Base.clearExtra();
+  if (regFlag)
+    Base.clearExtra();
   return;
 }
+
+#endif
   
 void
 RegMethod::incIndent() 
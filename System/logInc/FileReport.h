@@ -62,7 +62,12 @@ class EReport
 {
  private:
 
+  static int errFlag;     ///< Write to std::cerr [not std::cout]
+
  public:
+
+  /// Send reports to std::cerr [keeps std::cout for data]
+  static void setErrStream(const int F) { errFlag=F; }
   
   EReport() {}  ///< Constructor
   EReport(const EReport&) {}  ///< Copy constructor
@@ -3,7 +3,7 @@
  
  * File:   logInc/NameStack.h
  *
- * Copyright (c) 2004-2015 by Stuart Ansell
+ * Copyright (c) 2004-2016 by Stuart Ansell
  *
  * This program is free software: you can redistribute it and/or modify
  * it under the terms of the GNU General Public License as published by
@@ -28,25 +28,44 @@ namespace ELog
     \class NameStack 
     \brief Holds a list of items for a calling stack
     \author S. Ansell
-    \version 1.0
-    \date June 2009
+    \version 2.0
+    \date May 2016
+
+    The stack is an intrusive list of NameItem objects
+    that are held by the registering RegMethod objects.
+    No allocation is done for a push/pop, the names are
+    held as pointers [normally to string literals].
   */
 class NameStack
 {
+ public:
+
+  /// Single item of the stack [owned by the caller]
+  struct NameItem
+  {
+    const char* CName;      ///< Class Name
+    const char* MName;      ///< Method Name
+    NameItem* prevPtr;      ///< Item below this one
+  };
+  
  private:
 
-  std::map<std::string,int> key;        ///< Key names
-  std::vector<std::string> Class;       ///< Class Name
-  std::vector<std::string> Method;      ///< Method Name
+  NameItem* topPtr;                     ///< Top of the stack
+  size_t depth;                         ///< Number of items
   std::string Extra;                    ///< Extra tag if neeed
   size_t extraLevel;                    ///< Extra tag if neeed
   long int indentLevel;                 ///< Indent level
 
+  /// \cond NOWRITTEN
+  NameStack(const NameStack&);
+  NameStack& operator=(const NameStack&);
+  /// \endcond NOWRITTEN
+
+  static std::string itemName(const NameItem&);
+  
  public:
 
   NameStack();
-  NameStack(const NameStack&);
-  NameStack& operator=(const NameStack&);
   ~NameStack() {}    ///< Destructor
 
   void clear(); 
@@ -55,9 +74,24 @@ class NameStack
   void setExtra(const std::string&);
   /// Remove extra output for exception [early]
   void clearExtra() { Extra.clear(); }
-  void addComp(const std::string&,const std::string&);
-  void popBack();
 
+  /// Add an item to the stack [must remain valid until popBack]
+  void addComp(NameItem& NI) 
+    { NI.prevPtr=topPtr; topPtr=&NI; depth++; }
+  /// Remove the top item
+  void popBack() 
+    {
+      if (topPtr)
+	{
+	  if (extraLevel==depth)
+	    {
+	      Extra.clear();
+	      extraLevel=0;
+	    }
+	  topPtr=topPtr->prevPtr;
+	  depth--;
+	}
+    }
   
   std::string getBase() const;
   std::string getItem(const long int) const;
@@ -66,7 +100,7 @@ class NameStack
   const std::string& getExtra() const;
 
   /// Access depth of function:
-  size_t getDepth() const { return Class.size(); }
+  size_t getDepth() const { return depth; }
 
   void addIndent(const long int);
   /// Output of the indent level
@@ -29,20 +29,35 @@ namespace ELog
     \brief Holds a list of items for a calling stack
     \author S. Ansell
     \date June 2009
-    \version 1.0
+    \version 2.0
 
     This class is called as a registration class.
     It keeps location etc possible for 
+    exceptions. The names are normally string literals
+    and are pushed on the stack as pointers.
+
+    If built with NO_NAMESTACK only the top levels of
+    the stack [main, the build phases and the top methods]
+    are registered. Deeper calls do not register, so the
+    code stack of an exception stops at those levels.
   */
 
 class RegMethod
 {
  private:
 
-  static NameStack Base;           ///< Singleton of base to register
+  static thread_local NameStack Base;  ///< Base to register [per thread]
 
-  int extraFlag;                   ///< Lifetime flag on extra
+  NameStack::NameItem Item;        ///< Item on the stack
+  std::string* ownName;            ///< Built names [if not literal]
   int indentLevel;                 ///< Additional indent
+#ifdef NO_NAMESTACK
+  static const size_t coarseDepth=4;  ///< Levels registered
+  int regFlag;                     ///< Item is on the stack
+#endif
+
+  void setNames(const std::string&,const std::string&);
+
   /// \cond NOWRITTEN
   RegMethod(const RegMethod&);
   RegMethod& operator=(const RegMethod&);
@@ -52,9 +67,42 @@ class RegMethod
 
   /// Access NameStack pointer
   NameStack* getBasePtr() { return &Base; }
+
+#ifndef NO_NAMESTACK
+  /// Constructor from literals [no allocation]
+  RegMethod(const char* CN,const char* MN) :
+    ownName(0),indentLevel(0)
+    { Item.CName=CN; Item.MName=MN; Base.addComp(Item); }
+  RegMethod(const std::string&,const std::string&);
+  RegMethod(const std::string&,const std::string&,const int);
+  /// Destructor : remove from stack
+  ~RegMethod()
+    {
+      Base.popBack();
+      if (indentLevel) 
+	Base.addIndent(-indentLevel);
+      delete [] ownName;
+    }
+#else
+  /// Constructor from literals [top levels only]
+  RegMethod(const char* CN,const char* MN) :
+    ownName(0),indentLevel(0),regFlag(Base.getDepth()<coarseDepth)
+    {
+      if (regFlag)
+	{ Item.CName=CN; Item.MName=MN; Base.addComp(Item); }
+    }
   RegMethod(const std::string&,const std::string&);
   RegMethod(const std::string&,const std::string&,const int);
-  ~RegMethod();
+  /// Destructor : remove from stack if registered
+  ~RegMethod()
+    {
+      if (regFlag)
+	Base.popBack();
+      if (indentLevel) 
+	Base.addIndent(-indentLevel);
+      delete [] ownName;
+    }
+#endif
 
   void setTrack(const std::string&);
   void clearTrack();
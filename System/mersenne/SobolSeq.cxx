@@ -0,0 +1,117 @@
+/********************************************************************* 
+  CombLayer : MCNP(X) Input builder
+ 
+ * File:   mersenne/SobolSeq.cxx
+ *
+ * Copyright (c) 2004-2016 by Stuart Ansell
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>. 
+ *
+ ****************************************************************************/
+#include <cstdint>
+#include <cstddef>
+
+#include "SobolSeq.h"
+
+SobolSeq::SobolSeq()
+  /*!
+    Constructor : builds the direction numbers
+    for the first three dimensions
+  */
+{
+  for(size_t k=0;k<nBits;k++)
+    {
+      // dim 0 : van der Corput 
+      V[0][k]=static_cast<uint32_t>(1U) << (nBits-1-k);
+      // dim 1 : s=1 a=0 m={1}
+      V[1][k]=(k<1) ? static_cast<uint32_t>(1U) << (nBits-1) :
+	V[1][k-1] ^ (V[1][k-1]>>1);
+      // dim 2 : s=2 a=1 m={1,3}
+      if (k<2)
+	V[2][k]=static_cast<uint32_t>((k) ? 3U : 1U) << (nBits-1-k);
+      else
+	V[2][k]=V[2][k-2] ^ (V[2][k-2]>>2) ^ V[2][k-1];
+    }
+  Shift[0]=Shift[1]=Shift[2]=0;
+}
+
+SobolSeq::SobolSeq(const SobolSeq& A)
+  /*!
+    Copy constructor
+    \param A :: SobolSeq to copy
+  */
+{
+  *this=A;
+}
+
+SobolSeq&
+SobolSeq::operator=(const SobolSeq& A)
+  /*!
+    Assignment operator
+    \param A :: SobolSeq to copy
+    \return *this
+  */
+{
+  if (this!=&A)
+    {
+      for(size_t i=0;i<3;i++)
+	{
+	  Shift[i]=A.Shift[i];
+	  for(size_t k=0;k<nBits;k++)
+	    V[i][k]=A.V[i][k];
+	}
+    }
+  return *this;
+}
+
+void
+SobolSeq::setShift(const uint32_t A,const uint32_t B,const uint32_t C)
+  /*!
+    Set the digital shift for each dimension
+    \param A :: Shift of dimension 0
+    \param B :: Shift of dimension 1
+    \param C :: Shift of dimension 2
+  */
+{
+  Shift[0]=A;
+  Shift[1]=B;
+  Shift[2]=C;
+  return;
+}
+
+void
+SobolSeq::getPoint(const size_t Index,double& X,double& Y,double& Z) const
+  /*!
+    Calculate a point of the sequence
+    \param Index :: Index of point
+    \param X :: Value in dimension 0 [0-1)
+    \param Y :: Value in dimension 1 [0-1)
+    \param Z :: Value in dimension 2 [0-1)
+  */
+{
+  uint32_t A(Shift[0]),B(Shift[1]),C(Shift[2]);
+  size_t G=Index ^ (Index>>1);
+  for(size_t k=0;G && k<nBits;k++,G>>=1)
+    if (G & 1)
+      {
+	A^=V[0][k];
+	B^=V[1][k];
+	C^=V[2][k];
+      }
+  const double scale(1.0/4294967296.0);
+  X=static_cast<double>(A)*scale;
+  Y=static_cast<double>(B)*scale;
+  Z=static_cast<double>(C)*scale;
+  return;
+}
@@ -0,0 +1,59 @@
+/********************************************************************* 
+  CombLayer : MCNP(X) Input builder
+ 
+ * File:   mersenneInc/SobolSeq.h
+ *
+ * Copyright (c) 2004-2016 by Stuart Ansell
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>. 
+ *
+ ****************************************************************************/
+#ifndef SobolSeq_h
+#define SobolSeq_h
+
+/*!
+  \class SobolSeq
+  \version 1.0
+  \author S. Ansell
+  \date May 2016
+  \brief Three dimensional Sobol low-discrepancy sequence
+
+  Points are generated directly from their index 
+  [Gray code order] so that any block of the sequence
+  can be produced independently. An optional random 
+  digital shift [XOR] decorrelates different runs.
+  Direction numbers are from Joe and Kuo.
+*/
+
+class SobolSeq
+{
+ private:
+
+  static const size_t nBits=32;      ///< Bits of precision
+  
+  uint32_t V[3][nBits];              ///< Direction numbers
+  uint32_t Shift[3];                 ///< Digital shift
+  
+ public:
+
+  SobolSeq();
+  SobolSeq(const SobolSeq&);
+  SobolSeq& operator=(const SobolSeq&);
+  ~SobolSeq() {}       ///< Destructor
+
+  void setShift(const uint32_t,const uint32_t,const uint32_t);
+  void getPoint(const size_t,double&,double&,double&) const;
+};
+
+#endif
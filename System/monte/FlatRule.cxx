@@ -0,0 +1,446 @@
+/********************************************************************* 
+  CombLayer : MCNP(X) Input builder
+ 
+ * File:   monte/FlatRule.cxx
+ *
+ * Copyright (c) 2004-2016 by Stuart Ansell
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>. 
+ *
+ ****************************************************************************/
+#include <fstream>
+#include <iomanip>
+#include <iostream>
+#include <sstream>
+#include <cmath>
+#include <complex>
+#include <string>
+#include <vector>
+#include <set>
+#include <map>
+#include <algorithm>
+
+#include "Exception.h"
+#include "FileReport.h"
+#include "NameStack.h"
+#include "RegMethod.h"
+#include "GTKreport.h"
+#include "OutputLog.h"
+#include "BaseVisit.h"
+#include "BaseModVisit.h"
+#include "MatrixBase.h"
+#include "Matrix.h"
+#include "Vec3D.h"
+#include "Surface.h"
+#include "Rules.h"
+#include "HeadRule.h"
+#include "Object.h"
+#include "FlatRule.h"
+
+namespace MonteCarlo
+{
+
+const long int FlatRule::trueExit;
+const long int FlatRule::falseExit;
+
+FlatRule::FlatRule() :
+  active(0),startIndex(falseExit)
+  /*!
+    Constructor
+  */
+{}
+
+FlatRule::FlatRule(const FlatRule& A) :
+  active(A.active),startIndex(A.startIndex),
+  SurfTable(A.SurfTable),SurfNum(A.SurfNum),
+  ObjTable(A.ObjTable),Code(A.Code)
+  /*!
+    Copy constructor
+    \param A :: FlatRule to copy
+  */
+{}
+
+FlatRule&
+FlatRule::operator=(const FlatRule& A)
+  /*!
+    Assignment operator
+    \param A :: FlatRule to copy
+    \return *this
+  */
+{
+  if (this!=&A)
+    {
+      active=A.active;
+      startIndex=A.startIndex;
+      SurfTable=A.SurfTable;
+      SurfNum=A.SurfNum;
+      ObjTable=A.ObjTable;
+      Code=A.Code;
+    }
+  return *this;
+}
+
+void
+FlatRule::clear()
+  /*!
+    Remove the compiled rule
+  */
+{
+  active=0;
+  startIndex=falseExit;
+  SurfTable.clear();
+  SurfNum.clear();
+  ObjTable.clear();
+  Code.clear();
+  return;
+}
+
+bool
+FlatRule::isCompilable(const Rule* RPtr)
+  /*!
+    Determine if the rule can be flattened. Intersections
+    and unions with missing leaves have special null
+    behaviour and are left to the tree.
+    \param RPtr :: Rule to check
+    \return true if the rule can be compiled
+  */
+{
+  if (!RPtr) return 0;
+  if (RPtr->type())
+    return (isCompilable(RPtr->leaf(0)) && 
+	    isCompilable(RPtr->leaf(1)));
+  
+  if (dynamic_cast<const CompGrp*>(RPtr) || 
+      dynamic_cast<const ContGrp*>(RPtr))
+    return (!RPtr->leaf(0) || isCompilable(RPtr->leaf(0)));
+
+  return (dynamic_cast<const SurfPoint*>(RPtr) ||
+	  dynamic_cast<const CompObj*>(RPtr) ||
+	  dynamic_cast<const ContObj*>(RPtr) ||
+	  dynamic_cast<const BoolValue*>(RPtr));
+}
+
+size_t
+FlatRule::surfIndex(const Geometry::Surface* SPtr,const int keyN)
+  /*!
+    Get the index of a surface in the table [adding if needed]
+    \param SPtr :: Surface 
+    \param keyN :: Surface number
+    \return index 
+  */
+{
+  for(size_t i=0;i<SurfNum.size();i++)
+    if (SurfNum[i]==keyN)
+      return i;
+  SurfTable.push_back(SPtr);
+  SurfNum.push_back(keyN);
+  return SurfNum.size()-1;
+}
+
+long int
+FlatRule::compile(const Rule* RPtr,const long int onTrue,
+		  const long int onFalse)
+  /*!
+    Compile the rule given the true/false targets.
+    The second leaf is compiled first so that its entry
+    point is known as the target of the first leaf.
+    \param RPtr :: Rule to compile
+    \param onTrue :: Target if rule is true
+    \param onFalse :: Target if rule is false
+    \return Entry point of the rule [or exit flag]
+  */
+{
+  if (RPtr->type()==1)    // intersection : both must be true
+    {
+      const long int BEntry=compile(RPtr->leaf(1),onTrue,onFalse);
+      return compile(RPtr->leaf(0),BEntry,onFalse);
+    }
+  if (RPtr->type()==-1)   // union : either true
+    {
+      const long int BEntry=compile(RPtr->leaf(1),onTrue,onFalse);
+      return compile(RPtr->leaf(0),onTrue,BEntry);
+    }
+
+  if (dynamic_cast<const CompGrp*>(RPtr))
+    return (RPtr->leaf(0)) ? 
+      compile(RPtr->leaf(0),onFalse,onTrue) : onTrue;
+  if (dynamic_cast<const ContGrp*>(RPtr))
+    return (RPtr->leaf(0)) ? 
+      compile(RPtr->leaf(0),onTrue,onFalse) : onFalse;
+  
+  const BoolValue* BPtr=dynamic_cast<const BoolValue*>(RPtr);
+  if (BPtr)
+    return (BPtr->isValid(Geometry::Vec3D())) ? onTrue : onFalse;
+
+  Item IC;
+  IC.sign=1;
+  IC.onTrue=onTrue;
+  IC.onFalse=onFalse;
+  
+  const SurfPoint* SPtr=dynamic_cast<const SurfPoint*>(RPtr);
+  if (SPtr)
+    {
+      if (!SPtr->getKey()) return onFalse;
+      IC.type=0;
+      IC.index=surfIndex(SPtr->getKey(),SPtr->getKeyN());
+      IC.sign=SPtr->getSign();
+    }
+  else
+    {
+      const CompObj* CPtr=dynamic_cast<const CompObj*>(RPtr);
+      const Object* OPtr=(CPtr) ? CPtr->getObj() :
+	dynamic_cast<const ContObj*>(RPtr)->getObj();
+      if (!OPtr) return (CPtr) ? onTrue : onFalse;
+      IC.type=(CPtr) ? -1 : 1;
+      IC.index=ObjTable.size();
+      ObjTable.push_back(OPtr);
+    }
+  Code.push_back(IC);
+  return static_cast<long int>(Code.size()-1);
+}
+
+int
+FlatRule::setRule(const Rule* RPtr)
+  /*!
+    Compile a rule
+    \param RPtr :: Top rule
+    \return 1 on success / 0 if the rule cannot be compiled
+  */
+{
+  ELog::RegMethod RegA("FlatRule","setRule");
+  
+  clear();
+  if (!isCompilable(RPtr)) return 0;
+  
+  startIndex=compile(RPtr,trueExit,falseExit);
+  active=1;
+  return 1;
+}
+
+long int
+FlatRule::findIndex(const int SN) const
+  /*!
+    Find the table index of a surface
+    \param SN :: Surface number [signed]
+    \return index or -1 if not found
+  */
+{
+  const int ASN(std::abs(SN));
+  for(size_t i=0;i<SurfNum.size();i++)
+    if (SurfNum[i]==ASN)
+      return static_cast<long int>(i);
+  return -1;
+}
+
+bool
+FlatRule::evaluate(const Geometry::Vec3D& Pt,const int mode,
+		   const int ExSN) const
+  /*!
+    Run the compiled rule
+    \param Pt :: Point to test
+    \param mode :: 0 : normal / 1 : Exclude ExSN / 2 : ExSN directional
+    \param ExSN :: Surface number to exclude [signed for direction]
+    \return true if valid
+  */
+{
+  const long int exIndex((mode) ? findIndex(ExSN) : -1);
+  long int pc(startIndex);
+  while(pc>=0)
+    {
+      const Item& IC=Code[static_cast<size_t>(pc)];
+      bool flag;
+      if (!IC.type)
+	{
+	  if (static_cast<long int>(IC.index)==exIndex)
+	    flag=(mode==1 || IC.sign*ExSN>0);
+	  else
+	    flag=(SurfTable[IC.index]->side(Pt)*IC.sign>=0);
+	}
+      else
+	{
+	  const Object* OPtr=ObjTable[IC.index];
+	  if (mode==0)
+	    flag=OPtr->isValid(Pt);
+	  else if (mode==1)
+	    flag=OPtr->isValid(Pt,ExSN);
+	  else
+	    flag=OPtr->isDirectionValid(Pt,ExSN);
+	  if (IC.type<0) flag=!flag;
+	}
+      pc=(flag) ? IC.onTrue : IC.onFalse;
+    }
+  return (pc==trueExit);
+}
+
+bool
+FlatRule::evaluate(const std::vector<int>& Sense,
+		   const long int exIndex,const int exSign) const
+  /*!
+    Run the compiled rule from stored surface senses.
+    Only for rules without object tests.
+    \param Sense :: side() value of each table surface
+    \param exIndex :: Table index of surface to set by exSign
+    \param exSign :: Sign to use for surface exIndex
+    \return true if valid
+  */
+{
+  long int pc(startIndex);
+  while(pc>=0)
+    {
+      const Item& IC=Code[static_cast<size_t>(pc)];
+      const bool flag=(static_cast<long int>(IC.index)==exIndex) ?
+	(IC.sign*exSign>0) : (Sense[IC.index]*IC.sign>=0);
+      pc=(flag) ? IC.onTrue : IC.onFalse;
+    }
+  return (pc==trueExit);
+}
+
+bool
+FlatRule::isValid(const Geometry::Vec3D& Pt) const
+  /*!
+    Determine if the point is valid
+    \param Pt :: Point to test
+    \return true if valid
+  */
+{
+  return evaluate(Pt,0,0);
+}
+
+bool
+FlatRule::isValid(const Geometry::Vec3D& Pt,const int ExSN) const
+  /*!
+    Determine if the point is valid 
+    \param Pt :: Point to test
+    \param ExSN :: Surface to treat as always valid
+    \return true if valid
+  */
+{
+  return evaluate(Pt,1,ExSN);
+}
+
+bool
+FlatRule::isValid(const Geometry::Vec3D& Pt,
+		  const std::vector<long int>& ExIndex) const
+  /*!
+    Determine if the point is valid with a number of 
+    surfaces treated as always valid. Only for rules 
+    without object tests.
+    \param Pt :: Point to test
+    \param ExIndex :: Table index [findIndex] of surfaces to exclude
+    \return true if valid
+  */
+{
+  if (!ObjTable.empty())
+    throw ColErr::ExBase(0,"FlatRule::isValid<vector> with objects");
+  
+  long int pc(startIndex);
+  while(pc>=0)
+    {
+      const Item& IC=Code[static_cast<size_t>(pc)];
+      const long int index(static_cast<long int>(IC.index));
+      const bool flag=
+	(std::find(ExIndex.begin(),ExIndex.end(),index)!=ExIndex.end()) ||
+	(SurfTable[IC.index]->side(Pt)*IC.sign>=0);
+      pc=(flag) ? IC.onTrue : IC.onFalse;
+    }
+  return (pc==trueExit);
+}
+
+bool
+FlatRule::isDirectionValid(const Geometry::Vec3D& Pt,
+			   const int ExSN) const
+  /*!
+    Determine if the point is valid 
+    \param Pt :: Point to test
+    \param ExSN :: Surface to treat as true/false [based on sign]
+    \return true if valid
+  */
+{
+  return evaluate(Pt,2,ExSN);
+}
+
+int
+FlatRule::pairValid(const int SN,const Geometry::Vec3D& Pt) const
+  /*!
+    Determine the validity of the point with the 
+    surface SN on each side. 
+    \param SN :: Surface number
+    \param Pt :: Point to test
+    \return valid(SN->false) [bit 1] : valid(SN->true) [bit 2]
+  */
+{
+  const int ASN(std::abs(SN));
+  return ((evaluate(Pt,2,-ASN)) ? 1 : 0) | 
+    ((evaluate(Pt,2,ASN)) ? 2 : 0);
+}
+
+void
+FlatRule::fillSense(const Geometry::Vec3D& Pt,
+		    std::vector<int>& Sense) const
+  /*!
+    Calculate the side of each table surface for a point
+    \param Pt :: Point to test
+    \param Sense :: side() value of each surface [resized]
+  */
+{
+  Sense.resize(SurfTable.size());
+  for(size_t i=0;i<SurfTable.size();i++)
+    Sense[i]=SurfTable[i]->side(Pt);
+  return;
+}
+
+int
+FlatRule::pairValid(const long int index,
+		    const std::vector<int>& Sense) const
+  /*!
+    Determine the validity of the surface senses with the 
+    surface index on each side. No geometric tests are
+    carried out. Only for rules without object tests.
+    \param index :: Table index of surface [findIndex]
+    \param Sense :: side() value of each table surface
+    \return valid(SN->false) [bit 1] : valid(SN->true) [bit 2]
+  */
+{
+  if (!ObjTable.empty())
+    throw ColErr::ExBase(0,"FlatRule::pairValid<sense> with objects");
+  if (Sense.size()!=SurfTable.size())
+    throw ColErr::MisMatch<size_t>(Sense.size(),SurfTable.size(),
+				   "FlatRule::pairValid<sense>");
+
+  return ((evaluate(Sense,index,-1)) ? 1 : 0) | 
+    ((evaluate(Sense,index,1)) ? 2 : 0);
+}
+
+void
+FlatRule::write(std::ostream& OX) const
+  /*!
+    Write out the compiled rule
+    \param OX :: Output stream
+  */
+{
+  OX<<"FlatRule["<<active<<"] start="<<startIndex<<std::endl;
+  for(size_t i=0;i<Code.size();i++)
+    {
+      const Item& IC=Code[i];
+      OX<<"  "<<i<<" : ";
+      if (!IC.type)
+	OX<<IC.sign*SurfNum[IC.index];
+      else
+	OX<<((IC.type<0) ? "#" : "%")<<ObjTable[IC.index]->getName();
+      OX<<" -> "<<IC.onTrue<<" / "<<IC.onFalse<<std::endl;
+    }
+  return;
+}
+
+}  // NAMESPACE MonteCarlo
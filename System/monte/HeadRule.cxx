@@ -45,10 +45,17 @@
 #include "BaseModVisit.h"
 #include "support.h"
 #include "stringCombine.h"
+#include "binaryIO.h"
 #include "MatrixBase.h"
 #include "Matrix.h"
 #include "Vec3D.h"
 #include "Surface.h"
+#include "Quadratic.h"
+#include "Plane.h"
+#include "Cylinder.h"
+#include "Sphere.h"
+#include "Cone.h"
+#include "BoundBox.h"
 #include "surfIndex.h"
 #include "BnId.h"
 #include "Acomp.h"
@@ -604,6 +611,308 @@ HeadRule::getSurfSet() const
   return (HeadNode) ? HeadNode->getSurfSet() : std::set<int>();
 }
 
+Geometry::BoundBox
+HeadRule::calcSurfBox(const Geometry::Surface* SPtr,const int sign)
+  /*!
+    Calculate the box of the half-space of a surface.
+    Only axis aligned planes, spheres and cylinders produce 
+    bounds, everything else is unbounded. Other surfaces
+    are used to cut down an existing box by tightenBox.
+    \param SPtr :: Surface [can be null]
+    \param sign :: Sense of surface in rule
+    \return Bounding box of the valid side
+  */
+{
+  Geometry::BoundBox Out;
+  if (!SPtr) return Out;
+  
+  const Geometry::Plane* PPtr=
+    dynamic_cast<const Geometry::Plane*>(SPtr);
+  if (PPtr)
+    {
+      const Geometry::Vec3D& Norm(PPtr->getNormal());
+      for(size_t i=0;i<3;i++)
+	{
+	  if (std::abs(Norm[i])>1.0-Geometry::zeroTol)
+	    {
+	      const double V=PPtr->getDistance()/Norm[i];
+	      if (sign*Norm[i]>0.0)
+		Out.setLow(i,V);
+	      else
+		Out.setHigh(i,V);
+	      break;
+	    }
+	}
+      return Out;
+    }
+  // Only the inside of closed surfaces is bounded
+  if (sign>0) return Out;
+
+  const Geometry::Sphere* SphPtr=
+    dynamic_cast<const Geometry::Sphere*>(SPtr);
+  if (SphPtr)
+    {
+      const Geometry::Vec3D RVec(SphPtr->getRadius(),
+				 SphPtr->getRadius(),
+				 SphPtr->getRadius());
+      return Geometry::BoundBox(SphPtr->getCentre()-RVec,
+				SphPtr->getCentre()+RVec);
+    }
+
+  const Geometry::Cylinder* CPtr=
+    dynamic_cast<const Geometry::Cylinder*>(SPtr);
+  if (CPtr)
+    {
+      // bounded in all directions perpendicular to the axis
+      const Geometry::Vec3D& Norm(CPtr->getNormal());
+      const Geometry::Vec3D& C(CPtr->getCentre());
+      const double R(CPtr->getRadius());
+      for(size_t i=0;i<3;i++)
+	if (std::abs(Norm[i])<Geometry::zeroTol)
+	  {
+	    Out.setLow(i,C[i]-R);
+	    Out.setHigh(i,C[i]+R);
+	  }
+    }
+  return Out;
+}
+
+bool
+HeadRule::boxRange(const Geometry::BoundBox& BBox,
+		   const Geometry::Vec3D& Org,
+		   const Geometry::Vec3D& Dir,
+		   double& lowV,double& highV)
+  /*!
+    Calculate the range of (Pt-Org).Dir over the box
+    \param BBox :: Box to use
+    \param Org :: Origin
+    \param Dir :: Direction
+    \param lowV :: Low value [output]
+    \param highV :: High value [output]
+    \return true if range is finite
+  */
+{
+  const Geometry::Vec3D& LP(BBox.getLow());
+  const Geometry::Vec3D& HP(BBox.getHigh());
+  lowV=0.0;
+  highV=0.0;
+  for(size_t i=0;i<3;i++)
+    {
+      if (std::abs(Dir[i])>Geometry::zeroTol)
+	{
+	  if (LP[i]<=-Geometry::BoundBox::boxInf ||
+	      HP[i]>=Geometry::BoundBox::boxInf)
+	    return 0;
+	  const double A=(LP[i]-Org[i])*Dir[i];
+	  const double B=(HP[i]-Org[i])*Dir[i];
+	  lowV+=std::min(A,B);
+	  highV+=std::max(A,B);
+	}
+    }
+  return 1;
+}
+
+void
+HeadRule::tightenBox(Geometry::BoundBox& BBox,
+		     const Geometry::Surface* SPtr,const int sign)
+  /*!
+    Cut down a box using the half-space of a surface 
+    that does not produce a box on its own. Planes
+    at general angle cut a side if the other axes are
+    bounded. Cylinders/cones at a general angle restrict
+    the box if the axial range is bounded.
+    \param BBox :: Box to reduce
+    \param SPtr :: Surface [can be null]
+    \param sign :: Sense of surface in rule
+  */
+{
+  if (!SPtr || BBox.isEmpty()) return;
+  
+  const Geometry::Plane* PPtr=
+    dynamic_cast<const Geometry::Plane*>(SPtr);
+  if (PPtr)
+    {
+      // half space : M.x >= E
+      const Geometry::Vec3D M(PPtr->getNormal()*sign);
+      const double E(PPtr->getDistance()*sign);
+      for(size_t i=0;i<3;i++)
+	{
+	  if (std::abs(M[i])<1e-6) continue;
+	  // maximum of the other terms
+	  double SMax(0.0);
+	  size_t j;
+	  for(j=1;j<3;j++)
+	    {
+	      const size_t index((i+j) % 3);
+	      if (std::abs(M[index])>Geometry::zeroTol)
+		{
+		  const double V=(M[index]>0.0) ? 
+		    BBox.getHigh()[index] : BBox.getLow()[index];
+		  if (std::abs(V)>=Geometry::BoundBox::boxInf) break;
+		  SMax+=M[index]*V;
+		}
+	    }
+	  if (j==3)
+	    {
+	      const double V=(E-SMax)/M[i];
+	      if (M[i]>0.0 && V>BBox.getLow()[i])
+		BBox.setLow(i,V);
+	      else if (M[i]<0.0 && V<BBox.getHigh()[i])
+		BBox.setHigh(i,V);
+	    }
+	}
+      return;
+    }
+  // Only the inside of closed surfaces is bounded
+  if (sign>0) return;
+
+  Geometry::Vec3D Org;
+  Geometry::Vec3D Dir;
+  double R(0.0);      // radius / tan(angle) for cones 
+  int cutFlag(0);
+  const Geometry::Cylinder* CPtr=
+    dynamic_cast<const Geometry::Cylinder*>(SPtr);
+  const Geometry::Cone* KPtr=(CPtr) ? 0 :
+    dynamic_cast<const Geometry::Cone*>(SPtr);
+  if (CPtr)
+    {
+      Org=CPtr->getCentre();
+      Dir=CPtr->getNormal();
+      R=CPtr->getRadius();
+    }
+  else if (KPtr)
+    {
+      const double cA(KPtr->getCosAngle());
+      if (cA<Geometry::zeroTol) return;
+      Org=KPtr->getCentre();
+      Dir=KPtr->getNormal();
+      R=sqrt(1.0-cA*cA)/cA;
+      cutFlag=KPtr->getCutFlag();
+    }
+  else
+    return;
+
+  double tLow,tHigh;
+  if (!boxRange(BBox,Org,Dir,tLow,tHigh))
+    return;
+  if (cutFlag>0) tLow=std::max(tLow,0.0);
+  if (cutFlag<0) tHigh=std::min(tHigh,0.0);
+  if (tLow>tHigh)
+    {
+      BBox=Geometry::BoundBox::emptyBox();
+      return;
+    }
+
+  // radius at each end / centre of the range
+  std::vector<std::pair<double,double> > TR;
+  if (CPtr)
+    {
+      TR.push_back(std::pair<double,double>(tLow,R));
+      TR.push_back(std::pair<double,double>(tHigh,R));
+    }
+  else
+    {
+      TR.push_back(std::pair<double,double>(tLow,std::abs(tLow)*R));
+      TR.push_back(std::pair<double,double>(tHigh,std::abs(tHigh)*R));
+      if (tLow<0.0 && tHigh>0.0)
+	TR.push_back(std::pair<double,double>(0.0,0.0));
+    }
+
+  for(size_t i=0;i<3;i++)
+    {
+      const double perp=sqrt(std::max(0.0,1.0-Dir[i]*Dir[i]));
+      double lowV(Geometry::BoundBox::boxInf);
+      double highV(-Geometry::BoundBox::boxInf);
+      for(const std::pair<double,double>& tr : TR)
+	{
+	  const double C=Org[i]+Dir[i]*tr.first;
+	  lowV=std::min(lowV,C-tr.second*perp);
+	  highV=std::max(highV,C+tr.second*perp);
+	}
+      if (lowV>BBox.getLow()[i])
+	BBox.setLow(i,lowV);
+      if (highV<BBox.getHigh()[i])
+	BBox.setHigh(i,highV);
+    }
+  return;
+}
+
+Geometry::BoundBox
+HeadRule::calcRuleBox(const Rule* RPtr)
+  /*!
+    Recursively calculate the bounding box of a rule.
+    Intersection gives the common box, union the
+    combined box. Complements are unbounded. The surfaces
+    of an intersection are then used to cut the common box.
+    \param RPtr :: Rule to process
+    \return Bounding box
+  */
+{
+  if (!RPtr) return Geometry::BoundBox();
+
+  if (RPtr->type()==1)
+    {
+      // flatten the intersection chain
+      std::vector<const Rule*> Items;
+      std::stack<const Rule*> Work;
+      Work.push(RPtr);
+      while(!Work.empty())
+	{
+	  const Rule* TPtr=Work.top();
+	  Work.pop();
+	  if (TPtr && TPtr->type()==1)
+	    {
+	      Work.push(TPtr->leaf(1));
+	      Work.push(TPtr->leaf(0));
+	    }
+	  else if (TPtr)
+	    Items.push_back(TPtr);
+	}
+      
+      Geometry::BoundBox Out;
+      for(const Rule* IPtr : Items)
+	Out.intersectBox(calcRuleBox(IPtr));
+
+      // Two passes since each cut can help the others
+      for(size_t pass=0;pass<2 && !Out.isEmpty();pass++)
+	for(const Rule* IPtr : Items)
+	  {
+	    const SurfPoint* SP=dynamic_cast<const SurfPoint*>(IPtr);
+	    if (SP)
+	      tightenBox(Out,SP->getKey(),SP->getSign());
+	  }
+      return Out;
+    }
+  if (RPtr->type()==-1)
+    {
+      Geometry::BoundBox Out=calcRuleBox(RPtr->leaf(0));
+      Out.unionBox(calcRuleBox(RPtr->leaf(1)));
+      return Out;
+    }
+  const SurfPoint* SP=dynamic_cast<const SurfPoint*>(RPtr);
+  if (SP)
+    return calcSurfBox(SP->getKey(),SP->getSign());
+  
+  return Geometry::BoundBox();
+}
+
+Geometry::BoundBox
+HeadRule::calcBoundBox() const
+  /*!
+    Calculate a conservative axis aligned bounding box 
+    of the rule. The box is padded so that points on the 
+    surface (within tolerance) are always inside.
+    Requires the surfaces to be populated.
+    \return Bounding box [unbounded on failure]
+  */
+{
+  ELog::RegMethod RegA("HeadRule","calcBoundBox");
+
+  Geometry::BoundBox Out=calcRuleBox(HeadNode);
+  Out.pad(10.0*Geometry::shiftTol);
+  return Out;
+}
+
 std::set<const Geometry::Surface*>
 HeadRule::getOppositeSurfaces() const
   /*!
@@ -1482,6 +1791,85 @@ HeadRule::addIntersection(const HeadRule& AHead)
   return;
 }
 
+void
+HeadRule::frontIntersection(const HeadRule& AHead) 
+  /*!
+    Add a rule as an intersection with the whole of the 
+    current rule. The new rule is the first leaf of a
+    new top node, so the existing tree is not searched.
+    \param AHead :: Other head rule
+   */
+{
+  ELog::RegMethod RegA("HeadRule","frontIntersection");
+  if (!AHead.HeadNode) return;
+
+  if (!HeadNode)
+    {
+      HeadNode=AHead.HeadNode->clone();
+      return;
+    }
+  HeadNode=new Intersection(0,AHead.HeadNode->clone(),HeadNode);
+  return;
+}
+
+void
+HeadRule::backIntersection(const HeadRule& AHead) 
+  /*!
+    Add a rule as an intersection with the whole of the 
+    current rule. The new rule is the second leaf of a
+    new top node.
+    \param AHead :: Other head rule
+   */
+{
+  ELog::RegMethod RegA("HeadRule","backIntersection");
+  if (!AHead.HeadNode) return;
+
+  if (!HeadNode)
+    {
+      HeadNode=AHead.HeadNode->clone();
+      return;
+    }
+  HeadNode=new Intersection(0,HeadNode,AHead.HeadNode->clone());
+  return;
+}
+
+void
+HeadRule::reverseRule()
+  /*!
+    Reverse every intersection list in the rule. This is
+    the order change that procString makes to a string.
+   */
+{
+  reverseIntersections(HeadNode);
+  return;
+}
+
+void
+HeadRule::reverseIntersections(Rule* RPtr)
+  /*!
+    Swap the leaves of every intersection below RPtr
+    so that all the intersection lists are reversed
+    \param RPtr :: Rule to reverse
+   */
+{
+  if (!RPtr) return;
+  if (RPtr->type())
+    {
+      Rule* LA=RPtr->leaf(0);
+      Rule* LB=RPtr->leaf(1);
+      reverseIntersections(LA);
+      reverseIntersections(LB);
+      if (RPtr->type()==1)
+	{
+	  RPtr->setLeaf(LB,0);
+	  RPtr->setLeaf(LA,1);
+	}
+    }
+  else
+    reverseIntersections(RPtr->leaf(0));
+  return;
+}
+
 
 void
 HeadRule::addUnion(const HeadRule& AHead) 
@@ -2017,3 +2405,39 @@ HeadRule::Intersects(const HeadRule& A) const
     }
   return 0;
 }
+
+void
+HeadRule::writeBinary(std::ostream& OX) const
+  /*!
+    Write the rule to a binary stream. The rule is
+    held as its string form.
+    \param OX :: Output stream
+  */
+{
+  StrFunc::writeBin(OX,display());
+  return;
+}
+
+void
+HeadRule::readBinary(std::istream& IX)
+  /*!
+    Read the rule from a binary stream. The parser
+    reverses every intersection list so they are 
+    swapped back to give the tree that was written.
+    \param IX :: Input stream
+  */
+{
+  ELog::RegMethod RegA("HeadRule","readBinary");
+
+  std::string Line;
+  StrFunc::readBin(IX,Line);
+  delete HeadNode;
+  HeadNode=0;
+  if (!StrFunc::isEmpty(Line))
+    {
+      if (procString(Line)!=1)
+	throw ColErr::InvalidLine(Line,"HeadRule::readBinary",0);
+      reverseIntersections(HeadNode);
+    }
+  return;
+}
@@ -72,6 +72,8 @@
 namespace MonteCarlo
 {
 
+const size_t LineIntersectVisit::bufferSize(16);
+
 std::ostream& 
 operator<<(std::ostream& OX,const LineIntersectVisit& A)
   /*!
@@ -93,7 +95,11 @@ LineIntersectVisit::LineIntersectVisit
     \param Pt :: Point to start track
     \param uVec :: Outgoing track direction
   */
-{}
+{
+  PtOut.reserve(bufferSize);
+  DOut.reserve(bufferSize);
+  SurfIndex.reserve(bufferSize);
+}
 
 LineIntersectVisit::LineIntersectVisit
   (const MonteCarlo::neutron& N) :
@@ -102,7 +108,11 @@ LineIntersectVisit::LineIntersectVisit
     Constructor
     \param N :: Neutron to track
   */
-{}
+{
+  PtOut.reserve(bufferSize);
+  DOut.reserve(bufferSize);
+  SurfIndex.reserve(bufferSize);
+}
 
 void
 LineIntersectVisit::setLine(const Geometry::Vec3D& Pt,
@@ -130,6 +140,20 @@ LineIntersectVisit::setLine(const neutron& N)
   return;
 }
 
+void
+LineIntersectVisit::reset(const neutron& N)
+  /*!
+    Set the line to a new track and remove the old
+    intercepts. The buffers keep their capacity so a
+    visitor re-used in a tracking loop does not reallocate.
+    \param N :: Neutron
+  */
+{
+  setLine(N);
+  clearTrack();
+  return;
+}
+
 void
 LineIntersectVisit::Accept(const Geometry::Surface&)
   /*!
@@ -44,6 +44,7 @@
 #include "BaseModVisit.h"
 #include "Element.h"
 #include "Zaid.h"
+#include "binaryIO.h"
 #include "MXcards.h"
 
 namespace MonteCarlo
@@ -172,4 +173,33 @@ MXcards::write(std::ostream& OX) const
   return;
 } 
 
+
+void
+MXcards::writeBinary(std::ostream& OX) const
+  /*!
+    Write the card to a binary stream 
+    \param OX :: Output stream
+  */
+{
+  StrFunc::writeBin(OX,Mnum);
+  StrFunc::writeBin(OX,NZaid);
+  StrFunc::writeBin(OX,particle);
+  StrFunc::writeBin(OX,items);
+  return;
+}
+
+void
+MXcards::readBinary(std::istream& IX)
+  /*!
+    Read the card from a binary stream [writeBinary]
+    \param IX :: Input stream
+  */
+{
+  StrFunc::readBin(IX,Mnum);
+  StrFunc::readBin(IX,NZaid);
+  StrFunc::readBin(IX,particle);
+  StrFunc::readBin(IX,items);
+  return;
+}
+
 }  // NAMESPACE MonteCarlo
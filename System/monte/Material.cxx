@@ -50,6 +50,7 @@
 #include "Element.h"
 #include "Zaid.h"
 #include "MXcards.h"
+#include "binaryIO.h"
 #include "Material.h"
 
 namespace MonteCarlo
@@ -823,4 +824,59 @@ Material::write(std::ostream& OX) const
   return;
 } 
 
+
+void
+Material::writeBinary(std::ostream& OX) const
+  /*!
+    Write the material to a binary stream 
+    \param OX :: Output stream
+  */
+{
+  StrFunc::writeBin(OX,Mnum);
+  StrFunc::writeBin(OX,Name);
+  StrFunc::writeBin(OX,zaidVec.size());
+  for(const Zaid& ZC : zaidVec)
+    ZC.writeBinary(OX);
+  StrFunc::writeBin(OX,mxCards.size());
+  for(const std::map<std::string,MXcards>::value_type& MC : mxCards)
+    {
+      StrFunc::writeBin(OX,MC.first);
+      MC.second.writeBinary(OX);
+    }
+  StrFunc::writeBin(OX,Libs);
+  StrFunc::writeBin(OX,SQW);
+  StrFunc::writeBin(OX,atomDensity);
+  return;
+}
+
+void
+Material::readBinary(std::istream& IX)
+  /*!
+    Read the material from a binary stream written
+    by writeBinary
+    \param IX :: Input stream
+  */
+{
+  StrFunc::readBin(IX,Mnum);
+  StrFunc::readBin(IX,Name);
+  size_t nItem;
+  StrFunc::readBin(IX,nItem);
+  zaidVec.resize(nItem);
+  for(Zaid& ZC : zaidVec)
+    ZC.readBinary(IX);
+
+  mxCards.clear();
+  StrFunc::readBin(IX,nItem);
+  for(size_t i=0;i<nItem;i++)
+    {
+      std::string Key;
+      StrFunc::readBin(IX,Key);
+      mxCards[Key].readBinary(IX);
+    }
+  StrFunc::readBin(IX,Libs);
+  StrFunc::readBin(IX,SQW);
+  StrFunc::readBin(IX,atomDensity);
+  return;
+}
+
 }  // NAMESPACE MonteCarlo
@@ -33,6 +33,7 @@
 #include <string>
 #include <sstream>
 #include <algorithm>
+#include <iterator>
 #include <memory>
 
 #include "Exception.h"
@@ -43,6 +44,7 @@
 #include "OutputLog.h"
 #include "support.h"
 #include "stringCombine.h"
+#include "binaryIO.h"
 #include "BaseVisit.h"
 #include "BaseModVisit.h"
 #include "MatrixBase.h"
@@ -53,6 +55,7 @@
 #include "Line.h"
 #include "LineIntersectVisit.h"
 #include "Surface.h"
+#include "BoundBox.h"
 #include "surfIndex.h"
 #include "Rules.h"
 #include "HeadRule.h"
@@ -60,7 +63,10 @@
 #include "neutron.h"
 #include "RuleCheck.h"
 #include "objectRegister.h"
+#include "QueryContext.h"
 #include "Object.h"
+#include "FlatRule.h"
+#include "SenseTrack.h"
 
 #include "Debug.h"
 
@@ -164,7 +170,7 @@ Object::startLine(const std::string& Line)
 Object::Object() :
   ObjName(0),listNum(-1),Tmp(300),MatN(-1),fill(0),trcl(0),
   universe(0),imp(1),density(0.0),placehold(0),populated(0),
-  objSurfValid(0)
+  flatStale(0),boxPtr(0),flatPtr(0),objSurfValid(0)
  /*!
    Defaut constuctor, set temperature to 300C and material to vacuum
  */
@@ -174,7 +180,8 @@ Object::Object(const int N,const int M,const double T,
 	       const std::string& Line) :
   ObjName(N),listNum(-1),Tmp(T),MatN(M),fill(0),trcl(0),
   universe(0),imp(1),density(0.0),placehold(0),
-  populated(0),objSurfValid(0)
+  populated(0),flatStale(0),boxPtr(0),flatPtr(0),
+  objSurfValid(0)
  /*!
    Constuctor, set temperature to 300C 
    \param N :: number
@@ -190,7 +197,10 @@ Object::Object(const Object& A) :
   ObjName(A.ObjName),listNum(A.listNum),Tmp(A.Tmp),MatN(A.MatN),
   fill(A.fill),trcl(A.trcl),universe(A.universe),imp(A.imp),
   density(A.density),placehold(A.placehold),populated(A.populated),
-  HRule(A.HRule),objSurfValid(0),SurList(A.SurList),SurSet(A.SurSet)
+  flatStale(A.flatStale),HRule(A.HRule),
+  boxPtr((A.boxPtr) ? new Geometry::BoundBox(*A.boxPtr) : 0),
+  flatPtr((A.flatPtr) ? new FlatRule(*A.flatPtr) : 0),objSurfValid(0),
+  SurList(A.SurList),SurSet(A.SurSet)
   /*!
     Copy constructor
     \param A :: Object to copy
@@ -219,6 +229,7 @@ Object::operator=(const Object& A)
       placehold=A.placehold;
       populated=A.populated;
       HRule=A.HRule;
+      ruleChanged();
       objSurfValid=0;
       SurList=A.SurList;
       SurSet=A.SurSet;
@@ -230,7 +241,10 @@ Object::~Object()
   /*!
     Delete operator : removes Object tree
   */
-{}
+{
+  delete boxPtr;
+  delete flatPtr;
+}
 
 Object*
 Object::clone() const 
@@ -294,6 +308,7 @@ Object::complementaryObject(const int Cnum,std::string& Ln)
   std::ostringstream CompCell;
   CompCell<<Cnum<<" ";
   Ln.insert(posA-1,CompCell.str());
+  ruleChanged();
   objSurfValid=0;
   return 1;
 }
@@ -390,6 +405,7 @@ Object::setObject(std::string Ln)
     }
 
   populated=0;
+  ruleChanged();
   if (HRule.procString(Ln))     // this currently does not fail:
     {
       SurList.clear();
@@ -412,6 +428,7 @@ Object::procString(const std::string& cellStr)
    */
 {
   populated=0;
+  ruleChanged();
   return HRule.procString(cellStr);
 }
 
@@ -438,6 +455,8 @@ Object::setObject(const int N,const int matNum,
   for(mc=TVec.begin();mc!=TVec.end();mc++)
     mc->write(cx);
 
+  populated=0;
+  ruleChanged();
   if (HRule.procString(cx.str()))     // this currently does not fail:
     {
       SurList.clear();
@@ -467,34 +486,189 @@ Object::populate()
     {
       HRule.populateSurf();
       populated=1;
+      ruleChanged();
     }
+  else if (flatStale)
+    ruleChanged();
   return 0;
 }
 
 int
 Object::addSurfString(const std::string& XE)
   /*!
-    Adds a string in the most ugly fashion...
+    Adds a string as an intersection with the cell rule.
     \param XE Bit to add (at the global point)
     \retval 1 on success
     \retval 0 on failure
   */
 {
   ELog::RegMethod RegA("Object","addSurfString");
-  const double Temp=Tmp;                   // need to set later
-  std::string Line;
-  if (HRule.isUnion())
-    Line = headStr()+" ("+cellCompStr()+")"+XE;
-  else
-    Line = str()+XE;
 
-  const int flag=setObject(Line);
-  Tmp=Temp;      
-  populated=0;
+  if (StrFunc::isEmpty(XE)) return 1;
+  HeadRule XRule;
+  if (!XRule.procString(XE))
+    {
+      ELog::EM<<"Failed to process rule in cell "<<ObjName
+	      <<" :: "<<XE<<ELog::endErr;
+      return 0;
+    }
+  addIntersection(XRule);
+  return 1;
+}
+
+void
+Object::addIntersection(const HeadRule& XRule)
+  /*!
+    Intersect the cell with a rule. The cell is written as
+    procString gives the old cell string followed by XRule:
+    XRule first and every intersection list of the old rule
+    reversed. The surface pointers and the surface list are 
+    extended for the new rule only, the box is cut by the
+    box of XRule and the compiled rule is rebuilt at the 
+    next populate.
+    \param XRule :: Rule to add
+  */
+{
+  ELog::RegMethod RegA("Object","addIntersection");
+
+  if (!XRule.hasRule()) return;
+
+  HeadRule NRule(XRule);
+  if (populated)
+    NRule.populateSurf();
+  HRule.reverseRule();
+  HRule.frontIntersection(NRule);
+
+  if (boxPtr)
+    boxPtr->intersectBox(NRule.calcBoundBox());
+  if (flatPtr)
+    flatPtr->clear();
+  flatStale=populated;
   objSurfValid=0;
-  return flag;
+
+  // Surface list is only extended if it exists
+  if (populated && !SurList.empty())
+    {
+      // all leaves [including complement groups]
+      std::set<const Geometry::Surface*> NSet;
+      std::stack<const Rule*> TreeLine;
+      TreeLine.push(NRule.getTopRule());
+      while(!TreeLine.empty())
+	{
+	  const Rule* tmpA=TreeLine.top();
+	  TreeLine.pop();
+	  const Rule* tmpB=tmpA->leaf(0);
+	  const Rule* tmpC=tmpA->leaf(1);
+	  if (tmpB) TreeLine.push(tmpB);
+	  if (tmpC && tmpC!=tmpB) TreeLine.push(tmpC);
+	  const SurfPoint* SurX=dynamic_cast<const SurfPoint*>(tmpA);
+	  if (SurX)
+	    {
+	      NSet.insert(SurX->getKey());
+	      SurSet.insert(SurX->getKeyN()*SurX->getSign());
+	    }
+	}
+      std::vector<const Geometry::Surface*> Out;
+      std::set_union(SurList.begin(),SurList.end(),
+		     NSet.begin(),NSet.end(),
+		     std::back_inserter(Out));
+      SurList.swap(Out);
+      for(const Geometry::Surface* SPtr : NSet)
+	{
+	  const int SN(SPtr->getName());
+	  if (SurSet.find(SN)!=SurSet.end() &&
+	      SurSet.find(-SN)!=SurSet.end())
+	    logicOppSurf.insert(SPtr);
+	}
+    }
+  return;
+}
+
+const std::vector<const Geometry::Surface*>&
+Object::getSurList() const
+  /*!
+    Access the surface list
+    \return sorted surfaces of the cell
+  */
+{
+  return SurList;
+}
+
+const Rule*
+Object::topRule() const
+  /*!
+    Return the top rule
+    \return top rule of the cell
+  */
+{
+  return HRule.getTopRule();
+}
+
+const HeadRule&
+Object::getHeadRule() const
+  /*!
+    Access the cell rule
+    \return head rule
+  */
+{
+  return HRule;
+}
+
+void
+Object::setBoundBox()
+  /*!
+    Calculate the bounding box from the rule. Must be 
+    called if the rule or the surfaces of the object change.
+    An unpopulated object has no box.
+  */
+{
+  delete boxPtr;
+  boxPtr=(populated) ? 
+    new Geometry::BoundBox(HRule.calcBoundBox()) : 0;
+  return;
+}
+
+void
+Object::ruleChanged()
+  /*!
+    Update the items that depend on the rule:
+    the box is recalculated and the rule recompiled if 
+    the surfaces are populated.
+  */
+{
+  setBoundBox();
+  flatStale=0;
+  if (populated)
+    {
+      if (!flatPtr) flatPtr=new FlatRule;
+      flatPtr->setRule(HRule.getTopRule());
+    }
+  else if (flatPtr)
+    flatPtr->clear();
+  return;
+}
+
+const FlatRule*
+Object::getFlatRule() const
+  /*!
+    Access the compiled rule
+    \return compiled rule [0 if not compiled/active]
+  */
+{
+  return (flatPtr && flatPtr->isActive()) ? flatPtr : 0;
 }
 
+const Geometry::BoundBox&
+Object::getBoundBox() const
+  /*!
+    Access the bounding box of the object [set by populate].
+    An unpopulated object has an unbounded box.
+    \return Bounding box [conservative]
+  */
+{
+  static const Geometry::BoundBox openBox;
+  return (boxPtr) ? *boxPtr : openBox;
+}
 
 int
 Object::isOnSide(const Geometry::Vec3D& Pt) const
@@ -606,7 +780,8 @@ Object::isValid(const Geometry::Vec3D& Pt) const
   \returns 1 if true and 0 if false
 */
 {
-  return HRule.isValid(Pt);
+  return (flatPtr && flatPtr->isActive()) ? 
+    flatPtr->isValid(Pt) : HRule.isValid(Pt);
 }
 
 int
@@ -620,7 +795,8 @@ Object::isValid(const Geometry::Vec3D& Pt,
   \returns 1 if true and 0 if false
 */
 {
-  return HRule.isValid(Pt,ExSN);
+  return (flatPtr && flatPtr->isActive()) ? 
+    flatPtr->isValid(Pt,ExSN) : HRule.isValid(Pt,ExSN);
 }
 
 int
@@ -634,7 +810,8 @@ Object::isDirectionValid(const Geometry::Vec3D& Pt,
   \returns 1 if true and 0 if false
 */
 {
-  return HRule.isDirectionValid(Pt,ExSN);
+  return (flatPtr && flatPtr->isActive()) ? 
+    flatPtr->isDirectionValid(Pt,ExSN) : HRule.isDirectionValid(Pt,ExSN);
 }
 
 
@@ -698,7 +875,8 @@ Object::pairValid(const int SN,const Geometry::Vec3D& Pt) const
     \retval 3 : valid [SN true/false]
   */
 {
-  return HRule.pairValid(SN,Pt);
+  return (flatPtr && flatPtr->isActive()) ? 
+    flatPtr->pairValid(SN,Pt) : HRule.pairValid(SN,Pt);
 }
 
 int
@@ -840,6 +1018,7 @@ Object::removeSurface(const int SurfN)
   if (cnt>0)
     {
       createSurfaceList();
+      ruleChanged();
       objSurfValid=0;
     }
   return cnt;
@@ -964,6 +1143,47 @@ Object::trackOutCell(const MonteCarlo::neutron& N,double& D,
   return trackCell(N,D,-1,SPtr,startSurf);
 }
 
+int
+Object::trackOutCell(const MonteCarlo::neutron& N,double& D,
+		     const Geometry::Surface*& SPtr,
+		     const int startSurf,
+		     LineIntersectVisit& LI) const
+  /*!
+    Track the distance to exit the cell using a
+    re-usable line visitor [for tracking loops]
+    \param N :: Neutron
+    \param D :: Distance to exit
+    \param SPtr :: Surface at exit
+    \param startSurf :: Start surface [not to be used]
+    \param LI :: Work space visitor
+    \return surface number on exit
+  */
+{
+  return trackCell(N,D,-1,SPtr,startSurf,LI);
+}
+
+int
+Object::trackOutCell(const MonteCarlo::neutron& N,double& D,
+		     const Geometry::Surface*& SPtr,
+		     const int startSurf,
+		     LineIntersectVisit& LI,
+		     SenseTrack& ST) const
+  /*!
+    Track the distance to exit the cell using a
+    re-usable line visitor and the surface senses 
+    along the track [for tracking loops]
+    \param N :: Neutron
+    \param D :: Distance to exit
+    \param SPtr :: Surface at exit
+    \param startSurf :: Start surface [not to be used]
+    \param LI :: Work space visitor
+    \param ST :: Work space surface senses
+    \return surface number on exit
+  */
+{
+  return trackCell(N,D,-1,SPtr,startSurf,LI,ST);
+}
+
 int
 Object::trackIntoCell(const MonteCarlo::neutron& N,double& D,
 		      const Geometry::Surface*& SPtr,
@@ -980,6 +1200,25 @@ Object::trackIntoCell(const MonteCarlo::neutron& N,double& D,
   return trackCell(N,D,1,SPtr,startSurf);
 }
 
+int
+Object::trackIntoCell(const MonteCarlo::neutron& N,double& D,
+		      const Geometry::Surface*& SPtr,
+		      const int startSurf,
+		      LineIntersectVisit& LI) const
+  /*!
+    Track the distance to a cell using a
+    re-usable line visitor [for tracking loops]
+    \param N :: Neutron
+    \param D :: Distance to entrance
+    \param SPtr :: Surface at exit
+    \param startSurf :: Start surface 
+    \param LI :: Work space visitor
+    \return surface number on exit
+  */
+{
+  return trackCell(N,D,1,SPtr,startSurf,LI);
+}
+
 int
 Object::calcInOut(const int pAB,const int N) const
   /*!
@@ -1019,11 +1258,91 @@ Object::trackCell(const MonteCarlo::neutron& N,double& D,
   ELog::RegMethod RegA("Object","trackCell[D,dir]");
 
   MonteCarlo::LineIntersectVisit LI(N);
+  return trackCell(N,D,direction,surfPtr,startSurf,LI);
+}
+
+int
+Object::trackCell(const MonteCarlo::neutron& N,double& D,
+		  const int direction,
+		  const Geometry::Surface*& surfPtr,
+		  const int startSurf,
+		  LineIntersectVisit& LI) const
+  /*!
+    Track to a neutron into/out of a cell. The visitor is
+    reset to the neutron track and its buffers re-used.
+    \param N :: Neutron 
+    \param D :: Distance traveled to the cell [get added too]
+    \param direction :: direction to track [+1/-1 : in/out ] 
+    \param surfPtr :: Surface at exit
+    \param startSurf :: Start surface [to be ignored]
+    \param LI :: Work space visitor
+    \return surface number of intercept
+   */
+{
+  ELog::RegMethod RegA("Object","trackCell[D,dir,LI]");
+
+  LI.reset(N);
   for(const Geometry::Surface* isptr : SurList)
-    {
-      isptr->acceptVisitor(LI);
-    }
+    isptr->acceptVisitor(LI);
+
+  return trackExit(N,D,direction,surfPtr,startSurf,LI,0);
+}
+
+int
+Object::trackCell(const MonteCarlo::neutron& N,double& D,
+		  const int direction,
+		  const Geometry::Surface*& surfPtr,
+		  const int startSurf,
+		  LineIntersectVisit& LI,
+		  SenseTrack& ST) const
+  /*!
+    Track to a neutron into/out of a cell. The validity
+    at each crossing is found from the surface senses at
+    the neutron position [only the crossed surface changes].
+    Falls back to point tests if the rule is not compiled
+    or has object tests.
+    \param N :: Neutron 
+    \param D :: Distance traveled to the cell [get added too]
+    \param direction :: direction to track [+1/-1 : in/out ] 
+    \param surfPtr :: Surface at exit
+    \param startSurf :: Start surface [to be ignored]
+    \param LI :: Work space visitor
+    \param ST :: Work space surface senses
+    \return surface number of intercept
+   */
+{
+  ELog::RegMethod RegA("Object","trackCell[D,dir,LI,ST]");
+
+  LI.reset(N);
+  for(const Geometry::Surface* isptr : SurList)
+    isptr->acceptVisitor(LI);
 
+  const SenseTrack* STPtr=
+    (flatPtr && flatPtr->isActive() && !flatPtr->hasObjects() &&
+     ST.calcPairs(*flatPtr,LI,N.uVec)) ? &ST : 0;
+  return trackExit(N,D,direction,surfPtr,startSurf,LI,STPtr);
+}
+
+int
+Object::trackExit(const MonteCarlo::neutron& N,double& D,
+		  const int direction,
+		  const Geometry::Surface*& surfPtr,
+		  const int startSurf,
+		  const LineIntersectVisit& LI,
+		  const SenseTrack* STPtr) const
+  /*!
+    Find the crossing that the neutron leaves/enters the
+    cell by from the intercepts in the visitor
+    \param N :: Neutron 
+    \param D :: Distance traveled to the cell [get added too]
+    \param direction :: direction to track [+1/-1 : in/out ] 
+    \param surfPtr :: Surface at exit
+    \param startSurf :: Start surface [to be ignored]
+    \param LI :: Visitor with the cell intercepts
+    \param STPtr :: Surface senses of intercepts [0 : test points]
+    \return surface number of intercept
+   */
+{
   const std::vector<Geometry::Vec3D>& IPts(LI.getPoints());
   const std::vector<double>& dPts(LI.getDistance());
   const std::vector<const Geometry::Surface*>& surfIndex(LI.getSurfIndex());
@@ -1041,8 +1360,10 @@ Object::trackCell(const MonteCarlo::neutron& N,double& D,
 	   (dPts[i]>0.0 && dPts[i]<D) )
 	{
 	  const int NS=surfIndex[i]->getName();	    // NOT SIGNED
-	  const int pAB=isDirectionValid(IPts[i],NS);
-	  const int mAB=isDirectionValid(IPts[i],-NS);
+	  const int pAB=(STPtr) ? (STPtr->getPair(i)>>1) :
+	    isDirectionValid(IPts[i],NS);
+	  const int mAB=(STPtr) ? (STPtr->getPair(i) & 1) :
+	    isDirectionValid(IPts[i],-NS);
 	  const int normD=surfIndex[i]->sideDirection(IPts[i],N.uVec);
 
 	  if (direction<0)
@@ -1134,6 +1455,7 @@ Object::makeComplement()
    */
 {
   HRule.makeComplement();
+  ruleChanged();
   return;
 }
 
@@ -1246,7 +1568,9 @@ Object::writeFLUKAmat(std::ostream& OX) const
     ModelSupport::objectRegister::Instance();
   if (!placehold)
     {
-      std::string objName=OR.inRenumberRange(ObjName);
+      // own context : called from the format threads
+      ModelSupport::QueryContext QC;
+      std::string objName=OR.inRenumberRange(ObjName,QC);
       if (objName.empty())
 	objName="global";
       std::ostringstream cx;
@@ -1277,7 +1601,9 @@ Object::writeFLUKA(std::ostream& OX) const
     ModelSupport::objectRegister::Instance();
   if (!placehold)
     {
-      std::string objName=OR.inRenumberRange(ObjName);
+      // own context : called from the format threads
+      ModelSupport::QueryContext QC;
+      std::string objName=OR.inRenumberRange(ObjName,QC);
       if (objName.empty())
 	objName="global";
       std::ostringstream cx;
@@ -1366,7 +1692,50 @@ Object::checkPointers() const
   return;
 }
 
+void
+Object::writeBinary(std::ostream& OX) const
+  /*!
+    Write the object to a binary stream
+    \param OX :: Output stream
+  */
+{
+  StrFunc::writeBin(OX,ObjName);
+  StrFunc::writeBin(OX,listNum);
+  StrFunc::writeBin(OX,Tmp);
+  StrFunc::writeBin(OX,MatN);
+  StrFunc::writeBin(OX,fill);
+  StrFunc::writeBin(OX,trcl);
+  StrFunc::writeBin(OX,universe);
+  StrFunc::writeBin(OX,imp);
+  StrFunc::writeBin(OX,density);
+  StrFunc::writeBin(OX,placehold);
+  HRule.writeBinary(OX);
+  return;
+}
 
+void
+Object::readBinary(std::istream& IX)
+  /*!
+    Read the object from a binary stream.
+    The surfaces are left unpopulated.
+    \param IX :: Input stream
+  */
+{
+  StrFunc::readBin(IX,ObjName);
+  StrFunc::readBin(IX,listNum);
+  StrFunc::readBin(IX,Tmp);
+  StrFunc::readBin(IX,MatN);
+  StrFunc::readBin(IX,fill);
+  StrFunc::readBin(IX,trcl);
+  StrFunc::readBin(IX,universe);
+  StrFunc::readBin(IX,imp);
+  StrFunc::readBin(IX,density);
+  StrFunc::readBin(IX,placehold);
+  HRule.readBinary(IX);
+  populated=0;
+  ruleChanged();
+  return;
+}
 
 } // NAMESPACE MonteCarlo
 
@@ -52,9 +52,13 @@
 #include "OutputLog.h"
 #include "Transform.h"
 #include "Surface.h"
+#include "Quadratic.h"
+#include "Plane.h"
+#include "BoundBox.h"
 #include "Rules.h"
 #include "HeadRule.h"
 #include "Object.h"
+#include "FlatRule.h"
 #include "SurfVertex.h"
 #include "Line.h"
 #include "SurInter.h"
@@ -63,6 +67,8 @@
 namespace MonteCarlo
 {
 
+const double Qhull::boxPad(1e-3);
+
 Qhull::Qhull() : Object()
   /*!
     Default Constructor
@@ -127,57 +133,147 @@ int
 Qhull::calcIntersections()
   /*! 
     Loops over all the surfaces and calculates the appropiate
-    intersection
+    intersection. Planes and plane-pair lines that miss the 
+    cell bounding box are skipped and the plane-pair lines are 
+    calculated once. The vertex list is the same (and in the 
+    same order) as the full search over all triples.
     \return number of items intersection points.
   */
 {
   ELog::RegMethod RegA("Qhull","calcIntersections");
 
   VList.clear();                       // clear list of Vertex
-  std::vector<const Geometry::Surface*>::const_iterator ic,jc,kc;
+  const size_t NS(SurList.size());
+
+  Geometry::BoundBox BBox(getBoundBox());
+  BBox.pad(boxPad);
+
+  // Planes [0 if not a plane] : surfaces that can reach the box
+  std::vector<const Geometry::Plane*> PList(NS,0);
+  std::vector<int> active(NS,1);
+  for(size_t i=0;i<NS;i++)
+    {
+      PList[i]=dynamic_cast<const Geometry::Plane*>(SurList[i]);
+      if (PList[i] && 
+	  !BBox.cutPlane(PList[i]->getNormal(),PList[i]->getDistance()))
+	active[i]=0;
+    }
+
+  // Lines of plane pairs that pass through the box [i*NS+j]
+  std::vector<Geometry::Line> LList(NS*NS);
+  std::vector<int> LFlag(NS*NS,0);
+  for(size_t i=0;i<NS;i++)
+    if (active[i] && PList[i])
+      for(size_t j=i+1;j<NS;j++)
+	if (active[j] && PList[j])
+	  {
+	    Geometry::Line& Lx=LList[i*NS+j];
+	    if (Lx.setLine(*PList[i],*PList[j]) &&
+		BBox.cutLine(Lx.getOrigin(),Lx.getDirect()))
+	      LFlag[i*NS+j]=1;
+	  }
+
+  // Compiled rule allows exclusion by table index
+  const FlatRule* FR=getFlatRule();
+  if (FR && FR->hasObjects()) FR=0;
+  for(size_t i=0;FR && i<NS;i++)
+    if (FR->findIndex(SurList[i]->getName())<0)
+      FR=0;
+
   int cnt(0);
-  for(ic=SurList.begin();ic!=SurList.end();ic++)
-    for(jc=ic+1;jc!=SurList.end();jc++)
-      for(kc=jc+1;kc!=SurList.end();kc++)
-        {
-	  // This adds intersections to the VList
-	  cnt+=getIntersect(*ic,*jc,*kc);
+  std::vector<Geometry::Vec3D> PntOut;
+  std::vector<long int> ExIndex(3);
+  for(size_t i=0;i<NS;i++)
+    {
+      if (!active[i]) continue;
+      for(size_t j=i+1;j<NS;j++)
+	{
+	  if (!active[j] || (PList[i] && PList[j] && !LFlag[i*NS+j]))
+	    continue;
+	  for(size_t k=j+1;k<NS;k++)
+	    {
+	      if (!active[k]) continue;
+	      // first two planes give the line : this is the line that
+	      // SurInter::makePoint(P,P,P) and processPoint(P,P,Q) set,
+	      // so the points are the same to the last bit
+	      size_t PIndex[3];
+	      size_t nPlane(0);
+	      size_t nonPlane(0);
+	      for(const size_t index : {i,j,k})
+		{
+		  if (PList[index])
+		    PIndex[nPlane++]=index;
+		  else
+		    nonPlane=index;
+		}
+	      PntOut.clear();
+	      if (nPlane>=2)
+		{
+		  const size_t LI(PIndex[0]*NS+PIndex[1]);
+		  if (!LFlag[LI]) continue;
+		  const Geometry::Quadratic* QPtr=
+		    dynamic_cast<const Geometry::Quadratic*>(SurList[nonPlane]);
+		  if (nPlane==3)
+		    LList[LI].intersect(PntOut,*PList[k]);
+		  else if (QPtr)
+		    LList[LI].intersect(PntOut,*QPtr);
+		  else
+		    PntOut=SurInter::processPoint(SurList[i],SurList[j],
+						  SurList[k]);
+		}
+	      else
+		PntOut=SurInter::processPoint(SurList[i],SurList[j],SurList[k]);
+
+	      if (!PntOut.empty())
+		cnt+=addVertex(SurList[i],SurList[j],SurList[k],
+			       PntOut,BBox,FR,ExIndex);
+	    }
 	}
+    }
   // return number of item found
   return cnt;
 }
 
 int
-Qhull::getIntersect(const Geometry::Surface* SurfX,
-		    const Geometry::Surface* SurfY,
-		    const Geometry::Surface* SurfZ)
+Qhull::addVertex(const Geometry::Surface* SurfX,
+		 const Geometry::Surface* SurfY,
+		 const Geometry::Surface* SurfZ,
+		 const std::vector<Geometry::Vec3D>& PntOut,
+		 const Geometry::BoundBox& BBox,
+		 const FlatRule* FR,
+		 std::vector<long int>& ExIndex)
   /*!
-    Calculates the intersection between three surfaces.
-    Adds the point to the vertex list if the point is valid 
-    and is on a side.
-    
+    Add the points of a surface triple to the vertex list 
+    if they are valid. The three surfaces are excluded from
+    the test.
     \param SurfX :: Surface pointer
     \param SurfY :: Surface pointer
     \param SurfZ :: Surface pointer
-    \returns Number intersections found
+    \param PntOut :: Intersection points of the surfaces
+    \param BBox :: Padded cell box 
+    \param FR :: Compiled rule [0 to use the rule tree]
+    \param ExIndex :: Work space for the excluded indexes [size 3]
+    \returns Number points added
   */
 {
-  ELog::RegMethod RegA("Qhull","getIntersect");
-
   const int AS=SurfX->getName();
   const int BS=SurfY->getName();
   const int CS=SurfZ->getName();
-
-  std::vector<Geometry::Vec3D> PntOut=
-    SurInter::processPoint(SurfX,SurfY,SurfZ);
+  if (FR)
+    {
+      ExIndex[0]=FR->findIndex(AS);
+      ExIndex[1]=FR->findIndex(BS);
+      ExIndex[2]=FR->findIndex(CS);
+    }
 
   int Ncnt(0);
-  std::set<int> ExSN={AS,BS,CS};
-	
   for(const Geometry::Vec3D& VC : PntOut)
     {
-      if (isValid(VC,ExSN) &&         // Is point in/on the object
-	  VC.abs()<1e8)          // Tracked onto the very large points
+      if (VC.abs()>=1e8 || !BBox.isValid(VC))
+	continue;
+      const bool validFlag=(FR) ? FR->isValid(VC,ExIndex) :
+	isValid(VC,std::set<int>({AS,BS,CS}));
+      if (validFlag)
 	{
 	  SurfVertex tmp;
 	  tmp.addSurface(const_cast<Geometry::Surface*>(SurfX));
@@ -453,6 +549,7 @@ Qhull::displace(const Geometry::Vec3D& DVec)
     \param DVec :: displacement
   */
 {
+  Object::displace(DVec);
   for(SurfVertex& vc :  VList)
     vc.displace(DVec);
   return;
@@ -466,6 +563,7 @@ Qhull::rotate(const Geometry::Matrix<double>& MRot)
     \param MRot :: rotation matrix
   */
 {
+  Object::rotate(MRot);
   for(SurfVertex& vc :  VList)
     vc.rotate(MRot);
   return;
@@ -479,6 +577,7 @@ Qhull::mirror(const Geometry::Plane& PObj)
     \param PObj :: Plane to mirror around
   */
 {
+  Object::mirror(PObj);
   for(SurfVertex& vc :  VList)
     vc.mirror(PObj);
   return;
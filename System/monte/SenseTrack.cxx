@@ -0,0 +1,212 @@
+/********************************************************************* 
+  CombLayer : MCNP(X) Input builder
+ 
+ * File:   monte/SenseTrack.cxx
+ *
+ * Copyright (c) 2004-2016 by Stuart Ansell
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>. 
+ *
+ ****************************************************************************/
+#include <fstream>
+#include <iomanip>
+#include <iostream>
+#include <sstream>
+#include <cmath>
+#include <complex>
+#include <string>
+#include <vector>
+#include <set>
+#include <map>
+#include <algorithm>
+
+#include "Exception.h"
+#include "FileReport.h"
+#include "NameStack.h"
+#include "RegMethod.h"
+#include "GTKreport.h"
+#include "OutputLog.h"
+#include "BaseVisit.h"
+#include "BaseModVisit.h"
+#include "MatrixBase.h"
+#include "Matrix.h"
+#include "Vec3D.h"
+#include "Surface.h"
+#include "Quadratic.h"
+#include "Plane.h"
+#include "Line.h"
+#include "LineIntersectVisit.h"
+#include "FlatRule.h"
+#include "SenseTrack.h"
+
+namespace MonteCarlo
+{
+
+const size_t SenseTrack::bufferSize(16);
+
+SenseTrack::SenseTrack()
+  /*!
+    Constructor
+  */
+{
+  Sense.reserve(bufferSize);
+  Order.reserve(bufferSize);
+  CrossIndex.reserve(bufferSize);
+  GroupSense.reserve(bufferSize);
+  PairFlag.reserve(bufferSize);
+}
+
+SenseTrack::SenseTrack(const SenseTrack& A) : 
+  Sense(A.Sense),Order(A.Order),CrossIndex(A.CrossIndex),
+  GroupSense(A.GroupSense),PairFlag(A.PairFlag)
+  /*!
+    Copy constructor
+    \param A :: SenseTrack to copy
+  */
+{}
+
+SenseTrack&
+SenseTrack::operator=(const SenseTrack& A)
+  /*!
+    Assignment operator
+    \param A :: SenseTrack to copy
+    \return *this
+  */
+{
+  if (this!=&A)
+    {
+      Sense=A.Sense;
+      Order=A.Order;
+      CrossIndex=A.CrossIndex;
+      GroupSense=A.GroupSense;
+      PairFlag=A.PairFlag;
+    }
+  return *this;
+}
+
+void
+SenseTrack::sortOrder(const std::vector<double>& dPts)
+  /*!
+    Set Order to the crossings in increasing distance.
+    Insertion sort [lists are short] to keep the buffer.
+    Non-finite distances [e.g. a line along a cylinder axis]
+    are not crossings and are left out.
+    \param dPts :: Distances of the crossings
+  */
+{
+  Order.clear();
+  for(size_t i=0;i<dPts.size();i++)
+    if (std::isfinite(dPts[i]))
+      {
+	size_t j(Order.size());
+	Order.push_back(i);
+	for(;j>0 && dPts[Order[j-1]]>dPts[i];j--)
+	  Order[j]=Order[j-1];
+	Order[j]=i;
+      }
+  return;
+}
+
+bool
+SenseTrack::isTangent(const Geometry::Surface& Surf,
+		      const Geometry::Vec3D& Pt,
+		      const Geometry::Vec3D& uVec)
+  /*!
+    Determine if the track touches a curved surface at a 
+    tangent. The intersection is then the double root of 
+    the quadratic and the surface is not crossed.
+    \param Surf :: Surface 
+    \param Pt :: Intersection point
+    \param uVec :: Track direction
+    \return true if the direction is in the tangent plane
+  */
+{
+  if (dynamic_cast<const Geometry::Plane*>(&Surf))
+    return 0;
+  return (std::abs(Surf.surfaceNormal(Pt).dotProd(uVec))<=
+	  Geometry::zeroTol);
+}
+
+int
+SenseTrack::calcPairs(const FlatRule& FR,
+		      const LineIntersectVisit& LI,
+		      const Geometry::Vec3D& uVec)
+  /*!
+    Calculate the pair validity of each crossing in the
+    visitor. Only the surfaces at the track origin are 
+    tested geometrically.
+    \param FR :: Compiled rule of the cell [no object tests]
+    \param LI :: Line visitor holding the crossings of the cell
+    \param uVec :: Track direction
+    \return 1 on success / 0 if a crossing surface is not in the rule
+  */
+{
+  const std::vector<Geometry::Vec3D>& IPts(LI.getPoints());
+  const std::vector<double>& dPts(LI.getDistance());
+  const std::vector<const Geometry::Surface*>& SIndex(LI.getSurfIndex());
+
+  CrossIndex.resize(dPts.size());
+  for(size_t i=0;i<dPts.size();i++)
+    {
+      CrossIndex[i]=FR.findIndex(SIndex[i]->getName());
+      if (CrossIndex[i]<0) return 0;
+    }
+  FR.fillSense(LI.getTrack().getOrigin(),Sense);
+  sortOrder(dPts);
+  PairFlag.assign(dPts.size(),0);
+  GroupSense.resize(dPts.size());
+
+  const size_t NC(Order.size());
+
+  // crossings behind the origin are already in the senses
+  size_t a(0);
+  while(a<NC && dPts[Order[a]]< -Geometry::zeroTol)
+    a++;
+
+  while(a<NC)
+    {
+      // common point : all surfaces on-surface
+      const bool atOrigin(dPts[Order[a]]<=Geometry::zeroTol);
+      size_t b(a+1);
+      while(b<NC && dPts[Order[b]]-dPts[Order[a]]<=Geometry::zeroTol)
+	b++;
+      for(size_t k=a;k<b;k++)
+	{
+	  const size_t SI(static_cast<size_t>(CrossIndex[Order[k]]));
+	  GroupSense[k]=Sense[SI];
+	  Sense[SI]=0;
+	}
+      for(size_t k=a;k<b;k++)
+	PairFlag[Order[k]]=FR.pairValid(CrossIndex[Order[k]],Sense);
+
+      // restore [reverse so repeated surfaces get the first value]
+      for(size_t k=b;k>a;k--)
+	Sense[static_cast<size_t>(CrossIndex[Order[k-1]])]=GroupSense[k-1];
+      // step over the point : crossed surfaces change sign.
+      // At the origin the side() value is not reliable 
+      // [e.g. sphere has no on-surface value] so use the direction
+      for(size_t k=a;k<b;k++)
+	{
+	  const size_t i(Order[k]);
+	  int& SV(Sense[static_cast<size_t>(CrossIndex[i])]);
+	  if (SV && isTangent(*SIndex[i],IPts[i],uVec))
+	    continue;
+	  SV=(SV && !atOrigin) ? -SV : SIndex[i]->sideDirection(IPts[i],uVec);
+	}
+      a=b;
+    }
+  return 1;
+}
+
+}  // NAMESPACE MonteCarlo
@@ -42,6 +42,7 @@
 #include "support.h"
 #include "IsoTable.h"
 #include "Element.h"
+#include "binaryIO.h"
 #include "Zaid.h"
 
 std::ostream&
@@ -194,3 +195,30 @@ Zaid::getAtomicMass() const
   return ET.mass(getZ());
 }    
 
+void
+Zaid::writeBinary(std::ostream& OX) const
+  /*!
+    Write the zaid to a binary stream 
+    \param OX :: Output stream
+  */
+{
+  StrFunc::writeBin(OX,index);
+  StrFunc::writeBin(OX,tag);
+  StrFunc::writeBin(OX,type);
+  StrFunc::writeBin(OX,density);
+  return;
+}
+
+void
+Zaid::readBinary(std::istream& IX)
+  /*!
+    Read the zaid from a binary stream [writeBinary]
+    \param IX :: Input stream
+  */
+{
+  StrFunc::readBin(IX,index);
+  StrFunc::readBin(IX,tag);
+  StrFunc::readBin(IX,type);
+  StrFunc::readBin(IX,density);
+  return;
+}
@@ -0,0 +1,116 @@
+/********************************************************************* 
+  CombLayer : MCNP(X) Input builder
+ 
+ * File:   monteInc/FlatRule.h
+ *
+ * Copyright (c) 2004-2016 by Stuart Ansell
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>. 
+ *
+ ****************************************************************************/
+#ifndef MonteCarlo_FlatRule_h
+#define MonteCarlo_FlatRule_h
+
+class Rule;
+
+namespace Geometry
+{
+  class Surface;
+}
+
+namespace MonteCarlo
+{
+  class Object;
+
+/*!
+  \class FlatRule
+  \version 1.0
+  \author S. Ansell
+  \date May 2016
+  \brief Compiled form of a rule for fast point tests
+
+  The rule tree is flattened into a contiguous list 
+  of leaf tests. Each test holds the next test to jump
+  to on true/false, so intersections/unions short-circuit
+  and complements just swap the targets. Surfaces are
+  held in a dense table of unique surfaces.
+  Must be rebuilt if the rule or the surface pointers change.
+*/
+
+class FlatRule
+{
+ private:
+
+  static const long int trueExit=-2;    ///< Exit flag on true
+  static const long int falseExit=-1;   ///< Exit flag on false
+
+  /// Single leaf test
+  struct Item
+  {
+    int type;          ///< 0 : surface / 1 : object / -1 : comp object
+    size_t index;      ///< Index into SurfTable/ObjTable
+    int sign;          ///< Sign of surface
+    long int onTrue;   ///< Next item if true
+    long int onFalse;  ///< Next item if false
+  };
+
+  int active;             ///< Compiled rule is valid
+  long int startIndex;    ///< First item [or exit flag]
+
+  std::vector<const Geometry::Surface*> SurfTable;  ///< Unique surfaces
+  std::vector<int> SurfNum;                         ///< Surface numbers
+  std::vector<const Object*> ObjTable;              ///< Object pointers
+  std::vector<Item> Code;                           ///< Leaf tests
+
+  static bool isCompilable(const Rule*);
+  size_t surfIndex(const Geometry::Surface*,const int);
+  long int compile(const Rule*,const long int,const long int);
+  bool evaluate(const Geometry::Vec3D&,const int,const int) const;
+  bool evaluate(const std::vector<int>&,const long int,const int) const;
+
+ public:
+
+  FlatRule();
+  FlatRule(const FlatRule&);
+  FlatRule& operator=(const FlatRule&);
+  ~FlatRule() {}      ///< Destructor
+
+  /// Is the rule compiled
+  int isActive() const { return active; }
+  /// Number of leaf tests
+  size_t size() const { return Code.size(); }
+  /// Number of unique surfaces
+  size_t nSurface() const { return SurfTable.size(); }
+  /// Does the rule hold object tests
+  bool hasObjects() const { return !ObjTable.empty(); }
+  long int findIndex(const int) const;
+
+  void clear();
+  int setRule(const Rule*);
+
+  bool isValid(const Geometry::Vec3D&) const;
+  bool isValid(const Geometry::Vec3D&,const int) const;
+  bool isValid(const Geometry::Vec3D&,const std::vector<long int>&) const;
+  bool isDirectionValid(const Geometry::Vec3D&,const int) const;
+  int pairValid(const int,const Geometry::Vec3D&) const;
+
+  void fillSense(const Geometry::Vec3D&,std::vector<int>&) const;
+  int pairValid(const long int,const std::vector<int>&) const;
+
+  void write(std::ostream&) const;
+};
+
+}
+
+#endif
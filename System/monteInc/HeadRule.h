@@ -30,6 +30,7 @@ class SurfPoint;
 namespace Geometry
 {
   class Surface;
+  class BoundBox;
 }
 
 
@@ -53,6 +54,13 @@ class HeadRule
   void removeItem(const Rule*);
   static int procPair(std::string&,std::map<int,Rule*>&,int&);
   static CompGrp* procComp(Rule*);
+  static Geometry::BoundBox calcSurfBox(const Geometry::Surface*,const int);
+  static Geometry::BoundBox calcRuleBox(const Rule*);
+  static bool boxRange(const Geometry::BoundBox&,const Geometry::Vec3D&,
+		       const Geometry::Vec3D&,double&,double&);
+  static void tightenBox(Geometry::BoundBox&,const Geometry::Surface*,
+			 const int);
+  static void reverseIntersections(Rule*);
 
   void createAddition(const int,const Rule*);
   const SurfPoint* findSurf(const int) const;
@@ -109,6 +117,7 @@ class HeadRule
   bool partMatched(const HeadRule&) const;
 
   std::set<int> getSurfSet() const;
+  Geometry::BoundBox calcBoundBox() const;
 
   int removeItems(const int);
   int removeUnsignedItems(const int);
@@ -127,6 +136,9 @@ class HeadRule
   void addIntersection(const std::string&);
   void addUnion(const std::string&);
   void addIntersection(const HeadRule&);
+  void frontIntersection(const HeadRule&);
+  void backIntersection(const HeadRule&);
+  void reverseRule();
   void addUnion(const HeadRule&);
   void addIntersection(const Rule*);
   void addUnion(const Rule*);
@@ -143,6 +155,9 @@ class HeadRule
   void displayVec(std::vector<Token>&) const;  
 
   std::string displayFluka() const;
+
+  void writeBinary(std::ostream&) const;
+  void readBinary(std::istream&);
 };  
 
 std::ostream&
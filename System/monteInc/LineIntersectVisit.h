@@ -41,6 +41,8 @@ class LineIntersectVisit : public Global::BaseVisit
   {
   private:
 
+    static const size_t bufferSize;       ///< Initial point reserve
+
     Geometry::Line ATrack;                ///< Line 
     std::vector<Geometry::Vec3D> PtOut;   ///< Output point 
     std::vector<double> DOut;             ///< Output distances
@@ -105,6 +107,7 @@ class LineIntersectVisit : public Global::BaseVisit
     // Re-set the line
     void setLine(const Geometry::Vec3D&,const Geometry::Vec3D&);
     void setLine(const neutron&);
+    void reset(const neutron&);
 
     // Accessors:
     double getDist(const Geometry::Surface*);
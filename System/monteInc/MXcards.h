@@ -62,6 +62,8 @@ class MXcards
 
 
   void write(std::ostream&) const;               
+  void writeBinary(std::ostream&) const;
+  void readBinary(std::istream&);
   
 };
 
@@ -114,6 +114,8 @@ class Material
   void write(std::ostream&) const;               
   void writeCinder(std::ostream&) const;
   void writeFLUKA(std::ostream&) const;               
+  void writeBinary(std::ostream&) const;
+  void readBinary(std::istream&);
   
 };
 
@@ -24,9 +24,17 @@
 
 class Token;
 
+namespace Geometry
+{
+  class BoundBox;
+}
+
 namespace MonteCarlo
 {
   class neutron;
+  class FlatRule;
+  class LineIntersectVisit;
+  class SenseTrack;
 
 /*!
   \class Object
@@ -54,8 +62,11 @@ class Object
   double density;    ///< Density
   int placehold;     ///< Is cell virtual (ie not in output)
   int populated;     ///< Full population
+  int flatStale;     ///< Rule extended since last compile
 
   HeadRule HRule;    ///< Top rule
+  Geometry::BoundBox* boxPtr;   ///< Bounding box [0 if not populated]
+  FlatRule* flatPtr;     ///< Compiled rule [0 if not compiled]
   /// Set of surfaces that are logically opposite in the rule.
   std::set<const Geometry::Surface*> logicOppSurf;
  
@@ -64,6 +75,12 @@ class Object
   int checkExteriorValid(const Geometry::Vec3D&,const Geometry::Vec3D&) const;
   /// Calc in/out 
   int calcInOut(const int,const int) const;
+  void ruleChanged();
+  void setBoundBox();
+  int trackExit(const MonteCarlo::neutron&,double&,
+		const int,const Geometry::Surface*&,
+		const int,const LineIntersectVisit&,
+		const SenseTrack*) const;
 
  protected:
   
@@ -112,6 +129,7 @@ class Object
   int complementaryObject(const int,std::string&);
   int hasComplement() const;                           
   int isPopulated() const { return populated; }        ///< Is populated   
+  const Geometry::BoundBox& getBoundBox() const;
   
   int getName() const  { return ObjName; }             ///< Get Name
   int getCreate() const  { return listNum; }           ///< Get Creation point
@@ -120,10 +138,9 @@ class Object
   double getDensity() const { return density; }        ///< Get Density [Atom/A^3]
   int getImp() const { return imp; }                   ///< Get importance
 
-  /// Return the top rule
-  const Rule* topRule() const { return HRule.getTopRule(); }
-  /// get head rule 
-  const HeadRule& getHeadRule() const { return HRule; }
+  const Rule* topRule() const;
+  const HeadRule& getHeadRule() const;
+  const FlatRule* getFlatRule() const;
   
   int populate();
   int createSurfaceList();
@@ -131,6 +148,7 @@ class Object
   int isObjSurfValid() const { return objSurfValid; }  ///< Check validity needed
   void setObjSurfValid()  { objSurfValid=1; }          ///< set as valid
   int addSurfString(const std::string&);   
+  void addIntersection(const HeadRule&);
   int removeSurface(const int);        
   int compositeSurf(const int,Rule*);
   int substituteSurf(const int,const int,Geometry::Surface*);  
@@ -152,14 +170,14 @@ class Object
   const std::set<int>& getSurfSet() const { return SurSet; }
 
   std::vector<int> getSurfaceIndex() const;
-  const std::vector<const Geometry::Surface*>& getSurList() const
-    { return SurList; }
+  const std::vector<const Geometry::Surface*>& getSurList() const;
   
-  ///\cond ABSTRACT
-  virtual void displace(const Geometry::Vec3D&) {}
-  virtual void rotate(const Geometry::Matrix<double>&) {}
-  virtual void mirror(const Geometry::Plane&) {}
-  ///\endcond ABSTRACT
+  /// Displacement [of the surfaces] : recalculate the box
+  virtual void displace(const Geometry::Vec3D&) { setBoundBox(); }
+  /// Rotation [of the surfaces] : recalculate the box
+  virtual void rotate(const Geometry::Matrix<double>&) { setBoundBox(); }
+  /// Mirror [of the surfaces] : recalculate the box
+  virtual void mirror(const Geometry::Plane&) { setBoundBox(); }
 
   // INTERSECTION
   int hasIntercept(const Geometry::Vec3D&,const Geometry::Vec3D&) const;
@@ -174,6 +192,12 @@ class Object
   int trackCell(const MonteCarlo::neutron&,double&,
 		const int,const Geometry::Surface*&,
 		const int) const;
+  int trackCell(const MonteCarlo::neutron&,double&,
+		const int,const Geometry::Surface*&,
+		const int,LineIntersectVisit&) const;
+  int trackCell(const MonteCarlo::neutron&,double&,
+		const int,const Geometry::Surface*&,
+		const int,LineIntersectVisit&,SenseTrack&) const;
   int trackCellX(const MonteCarlo::neutron&,double&,
 		const int,const Geometry::Surface*&,
 		const int) const;
@@ -181,6 +205,15 @@ class Object
 		    const Geometry::Surface*&,const int =0) const;
   int trackOutCell(const MonteCarlo::neutron&,double&,
 		   const Geometry::Surface*&,const int =0) const;
+  int trackIntoCell(const MonteCarlo::neutron&,double&,
+		    const Geometry::Surface*&,const int,
+		    LineIntersectVisit&) const;
+  int trackOutCell(const MonteCarlo::neutron&,double&,
+		   const Geometry::Surface*&,const int,
+		   LineIntersectVisit&) const;
+  int trackOutCell(const MonteCarlo::neutron&,double&,
+		   const Geometry::Surface*&,const int,
+		   LineIntersectVisit&,SenseTrack&) const;
 
   // OUTPUT
   std::string cellCompStr() const;
@@ -193,6 +226,9 @@ class Object
   void writeFLUKA(std::ostream&) const;    
   void writeFLUKAmat(std::ostream&) const;    
 
+  void writeBinary(std::ostream&) const;
+  void readBinary(std::istream&);
+
   void checkPointers() const;
 
 };
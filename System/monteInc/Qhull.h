@@ -25,6 +25,7 @@
 namespace Geometry
 {
   class Surface;
+  class BoundBox;
 }
 
 namespace MonteCarlo
@@ -46,11 +47,15 @@ class Qhull : public Object
 {
  private:
   
+  static const double boxPad;         ///< Extra padding of cell box
+
   std::vector<SurfVertex> VList;      ///< Full Vertex list
   Geometry::Vec3D CofM;               ///< Effective centre of mass
 
-  int getIntersect(const Geometry::Surface*,const Geometry::Surface*,
-		   const Geometry::Surface*);
+  int addVertex(const Geometry::Surface*,const Geometry::Surface*,
+		const Geometry::Surface*,const std::vector<Geometry::Vec3D>&,
+		const Geometry::BoundBox&,const FlatRule*,
+		std::vector<long int>&);
 
   void calcCentreOfMass();
 
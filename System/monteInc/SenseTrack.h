@@ -0,0 +1,86 @@
+/********************************************************************* 
+  CombLayer : MCNP(X) Input builder
+ 
+ * File:   monteInc/SenseTrack.h
+ *
+ * Copyright (c) 2004-2016 by Stuart Ansell
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>. 
+ *
+ ****************************************************************************/
+#ifndef MonteCarlo_SenseTrack_h
+#define MonteCarlo_SenseTrack_h
+
+namespace Geometry
+{
+  class Vec3D;
+  class Surface;
+}
+
+namespace MonteCarlo
+{
+  class FlatRule;
+  class LineIntersectVisit;
+
+/*!
+  \class SenseTrack
+  \version 1.0
+  \author S. Ansell
+  \date May 2016
+  \brief Surface senses along a track through a cell
+
+  Holds the side of each surface of a compiled rule at 
+  the track origin. The crossings of the line visitor are 
+  walked in distance order and only the crossed surface 
+  changes sign, so the pair validity of every crossing is
+  found from the stored senses without geometric side tests.
+  Crossings closer than zeroTol are treated as a common point
+  with all their surfaces on-surface [as side() would].
+  A single root at a tangent keeps its sense.
+  The buffers are kept between tracks.
+*/
+
+class SenseTrack
+{
+ private:
+
+  static const size_t bufferSize;    ///< Initial reserve
+
+  std::vector<int> Sense;            ///< Sense of each rule surface
+  std::vector<size_t> Order;         ///< Crossings in distance order
+  std::vector<long int> CrossIndex;  ///< Rule table index of crossing
+  std::vector<int> GroupSense;       ///< Saved sense of common point
+  std::vector<int> PairFlag;         ///< pairValid of each crossing
+
+  void sortOrder(const std::vector<double>&);
+  static bool isTangent(const Geometry::Surface&,const Geometry::Vec3D&,
+			const Geometry::Vec3D&);
+
+ public:
+
+  SenseTrack();
+  SenseTrack(const SenseTrack&);
+  SenseTrack& operator=(const SenseTrack&);
+  ~SenseTrack() {}     ///< Destructor
+
+  int calcPairs(const FlatRule&,const LineIntersectVisit&,
+		const Geometry::Vec3D&);
+  /// Access pair valid [bit 1 : false valid / bit 2 : true valid]
+  int getPair(const size_t Index) const { return PairFlag[Index]; }
+  
+};
+
+}
+
+#endif
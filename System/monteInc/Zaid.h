@@ -69,6 +69,8 @@ class Zaid
   double getAtomicMass() const;
 
   void write(std::ostream&) const;
+  void writeBinary(std::ostream&) const;
+  void readBinary(std::istream&);
 
 };
 
@@ -42,6 +42,7 @@
 #include "RegMethod.h"
 #include "OutputLog.h"
 #include "support.h"
+#include "blockWrite.h"
 #include "MapRange.h"
 #include "Triple.h"
 #include "SrcData.h"
@@ -979,15 +980,28 @@ PhysicsCards::writeHelp(const std::string& keyName) const
 }
   
    
+void
+PhysicsCards::writeRND(std::ostream& OX) const
+  /*!
+    Write out the random number card alone
+    \param OX :: Output stream
+  */
+{
+  RAND->write(OX);
+  return;
+}
+
 void 
 PhysicsCards::write(std::ostream& OX,
 		    const std::vector<int>& cellOutOrder,
-		    const std::set<int>& voidCells) const 
+		    const std::set<int>& voidCells,
+		    const size_t nThread) const 
   /*!
     Write out each of the cards
     \param OX :: Output stream
     \param cellOutOrder :: Cell List
     \param voidCell :: List of void cells
+    \param nThread :: Threads for the vol/imp cards [1 : serial]
     \todo Check that histp does not need a line cut.
   */
 {
@@ -1012,9 +1026,16 @@ PhysicsCards::write(std::ostream& OX,
   PTRAC->write(OX);
   
   mode.write(OX);
-  Volume.write(OX,cellOutOrder);
-   for(const PhysImp& PI : ImpCards)
-    PI.write(OX,cellOutOrder);  
+  // vol + imp cards : one item per card
+  StrFunc::writeBlocks
+    (OX,nThread,ImpCards.size()+1,1,
+     [&](const size_t index,std::ostream& OS)
+     {
+       if (!index)
+	 Volume.write(OS,cellOutOrder);
+       else
+	 ImpCards[index-1].write(OS,cellOutOrder);
+     });
 
    PWTCard->write(OX,cellOutOrder,voidCells);
 
@@ -160,8 +160,9 @@ class PhysicsCards
 
   void writeHelp(const std::string&) const;
   
+  void writeRND(std::ostream&) const;
   void write(std::ostream&,const std::vector<int>&,
-	     const std::set<int>&) const;   
+	     const std::set<int>&,const size_t =1) const;   
 };
 
 }
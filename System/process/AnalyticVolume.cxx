@@ -0,0 +1,301 @@
+/********************************************************************* 
+  CombLayer : MCNP(X) Input builder
+ 
+ * File:   process/AnalyticVolume.cxx
+ *
+ * Copyright (c) 2004-2016 by Stuart Ansell
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>. 
+ *
+ ****************************************************************************/
+#include <fstream>
+#include <iomanip>
+#include <iostream>
+#include <sstream>
+#include <cmath>
+#include <complex>
+#include <list>
+#include <vector>
+#include <set>
+#include <map>
+#include <string>
+#include <algorithm>
+#include <memory>
+
+#include "Exception.h"
+#include "FileReport.h"
+#include "NameStack.h"
+#include "RegMethod.h"
+#include "GTKreport.h"
+#include "OutputLog.h"
+#include "BaseVisit.h"
+#include "BaseModVisit.h"
+#include "MatrixBase.h"
+#include "Matrix.h"
+#include "Vec3D.h"
+#include "Surface.h"
+#include "Quadratic.h"
+#include "Plane.h"
+#include "Cylinder.h"
+#include "Rules.h"
+#include "HeadRule.h"
+#include "Object.h"
+#include "AnalyticVolume.h"
+
+namespace ModelSupport
+{
+
+bool
+intersectSurfaces(const Rule* RPtr,
+		  std::vector<SSTYPE>& SurfList)
+  /*!
+    Collect the signed surfaces of a rule if it is a pure
+    intersection of surfaces 
+    \param RPtr :: Rule to process
+    \param SurfList :: signed surfaces found
+    \return true if the rule is only surfaces/intersections
+  */
+{
+  if (!RPtr) return 0;
+
+  const SurfPoint* SPtr=
+    dynamic_cast<const SurfPoint*>(RPtr);
+  if (SPtr)
+    {
+      if (!SPtr->getKey()) return 0;
+      SurfList.push_back(SSTYPE(SPtr->getSign(),SPtr->getKey()));
+      return 1;
+    }
+  if (dynamic_cast<const Intersection*>(RPtr))
+    return intersectSurfaces(RPtr->leaf(0),SurfList) &&
+      intersectSurfaces(RPtr->leaf(1),SurfList);
+
+  return 0;
+}
+
+int
+convexPlaneVolume(const std::vector<SSTYPE>& SurfList,double& Vol)
+  /*!
+    Calculate the volume of a convex polyhedron defined by
+    an intersection of plane half-spaces. The vertices are
+    the valid triple intersections and the volume is the
+    sum over the faces of (centre.outward area)/3.
+    \param SurfList :: signed planes
+    \param Vol :: Volume [if calculated]
+    \return 1 on success / 0 if not planes or unbounded
+  */
+{
+  ELog::RegMethod RegA("AnalyticVolume[F]","convexPlaneVolume");
+
+  // unique outward normals / distance : N.x <= D 
+  std::vector<Geometry::Vec3D> NVec;
+  std::vector<double> DVec;
+  for(const SSTYPE& SS : SurfList)
+    {
+      const Geometry::Plane* PPtr=
+	dynamic_cast<const Geometry::Plane*>(SS.second);
+      if (!PPtr) return 0;
+      const double S((SS.first>0) ? -1.0 : 1.0);
+      const Geometry::Vec3D N(PPtr->getNormal()*S);
+      const double D(PPtr->getDistance()*S);
+      size_t i;
+      for(i=0;i<NVec.size() &&
+	    (NVec[i].Distance(N)>Geometry::zeroTol ||
+	     std::abs(DVec[i]-D)>Geometry::zeroTol);i++) ;
+      if (i==NVec.size())
+	{
+	  NVec.push_back(N);
+	  DVec.push_back(D);
+	}
+    }
+  const size_t NP(NVec.size());
+  if (NP<4) return 0;
+
+  // length scale for tolerance
+  double scale(1.0);
+  for(const double D : DVec)
+    scale=std::max(scale,std::abs(D));
+  const double tol(1e-9*scale);
+
+  std::vector<Geometry::Vec3D> Pts;
+  for(size_t i=0;i<NP;i++)
+    for(size_t j=i+1;j<NP;j++)
+      {
+	const Geometry::Vec3D NxN(NVec[i]*NVec[j]);
+	for(size_t k=j+1;k<NP;k++)
+	  {
+	    const double det=NVec[k].dotProd(NxN);
+	    if (std::abs(det)<Geometry::parallelTol) continue;
+	    const Geometry::Vec3D Pt=
+	      ((NVec[j]*NVec[k])*DVec[i]+
+	       (NVec[k]*NVec[i])*DVec[j]+
+	       NxN*DVec[k])/det;
+	    size_t m;
+	    for(m=0;m<NP && NVec[m].dotProd(Pt)-DVec[m]<tol;m++) ;
+	    if (m!=NP) continue;
+	    
+	    for(m=0;m<Pts.size() && Pts[m].Distance(Pt)>tol;m++) ;
+	    if (m==Pts.size())
+	      Pts.push_back(Pt);
+	  }
+      }
+  if (Pts.size()<4) return 0;
+
+  Geometry::Vec3D Centre;
+  for(const Geometry::Vec3D& Pt : Pts)
+    Centre+=Pt;
+  Centre/=static_cast<double>(Pts.size());
+  
+  double V(0.0);
+  double totalArea(0.0);
+  Geometry::Vec3D AreaSum;
+  for(size_t i=0;i<NP;i++)
+    {
+      std::vector<Geometry::Vec3D> Face;
+      for(const Geometry::Vec3D& Pt : Pts)
+	if (std::abs(NVec[i].dotProd(Pt)-DVec[i])<tol)
+	  Face.push_back(Pt);
+      if (Face.size()<3) continue;
+      
+      Geometry::Vec3D FC;
+      for(const Geometry::Vec3D& Pt : Face)
+	FC+=Pt;
+      FC/=static_cast<double>(Face.size());
+      // Order about the outward normal
+      const Geometry::Vec3D U((Face[0]-FC).unit());
+      const Geometry::Vec3D W(NVec[i]*U);
+      std::vector<std::pair<double,size_t>> Angle;
+      for(size_t j=0;j<Face.size();j++)
+	{
+	  const Geometry::Vec3D DP(Face[j]-FC);
+	  Angle.push_back(std::pair<double,size_t>
+			  (std::atan2(DP.dotProd(W),DP.dotProd(U)),j));
+	}
+      std::sort(Angle.begin(),Angle.end());
+      double area(0.0);
+      for(size_t j=0;j<Angle.size();j++)
+	{
+	  const Geometry::Vec3D& A(Face[Angle[j].second]);
+	  const Geometry::Vec3D& B(Face[Angle[(j+1) % Angle.size()].second]);
+	  area+=NVec[i].dotProd((A-FC)*(B-FC))/2.0;
+	}
+      V+=area*(NVec[i].dotProd(FC-Centre))/3.0;
+      totalArea+=area;
+      AreaSum+=NVec[i]*area;
+    }
+  // closed surface : sum of outward areas is zero
+  if (totalArea<=0.0 || AreaSum.abs()>1e-6*totalArea)
+    return 0;
+  Vol=V;
+  return 1;
+}
+
+int
+cylinderVolume(const std::vector<SSTYPE>& SurfList,double& Vol)
+  /*!
+    Calculate the volume of a cylinder or cylindrical 
+    shell [coaxial] cut by two planes normal to the axis.
+    \param SurfList :: signed surfaces
+    \param Vol :: Volume [if calculated]
+    \return 1 on success / 0 if not a simple cylinder
+  */
+{
+  ELog::RegMethod RegA("AnalyticVolume[F]","cylinderVolume");
+
+  const Geometry::Cylinder* OuterPtr(0);
+  const Geometry::Cylinder* InnerPtr(0);
+  std::vector<std::pair<int,const Geometry::Plane*>> PList;
+  for(const SSTYPE& SS : SurfList)
+    {
+      const Geometry::Cylinder* CPtr=
+	dynamic_cast<const Geometry::Cylinder*>(SS.second);
+      const Geometry::Plane* PPtr=
+	dynamic_cast<const Geometry::Plane*>(SS.second);
+      if (CPtr)
+	{
+	  const Geometry::Cylinder*& CRef((SS.first<0) ? OuterPtr : InnerPtr);
+	  if (CRef && CRef!=CPtr) return 0;
+	  CRef=CPtr;
+	}
+      else if (PPtr)
+	PList.push_back(std::pair<int,const Geometry::Plane*>(SS.first,PPtr));
+      else
+	return 0;
+    }
+  if (!OuterPtr || PList.size()!=2) return 0;
+
+  const Geometry::Vec3D& Axis(OuterPtr->getNormal());
+  const double R(OuterPtr->getRadius());
+  double r(0.0);
+  if (InnerPtr)
+    {
+      // coaxial : parallel and centre on axis
+      const Geometry::Vec3D DC(InnerPtr->getCentre()-OuterPtr->getCentre());
+      if (std::abs(std::abs(InnerPtr->getNormal().dotProd(Axis))-1.0)>
+	  Geometry::zeroTol ||
+	  (DC-Axis*DC.dotProd(Axis)).abs()>Geometry::zeroTol)
+	return 0;
+      r=InnerPtr->getRadius();
+      if (r>=R) 
+	{
+	  Vol=0.0;
+	  return 1;
+	}
+    }
+
+  // planes normal to the axis bounding a slab
+  double lowT(-1e38),highT(1e38);
+  for(const std::pair<int,const Geometry::Plane*>& PP : PList)
+    {
+      const double NA=PP.second->getNormal().dotProd(Axis);
+      if (std::abs(std::abs(NA)-1.0)>Geometry::zeroTol)
+	return 0;
+      // plane : t = D/NA along axis from origin of cylinder centre
+      const double T=(PP.second->getDistance()-
+		      PP.second->getNormal().dotProd(OuterPtr->getCentre()))/NA;
+      // sign>0 : N.x>D : t>T if NA>0
+      if ((PP.first>0) == (NA>0.0))
+	lowT=std::max(lowT,T);
+      else
+	highT=std::min(highT,T);
+    }
+  if (lowT<-1e37 || highT>1e37) return 0;
+  
+  Vol=(highT>lowT) ? M_PI*(R*R-r*r)*(highT-lowT) : 0.0;
+  return 1;
+}
+
+int
+analyticVolume(const MonteCarlo::Object& Obj,double& Vol)
+  /*!
+    Calculate the exact volume of an object if it 
+    is a convex set of planes or a cylinder [shell] cut by
+    two planes.
+    \param Obj :: Object [populated]
+    \param Vol :: Volume [if calculated]
+    \return 1 if volume is exact / 0 if not possible
+  */
+{
+  ELog::RegMethod RegA("AnalyticVolume[F]","analyticVolume");
+
+  if (!Obj.isPopulated()) return 0;
+  std::vector<SSTYPE> SurfList;
+  if (!intersectSurfaces(Obj.getHeadRule().getTopRule(),SurfList))
+    return 0;
+  
+  return (convexPlaneVolume(SurfList,Vol) ||
+	  cylinderVolume(SurfList,Vol)) ? 1 : 0;
+}
+
+} // NAMESPACE ModelSupport
@@ -70,7 +70,12 @@
 #include "DBMaterial.h"
 #include "ObjTrackItem.h"
 #include "neutron.h"
+#include "Line.h"
+#include "LineIntersectVisit.h"
+#include "SenseTrack.h"
 #include "Simulation.h"
+#include "SimTrack.h"
+#include "QueryContext.h"
 #include "LineTrack.h"
 
 #include "debugMethod.h"
@@ -145,44 +150,64 @@ LineTrack::clearAll()
 void
 LineTrack::calculate(const Simulation& ASim)
   /*!
-    Calculate the track
+    Calculate the track [failures reported]. The last-cell 
+    hint is taken from and returned to the SimTrack singleton,
+    since a start point on a cell boundary is resolved by it.
     \param ASim :: Simulation to use						
   */
 {
-  ELog::RegMethod RegA("LineTrack","calculate");
+  SimTrack& ST(SimTrack::Instance());
+
+  QueryContext QC(1);
+  QC.setCell(ASim.getCellVersion(),ST.curCell(&ASim));
+  calculate(ASim,QC);
+  ST.setCell(&ASim,QC.getCell(ASim.getCellVersion()));
+  return;
+}
+
+void
+LineTrack::calculate(const Simulation& ASim,QueryContext& QC)
+  /*!
+    Calculate the track. The error trace is only written if
+    the context is in debug mode.
+    \param ASim :: Simulation to use						
+    \param QC :: Query context [caller owned]
+  */
+{
+  ELog::RegMethod RegA("LineTrack","calculate(QC)");
 
   double aDist(0);                         // Length of track
   const Geometry::Surface* SPtr;           // Surface
   const ModelSupport::ObjSurfMap* OSMPtr =ASim.getOSM();
 
   MonteCarlo::neutron nOut(1.0,InitPt,EndPt-InitPt);
+  MonteCarlo::LineIntersectVisit LI(nOut);   // work space for track
+  MonteCarlo::SenseTrack ST;                 // surface senses of track
   // Find Initial cell [no default]
   MonteCarlo::Object* OPtr=ASim.findCell(InitPt+
-					 (EndPt-InitPt).unit()*1e-5,0);
+					 (EndPt-InitPt).unit()*1e-5,0,QC);
 
   if (!OPtr)
     ELog::EM<<"Initial point not in model:"<<InitPt<<ELog::endErr;
   int SN=OPtr->isOnSide(InitPt);
   
-  const MonteCarlo::Object* prevOPtr(0);
   while(OPtr)
     {
       // Note: Need OPPOSITE Sign on exiting surface
-      SN= OPtr->trackOutCell(nOut,aDist,SPtr,abs(SN));
+      SN= OPtr->trackOutCell(nOut,aDist,SPtr,abs(SN),LI,ST);
       // Update Track : returns 1 on excess of distance
       if (SN && updateDistance(OPtr,aDist))
 	{
-	  prevOPtr=OPtr;
 	  nOut.moveForward(aDist);
 	  
-	  OPtr=OSMPtr->findNextObject(SN,nOut.Pos,OPtr->getName());
-	  if (!OPtr)
+	  OPtr=OSMPtr->findNextObject(SN,nOut.Pos,OPtr->getName(),QC);
+	  if (!OPtr && QC.isDebug())
 	    {
 	      ELog::EM<<"INIT POINT == "<<InitPt<<ELog::endDiag;
 	      calculateError(ASim);
 	    }
 	  if (!OPtr || aDist<Geometry::zeroTol)
-	    OPtr=ASim.findCell(nOut.Pos,0);
+	    OPtr=ASim.findCell(nOut.Pos,0,QC);
 	}
       else
 	OPtr=0;	
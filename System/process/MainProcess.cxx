@@ -64,6 +64,8 @@
 #include "defaultConfig.h"
 #include "DBModify.h"
 #include "SimProcess.h"
+#include "SimSnapShot.h"
+#include "QueryServer.h"
 #include "DefPhysics.h"
 #include "TallySelector.h"
 #include "ReportSelector.h"
@@ -236,6 +238,7 @@ createInputs(inputParam& IParam)
   IParam.regItem("I","isolate");
   IParam.regDefItemList<std::string>("imp","importance",10,RItems);
   IParam.regDefItem<int>("m","multi",1,1);
+  IParam.regFlag("linearFind","linearFind");
   IParam.regDefItem<std::string>("matDB","materialDatabase",1,
                                  std::string("shielding"));  
   IParam.regFlag("M","mesh");
@@ -246,7 +249,9 @@ createInputs(inputParam& IParam)
   IParam.regItem("memStack","memStack");
   IParam.regDefItem<int>("n","nps",1,10000);
   IParam.regFlag("p","PHITS");
+  IParam.regItem("query","query",0,1);
   IParam.regFlag("fluka","FLUKA");
+  IParam.regFlag("allCodes","allCodes");
   IParam.regFlag("mcnp6","MCNP6");
   IParam.regFlag("Monte","Monte");
   IParam.regItem("offset","offset",1,4);
@@ -270,6 +275,8 @@ createInputs(inputParam& IParam)
   IParam.regItem("SV","sdefVec");
   IParam.regItem("SZ","sdefZRot");
   IParam.regDefItem<long int>("s","random",1,375642321L);
+  IParam.regItem("snapIn","snapIn",1);
+  IParam.regItem("snapOut","snapOut",1);
   // std::vector<std::string> AItems(15);
   // IParam.regDefItemList<std::string>("T","tally",15,AItems);
   IParam.regMulti("T","tally",1000,0);
@@ -278,17 +285,25 @@ createInputs(inputParam& IParam)
   IParam.regMulti("TMod","tallyMod",8,1);
   IParam.regFlag("TW","tallyWeight");
   IParam.regItem("TX","Txml",1);
+  IParam.regDefItem<int>("threads","threads",1,0);
   IParam.regItem("targetType","targetType",1);
   IParam.regDefItem<int>("u","units",1,0);
   IParam.regItem("validCheck","validCheck",1);
+  IParam.regMulti("validFC","validFC",1000,1);
+  IParam.regMulti("validPoint","validPoint",1000,1,3);
+  IParam.regDefItem<int>("validThread","validThread",1,0);
   IParam.regFlag("um","voidUnMask");
   IParam.regMulti("volume","volume",4,1);
   IParam.regItem("volCard","volCard");
   IParam.regDefItem<int>("VN","volNum",1,20000);
+  IParam.regDefItem<double>("volErr","volErr",1,0.0);
+  IParam.regDefItem<std::string>("volSample","volSample",1,"random");
   IParam.regMulti("volCell","volCells",100,1,100);
     
   IParam.regFlag("void","void");
   IParam.regFlag("vtk","vtk");
+  IParam.regFlag("vtkTrack","vtkTrack");
+  IParam.regDefItem<std::string>("vtkFormat","vtkFormat",1,"ascii");
   IParam.regFlag("vcell","vcell");
   std::vector<std::string> VItems(15,"");
   IParam.regDefItemList<std::string>("vmat","vmat",15,VItems);
@@ -339,6 +354,8 @@ createInputs(inputParam& IParam)
   IParam.setDesc("i","iterate on variables");
   IParam.setDesc("I","Isolate component");
   IParam.setDesc("imp","Importance regions");
+  IParam.setDesc("linearFind","Use a linear search to find cells "
+                 "[not the cell box tree]");
   IParam.setDesc("m","Create multiple files (diff: RNDseed)");
   IParam.setDesc("matDB","Set the material database to use "
                  "(shielding or neutronics)");  
@@ -352,6 +369,9 @@ createInputs(inputParam& IParam)
   IParam.setDesc("MCNP6","MCNP6 output");
   IParam.setDesc("FLUKA","FLUKA output");
   IParam.setDesc("PHITS","PHITS output");
+  IParam.setDesc("query","Answer geometry queries after the build "
+		 "[stdin/stdout or UNIX socket path]");
+  IParam.setDesc("allCodes","MCNP, PHITS and FLUKA output [one build]");
   IParam.setDesc("Monte","MonteCarlo capable simulation");
   IParam.setDesc("offset","Displace to component [name]");
   IParam.setDesc("photon","Photon Cut energy");
@@ -359,6 +379,8 @@ createInputs(inputParam& IParam)
   IParam.setDesc("r","Renubmer cells");
   IParam.setDesc("report","Report a position/axis");
   IParam.setDesc("s","RND Seed");
+  IParam.setDesc("snapIn","Geometry snapshot file to load");
+  IParam.setDesc("snapOut","Write geometry snapshot after the build");
   IParam.setDesc("SF","File read source");
   IParam.setDesc("SA","Source Angle [deg]");
   IParam.setDesc("SI","Source Index value [1:2]");
@@ -376,6 +398,7 @@ createInputs(inputParam& IParam)
   IParam.setDesc("TGrid","Set a grid on a point tally [tallyN NXpts NZPts]");
   IParam.setDesc("TW","Activate tally pd weight system");
   IParam.setDesc("Txml","Tally xml file");
+  IParam.setDesc("threads","Threads for parallel sections [0 : all cores]");
   IParam.setDesc("targetType","Name of target type");
   IParam.setDesc("u","Units in cm");
   IParam.setDesc("um","Unset spherical void area (from imp=0)");
@@ -384,10 +407,17 @@ createInputs(inputParam& IParam)
   IParam.setDesc("volCells","Cells [object/range]");
   IParam.setDesc("volCard","set/delete the vol card");
   IParam.setDesc("vtk","Write out VTK plot mesh");
+  IParam.setDesc("vtkTrack","Fill VTK mesh rows by tracking");
+  IParam.setDesc("vtkFormat","VTK output [ascii/binary/vti/vtiz]");
   IParam.setDesc("vcell","Use cell id rather than material");
   IParam.setDesc("vmat","Material sections to be written by vtk output");
   IParam.setDesc("VN","Number of points in the volume integration");
+  IParam.setDesc("volErr","Stop volume points at this relative error");
+  IParam.setDesc("volSample","Volume points [random/stratified/sobol]");
   IParam.setDesc("validCheck","Run simulation to check for validity");
+  IParam.setDesc("validFC","FixedComp centres for validCheck [All/names]");
+  IParam.setDesc("validPoint","Start point for validCheck");
+  IParam.setDesc("validThread","Threads for validCheck [0 : -threads]");
 
   IParam.setDesc("w","weightBias");
   IParam.setDesc("wExt","Extraction biasisng [see: -wExt help]");
@@ -973,6 +1003,9 @@ createSimulation(inputParam& IParam,
     ELog::EM.setActive(IParam.getValue<size_t>("debug"));
   
   IParam.processMainInput(Names);
+  // query on stdin/stdout : log to std::cerr
+  if (IParam.flag("query") && !IParam.itemCnt("query",0))
+    ELog::EReport::setErrStream(1);
 
   Simulation* SimPtr;
   if (IParam.flag("PHITS"))
@@ -986,6 +1019,8 @@ createSimulation(inputParam& IParam,
 
   if (IParam.flag("mcnp6"))
     SimPtr->setMcnpType(1);
+  if (IParam.flag("linearFind"))
+    SimPtr->setCellTree(0);
 
   SimPtr->setCmdLine(cmdLine.str());        // set full command line
 
@@ -1066,19 +1101,59 @@ buildFullSimulation(Simulation* SimPtr,
 {
   ELog::RegMethod RegA("MainProcess[F]","buildFullSimulation");
 
-  // Definitions section 
-  int MCIndex(0);
-  const int multi=IParam.getValue<int>("multi");
-  
   SimPtr->removeComplements();
   SimPtr->removeDeadSurfaces(0);         
   ModelSupport::setDefaultPhysics(*SimPtr,IParam);
       
   ModelSupport::setDefRotation(IParam);
   SimPtr->masterRotation();
+  if (IParam.flag("snapOut"))
+    SimProcess::writeSnapShot
+      (*SimPtr,IParam.getValue<std::string>("snapOut"));
+
+  processFullSimulation(SimPtr,IParam,OName);
+  return;
+}
+
+void
+buildSnapSimulation(Simulation* SimPtr,
+		    const mainSystem::inputParam& IParam,
+		    const std::string& OName)
+  /*!
+    Load the geometry from a snapshot [snapIn] written 
+    after a full build and process it as a full build
+    \param SimPtr :: Simulation point
+    \param IParam :: Input parameters
+    \param OName :: Output name
+   */
+{
+  ELog::RegMethod RegA("MainProcess[F]","buildSnapSimulation");
+
+  SimProcess::readSnapShot(*SimPtr,IParam.getValue<std::string>("snapIn"));
+  ModelSupport::setDefaultPhysics(*SimPtr,IParam);
+  processFullSimulation(SimPtr,IParam,OName);
+  return;
+}
+
+void
+processFullSimulation(Simulation* SimPtr,
+		      const mainSystem::inputParam& IParam,
+		      const std::string& OName)
+  /*!
+    Carry out the tally/weight/output processing
+    of a built geometry
+    \param SimPtr :: Simulation point
+    \param IParam :: Input parameters
+    \param OName :: Output name
+   */
+{
+  ELog::RegMethod RegA("MainProcess[F]","processFullSimulation");
+
+  const int multi=IParam.getValue<int>("multi");
 
   const int renumCellWork=tallySelection(*SimPtr,IParam);
   reportSelection(*SimPtr,IParam);
+  SimPtr->buildCellTree();         // tally changes drop the tree
   if (createVTK(IParam,SimPtr,OName))
     return;
   // 
@@ -1087,15 +1162,24 @@ buildFullSimulation(Simulation* SimPtr,
   if (renumCellWork)
     tallyRenumberWork(*SimPtr,IParam);
   tallyModification(*SimPtr,IParam);
+  SimPtr->setWriteThreads(IParam.getValue<size_t>("threads"));
 
-  // Ensure we done loop
-  do
+  if (IParam.flag("allCodes"))
+    SimProcess::writeMultiCode(*SimPtr,OName,multi);
+  else
+    SimProcess::writeMultiSim(*SimPtr,OName,multi);
+
+  if (IParam.flag("query"))
     {
-      SimProcess::writeIndexSim(*SimPtr,OName,MCIndex);
-      MCIndex++;
+      SimPtr->createObjSurfMap();
+      SimPtr->buildCellTree();
+      ModelSupport::QueryServer QS(*SimPtr);
+      QS.setThreads(IParam.getValue<size_t>("threads"));
+      if (IParam.itemCnt("query",0))
+	QS.serveSocket(IParam.getValue<std::string>("query"));
+      else
+	QS.serve(std::cin,std::cout);
     }
-  while(MCIndex<multi);
-
   return;
 }
   
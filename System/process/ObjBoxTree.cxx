@@ -0,0 +1,327 @@
+/********************************************************************* 
+  CombLayer : MCNP(X) Input builder
+ 
+ * File:   process/ObjBoxTree.cxx
+ *
+ * Copyright (c) 2004-2016 by Stuart Ansell
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>. 
+ *
+ ****************************************************************************/
+#include <fstream>
+#include <iomanip>
+#include <iostream>
+#include <cmath>
+#include <complex> 
+#include <vector>
+#include <set> 
+#include <map> 
+#include <string>
+#include <algorithm>
+#include <iterator>
+#include <limits>
+#include <memory>
+
+#include "Exception.h"
+#include "FileReport.h"
+#include "NameStack.h"
+#include "RegMethod.h"
+#include "GTKreport.h"
+#include "OutputLog.h"
+#include "BaseVisit.h"
+#include "BaseModVisit.h"
+#include "MatrixBase.h"
+#include "Matrix.h"
+#include "Vec3D.h"
+#include "BoundBox.h"
+#include "Rules.h"
+#include "HeadRule.h"
+#include "Object.h"
+#include "Qhull.h"
+#include "ObjBoxTree.h"
+
+namespace ModelSupport
+{
+
+const size_t ObjBoxTree::leafSize(4);
+
+ObjBoxTree::ObjBoxTree() :
+  active(1),built(0)
+  /*!
+    Constructor
+  */
+{}
+
+ObjBoxTree::ObjBoxTree(const ObjBoxTree& A) :
+  active(A.active),built(0)
+  /*!
+    Copy constructor : The tree refers to the
+    objects of the original so is not copied
+    \param A :: ObjBoxTree to copy
+  */
+{}
+
+ObjBoxTree&
+ObjBoxTree::operator=(const ObjBoxTree& A)
+  /*!
+    Assignment operator : tree is cleared [see build]
+    \param A :: ObjBoxTree to copy
+    \return *this
+  */
+{
+  if (this!=&A)
+    {
+      active=A.active;
+      clearAll();
+    }
+  return *this;
+}
+
+void
+ObjBoxTree::clearAll()
+  /*!
+    Remove the tree [findCell is invalid until build]
+  */
+{
+  built=0;
+  Items.clear();
+  ItemOrder.clear();
+  ItemBox.clear();
+  unBound.clear();
+  Nodes.clear();
+  return;
+}
+
+size_t
+ObjBoxTree::buildNode(std::vector<size_t>& Index,
+		      const size_t aIndex,const size_t bIndex,
+		      const std::vector<Geometry::Vec3D>& CPts)
+  /*!
+    Build a node of the tree by splitting the items
+    at the median of the longest axis of the centres.
+    Leaf items are sorted into cell-map order.
+    \param Index :: Item index [re-ordered]
+    \param aIndex :: First index in Index
+    \param bIndex :: One past last index in Index
+    \param CPts :: Centre points of the items
+    \return node number
+  */
+{
+  const size_t NIndex(Nodes.size());
+  Nodes.push_back(BoxNode());
+
+  Geometry::BoundBox NBox=Geometry::BoundBox::emptyBox();
+  Geometry::BoundBox CBox=Geometry::BoundBox::emptyBox();
+  for(size_t i=aIndex;i<bIndex;i++)
+    {
+      NBox.unionBox(ItemBox[Index[i]]);
+      CBox.addPoint(CPts[Index[i]]);
+    }
+  Nodes[NIndex].Box=NBox;
+
+  if (bIndex-aIndex<=leafSize)
+    {
+      std::sort(Index.begin()+static_cast<long int>(aIndex),
+		Index.begin()+static_cast<long int>(bIndex),
+		[this](const size_t A,const size_t B)
+		{ return ItemOrder[A]<ItemOrder[B]; });
+      Nodes[NIndex].first=aIndex;
+      Nodes[NIndex].nItem=bIndex-aIndex;
+      Nodes[NIndex].right=0;
+      Nodes[NIndex].minOrder=ItemOrder[Index[aIndex]];
+      return NIndex;
+    }
+
+  const size_t axis=CBox.longAxis();
+  const size_t mid=(aIndex+bIndex)/2;
+  std::nth_element(Index.begin()+static_cast<long int>(aIndex),
+		   Index.begin()+static_cast<long int>(mid),
+		   Index.begin()+static_cast<long int>(bIndex),
+		   [&CPts,axis](const size_t A,const size_t B)
+		   { return CPts[A][axis]<CPts[B][axis]; });
+
+  const size_t leftN=buildNode(Index,aIndex,mid,CPts);
+  const size_t rightN=buildNode(Index,mid,bIndex,CPts);
+  Nodes[NIndex].first=leftN;
+  Nodes[NIndex].nItem=0;
+  Nodes[NIndex].right=rightN;
+  Nodes[NIndex].minOrder=
+    std::min(Nodes[leftN].minOrder,Nodes[rightN].minOrder);
+  return NIndex;
+}
+
+void
+ObjBoxTree::build(const std::map<int,MonteCarlo::Qhull*>& OMap)
+  /*!
+    Build the tree from the bounding boxes of all the cells.
+    \param OMap :: Cell map
+  */
+{
+  build(OMap,Geometry::BoundBox());
+  return;
+}
+
+void
+ObjBoxTree::build(const std::map<int,MonteCarlo::Qhull*>& OMap,
+		  const Geometry::BoundBox& Region)
+  /*!
+    Build the tree from the bounding boxes of the cells.
+    Placeholder cells are ignored. Cells with unbounded
+    or unpopulated rules are held in the unBound list.
+    Cells that cannot reach the region are ignored, so
+    findCell is only valid for points in the region.
+    \param OMap :: Cell map
+    \param Region :: Region of interest
+  */
+{
+  ELog::RegMethod RegA("ObjBoxTree","build(Region)");
+
+  clearAll();
+
+  std::vector<MonteCarlo::Object*> BObj;
+  std::vector<MonteCarlo::Object*> UObj;
+  std::vector<size_t> UOrder;
+
+  size_t orderIndex(0);
+  for(const std::map<int,MonteCarlo::Qhull*>::value_type& MC : OMap)
+    {
+      MonteCarlo::Object* OPtr=MC.second;
+      orderIndex++;
+      if (OPtr->isPlaceHold()) continue;
+
+      const Geometry::BoundBox& BBox=OPtr->getBoundBox();
+      if (BBox.isEmpty() ||                 // cell contains nothing
+	  !BBox.overlap(Region)) continue;
+      if (BBox.isFinite())
+	{
+	  BObj.push_back(OPtr);
+	  ItemOrder.push_back(orderIndex);
+	  ItemBox.push_back(BBox);
+	}
+      else
+	{
+	  UObj.push_back(OPtr);
+	  UOrder.push_back(orderIndex);
+	}
+    }
+
+  if (!BObj.empty())
+    {
+      std::vector<Geometry::Vec3D> CPts;
+      std::vector<size_t> Index;
+      for(size_t i=0;i<ItemBox.size();i++)
+	{
+	  CPts.push_back(ItemBox[i].getCentre());
+	  Index.push_back(i);
+	}
+      buildNode(Index,0,Index.size(),CPts);
+      
+      // Re-order items so leaves refer to contiguous ranges
+      const std::vector<size_t> BOrder(ItemOrder);
+      const std::vector<Geometry::BoundBox> BBoxes(ItemBox);
+      ItemOrder.clear();
+      ItemBox.clear();
+      for(const size_t I : Index)
+	{
+	  Items.push_back(BObj[I]);
+	  ItemOrder.push_back(BOrder[I]);
+	  ItemBox.push_back(BBoxes[I]);
+	}
+    }
+  
+  for(size_t i=0;i<UObj.size();i++)
+    {
+      unBound.push_back(Items.size());
+      Items.push_back(UObj[i]);
+      ItemOrder.push_back(UOrder[i]);
+      ItemBox.push_back(Geometry::BoundBox());
+    }
+  built=1;
+  return;
+}
+
+MonteCarlo::Object*
+ObjBoxTree::findCell(const Geometry::Vec3D& Pt) const
+  /*!
+    Find the first cell [in cell-map order] that
+    contains the point. Items and nodes that cannot 
+    beat the best order found are skipped.
+    \param Pt :: Point to find
+    \return Object ptr / 0 if not found
+  */
+{
+  MonteCarlo::Object* bestPtr(0);
+  size_t bestOrder(std::numeric_limits<size_t>::max());
+
+  for(const size_t I : unBound)
+    if (!Items[I]->isPlaceHold() && Items[I]->isValid(Pt))
+      {
+	bestPtr=Items[I];
+	bestOrder=ItemOrder[I];
+	break;
+      }
+
+  if (!Nodes.empty())
+    {
+      size_t NStack[64];
+      size_t stackN(0);
+      NStack[stackN++]=0;
+      while(stackN)
+	{
+	  const BoxNode& BN=Nodes[NStack[--stackN]];
+	  if (BN.minOrder>=bestOrder || !BN.Box.isValid(Pt)) continue;
+	  if (BN.nItem)
+	    {
+	      for(size_t i=BN.first;i<BN.first+BN.nItem &&
+		    ItemOrder[i]<bestOrder;i++)
+		if (ItemBox[i].isValid(Pt) &&
+		    !Items[i]->isPlaceHold() && Items[i]->isValid(Pt))
+		  {
+		    bestPtr=Items[i];
+		    bestOrder=ItemOrder[i];
+		  }
+	    }
+	  else if (Nodes[BN.first].minOrder<Nodes[BN.right].minOrder)
+	    {
+	      // lower order popped first
+	      NStack[stackN++]=BN.right;
+	      NStack[stackN++]=BN.first;
+	    }
+	  else
+	    {
+	      NStack[stackN++]=BN.first;
+	      NStack[stackN++]=BN.right;
+	    }
+	}
+    }
+  return bestPtr;
+}
+
+void
+ObjBoxTree::write(std::ostream& OX) const
+  /*!
+    Write out the tree statistics
+    \param OX :: Output stream
+  */
+{
+  OX<<"ObjBoxTree : "<<((built) ? "built" : "not built")
+    <<" Items == "<<Items.size()
+    <<" unBound == "<<unBound.size()
+    <<" Nodes == "<<Nodes.size();
+  if (!Nodes.empty())
+    OX<<" Box == "<<Nodes[0].Box;
+  return;
+}
+
+}  // NAMESPACE ModelSupport
@@ -54,6 +54,7 @@
 #include "localRotate.h"
 #include "masterRotate.h"
 #include "Qhull.h"
+#include "QueryContext.h"
 #include "ObjSurfMap.h"
 
 #include "debugMethod.h"
@@ -217,14 +218,33 @@ ObjSurfMap::findNextObject(const int SN,
 			   const Geometry::Vec3D& Pos,
 			   const int objExclude) const
   /*!
-    Calculate the next object 
+    Calculate the next object [failures reported]
     \param SN :: Surface number
     \param Pos :: position
     \param ObjExclude :: Excluded object
     \return Next Object Ptr / 0 on point not valid
   */
 {
-  ELog::RegMethod RegA("ObjSurfMap","findNextObject");
+  QueryContext QC(1);
+  return findNextObject(SN,Pos,objExclude,QC);
+}
+
+MonteCarlo::Object*
+ObjSurfMap::findNextObject(const int SN,
+			   const Geometry::Vec3D& Pos,
+			   const int objExclude,
+			   QueryContext& QC) const
+  /*!
+    Calculate the next object. Failures are only reported
+    if the context is in debug mode.
+    \param SN :: Surface number
+    \param Pos :: position
+    \param ObjExclude :: Excluded object
+    \param QC :: Query context
+    \return Next Object Ptr / 0 on point not valid
+  */
+{
+  ELog::RegMethod RegA("ObjSurfMap","findNextObject(QC)");
 
 
   const STYPE& MVec=getObjects(SN);
@@ -236,6 +256,7 @@ ObjSurfMap::findNextObject(const int SN,
 	  MPtr->isDirectionValid(Pos,SN))
 	return MPtr;
     }
+  if (!QC.isDebug()) return 0;
   
   // DEBUG CODE FOR FAILURE:
   ModelSupport::surfIndex& SurI=ModelSupport::surfIndex::Instance();
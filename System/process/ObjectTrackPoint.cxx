@@ -121,6 +121,32 @@ ObjectTrackPoint::addUnit(const Simulation& System,
   return;
 }  
 
+void
+ObjectTrackPoint::addUnit(const Simulation& System,
+			const long int objN,
+			const Geometry::Vec3D& IPt,
+			QueryContext& QC)
+  /*!
+    Create a target track between the IPt and the target point
+    using the caller's query context [thread safe]
+    \param System :: Simulation to use
+    \param objN :: Index of object
+    \param IPt :: initial point
+    \param QC :: Query context
+  */
+{
+  ELog::RegMethod RegA("ObjectTrackPoint","addUnit(QC)");
+
+  std::map<long int,LineTrack>::iterator mc=Items.find(objN);
+  if (mc!=Items.end())
+    Items.erase(mc);
+
+  LineTrack A(IPt,TargetPt);
+  A.calculate(System,QC);
+  Items.insert(std::map<long int,LineTrack>::value_type(objN,A));
+  return;
+}  
+
 void 
 ObjectTrackPoint::write(std::ostream& OX) const
   /*!
@@ -0,0 +1,92 @@
+/********************************************************************* 
+  CombLayer : MCNP(X) Input builder
+ 
+ * File:   process/QueryContext.cxx
+ *
+ * Copyright (c) 2004-2016 by Stuart Ansell
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>. 
+ *
+ ****************************************************************************/
+#include <fstream>
+#include <iomanip>
+#include <iostream>
+#include <string>
+#include <atomic>
+
+#include "QueryContext.h"
+
+namespace ModelSupport
+{
+
+size_t
+QueryContext::newVersion()
+  /*!
+    Get a new cell-map version number. The numbers
+    are unique across all Simulations and threads.
+    \return version number [>0]
+  */
+{
+  static std::atomic<size_t> versionCnt(0);
+  return ++versionCnt;
+}
+  
+QueryContext::QueryContext(const int D) :
+  debug(D),version(0),lastCell(0)
+  /*!
+    Constructor
+    \param D :: Report tracking failures
+  */
+{}
+
+QueryContext::QueryContext(const QueryContext& A) : 
+  debug(A.debug),version(A.version),lastCell(A.lastCell),
+  rangeKey(A.rangeKey)
+  /*!
+    Copy constructor
+    \param A :: QueryContext to copy
+  */
+{}
+
+QueryContext&
+QueryContext::operator=(const QueryContext& A)
+  /*!
+    Assignment operator
+    \param A :: QueryContext to copy
+    \return *this
+  */
+{
+  if (this!=&A)
+    {
+      debug=A.debug;
+      version=A.version;
+      lastCell=A.lastCell;
+      rangeKey=A.rangeKey;
+    }
+  return *this;
+}
+
+void
+QueryContext::clearAll()
+  /*!
+    Remove the hints 
+  */
+{
+  version=0;
+  lastCell=0;
+  rangeKey.clear();
+  return;
+}
+
+} // NAMESPACE ModelSupport
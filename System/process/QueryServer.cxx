@@ -0,0 +1,485 @@
+/********************************************************************* 
+  CombLayer : MCNP(X) Input builder
+ 
+ * File:   process/QueryServer.cxx
+ *
+ * Copyright (c) 2004-2016 by Stuart Ansell
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>. 
+ *
+ ****************************************************************************/
+#include <fstream>
+#include <iomanip>
+#include <iostream>
+#include <sstream>
+#include <cmath>
+#include <complex> 
+#include <vector>
+#include <set> 
+#include <map> 
+#include <string>
+#include <algorithm>
+#include <memory>
+#include <thread>
+#include <atomic>
+#include <exception>
+#include <cstring>
+#include <cerrno>
+#include <unistd.h>
+#include <sys/socket.h>
+#include <sys/un.h>
+
+#include "Exception.h"
+#include "FileReport.h"
+#include "NameStack.h"
+#include "RegMethod.h"
+#include "GTKreport.h"
+#include "OutputLog.h"
+#include "BaseVisit.h"
+#include "BaseModVisit.h"
+#include "support.h"
+#include "stringCombine.h"
+#include "MatrixBase.h"
+#include "Matrix.h"
+#include "Vec3D.h"
+#include "varList.h"
+#include "Code.h"
+#include "FItem.h"
+#include "FuncDataBase.h"
+#include "Rules.h"
+#include "HeadRule.h"
+#include "Object.h"
+#include "Qhull.h"
+#include "QueryContext.h"
+#include "Simulation.h"
+#include "Zaid.h"
+#include "MXcards.h"
+#include "Material.h"
+#include "DBMaterial.h"
+#include "objectRegister.h"
+#include "LineTrack.h"
+#include "ObjectTrackAct.h"
+#include "ObjectTrackPoint.h"
+#include "QueryServer.h"
+
+namespace ModelSupport
+{
+
+QueryServer::QueryServer(const Simulation& ASim) :
+  System(ASim),nThread(0),inBatch(0)
+  /*! 
+    Constructor 
+    \param ASim :: Built simulation [must exist for life of object]
+  */
+{}
+
+QueryServer::QueryServer(const QueryServer& A) :
+  System(A.System),nThread(A.nThread),
+  inBatch(A.inBatch),Batch(A.Batch)
+  /*! 
+    Copy Constructor 
+    \param A :: QueryServer to copy
+  */
+{}
+
+std::string
+QueryServer::findCell(std::string& Line,QueryContext& QC) const
+  /*!
+    Find the cell at a point
+    \param Line :: Arguments [x y z]
+    \param QC :: Query context
+    \return response 
+  */
+{
+  Geometry::Vec3D Pt;
+  if (!StrFunc::section(Line,Pt))
+    return "error findCell x y z";
+
+  const MonteCarlo::Object* OPtr=System.findCell(Pt,0,QC);
+  std::ostringstream cx;
+  cx<<"ok ";
+  if (OPtr)
+    cx<<OPtr->getName()<<" "<<OPtr->getMat();
+  else
+    cx<<"0 0";
+  return cx.str();
+}
+
+std::string
+QueryServer::lineTrack(std::string& Line,QueryContext& QC) const
+  /*!
+    Track between two points
+    \param Line :: Arguments [x y z x y z]
+    \param QC :: Query context
+    \return response 
+  */
+{
+  Geometry::Vec3D APt,BPt;
+  if (!StrFunc::section(Line,APt) || !StrFunc::section(Line,BPt))
+    return "error lineTrack x y z x y z";
+
+  LineTrack LT(APt,BPt);
+  LT.calculate(System,QC);
+
+  const std::vector<long int>& Cells=LT.getCells();
+  const std::vector<MonteCarlo::Object*>& OVec=LT.getObjVec();
+  const std::vector<double>& TVec=LT.getTrack();
+
+  std::ostringstream cx;
+  cx.precision(10);
+  cx<<"ok "<<Cells.size();
+  for(size_t i=0;i<Cells.size();i++)
+    cx<<" "<<Cells[i]<<" "<<OVec[i]->getMat()<<" "<<TVec[i];
+  return cx.str();
+}
+
+std::string
+QueryServer::attnSum(std::string& Line,QueryContext& QC) const
+  /*!
+    Attenuation sum between two points
+    \param Line :: Arguments [x y z x y z]
+    \param QC :: Query context
+    \return response 
+  */
+{
+  Geometry::Vec3D APt,BPt;
+  if (!StrFunc::section(Line,APt) || !StrFunc::section(Line,BPt))
+    return "error attnSum x y z x y z";
+
+  ObjectTrackPoint OTrack(BPt);
+  OTrack.addUnit(System,0,APt,QC);
+
+  std::ostringstream cx;
+  cx.precision(10);
+  cx<<"ok "<<OTrack.getAttnSum(0);
+  return cx.str();
+}
+
+std::string
+QueryServer::cellInfo(std::string& Line,QueryContext& QC) const
+  /*!
+    Information on a cell
+    \param Line :: Arguments [cell number]
+    \param QC :: Query context
+    \return response 
+  */
+{
+  const ModelSupport::objectRegister& OR=
+    ModelSupport::objectRegister::Instance();
+
+  int cellN;
+  if (!StrFunc::section(Line,cellN))
+    return "error cell N";
+
+  const MonteCarlo::Qhull* OPtr=System.findQhull(cellN);
+  if (!OPtr)
+    return "error cell "+StrFunc::makeString(cellN)+" not found";
+
+  const std::string Name=OR.inRange(cellN,QC);
+  std::ostringstream cx;
+  cx.precision(10);
+  cx<<"ok "<<OPtr->getMat()<<" "<<OPtr->getDensity()<<" "
+    <<OPtr->getImp()<<" "<<OPtr->getTemp()<<" "
+    <<((Name.empty()) ? "-" : Name);
+  return cx.str();
+}
+
+std::string
+QueryServer::materialInfo(std::string& Line) const
+  /*!
+    Information on a material
+    \param Line :: Arguments [material number]
+    \return response 
+  */
+{
+  const ModelSupport::DBMaterial& DB=
+    ModelSupport::DBMaterial::Instance();
+
+  int matN;
+  if (!StrFunc::section(Line,matN))
+    return "error material N";
+  if (!DB.hasKey(matN))
+    return "error material "+StrFunc::makeString(matN)+" not found";
+
+  const MonteCarlo::Material& MObj=DB.getMaterial(matN);
+  std::ostringstream cx;
+  cx.precision(10);
+  cx<<"ok "<<MObj.getName()<<" "<<MObj.getAtomDensity()<<" "
+    <<MObj.getMeanA();
+  return cx.str();
+}
+
+std::string
+QueryServer::process(const std::string& Request,QueryContext& QC) const
+  /*!
+    Evaluate a single request. Thread safe if each
+    thread has its own query context. A failed request
+    gives a one line error response.
+    \param Request :: Request line
+    \param QC :: Query context
+    \return response line
+  */
+{
+  std::string Line(Request);
+  std::string Cmd;
+  if (!StrFunc::section(Line,Cmd))
+    return "error empty request";
+
+  try
+    {
+      if (Cmd=="findCell")
+	return findCell(Line,QC);
+      if (Cmd=="lineTrack")
+	return lineTrack(Line,QC);
+      if (Cmd=="attnSum")
+	return attnSum(Line,QC);
+      if (Cmd=="cell")
+	return cellInfo(Line,QC);
+      if (Cmd=="material")
+	return materialInfo(Line);
+    }
+  catch (ColErr::ExBase& A)
+    {
+      // getErr : what() shares a static buffer and adds the stack
+      std::string Err(A.getErr());
+      std::replace(Err.begin(),Err.end(),'\n',' ');
+      return "error "+Err;
+    }
+  catch (std::exception& A)
+    {
+      return std::string("error ")+A.what();
+    }
+  return "error unknown request "+Cmd;
+}
+
+void
+QueryServer::processBatch(const std::vector<std::string>& Requests,
+			  std::vector<std::string>& Response) const
+  /*!
+    Evaluate the requests over several threads
+    \param Requests :: Request lines
+    \param Response :: Response for each request
+  */
+{
+  ELog::RegMethod RegA("QueryServer","processBatch");
+
+  Response.assign(Requests.size(),std::string());
+  if (Requests.empty()) return;
+
+  size_t NT(nThread);
+  if (!NT)
+    NT=static_cast<size_t>(std::thread::hardware_concurrency());
+  NT=std::max<size_t>(1,std::min(NT,Requests.size()));
+
+  std::atomic<size_t> itemCnt(0);
+  std::vector<std::exception_ptr> TError(NT);
+  std::vector<std::thread> TUnit;
+  for(size_t i=0;i<NT;i++)
+    {
+      TUnit.push_back
+	(std::thread([&,i]()
+		     {
+		       try
+			 {
+			   QueryContext QC;
+			   for(size_t index=itemCnt++;index<Requests.size();
+			       index=itemCnt++)
+			     Response[index]=process(Requests[index],QC);
+			 }
+		       catch (...)
+			 {
+			   TError[i]=std::current_exception();
+			 }
+		     }));
+    }
+  for(std::thread& TU : TUnit)
+    TU.join();
+  for(const std::exception_ptr& EP : TError)
+    if (EP) std::rethrow_exception(EP);
+  return;
+}
+
+void
+QueryServer::runBatch(std::ostream& OX) const
+  /*!
+    Evaluate the batch and write the responses
+    \param OX :: Output stream
+  */
+{
+  std::vector<std::string> Response;
+  processBatch(Batch,Response);
+  for(const std::string& R : Response)
+    OX<<R<<"\n";
+  return;
+}
+
+int
+QueryServer::processLine(const std::string& Request,std::ostream& OX)
+  /*!
+    Process a line of the session : a request, or
+    a batch/end/quit/shutdown control line. Blank
+    lines and # comments are ignored.
+    \param Request :: Request line
+    \param OX :: Output stream for responses
+    \retval 0 :: continue
+    \retval 1 :: quit session
+    \retval 2 :: shutdown server
+  */
+{
+  std::string Line(Request);
+  std::string Cmd;
+  if (!StrFunc::section(Line,Cmd) || Cmd[0]=='#')
+    return 0;
+  
+  if (Cmd=="quit" || Cmd=="shutdown")
+    {
+      if (inBatch)
+	runBatch(OX);
+      inBatch=0;
+      Batch.clear();
+      return (Cmd=="quit") ? 1 : 2;
+    }
+
+  if (Cmd=="batch")
+    {
+      inBatch=1;
+      Batch.clear();
+    }
+  else if (Cmd=="end")
+    {
+      runBatch(OX);
+      inBatch=0;
+      Batch.clear();
+    }
+  else if (inBatch)
+    Batch.push_back(Request);
+  else
+    {
+      QueryContext QC;
+      OX<<process(Request,QC)<<"\n";
+    }
+  return 0;
+}
+
+void
+QueryServer::serve(std::istream& IX,std::ostream& OX)
+  /*!
+    Answer requests from a stream until quit/end of input
+    \param IX :: Input stream
+    \param OX :: Output stream
+  */
+{
+  ELog::RegMethod RegA("QueryServer","serve");
+
+  std::string Line;
+  while(std::getline(IX,Line))
+    {
+      const int flag=processLine(Line,OX);
+      OX.flush();
+      if (flag) return;
+    }
+  if (inBatch)
+    runBatch(OX);
+  inBatch=0;
+  Batch.clear();
+  OX.flush();
+  return;
+}
+
+void
+QueryServer::writeAll(const int FD,const std::string& Out)
+  /*!
+    Write a full string to a socket
+    \param FD :: File descriptor
+    \param Out :: String to write
+  */
+{
+  size_t index(0);
+  while(index<Out.size())
+    {
+      const ssize_t N=::write(FD,Out.c_str()+index,Out.size()-index);
+      if (N<0 && errno==EINTR) continue;
+      if (N<=0) return;
+      index+=static_cast<size_t>(N);
+    }
+  return;
+}
+
+void
+QueryServer::serveSocket(const std::string& SName)
+  /*!
+    Answer requests from clients on a UNIX domain socket.
+    Clients are served one at a time until a shutdown request.
+    \param SName :: Socket path [replaced if it exists]
+  */
+{
+  ELog::RegMethod RegA("QueryServer","serveSocket");
+
+  sockaddr_un Addr;
+  std::memset(&Addr,0,sizeof(Addr));
+  Addr.sun_family=AF_UNIX;
+  if (SName.empty() || SName.size()>=sizeof(Addr.sun_path))
+    throw ColErr::FileError(0,SName,"socket path length");
+  std::strncpy(Addr.sun_path,SName.c_str(),sizeof(Addr.sun_path)-1);
+
+  const int serverFD=::socket(AF_UNIX,SOCK_STREAM,0);
+  if (serverFD<0)
+    throw ColErr::FileError(0,SName,"socket");
+  ::unlink(SName.c_str());
+  if (::bind(serverFD,reinterpret_cast<sockaddr*>(&Addr),sizeof(Addr)) ||
+      ::listen(serverFD,4))
+    {
+      ::close(serverFD);
+      throw ColErr::FileError(0,SName,"bind/listen");
+    }
+  ELog::EM<<"Query server on "<<SName<<ELog::endDiag;
+
+  int flag(0);
+  while(flag!=2)
+    {
+      const int clientFD=::accept(serverFD,0,0);
+      if (clientFD<0)
+	{
+	  if (errno==EINTR) continue;
+	  break;
+	}
+      flag=0;
+      char Buffer[4096];
+      std::string Pending;
+      while(!flag)
+	{
+	  const ssize_t N=::read(clientFD,Buffer,sizeof(Buffer));
+	  if (N<0 && errno==EINTR) continue;
+	  if (N<=0) break;
+	  Pending.append(Buffer,static_cast<size_t>(N));
+
+	  std::ostringstream OX;
+	  std::string::size_type pos;
+	  while(!flag && (pos=Pending.find('\n'))!=std::string::npos)
+	    {
+	      flag=processLine(Pending.substr(0,pos),OX);
+	      Pending.erase(0,pos+1);
+	    }
+	  writeAll(clientFD,OX.str());
+	}
+      inBatch=0;
+      Batch.clear();
+      ::close(clientFD);
+    }
+  ::close(serverFD);
+  ::unlink(SName.c_str());
+  return;
+}
+  
+} // Namespace ModelSupport
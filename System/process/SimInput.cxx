@@ -124,6 +124,24 @@ processExitChecks(Simulation& System,const mainSystem::inputParam& IParam)
       ELog::EM<<"SIMVALID TRACK "<<ELog::endDiag;
       ELog::EM<<"-------------- "<<ELog::endDiag;
       ModelSupport::SimValid SValidCheck;
+      if (IParam.flag("validPoint") || IParam.flag("validFC"))
+	SValidCheck.clearCentres();
+      for(size_t i=0;i<IParam.setCnt("validPoint");i++)
+	{
+	  size_t index(0);
+	  SValidCheck.addCentre
+	    (IParam.getCntVec3D("validPoint",i,index,"validPoint"));
+	}
+      for(size_t i=0;i<IParam.setCnt("validFC");i++)
+	{
+	  std::vector<std::string> FCNames;
+	  for(size_t j=0;j<IParam.itemCnt("validFC",i);j++)
+	    FCNames.push_back(IParam.getValue<std::string>("validFC",i,j));
+	  SValidCheck.addFixedComps(FCNames);
+	}
+      SValidCheck.setThreads
+	(IParam.getValue<size_t>((IParam.flag("validThread")) ?
+				 "validThread" : "threads"));
       if (!SValidCheck.run(System,IParam.getValue<size_t>("validCheck")))
 	errFlag += -1;
     }
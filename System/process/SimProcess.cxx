@@ -22,6 +22,7 @@
 #include <fstream>
 #include <iomanip>
 #include <iostream>
+#include <sstream>
 #include <cmath>
 #include <complex> 
 #include <vector>
@@ -43,6 +44,7 @@
 #include "BaseVisit.h"
 #include "BaseModVisit.h"
 #include "support.h"
+#include "stringCombine.h"
 #include "MatrixBase.h"
 #include "Matrix.h"
 #include "Vec3D.h"
@@ -65,7 +67,11 @@
 #include "Source.h"
 #include "KCode.h"
 #include "PhysicsCards.h"
+#include "Surface.h"
 #include "Simulation.h"
+#include "SimPHITS.h"
+#include "SimFLUKA.h"
+#include "version.h"
 #include "SimProcess.h"
 
 namespace SimProcess
@@ -115,6 +121,169 @@ writeIndexSim(Simulation& System,const std::string& FName,const int Number)
   return;
 }
   
+size_t
+findUnique(const std::string& Deck,const std::string& Item)
+  /*!
+    Find the position of an item that is at the start of a 
+    line and only occurs once in the deck
+    \param Deck :: Full deck
+    \param Item :: Item to find
+    \return position / std::string::npos if not found/unique
+  */
+{
+  if (Item.empty()) return std::string::npos;
+  const std::string LItem("\n"+Item);
+  const size_t index=Deck.find(LItem);
+  if (index==std::string::npos ||
+      Deck.find(LItem,index+1)!=std::string::npos)
+    return std::string::npos;
+  return index+1;
+}
+
+void
+writeMultiSim(Simulation& System,const std::string& FName,const int multi)
+  /*!
+    Writes out the same files as writeIndexSim for index 0 to
+    multi-1. The deck is only formatted once: the version line
+    and the RND card are found in it and each file is the 
+    deck with just those two lines replaced. If either is not
+    found [uniquely] each file is written in full.
+    \param System :: Simuation object 
+    \param FName :: basic filename
+    \param multi :: number of files to write
+  */
+{
+  ELog::RegMethod RegA("SimProcess","writeMultiSim");
+
+  physicsSystem::PhysicsCards& PC=System.getPC();
+  version& VR=version::Instance();
+
+  System.prepareWrite();
+  // seeds as writeIndexSim [always one file]
+  std::vector<long int> Seeds;
+  for(int i=0;i<std::max(multi,1);i++)
+    {
+      PC.setRND(PC.getRNDseed()+i*10);
+      Seeds.push_back(PC.getRNDseed());
+    }
+  if (Seeds.size()==1)
+    {
+      System.write(FName+"1.x");
+      return;
+    }
+  
+  // render with the first seed
+  PC.setRND(Seeds.front());
+  const int vNum=VR.getVersion();
+  std::ostringstream cx;
+  System.writeDeck(cx);
+  const std::string Deck(cx.str());
+
+  // version line has a code dependent comment character
+  const std::string VLine("  ========= "+StrFunc::makeString(vNum)+
+			  " ========== \n");
+  const size_t vPos=Deck.find(VLine);
+  std::ostringstream rx;
+  PC.writeRND(rx);
+  const std::string RNDcard(rx.str());
+  const size_t rPos=findUnique(Deck,RNDcard);
+
+  if (vPos==std::string::npos || rPos==std::string::npos || rPos<vPos)
+    {
+      ELog::EM<<"RND card not found : writing files in full"<<ELog::endWarn;
+      std::ofstream OX((FName+"1.x").c_str());
+      OX.write(Deck.c_str(),static_cast<std::streamsize>(Deck.size()));
+      OX.close();
+      for(size_t i=1;i<Seeds.size();i++)
+	{
+	  PC.setRND(Seeds[i]);
+	  System.write(FName+StrFunc::makeString(i+1)+".x");
+	}
+      return;
+    }
+
+  // Deck is : [0 vPos] VLine [vEnd rPos] RNDcard [rEnd size]
+  const size_t vEnd(vPos+VLine.size());
+  const size_t rEnd(rPos+RNDcard.size());
+  const char* DPtr(Deck.c_str());
+  for(size_t i=0;i<Seeds.size();i++)
+    {
+      const int fileVersion=(i) ? VR.getIncrement() : vNum;
+      const std::string VCard("  ========= "+
+			      StrFunc::makeString(fileVersion)+
+			      " ========== \n");
+      PC.setRND(Seeds[i]);
+      std::ostringstream ncx;
+      PC.writeRND(ncx);
+      const std::string RCard(ncx.str());
+      
+      std::ofstream OX((FName+StrFunc::makeString(i+1)+".x").c_str());
+      OX.write(DPtr,static_cast<std::streamsize>(vPos));
+      OX.write(VCard.c_str(),static_cast<std::streamsize>(VCard.size()));
+      OX.write(DPtr+vEnd,static_cast<std::streamsize>(rPos-vEnd));
+      OX.write(RCard.c_str(),static_cast<std::streamsize>(RCard.size()));
+      OX.write(DPtr+rEnd,static_cast<std::streamsize>(Deck.size()-rEnd));
+      OX.close();
+    }
+  return;
+}
+
+void
+writeMultiCode(Simulation& System,const std::string& FName,const int multi)
+  /*!
+    Writes the MCNP, PHITS and FLUKA decks of one simulation.
+    The cells and surfaces are formatted for all three codes 
+    in one [threaded] pass and then each deck is written
+    in turn for each of the random number seeds of writeIndexSim.
+    Files are FName[N].x (MCNP), FName[N].phits and FName[N].inp (FLUKA)
+    \param System :: Simuation object 
+    \param FName :: basic filename
+    \param multi :: number of seeds to write
+  */
+{
+  ELog::RegMethod RegA("SimProcess","writeMultiCode");
+
+  physicsSystem::PhysicsCards& PC=System.getPC();
+
+  System.prepareWrite();
+  std::vector<long int> Seeds;
+  for(int i=0;i<std::max(multi,1);i++)
+    {
+      PC.setRND(PC.getRNDseed()+i*10);
+      Seeds.push_back(PC.getRNDseed());
+    }
+
+  // Cards : MCNP / PHITS / FLUKA / FLUKA material assignment
+  const std::vector<std::string> CellCards=
+    System.formatCells({&MonteCarlo::Object::write,
+	  &MonteCarlo::Object::writePHITS,
+	  &MonteCarlo::Object::writeFLUKA,
+	  &MonteCarlo::Object::writeFLUKAmat});
+  // Surfaces : MCNP [and PHITS] / FLUKA
+  const std::vector<std::string> SurfCards=
+    System.formatSurfaces({&Geometry::Surface::write,
+	  &Geometry::Surface::writeFLUKA});
+
+  for(size_t i=0;i<Seeds.size();i++)
+    {
+      PC.setRND(Seeds[i]);
+      const std::string IName(FName+StrFunc::makeString(i+1));
+
+      std::ofstream MX((IName+".x").c_str());
+      System.writeMCNP(MX,CellCards[0],SurfCards[0]);
+      MX.close();
+
+      std::ofstream PX((IName+".phits").c_str());
+      SimPHITS::writePHITS(System,PX,CellCards[1],SurfCards[0]);
+      PX.close();
+
+      std::ofstream FX((IName+".inp").c_str());
+      SimFLUKA::writeFLUKA(System,FX,CellCards[2],SurfCards[1],CellCards[3]);
+      FX.close();
+    }
+  return;
+}
+  
 void
 writeIndexSimPHITS(Simulation& System,const std::string& FName,
 		   const int Number)
@@ -152,12 +321,11 @@ getIndexVar(const FuncDataBase& Control,
   \return Value
 */
  {
-   ELog::RegMethod RegA("SimProcess","getIndexVar");
-   std::ostringstream cx;
+  ELog::RegMethod RegA("SimProcess","getIndexVar");
 
-   cx<<FName<<index<<BName;
-   if (Control.hasVariable(cx.str()))
-    return Control.EvalVar<T>(cx.str());
+  T Out;
+  if (Control.tryEval(FName,static_cast<long int>(index),BName,Out))
+    return Out;
   // rely on this to throw
   return Control.EvalVar<T>(FName+BName);
 }
@@ -182,13 +350,11 @@ getDefIndexVar(const FuncDataBase& Control,
   */
 {
   ELog::RegMethod RegA("SimProcess","getDefIndexVar");
-  std::ostringstream cx;
-  cx<<FName<<index<<BName;
-  if (Control.hasVariable(cx.str()))
-    return Control.EvalVar<T>(cx.str());
-  if (Control.hasVariable(FName+BName))
-    return Control.EvalVar<T>(FName+BName);
-  return defVal;
+
+  T Out(defVal);
+  if (!Control.tryEval(FName,static_cast<long int>(index),BName,Out))
+    Control.tryEval(FName+BName,Out);
+  return Out;
 }
 
 template<typename T>
@@ -197,7 +363,7 @@ getIndexVec(const FuncDataBase& Control,
 	    const std::string& FName,
 	    const int index,
 	    const std::string& BName,
-	    const std::vector<T>& outVec)
+	    std::vector<T>& outVec)
   /*!
     Get an item based on the FName+BName 
     with interal index. It adds a default value to obtain
@@ -212,30 +378,19 @@ getIndexVec(const FuncDataBase& Control,
 {
   ELog::RegMethod RegA("SimProcess","getIndexVec");
   std::ostringstream cx;
-  std::ostringstream dx;
-  int sndIndex(0);
-  int valid(0);
-  do
+  cx<<FName<<index<<BName;
+  const std::string IName(cx.str());
+  const std::string DName(FName+BName);
+
+  T Value;
+  long int sndIndex(0);
+  while(Control.tryEval(IName,sndIndex,"",Value) ||
+	Control.tryEval(DName,sndIndex,"",Value))
     {
-      valid=0;
-      cx.str("");
-      dx.str("");
-      cx<<FName<<index<<BName<<sndIndex;
-      dx<<FName<<BName<<sndIndex;
-      if (Control.hasVariable(cx.str()))
-	{
-	  outVec.push_back(Control.EvalVar<T>(cx.str()));
-	  valid=1;
-	}
-      else if (Control.hasVariable(dx.str()))
-	{
-	  outVec.push_back(Control.EvalVar<T>(dx.str()));
-	  valid=1;
-	}
+      outVec.push_back(Value);
       sndIndex++;
-    } while(valid);
-
-  return sndIndex-1;
+    }
+  return static_cast<int>(sndIndex);
 }
 
 
@@ -254,8 +409,9 @@ getDefVar(const FuncDataBase& Control,
   */
 {
   ELog::RegMethod RegA("SimProcess","getDefVar");
-  return (Control.hasVariable(VName)) ?
-    Control.EvalVar<T>(VName) : defVal;
+  T Out(defVal);
+  Control.tryEval(VName,Out);
+  return Out;
 }
 
 void
@@ -294,17 +450,13 @@ getVarVec(const FuncDataBase& Control,
 {
   ELog::RegMethod RegA("SimProcess","getVarVec");
 
-  std::ostringstream cx;
   std::vector<T> Out;
-
-  int index(0);
-  cx<<VName<<index;
-  while(Control.hasVariable(cx.str()))
+  T Value;
+  long int index(0);
+  while(Control.tryEval(VName,index,"",Value))
     {
-      Out.push_back(Control.EvalVar<T>(cx.str()));
+      Out.push_back(Value);
       index++;
-      cx.str("");
-      cx<<VName<<index;
     }
   return Out;
 }
@@ -0,0 +1,192 @@
+/********************************************************************* 
+  CombLayer : MCNP(X) Input builder
+ 
+ * File:   process/SimSnapShot.cxx
+ *
+ * Copyright (c) 2004-2016 by Stuart Ansell
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>. 
+ *
+ ****************************************************************************/
+#include <fstream>
+#include <iomanip>
+#include <iostream>
+#include <sstream>
+#include <cmath>
+#include <complex> 
+#include <vector>
+#include <map> 
+#include <list> 
+#include <set>
+#include <string>
+#include <algorithm>
+#include <memory>
+
+#include "Exception.h"
+#include "FileReport.h"
+#include "NameStack.h"
+#include "RegMethod.h"
+#include "GTKreport.h"
+#include "OutputLog.h"
+#include "BaseVisit.h"
+#include "BaseModVisit.h"
+#include "support.h"
+#include "binaryIO.h"
+#include "MatrixBase.h"
+#include "Matrix.h"
+#include "Vec3D.h"
+#include "Surface.h"
+#include "surfaceFactory.h"
+#include "surfIndex.h"
+#include "Rules.h"
+#include "Code.h"
+#include "varList.h"
+#include "FuncDataBase.h"
+#include "HeadRule.h"
+#include "Object.h"
+#include "Qhull.h"
+#include "Zaid.h"
+#include "MXcards.h"
+#include "Material.h"
+#include "DBMaterial.h"
+#include "objectRegister.h"
+#include "Simulation.h"
+#include "SimSnapShot.h"
+
+namespace SimProcess
+{
+
+/// Identifier at the start of a snapshot file
+static const std::string snapMagic("CombLayerSnapShot");
+/// Format version of the snapshot file
+static const int snapVersion(1);
+
+void
+writeSnapShot(const Simulation& System,const std::string& FName)
+  /*!
+    Write the finished geometry to a binary file so
+    it can be reloaded without building the model.
+    The file holds the objectRegister cell ranges,
+    the materials used, the surfaces and the cells.
+    \param System :: Simulation to write
+    \param FName :: Output file name
+  */
+{
+  ELog::RegMethod RegA("SimSnapShot[F]","writeSnapShot");
+
+  const ModelSupport::DBMaterial& DB=
+    ModelSupport::DBMaterial::Instance();
+  const ModelSupport::surfIndex::STYPE& SMap=
+    ModelSupport::surfIndex::Instance().surMap();
+  const Simulation::OTYPE& Cells=System.getCells();
+
+  std::ofstream OX(FName.c_str(),std::ios::binary);
+  if (!OX.good())
+    throw ColErr::FileError(0,FName,"writeSnapShot");
+
+  StrFunc::writeBin(OX,snapMagic);
+  StrFunc::writeBin(OX,snapVersion);
+
+  ModelSupport::objectRegister::Instance().writeBinary(OX);
+
+  std::set<int> matSet;
+  for(const Simulation::OTYPE::value_type& OV : Cells)
+    if (OV.second->getMat())
+      matSet.insert(OV.second->getMat());
+  StrFunc::writeBin(OX,matSet.size());
+  for(const int MN : matSet)
+    DB.getMaterial(MN).writeBinary(OX);
+
+  StrFunc::writeBin(OX,SMap.size());
+  for(const ModelSupport::surfIndex::STYPE::value_type& SV : SMap)
+    {
+      StrFunc::writeBin(OX,SV.second->className());
+      SV.second->writeBinary(OX);
+    }
+
+  StrFunc::writeBin(OX,Cells.size());
+  for(const Simulation::OTYPE::value_type& OV : Cells)
+    OV.second->writeBinary(OX);
+
+  ELog::EM<<"Snapshot "<<FName<<" : "<<Cells.size()<<" cells "
+	  <<SMap.size()<<" surfaces"<<ELog::endDiag;
+  return;
+}
+
+void
+readSnapShot(Simulation& System,const std::string& FName)
+  /*!
+    Replace the geometry of the simulation with
+    a snapshot from writeSnapShot. The object surface
+    map is rebuilt from the cells.
+    \param System :: Simulation to fill [reset]
+    \param FName :: Snapshot file name
+  */
+{
+  ELog::RegMethod RegA("SimSnapShot[F]","readSnapShot");
+
+  ModelSupport::DBMaterial& DB=ModelSupport::DBMaterial::Instance();
+  ModelSupport::surfIndex& SI=ModelSupport::surfIndex::Instance();
+  const Geometry::surfaceFactory& SF=Geometry::surfaceFactory::Instance();
+
+  std::ifstream IX(FName.c_str(),std::ios::binary);
+  if (!IX.good())
+    throw ColErr::FileError(0,FName,"readSnapShot");
+
+  std::string Magic;
+  int version;
+  StrFunc::readBin(IX,Magic);
+  if (Magic!=snapMagic)
+    throw ColErr::InvalidLine(Magic,FName+" not a snapshot",0);
+  StrFunc::readBin(IX,version);
+  if (version!=snapVersion)
+    throw ColErr::MisMatch<int>(version,snapVersion,"snapshot version");
+
+  System.resetAll();
+  ModelSupport::objectRegister::Instance().readBinary(IX);
+
+  size_t nItem;
+  StrFunc::readBin(IX,nItem);
+  for(size_t i=0;i<nItem;i++)
+    {
+      MonteCarlo::Material MObj;
+      MObj.readBinary(IX);
+      DB.resetMaterial(MObj);
+    }
+
+  StrFunc::readBin(IX,nItem);
+  for(size_t i=0;i<nItem;i++)
+    {
+      std::string SName;
+      StrFunc::readBin(IX,SName);
+      Geometry::Surface* SPtr=SF.createSurface(SName);
+      SPtr->readBinary(IX);
+      SI.insertSurface(SPtr);
+    }
+
+  StrFunc::readBin(IX,nItem);
+  for(size_t i=0;i<nItem;i++)
+    {
+      MonteCarlo::Qhull QH;
+      QH.readBinary(IX);
+      System.addCell(QH.getName(),QH);
+    }
+  System.createObjSurfMap();
+
+  ELog::EM<<"Snapshot "<<FName<<" : "<<System.getCells().size()
+	  <<" cells "<<SI.surMap().size()<<" surfaces"<<ELog::endDiag;
+  return;
+}
+
+}  // NAMESPACE SimProcess
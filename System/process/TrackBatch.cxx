@@ -0,0 +1,374 @@
+/********************************************************************* 
+  CombLayer : MCNP(X) Input builder
+ 
+ * File:   process/TrackBatch.cxx
+ *
+ * Copyright (c) 2004-2016 by Stuart Ansell
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>. 
+ *
+ ****************************************************************************/
+#include <fstream>
+#include <iomanip>
+#include <iostream>
+#include <cmath>
+#include <complex> 
+#include <vector>
+#include <set> 
+#include <map> 
+#include <string>
+#include <algorithm>
+#include <memory>
+#include <thread>
+#include <atomic>
+#include <exception>
+
+#include "Exception.h"
+#include "FileReport.h"
+#include "NameStack.h"
+#include "RegMethod.h"
+#include "GTKreport.h"
+#include "OutputLog.h"
+#include "BaseVisit.h"
+#include "BaseModVisit.h"
+#include "MatrixBase.h"
+#include "Matrix.h"
+#include "Vec3D.h"
+#include "Surface.h"
+#include "Quadratic.h"
+#include "Plane.h"
+#include "varList.h"
+#include "Code.h"
+#include "FItem.h"
+#include "FuncDataBase.h"
+#include "BnId.h"
+#include "Rules.h"
+#include "neutron.h"
+#include "Line.h"
+#include "LineIntersectVisit.h"
+#include "SenseTrack.h"
+#include "HeadRule.h"
+#include "Object.h"
+#include "Qhull.h"
+#include "ObjSurfMap.h"
+#include "QueryContext.h"
+#include "Simulation.h"
+#include "SimTrack.h"
+#include "Zaid.h"
+#include "MXcards.h"
+#include "Material.h"
+#include "DBMaterial.h"
+#include "LineTrack.h"
+#include "TrackBatch.h"
+
+namespace ModelSupport
+{
+
+const size_t TrackBatch::blockSize(64);
+
+TrackBatch::TrackBatch(const Geometry::Vec3D& PtA) :
+  nThread(0),TargetPt(PtA),TargetPlane(0)
+  /*! 
+    Constructor 
+    \param PtA :: Target point
+  */
+{}
+
+TrackBatch::TrackBatch(const Geometry::Plane& PA) :
+  nThread(0),TargetPlane(&PA)
+  /*! 
+    Constructor 
+    \param PA :: Target plane [must exist for the life of the object]
+  */
+{}
+
+TrackBatch::TrackBatch(const TrackBatch& A) :
+  nThread(A.nThread),TargetPt(A.TargetPt),
+  TargetPlane(A.TargetPlane)
+  /*! 
+    Copy Constructor 
+    \param A :: TrackBatch to copy
+  */
+{}
+
+TrackBatch&
+TrackBatch::operator=(const TrackBatch& A) 
+  /*! 
+    Assignment operator
+    \param A :: TrackBatch to copy
+    \return *this
+  */
+{
+  if (this!=&A)
+    {
+      nThread=A.nThread;
+      TargetPt=A.TargetPt;
+      TargetPlane=A.TargetPlane;
+    }
+  return *this;
+}
+
+Geometry::Vec3D
+TrackBatch::endPoint(const Geometry::Vec3D& IPt) const
+  /*!
+    Get the end point of a track
+    \param IPt :: Initial point
+    \return target point / closest point on the target plane
+  */
+{
+  return (TargetPlane) ? TargetPlane->closestPt(IPt) : TargetPt;
+}
+
+const std::pair<double,double>&
+TrackBatch::matFactor(matTYPE& MCache,const int matN)
+  /*!
+    Get the material factors from the cache [thread local]
+    \param MCache :: Cache of material factors
+    \param matN :: Material number
+    \return pow(A,0.66) : atom density
+  */
+{
+  matTYPE::const_iterator mc=MCache.find(matN);
+  if (mc==MCache.end())
+    {
+      const ModelSupport::DBMaterial& DB=
+	ModelSupport::DBMaterial::Instance();
+      const MonteCarlo::Material& matInfo=DB.getMaterial(matN);
+      mc=MCache.emplace
+	(matN,std::pair<double,double>
+	 (std::pow(matInfo.getMeanA(),0.66),
+	  matInfo.getAtomDensity())).first;
+    }
+  return mc->second;
+}
+
+int
+TrackBatch::attnTrack(const Simulation& System,QueryContext& QC,
+		      matTYPE& MCache,const Geometry::Vec3D& IPt,
+		      double& sum) const
+  /*!
+    Track from IPt to the target and sum the attenuation.
+    The stepping is that of LineTrack::calculate. The cell
+    hint in QC is that left by the previous track.
+    \param System :: Simulation to use
+    \param QC :: Query context of the block
+    \param MCache :: Material factors of thread
+    \param IPt :: Initial point
+    \param sum :: Attenuation sum 
+    \return 1 on success / 0 if tracking failed
+  */
+{
+  const Geometry::Vec3D EPt(endPoint(IPt));
+  const double aimDist((EPt-IPt).abs());
+  const ModelSupport::ObjSurfMap* OSMPtr =System.getOSM();
+
+  sum=0.0;
+  double TDist(0.0);
+  double aDist(0.0);
+  const Geometry::Surface* SPtr;
+
+  MonteCarlo::neutron nOut(1.0,IPt,EPt-IPt);
+  MonteCarlo::LineIntersectVisit LI(nOut);   // work space for track
+  MonteCarlo::SenseTrack ST;                 // surface senses of track
+  MonteCarlo::Object* OPtr=
+    System.findCell(IPt+(EPt-IPt).unit()*1e-5,0,QC);
+  if (!OPtr) return 0;
+
+  int SN=OPtr->isOnSide(IPt);
+  while(OPtr)
+    {
+      SN= OPtr->trackOutCell(nOut,aDist,SPtr,abs(SN),LI,ST);
+      if (!SN) break;
+
+      TDist+=aDist;
+      const bool endFlag(aimDist-TDist < -Geometry::zeroTol);
+      const int matN(OPtr->getMat());
+      if (matN)
+	{
+	  const std::pair<double,double>& MF=matFactor(MCache,matN);
+	  const double D((endFlag) ? aDist-TDist+aimDist : aDist);
+	  sum+=D*MF.first*MF.second;
+	}
+      if (endFlag) break;
+	
+      nOut.moveForward(aDist);
+      OPtr=OSMPtr->findNextObject(SN,nOut.Pos,OPtr->getName(),QC);
+      if (!OPtr) return 0;
+      if (aDist<Geometry::zeroTol)
+	OPtr=System.findCell(nOut.Pos,0,QC);
+    }
+  return 1;
+}
+
+void
+TrackBatch::attnBlock(const Simulation& System,QueryContext& QC,
+		      matTYPE& MCache,
+		      const std::vector<Geometry::Vec3D>& Pts,
+		      const size_t IA,const size_t IB,
+		      std::vector<double>& Attn,
+		      std::vector<char>& Good) const
+  /*!
+    Track the points [IA,IB) in order, each seeded by the
+    cell hint left by the previous track
+    \param System :: Simulation to use
+    \param QC :: Query context [hint of the track before IA]
+    \param MCache :: Material factors of thread
+    \param Pts :: Initial points
+    \param IA :: First point
+    \param IB :: One past the last point
+    \param Attn :: Attenuation sum for each point
+    \param Good :: Tracking success for each point
+  */
+{
+  for(size_t index=IA;index<IB;index++)
+    Good[index]=static_cast<char>
+      (attnTrack(System,QC,MCache,Pts[index],Attn[index]));
+  return;
+}
+
+double
+TrackBatch::lineAttn(const Simulation& System,
+		     const Geometry::Vec3D& IPt) const
+  /*!
+    Serial track through LineTrack [with failure reporting]
+    \param System :: Simulation to use
+    \param IPt :: Initial point
+    \return Attenuation sum
+  */
+{
+  ELog::RegMethod RegA("TrackBatch","lineAttn");
+
+  LineTrack A(IPt,endPoint(IPt));
+  A.calculate(System);
+
+  matTYPE MCache;
+  const std::vector<MonteCarlo::Object*>& OVec=A.getObjVec();
+  const std::vector<double>& TVec=A.getTrack();
+  double sum(0.0);
+  for(size_t i=0;i<TVec.size();i++)
+    {
+      const int matN=OVec[i]->getMat();
+      if (matN)
+	{
+	  const std::pair<double,double>& MF=matFactor(MCache,matN);
+	  sum+=TVec[i]*MF.first*MF.second;
+	}
+    }
+  return sum;
+}
+  
+void
+TrackBatch::calculate(const Simulation& System,
+		      const std::vector<Geometry::Vec3D>& Pts,
+		      std::vector<double>& Attn) const
+  /*!
+    Calculate the attenuation of each point to the target.
+    As in the serial LineTrack loop, each track is seeded with 
+    the cell hint of the previous track. Each block is seeded
+    by first tracking the point before it. After the join the 
+    seeds are checked along the serial chain [from the SimTrack 
+    cell] and a block with a different seed is re-tracked in 
+    order, so the result is that of the serial loop.
+    \param System :: Simulation to use
+    \param Pts :: Initial points
+    \param Attn :: Attenuation sum for each point
+  */
+{
+  ELog::RegMethod RegA("TrackBatch","calculate");
+
+  Attn.assign(Pts.size(),0.0);
+  if (Pts.empty()) return;
+  
+  size_t NT(nThread);
+  if (!NT)
+    NT=static_cast<size_t>(std::thread::hardware_concurrency());
+  // a single thread is one block : the hint runs through every track
+  const size_t bSize((NT==1) ? Pts.size() : blockSize);
+  const size_t nBlock((Pts.size()+bSize-1)/bSize);
+  NT=std::max<size_t>(1,std::min(NT,nBlock));
+
+  SimTrack& ST(SimTrack::Instance());
+  const size_t cellVersion(System.getCellVersion());
+  MonteCarlo::Object* const startCell(ST.curCell(&System));
+  std::vector<MonteCarlo::Object*> SeedCell(nBlock,startCell);
+  std::vector<MonteCarlo::Object*> EndCell(nBlock,0);
+
+  std::vector<char> Good(Pts.size(),0);
+  std::atomic<size_t> blockCnt(0);
+  std::vector<std::exception_ptr> TError(NT);
+  std::vector<std::thread> TUnit;
+  for(size_t i=0;i<NT;i++)
+    {
+      TUnit.push_back
+	(std::thread([&,i]()
+		     {
+		       try
+			 {
+			   matTYPE MCache;
+			   for(size_t B=blockCnt++;B<nBlock;B=blockCnt++)
+			     {
+			       QueryContext QC;
+			       if (B)
+				 {
+				   // seed : hint after the previous track
+				   double sum;
+				   attnTrack(System,QC,MCache,
+					     Pts[B*bSize-1],sum);
+				   SeedCell[B]=QC.getCell(cellVersion);
+				 }
+			       else
+				 QC.setCell(cellVersion,startCell);
+			       attnBlock(System,QC,MCache,Pts,B*bSize,
+					 std::min(Pts.size(),(B+1)*bSize),
+					 Attn,Good);
+			       EndCell[B]=QC.getCell(cellVersion);
+			     }
+			 }
+		       catch (...)
+			 {
+			   TError[i]=std::current_exception();
+			 }
+		     }));
+    }
+  for(std::thread& TU : TUnit)
+    TU.join();
+  for(const std::exception_ptr& EP : TError)
+    if (EP) std::rethrow_exception(EP);
+
+  // serial chain : re-track blocks that had a different seed
+  MonteCarlo::Object* hintCell(startCell);
+  matTYPE MCache;
+  for(size_t B=0;B<nBlock;B++)
+    {
+      if (SeedCell[B]!=hintCell)
+	{
+	  QueryContext QC;
+	  QC.setCell(cellVersion,hintCell);
+	  attnBlock(System,QC,MCache,Pts,B*bSize,
+		    std::min(Pts.size(),(B+1)*bSize),Attn,Good);
+	  EndCell[B]=QC.getCell(cellVersion);
+	}
+      hintCell=EndCell[B];
+    }
+  ST.setCell(&System,hintCell);
+
+  // failed tracks are re-run serially for the error trace
+  for(size_t index=0;index<Pts.size();index++)
+    if (!Good[index])
+      Attn[index]=lineAttn(System,Pts[index]);
+  
+  return;
+}
+  
+} // Namespace ModelSupport
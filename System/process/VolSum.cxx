@@ -31,6 +31,11 @@
 #include <set>
 #include <vector>
 #include <memory>
+#include <algorithm>
+#include <cstdint>
+#include <thread>
+#include <atomic>
+#include <exception>
 #include <boost/format.hpp>
 
 #include "Exception.h"
@@ -39,6 +44,7 @@
 #include "RegMethod.h"
 #include "OutputLog.h"
 #include "MersenneTwister.h"
+#include "SobolSeq.h"
 #include "BaseVisit.h"
 #include "BaseModVisit.h"
 #include "support.h"
@@ -62,8 +68,14 @@
 #include "Tally.h"
 #include "cellFluxTally.h"
 #include "ObjSurfMap.h"
+#include "QueryContext.h"
 #include "neutron.h"
+#include "Line.h"
+#include "LineIntersectVisit.h"
+#include "SenseTrack.h"
 #include "Simulation.h"
+#include "BoundBox.h"
+#include "AnalyticVolume.h"
 #include "volUnit.h"
 #include "VolSum.h"
 
@@ -72,11 +84,15 @@ extern MTRand RNG;
 namespace ModelSupport
 {
 
+const size_t VolSum::batchSize(10000);
+const size_t VolSum::roundSize(16);
+
 VolSum::VolSum(const Geometry::Vec3D& OPt,
 	       const Geometry::Vec3D& AxisRange) : 
   Origin(OPt),X(fabs(AxisRange[0]),0,0),
   Y(0,fabs(AxisRange[1]),0),Z(0,0,fabs(AxisRange[2])),
-  fullVol(0.0),totalDist(0),nTracks(0)
+  fullVol(0.0),totalDist(0),nTracks(0),nThread(0),sampleType(0),
+  analytic(0)
   /*!
     Constructor
     \param OPt :: Centre
@@ -87,7 +103,8 @@ VolSum::VolSum(const Geometry::Vec3D& OPt,
 VolSum::VolSum(const VolSum& A) : 
   Origin(A.Origin),X(A.X),Y(A.Y),Z(A.Z),
   fullVol(A.fullVol),totalDist(A.totalDist),
-  nTracks(A.nTracks),tallyVols(A.tallyVols)
+  nTracks(A.nTracks),nThread(A.nThread),sampleType(A.sampleType),
+  analytic(A.analytic),tallyVols(A.tallyVols),exactVol(A.exactVol)
   /*!
     Copy constructor
     \param A :: VolSum to copy
@@ -111,7 +128,11 @@ VolSum::operator=(const VolSum& A)
       fullVol=A.fullVol;
       totalDist=A.totalDist;
       nTracks=A.nTracks;
+      nThread=A.nThread;
+      sampleType=A.sampleType;
+      analytic=A.analytic;
       tallyVols=A.tallyVols;
+      exactVol=A.exactVol;
     }
   return *this;
 }
@@ -277,6 +298,37 @@ VolSum::addFlux(const int ObjN,const double& R,const double& D)
   return;
 }
 
+void
+VolSum::endHistory()
+  /*!
+    Close the history on all the tally units
+   */
+{
+  for(tvTYPE::value_type& TV : tallyVols)
+    TV.second.endHistory();
+  return;
+}
+
+void
+VolSum::setSampling(const std::string& Type)
+  /*!
+    Set the point sampling used by adaptiveRun
+    \param Type :: random / stratified / sobol
+  */
+{
+  ELog::RegMethod RegA("VolSum","setSampling");
+
+  if (Type=="random" || Type=="Random")
+    sampleType=0;
+  else if (Type=="stratified" || Type=="Stratified")
+    sampleType=1;
+  else if (Type=="sobol" || Type=="Sobol")
+    sampleType=2;
+  else
+    throw ColErr::InContainerError<std::string>(Type,"Sample type");
+  return;
+}
+
 void
 VolSum::reset()
   /*!
@@ -287,6 +339,7 @@ VolSum::reset()
   std::map<int,volUnit>::iterator mc;
   for(mc=tallyVols.begin();mc!=tallyVols.end();mc++)
     mc->second.reset();
+  exactVol.clear();
   nTracks=0;
   totalDist=0.0;
   return;
@@ -317,11 +370,224 @@ VolSum::pointRun(const Simulation& System,const size_t N)
 			 Z*(RNG.rand()-0.5));
       OPtr=System.findCell(Pt,OPtr);
       addDistance(OPtr->getName(),1.0);
+      endHistory();
     }
   nTracks+=N;
   return;
 }
 
+void
+VolSum::sampleBatch(const Simulation& System,const cuTYPE& CellUnit,
+		    const SobolSeq& SS,const unsigned long int seed,
+		    const size_t nStart,const size_t nEnd,
+		    QueryContext& QC,std::vector<size_t>& Hits) const
+  /*!
+    Sample one batch of points
+    \param System :: Simulation to use
+    \param CellUnit :: Cell number to tally unit index
+    \param SS :: Sobol sequence [sobol sampling only]
+    \param seed :: Random seed of batch
+    \param nStart :: First point index
+    \param nEnd :: Last point index + 1
+    \param QC :: Query context of thread
+    \param Hits :: Number of points found in each tally unit
+  */
+{
+  static const size_t nStrata(21);   // 21^3 < batchSize
+  static const size_t nCube(nStrata*nStrata*nStrata);
+
+  MTRand Rand(static_cast<MTRand::uint32>(seed));
+  MonteCarlo::Object* OPtr(0);
+  const MonteCarlo::Object* lastPtr(0);
+  const std::vector<size_t>* unitPtr(0);
+  for(size_t i=nStart;i<nEnd;i++)
+    {
+      double a,b,c;
+      if (sampleType==2)
+	SS.getPoint(i,a,b,c);
+      else if (sampleType==1)
+	{
+	  const size_t s(i % nCube);
+	  const double sN(static_cast<double>(nStrata));
+	  a=(static_cast<double>(s % nStrata)+Rand.randExc())/sN;
+	  b=(static_cast<double>((s/nStrata) % nStrata)+Rand.randExc())/sN;
+	  c=(static_cast<double>(s/(nStrata*nStrata))+Rand.randExc())/sN;
+	}
+      else
+	{
+	  a=Rand.randExc();
+	  b=Rand.randExc();
+	  c=Rand.randExc();
+	}
+      const Geometry::Vec3D Pt(Origin+X*(a-0.5)+Y*(b-0.5)+Z*(c-0.5));
+      OPtr=System.findCell(Pt,OPtr,QC);
+      if (!OPtr) continue;
+      if (OPtr!=lastPtr)
+	{
+	  lastPtr=OPtr;
+	  cuTYPE::const_iterator mc=CellUnit.find(OPtr->getName());
+	  unitPtr=(mc!=CellUnit.end()) ? &mc->second : 0;
+	}
+      if (unitPtr)
+	for(const size_t U : *unitPtr)
+	  Hits[U]++;
+    }
+  return;
+}
+
+void
+VolSum::calcExact(const Simulation& System)
+  /*!
+    Find the tally units that have an exact volume: all
+    the cells are analytic and within the sample box
+    \param System :: Simulation to use
+  */
+{
+  ELog::RegMethod RegA("VolSum","calcExact");
+
+  const Geometry::Vec3D LowPt(Origin-(X+Y+Z)/2.0);
+  const Geometry::Vec3D HighPt(Origin+(X+Y+Z)/2.0);
+  const Geometry::BoundBox SampleBox(LowPt,HighPt);
+  
+  std::map<int,double> CellVol;       // cell : volume [-ve : not exact]
+  for(const tvTYPE::value_type& TV : tallyVols)
+    {
+      double sumVol(0.0);
+      for(const int CN : TV.second.getCells())
+	{
+	  std::map<int,double>::const_iterator mc=CellVol.find(CN);
+	  if (mc==CellVol.end())
+	    {
+	      double V(-1.0);
+	      const MonteCarlo::Qhull* QPtr=System.findQhull(CN);
+	      if (QPtr)
+		{
+		  const Geometry::BoundBox& BBox=QPtr->getBoundBox();
+		  if (!BBox.isFinite() ||
+		      !SampleBox.isValid(BBox.getLow()) ||
+		      !SampleBox.isValid(BBox.getHigh()) ||
+		      !analyticVolume(*QPtr,V))
+		    V=-1.0;
+		}
+	      mc=CellVol.insert(std::pair<int,double>(CN,V)).first;
+	    }
+	  if (mc->second<0.0)
+	    {
+	      sumVol= -1.0;
+	      break;
+	    }
+	  sumVol+=mc->second;
+	}
+      if (sumVol>=0.0)
+	exactVol.insert(std::pair<int,double>(TV.first,sumVol));
+    }
+  ELog::EM<<"Exact volumes for "<<exactVol.size()<<" of "
+	  <<tallyVols.size()<<" tallies"<<ELog::endDiag;
+  return;
+}
+
+void
+VolSum::adaptiveRun(const Simulation& System,const size_t maxN,
+		    const double relErr)
+  /*!
+    Calculate the volumes by point sampling over several
+    threads. Points are taken in rounds of batches and the
+    run stops once every tally unit has a relative error 
+    less than relErr [or maxN points are used].
+    \param System :: Simulation to use
+    \param maxN :: Maximum number of points 
+    \param relErr :: Target relative error [0 : run all points]
+  */
+{
+  ELog::RegMethod RegA("VolSum","adaptiveRun");
+
+  reset();
+  fullVol=X.abs()*Y.abs()*Z.abs();
+  if (analytic)
+    calcExact(System);
+  
+  std::vector<volUnit*> UPtr;
+  cuTYPE CellUnit;
+  for(tvTYPE::value_type& TV : tallyVols)
+    {
+      if (exactVol.find(TV.first)!=exactVol.end()) continue;
+      for(const int CN : TV.second.getCells())
+	CellUnit[CN].push_back(UPtr.size());
+      UPtr.push_back(&TV.second);
+    }
+  const size_t nUnit(UPtr.size());
+  if (!maxN || !nUnit) return;
+
+  // global RNG only sets the streams
+  const unsigned long int baseSeed=RNG.randInt();
+  SobolSeq SS;
+  SS.setShift(RNG.randInt(),RNG.randInt(),RNG.randInt());
+  
+  const size_t nBatch((maxN+batchSize-1)/batchSize);
+  size_t NT(nThread);
+  if (!NT)
+    NT=static_cast<size_t>(std::thread::hardware_concurrency());
+  NT=std::max<size_t>(1,std::min(NT,std::min(nBatch,roundSize)));
+  
+  std::vector<ModelSupport::QueryContext> QCVec(NT);
+  size_t batchIndex(0);
+  double maxErr(1.0);
+  while(batchIndex<nBatch)
+    {
+      const size_t firstBatch(batchIndex);
+      const size_t nRound(std::min(roundSize,nBatch-batchIndex));
+      std::vector<std::vector<size_t>> Hits
+	(nRound,std::vector<size_t>(nUnit,0));
+
+      std::atomic<size_t> batchCnt(0);
+      std::vector<std::exception_ptr> TError(NT);
+      std::vector<std::thread> TUnit;
+      for(size_t i=0;i<NT;i++)
+	{
+	  TUnit.push_back
+	    (std::thread([&,i]()
+			 {
+			   try
+			     {
+			       for(size_t B=batchCnt++;B<nRound;
+				   B=batchCnt++)
+				 {
+				   const size_t BI(firstBatch+B);
+				   sampleBatch(System,CellUnit,SS,baseSeed+BI,
+					       BI*batchSize,
+					       std::min(maxN,(BI+1)*batchSize),
+					       QCVec[i],Hits[B]);
+				 }
+			     }
+			   catch (...)
+			     {
+			       TError[i]=std::current_exception();
+			     }
+			 }));
+	}
+      for(std::thread& TU : TUnit)
+	TU.join();
+      for(const std::exception_ptr& EP : TError)
+	if (EP) std::rethrow_exception(EP);
+
+      // Sum in batch order
+      for(const std::vector<size_t>& BH : Hits)
+	for(size_t U=0;U<nUnit;U++)
+	  UPtr[U]->addPoints(BH[U]);
+      batchIndex+=nRound;
+      nTracks=std::min(maxN,batchIndex*batchSize);
+
+      maxErr=0.0;
+      for(const volUnit* VU : UPtr)
+	maxErr=std::max(maxErr,VU->calcError(static_cast<double>(nTracks)));
+      if (relErr>0.0 && maxErr<=relErr)
+	break;
+    }
+  ELog::EM<<"Volume points == "<<nTracks<<" : max relative error == "
+	  <<maxErr<<ELog::endDiag;
+  return;
+}
+
 Geometry::Vec3D
 VolSum::getCubePoint() const
   /*!
@@ -384,6 +650,9 @@ VolSum::trackRun(const Simulation& System,const size_t N)
   
   const Geometry::Surface* SPtr;          // Output surface
   double aDist;       
+  MonteCarlo::LineIntersectVisit LI(Geometry::Vec3D(0,0,0),
+				    Geometry::Vec3D(1,0,0));
+  MonteCarlo::SenseTrack ST;
 
   // Note for sphere that you can use X,Y,Z in any orthogonal 
   // directiron
@@ -407,7 +676,7 @@ VolSum::trackRun(const Simulation& System,const size_t N)
       while(OPtr)
 	{
 	  // Note: Need OPPOSITE Sign on exiting surface
-	  SN= -OPtr->trackOutCell(TNeut,aDist,SPtr,-SN);
+	  SN= -OPtr->trackOutCell(TNeut,aDist,SPtr,-SN,LI,ST);
 	  trackDistance-=aDist;
 	  if (trackDistance > 0.0)
 	    {
@@ -428,6 +697,7 @@ VolSum::trackRun(const Simulation& System,const size_t N)
 	      OPtr=0;
 	    }
 	}
+      endHistory();
     }
   ELog::EM<<"Total Dist == "<<totalDist<<ELog::endTrace;  
   nTracks+=N;
@@ -443,7 +713,9 @@ VolSum::calcVolume(const int TN) const
    */
 {
   ELog::RegMethod RegA("VolSum","calcVolume");
-
+  std::map<int,double>::const_iterator ec=exactVol.find(TN);
+  if (ec!=exactVol.end())
+    return ec->second;
   if (nTracks<1) return 0.0;
   std::map<int,volUnit>::const_iterator mc;
   mc=tallyVols.find(TN);
@@ -453,6 +725,25 @@ VolSum::calcVolume(const int TN) const
   return 0.0;
 }
 
+double
+VolSum::calcError(const int TN) const
+  /*!
+    Calcuate the relative error of the volume of a tally unit
+    \param TN :: Tally number
+    \return Relative error
+   */
+{
+  ELog::RegMethod RegA("VolSum","calcError");
+  if (exactVol.find(TN)!=exactVol.end())
+    return 0.0;
+  if (nTracks<1) return 1.0;
+  tvTYPE::const_iterator mc=tallyVols.find(TN);
+  if (mc!=tallyVols.end())
+    return mc->second.calcError(static_cast<double>(nTracks));
+  ELog::EM<<"No tally of value "<<TN<<ELog::endErr;
+  return 1.0;
+}
+
 
 void 
 VolSum::write(const std::string& OFile) const
@@ -462,12 +753,12 @@ VolSum::write(const std::string& OFile) const
   */
 {
   ELog::RegMethod RegA("VolSum","write");
-  boost::format FMTI3("%3d  %11.5e %c  mat%3d %s");
+  boost::format FMTI3("%3d  %11.5e %7.5f %c  mat%3d %s");
   
   std::ofstream OX(OFile.c_str());
   
-  OX<<"FluxName   Volume(cc)  Sf Matrl  Description"<<std::endl;
-  OX<<"========  ============ == ====== "
+  OX<<"FluxName   Volume(cc)  RelErr  Sf Matrl  Description"<<std::endl;
+  OX<<"========  ============ ======= == ====== "
     <<"================================================ "<<std::endl;
 
   char sf='a';  
@@ -475,7 +766,7 @@ VolSum::write(const std::string& OFile) const
   for(mc=tallyVols.begin();mc!=tallyVols.end();mc++)
     {
       OX<<"tally"<<(FMTI3 % mc->first % 
-		    (fullVol*mc->second.calcVol(1.0/nTracks)) %
+		    calcVolume(mc->first) % calcError(mc->first) %
 		    sf % mc->second.getMat() % 
 		    mc->second.getComment())<<std::endl;
       sf++;
@@ -85,7 +85,10 @@ calcVolumes(Simulation* SimPtr,const mainSystem::inputParam& IParam)
       else
 	VTally.populateTally(*SimPtr);
 
-      VTally.pointRun(*SimPtr,NP);
+      VTally.setThreads(IParam.getValue<size_t>("threads"));
+      VTally.setSampling(IParam.getValue<std::string>("volSample"));
+      VTally.setAnalytic(1);
+      VTally.adaptiveRun(*SimPtr,NP,IParam.getValue<double>("volErr"));
       ELog::EM<<"Volume == "<<Org<<" : "<<XYZ<<" : "<<NP<<ELog::endDiag;
       VTally.write("volumes");
     }
@@ -23,6 +23,7 @@
 #include <iomanip>
 #include <iostream>
 #include <sstream>
+#include <cstdio>
 #include <cmath>
 #include <complex>
 #include <list>
@@ -30,16 +31,13 @@
 #include <set>
 #include <map>
 #include <string>
-#include <boost/format.hpp>
 
 #include "Exception.h"
 #include "Vec3D.h"
 #include "masterWrite.h"
 
 masterWrite::masterWrite() :
-  zeroTol(1e-20),sigFig(6),
-  FMTdouble("%1.6g"),
-  FMTinteger("%1d")
+  zeroTol(1e-20),sigFig(6)
   /*!
     Constructor
   */
@@ -65,9 +63,7 @@ masterWrite::setSigFig(const int S)
 {
   if (S<=0)
     throw ColErr::IndexError<int>(S,0,"masterWrite::setSigFig");
-  std::ostringstream cx;
-  cx<<"\%1."<<S<<"g";
-  FMTdouble=boost::format(cx.str());
+  sigFig=S;
   return;
 }
 
@@ -85,7 +81,8 @@ masterWrite::setZero(const double Z)
 std::string
 masterWrite::Num(const double& D)
   /*!
-    Write out a specific double
+    Write out a specific double. Formatted with a local
+    buffer [%1.<sigFig>g] so it can be used by concurrent writers.
     \param D :: number to process
     \return formated number / 0.0 
    */
@@ -93,7 +90,9 @@ masterWrite::Num(const double& D)
   if (fabs(D)<zeroTol)
     return "0.0";
 
-  return (FMTdouble % D).str();
+  char buffer[64];
+  std::snprintf(buffer,sizeof(buffer),"%1.*g",sigFig,D);
+  return std::string(buffer);
 }
   
 std::string
@@ -104,7 +103,9 @@ masterWrite::Num(const int& I)
     \return formated number
   */
 {
-  return (FMTinteger % I).str();
+  char buffer[32];
+  std::snprintf(buffer,sizeof(buffer),"%d",I);
+  return std::string(buffer);
 }
 
 std::string
@@ -118,8 +119,7 @@ masterWrite::Num(const Geometry::Vec3D& V)
   std::string Out;
   for(int i=0;i<3;i++)
     {
-      Out +=(fabs(V[i])<zeroTol) ? "0.0" :
-	(FMTdouble % V[i]).str();
+      Out +=Num(V[i]);
       if (i!=2) Out+=" ";
     }
   return Out;
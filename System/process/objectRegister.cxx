@@ -48,6 +48,7 @@
 #include "masterRotate.h"
 #include "support.h"
 #include "stringCombine.h"
+#include "binaryIO.h"
 #include "surfIndex.h"
 #include "surfRegister.h"
 #include "HeadRule.h"
@@ -62,6 +63,7 @@
 #include "CellMap.h"
 #include "SurfMap.h"
 #include "LayerComp.h"
+#include "QueryContext.h"
 #include "objectRegister.h"
 
 namespace ModelSupport
@@ -147,35 +149,63 @@ objectRegister::getLast(const std::string& Name) const
 }
   
 std::string
-objectRegister::inRange(const int Index) const
+objectRegister::searchRange(const MTYPE& MUnit,const int Index,
+			    QueryContext& QC)
   /*!
-    Determine in the cell in within range
+    Find the range that holds the index. The last 
+    range found is kept in the context as the first guess.
+    \param MUnit :: Map of ranges
     \param Index :: cell number to test
+    \param QC :: Query context
     \return string
    */
 {
-  static std::string prev;
-  
   MTYPE::const_iterator mc;
-  mc=regionMap.find(prev);
+  mc=MUnit.find(QC.getRange());
 
-  if (mc!=regionMap.end() && 
+  if (mc!=MUnit.end() && 
       Index>=mc->second.first && 
       Index<=mc->second.second)
     return mc->first;
     
-  for(mc=regionMap.begin();mc!=regionMap.end();mc++)
+  for(mc=MUnit.begin();mc!=MUnit.end();mc++)
     {
       const std::pair<int,int>& IP=mc->second;
       if (Index>=IP.first && Index<=IP.second)
 	{
-	  prev=mc->first;
+	  QC.setRange(mc->first);
 	  return mc->first;
 	}
     }
   return std::string("");
 }
 
+std::string
+objectRegister::inRange(const int Index) const
+  /*!
+    Determine in the cell in within range. The last
+    range is shared between calls [not thread safe].
+    \param Index :: cell number to test
+    \return string
+   */
+{
+  static QueryContext QC;
+  return searchRange(regionMap,Index,QC);
+}
+
+std::string
+objectRegister::inRange(const int Index,QueryContext& QC) const
+  /*!
+    Determine in the cell in within range. The last 
+    range found is kept in the context as the first guess.
+    \param Index :: cell number to test
+    \param QC :: Query context [caller owned]
+    \return string
+   */
+{
+  return searchRange(regionMap,Index,QC);
+}
+
 void
 objectRegister::addActiveCell(const int cellN)
   /*!
@@ -301,6 +331,20 @@ objectRegister::hasObject(const std::string& Name) const
   return (mc!=Components.end()) ? 1 : 0;
 }
 
+std::vector<std::string>
+objectRegister::getObjectNames() const
+  /*!
+    Get the names of all the registered FixedComp
+    \return names [sorted]
+  */
+{
+  std::vector<std::string> Out;
+  for(const cMapTYPE::value_type& MC : Components)
+    if (MC.second)
+      Out.push_back(MC.first);
+  return Out;
+}
+
 attachSystem::FixedComp*
 objectRegister::getInternalObject(const std::string& Name) 
   /*!
@@ -494,33 +538,27 @@ objectRegister::getRenumberRange(const std::string& Name) const
 std::string
 objectRegister::inRenumberRange(const int Index) const
   /*!
-    Get the range of an object
+    Get the range of an object. The last range is
+    shared between calls [not thread safe].
     \param Index :: Offset number
     \return string of object
    */
 {
-  static std::string prev;
-  
-  MTYPE::const_iterator mc;
-  // normally same as previous search
-  if (!prev.empty())
-    {
-      mc=renumMap.find(prev);
-      if (mc!=renumMap.end() && 
-	  Index>=mc->second.first && 
-	  Index<=mc->second.second)
-	return mc->first;
-    }
-  for(mc=renumMap.begin();mc!=renumMap.end();mc++)
-    {
-      const std::pair<int,int>& IP=mc->second;
-      if (Index>=IP.first && Index<=IP.second)
-	{
-	  prev=mc->first;
-	  return mc->first;
-	}
-    }
-  return std::string("");
+  static QueryContext QC;
+  return searchRange(renumMap,Index,QC);
+}
+
+std::string
+objectRegister::inRenumberRange(const int Index,QueryContext& QC) const
+  /*!
+    Get the range of an object. The last range found
+    is kept in the context as the first guess.
+    \param Index :: Offset number
+    \param QC :: Query context [caller owned]
+    \return string of object
+   */
+{
+  return searchRange(renumMap,Index,QC);
 }
 
   
@@ -720,6 +758,83 @@ objectRegister::write(const std::string& OFile) const
   return;
 }
 
+void
+objectRegister::writeMap(std::ostream& OX,const MTYPE& MUnit)
+  /*!
+    Write a region map to a binary stream
+    \param OX :: Output stream
+    \param MUnit :: Map to write
+  */
+{
+  StrFunc::writeBin(OX,MUnit.size());
+  for(const MTYPE::value_type& MItem : MUnit)
+    {
+      StrFunc::writeBin(OX,MItem.first);
+      StrFunc::writeBin(OX,MItem.second.first);
+      StrFunc::writeBin(OX,MItem.second.second);
+    }
+  return;
+}
+
+void
+objectRegister::readMap(std::istream& IX,MTYPE& MUnit)
+  /*!
+    Read a region map from a binary stream
+    \param IX :: Input stream
+    \param MUnit :: Map to fill [cleared]
+  */
+{
+  size_t nItem;
+  StrFunc::readBin(IX,nItem);
+  MUnit.clear();
+  for(size_t i=0;i<nItem;i++)
+    {
+      std::string Key;
+      std::pair<int,int> Range;
+      StrFunc::readBin(IX,Key);
+      StrFunc::readBin(IX,Range.first);
+      StrFunc::readBin(IX,Range.second);
+      MUnit.emplace(Key,Range);
+    }
+  return;
+}
+
+void
+objectRegister::writeBinary(std::ostream& OX) const
+  /*!
+    Write the cell ranges and active cells to a binary
+    stream. The components are not written.
+    \param OX :: Output stream
+  */
+{
+  StrFunc::writeBin(OX,cellNumber);
+  writeMap(OX,regionMap);
+  writeMap(OX,renumMap);
+  const std::vector<int> ACells(activeCells.begin(),activeCells.end());
+  StrFunc::writeBin(OX,ACells);
+  return;
+}
+
+void
+objectRegister::readBinary(std::istream& IX)
+  /*!
+    Read the cell ranges and active cells from a binary
+    stream. The components are reset.
+    \param IX :: Input stream
+  */
+{
+  ELog::RegMethod RegA("objectRegister","readBinary");
+
+  reset();
+  StrFunc::readBin(IX,cellNumber);
+  readMap(IX,regionMap);
+  readMap(IX,renumMap);
+  std::vector<int> ACells;
+  StrFunc::readBin(IX,ACells);
+  activeCells.insert(ACells.begin(),ACells.end());
+  return;
+}
+
 ///\cond TEMPLATE
   
 template const attachSystem::FixedComp* 
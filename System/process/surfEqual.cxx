@@ -156,7 +156,8 @@ struct EqualSurface
 const Geometry::Surface*
 equalSurface(const Geometry::Surface* SPtr)
   /*!
-    Process a equal surface request
+    Process a equal surface request. Only the
+    hash candidates from surfIndex are tested.
     \param SPtr :: surface pointer
     \return Surface pointer 
    */
@@ -172,7 +173,7 @@ equalSurface(const Geometry::Surface* SPtr)
     EqualSurface<boost::mpl::_1 , boost::mpl::_2,const Geometry::Surface*> >::type FTYPE;
   
   ModelSupport::surfIndex& SurI=ModelSupport::surfIndex::Instance();
-  return FTYPE::dispatch(Index,SPtr,SurI.surMap());
+  return FTYPE::dispatch(Index,SPtr,SurI.equalCandidates(SPtr));
 }
 
 Geometry::Surface*
@@ -194,7 +195,7 @@ equalSurface(Geometry::Surface* SPtr)
     EqualSurface<boost::mpl::_1 , boost::mpl::_2,Geometry::Surface*> >::type FTYPE;
   
   ModelSupport::surfIndex& SurI=ModelSupport::surfIndex::Instance();
-  return FTYPE::dispatch(Index,SPtr,SurI.surMap());
+  return FTYPE::dispatch(Index,SPtr,SurI.equalCandidates(SPtr));
 }
 
 
@@ -244,7 +245,8 @@ equalSurfNum(const Geometry::Surface* SPtr)
     EqualSurface<boost::mpl::_1 , boost::mpl::_2,const Geometry::Surface*> >::type FTYPE;
   
   ModelSupport::surfIndex& SurI=ModelSupport::surfIndex::Instance();
-  const Geometry::Surface* OutPtr=FTYPE::dispatch(Index,SPtr,SurI.surMap());
+  const Geometry::Surface* OutPtr=
+    FTYPE::dispatch(Index,SPtr,SurI.equalCandidates(SPtr));
   return OutPtr->getName();
 }
 
@@ -58,7 +58,7 @@ operator<<(std::ostream& OX,const volUnit& A)
 }
 
 volUnit::volUnit() : 
-  npts(0),lineSum(0.0),matNum(0)
+  npts(0),lineSum(0.0),lineSumSq(0.0),histSum(0.0),matNum(0)
   /*!
     Constructor
   */
@@ -67,7 +67,8 @@ volUnit::volUnit() :
 
 volUnit::volUnit(const int MN,const std::string& CM,
 		 const std::vector<int>& CList) : 
-  npts(0),lineSum(0.0),comment(CM),matNum(MN)
+  npts(0),lineSum(0.0),lineSumSq(0.0),histSum(0.0),
+  comment(CM),matNum(MN)
   /*!
     Constructor
     \param MN :: Material number
@@ -80,6 +81,7 @@ volUnit::volUnit(const int MN,const std::string& CM,
 
 volUnit::volUnit(const volUnit& A) : 
   npts(A.npts),cells(A.cells),lineSum(A.lineSum),
+  lineSumSq(A.lineSumSq),histSum(A.histSum),
   comment(A.comment),matNum(A.matNum)
   /*!
     Copy constructor
@@ -100,6 +102,8 @@ volUnit::operator=(const volUnit& A)
       npts=A.npts;
       cells=A.cells;
       lineSum=A.lineSum;
+      lineSumSq=A.lineSumSq;
+      histSum=A.histSum;
       comment=A.comment;
       matNum=A.matNum;
     }
@@ -152,6 +156,7 @@ volUnit::addUnit(const int CN,const double D)
       // 	ELog::EM<<"D = "<<D<<ELog::endTrace;
       npts++;
       lineSum+=D;
+      histSum+=D;
     }
   return;
 }
@@ -170,10 +175,35 @@ volUnit::addFlux(const int CN,const double R,const double D)
     {
       npts++;
       lineSum+=1.0/R-1.0/(R+D);
+      histSum+=1.0/R-1.0/(R+D);
     }
   return;
 }
 
+void
+volUnit::addPoints(const size_t N)
+  /*!
+    Add N point hits [each a history of unit length]
+    \param N :: Number of hits
+  */
+{
+  npts+=static_cast<int>(N);
+  lineSum+=static_cast<double>(N);
+  lineSumSq+=static_cast<double>(N);
+  return;
+}
+
+void
+volUnit::endHistory()
+  /*!
+    Close the current history for the variance sum
+  */
+{
+  lineSumSq+=histSum*histSum;
+  histSum=0.0;
+  return;
+}
+
 void 
 volUnit::reset()
   /*!
@@ -182,6 +212,8 @@ volUnit::reset()
 {
   npts=0;
   lineSum=0.0;
+  lineSumSq=0.0;
+  histSum=0.0;
   return;
 }
 
@@ -199,10 +231,29 @@ volUnit::calcVol(const double D) const
 
 double
 volUnit::calcLine(const double D) const
+  /*!
+    Calculate the fraction of contributions
+    \param D :: Track divider
+    \return scaled number of contributions
+  */
 {
   return D*npts;
 }
 
+double
+volUnit::calcError(const double N) const
+  /*!
+    Calculate the relative error of the volume
+    [R^2 = sum(x^2)/sum(x)^2 - 1/N]
+    \param N :: Number of histories
+    \return relative error [1.0 if no contribution]
+  */
+{
+  if (lineSum<=0.0 || N<1.0) return 1.0;
+  const double R2=lineSumSq/(lineSum*lineSum)-1.0/N;
+  return (R2>0.0) ? std::sqrt(R2) : 0.0;
+}
+
 void 
 volUnit::write(std::ostream& OX) const
   /*!
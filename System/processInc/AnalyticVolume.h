@@ -0,0 +1,50 @@
+/********************************************************************* 
+  CombLayer : MCNP(X) Input builder
+ 
+ * File:   processInc/AnalyticVolume.h
+ *
+ * Copyright (c) 2004-2016 by Stuart Ansell
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>. 
+ *
+ ****************************************************************************/
+#ifndef ModelSupport_AnalyticVolume_h
+#define ModelSupport_AnalyticVolume_h
+
+namespace Geometry
+{
+  class Surface;
+  class Plane;
+}
+
+class Rule;
+
+namespace MonteCarlo
+{
+  class Object;
+}
+
+namespace ModelSupport
+{
+  /// signed surface of an intersection
+  typedef std::pair<int,const Geometry::Surface*> SSTYPE;
+
+  bool intersectSurfaces(const Rule*,std::vector<SSTYPE>&);
+  
+  int convexPlaneVolume(const std::vector<SSTYPE>&,double&);
+  int cylinderVolume(const std::vector<SSTYPE>&,double&);
+  int analyticVolume(const MonteCarlo::Object&,double&);
+}
+
+#endif
@@ -35,6 +35,8 @@ namespace MonteCarlo
 namespace ModelSupport
 {
 
+class QueryContext;
+
 /*!
   \class LineTrack
   \version 1.0
@@ -71,6 +73,7 @@ class LineTrack
   bool isCompelete() const { return (aimDist-TDist) < -Geometry::zeroTol; }
 
   void calculate(const Simulation&);
+  void calculate(const Simulation&,QueryContext&);
   void calculateError(const Simulation&);
   /// Access Cells
   const std::vector<long int>& getCells() const
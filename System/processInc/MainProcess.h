@@ -89,6 +89,9 @@ namespace mainSystem
 			  std::vector<std::string>&);
 
   void buildFullSimulation(Simulation*,const inputParam&,const std::string&);
+  void buildSnapSimulation(Simulation*,const inputParam&,const std::string&);
+  void processFullSimulation(Simulation*,const inputParam&,
+			     const std::string&);
   void exitDelete(Simulation*);
 }
 
@@ -0,0 +1,104 @@
+/********************************************************************* 
+  CombLayer : MCNP(X) Input builder
+ 
+ * File:   processInc/ObjBoxTree.h
+ *
+ * Copyright (c) 2004-2016 by Stuart Ansell
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>. 
+ *
+ ****************************************************************************/
+#ifndef ModelSupport_ObjBoxTree_h
+#define ModelSupport_ObjBoxTree_h
+
+namespace MonteCarlo
+{
+  class Object;
+  class Qhull;
+}
+
+namespace ModelSupport
+{
+
+/*!
+  \class ObjBoxTree
+  \version 1.0
+  \author S. Ansell
+  \date May 2016
+  \brief Bounding volume hierarchy of cell boxes
+
+  Point location for Simulation::findCell. The tree is
+  built from the cell bounding boxes and is invalidated
+  by any change to the cell map. Cells without a finite
+  box are always tested. Leaves hold their items in
+  cell-map order and each node the lowest order below it,
+  so the search returns the first cell in cell-map order,
+  identical to a linear search, without sorting.
+*/
+
+class ObjBoxTree
+{
+ private:
+
+  /// Tree node : leaf if nItem!=0
+  struct BoxNode
+  {
+    Geometry::BoundBox Box;    ///< Box of all items below node
+    size_t first;              ///< First item [leaf] / left node
+    size_t nItem;              ///< Number of items [0 : internal]
+    size_t right;              ///< Right node [internal only]
+    size_t minOrder;           ///< Lowest cell-map order below node
+  };
+
+  static const size_t leafSize;   ///< Max items in a leaf
+
+  int active;                     ///< Use the tree for findCell
+  int built;                      ///< Tree is current
+
+  std::vector<MonteCarlo::Object*> Items;    ///< Objects [tree order]
+  std::vector<size_t> ItemOrder;             ///< Cell-map order of item
+  std::vector<Geometry::BoundBox> ItemBox;   ///< Box of item
+  std::vector<size_t> unBound;               ///< Items without box [ordered]
+  std::vector<BoxNode> Nodes;                ///< Tree nodes [0 : root]
+
+  size_t buildNode(std::vector<size_t>&,const size_t,const size_t,
+		   const std::vector<Geometry::Vec3D>&);
+
+ public:
+
+  ObjBoxTree();
+  ObjBoxTree(const ObjBoxTree&);
+  ObjBoxTree& operator=(const ObjBoxTree&);
+  ~ObjBoxTree() {}          ///< Destructor
+
+  /// Set the tree / linear search
+  void setActive(const int A) { active=A; }
+  /// Is tree to be used
+  int isActive() const { return active; }
+  /// Is tree current
+  int isBuilt() const { return built; }
+
+  void clearAll();
+  void build(const std::map<int,MonteCarlo::Qhull*>&);
+  void build(const std::map<int,MonteCarlo::Qhull*>&,
+	     const Geometry::BoundBox&);
+
+  MonteCarlo::Object* findCell(const Geometry::Vec3D&) const;
+
+  void write(std::ostream&) const;
+};
+
+}
+
+#endif
@@ -35,6 +35,8 @@ namespace MonteCarlo
 namespace ModelSupport
 {
 
+class QueryContext;
+
 /*!
   \class ObjSurfMap
   \version 1.0
@@ -72,6 +74,9 @@ class ObjSurfMap
   const STYPE& getObjects(const int) const;
   MonteCarlo::Object* findNextObject(const int,
 				     const Geometry::Vec3D&,const int) const;
+  MonteCarlo::Object* findNextObject(const int,
+				     const Geometry::Vec3D&,const int,
+				     QueryContext&) const;
 
   void removeReverseSurf(const int,const int);
 
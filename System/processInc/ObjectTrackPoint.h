@@ -36,6 +36,7 @@ namespace ModelSupport
 {
 
   class LineTrack;
+  class QueryContext;
 
 /*!
   \class ObjectTrackPoint
@@ -70,6 +71,8 @@ class ObjectTrackPoint : public ObjectTrackAct
   void setTarget(const Geometry::Vec3D& Pt) { TargetPt=Pt; }
 
   void addUnit(const Simulation&,const long int,const Geometry::Vec3D&);
+  void addUnit(const Simulation&,const long int,const Geometry::Vec3D&,
+	       QueryContext&);
 
   /// Debug function effectivley
   //  const std::map<int,ObjTrackItem>& getMap() const { return Items; }
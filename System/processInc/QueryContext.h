@@ -0,0 +1,89 @@
+/********************************************************************* 
+  CombLayer : MCNP(X) Input builder
+ 
+ * File:   processInc/QueryContext.h
+ *
+ * Copyright (c) 2004-2016 by Stuart Ansell
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>. 
+ *
+ ****************************************************************************/
+#ifndef ModelSupport_QueryContext_h
+#define ModelSupport_QueryContext_h
+
+namespace MonteCarlo
+{
+  class Object;
+}
+
+namespace ModelSupport
+{
+
+/*!
+  \class QueryContext
+  \version 1.0
+  \author S. Ansell
+  \date May 2016
+  \brief Per-caller state for geometry queries
+
+  Holds the last-cell hint for Simulation::findCell and
+  the last range key for objectRegister::inRange and
+  inRenumberRange. Each caller [thread] owns its own 
+  context so the queries themselves are stateless. A cell 
+  hint is only used if the cell map has not changed since 
+  it was set.
+*/
+
+class QueryContext
+{
+ private:
+
+  int debug;                      ///< Report tracking failures
+  size_t version;                 ///< Cell-map version of lastCell
+  MonteCarlo::Object* lastCell;   ///< Last cell found
+  std::string rangeKey;           ///< Last objectRegister range
+
+ public:
+
+  static size_t newVersion();
+
+  explicit QueryContext(const int =0);
+  QueryContext(const QueryContext&);
+  QueryContext& operator=(const QueryContext&);
+  ~QueryContext() {}            ///< Destructor
+
+  void clearAll();
+
+  /// Set the failure reporting
+  void setDebug(const int D) { debug=D; }
+  /// Are failures to be reported
+  int isDebug() const { return debug; }
+
+  /// Get last cell if the cell map version matches
+  MonteCarlo::Object* getCell(const size_t V) const
+    { return (V==version) ? lastCell : 0; }
+  /// Set the last cell and its cell map version
+  void setCell(const size_t V,MonteCarlo::Object* OPtr)
+    { version=V; lastCell=OPtr; }
+
+  /// Access last range key
+  const std::string& getRange() const { return rangeKey; }
+  /// Set last range key
+  void setRange(const std::string& K) { rangeKey=K; }
+  
+};
+
+}
+
+#endif
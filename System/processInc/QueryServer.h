@@ -0,0 +1,91 @@
+/********************************************************************* 
+  CombLayer : MCNP(X) Input builder
+ 
+ * File:   processInc/QueryServer.h
+ *
+ * Copyright (c) 2004-2016 by Stuart Ansell
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>. 
+ *
+ ****************************************************************************/
+#ifndef ModelSupport_QueryServer_h
+#define ModelSupport_QueryServer_h
+
+class Simulation;
+
+namespace ModelSupport
+{
+
+class QueryContext;
+
+/*!
+  \class QueryServer
+  \version 1.0
+  \author S. Ansell
+  \date May 2016
+  \brief Answers line requests on a built geometry
+
+  Each request line gives one response line 
+  [ok ... / error message]:
+  - findCell x y z : cell material
+  - lineTrack x y z x y z : nCell { cell material length }
+  - attnSum x y z x y z : attenuation sum [ObjectTrackAct::getAttnSum]
+  - cell N : material density imp temperature objectRegister name
+  - material N : name atomDensity meanA
+  
+  Lines between batch and end are evaluated over
+  several threads and answered in order at the end.
+  quit closes the session and shutdown also stops
+  the socket server.
+*/
+
+class QueryServer
+{
+ private:
+
+  const Simulation& System;          ///< Built simulation
+  size_t nThread;                    ///< Threads for a batch [0 : auto]
+  int inBatch;                       ///< Collecting a batch
+  std::vector<std::string> Batch;    ///< Requests of the batch
+
+  std::string findCell(std::string&,QueryContext&) const;
+  std::string lineTrack(std::string&,QueryContext&) const;
+  std::string attnSum(std::string&,QueryContext&) const;
+  std::string cellInfo(std::string&,QueryContext&) const;
+  std::string materialInfo(std::string&) const;
+
+  void runBatch(std::ostream&) const;
+  static void writeAll(const int,const std::string&);
+  
+ public:
+
+  QueryServer(const Simulation&);
+  QueryServer(const QueryServer&);
+  ~QueryServer() {}          ///< Destructor
+
+  /// Set the number of batch threads [0 : hardware]
+  void setThreads(const size_t N) { nThread=N; }
+
+  std::string process(const std::string&,QueryContext&) const;
+  void processBatch(const std::vector<std::string>&,
+		    std::vector<std::string>&) const;
+  
+  int processLine(const std::string&,std::ostream&);
+  void serve(std::istream&,std::ostream&);
+  void serveSocket(const std::string&);
+};
+
+}
+
+#endif
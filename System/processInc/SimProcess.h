@@ -38,6 +38,9 @@ namespace SimProcess
 
   void writeMany(Simulation&,const std::string&,const int);
   void writeIndexSim(Simulation&,const std::string&,const int);
+  size_t findUnique(const std::string&,const std::string&);
+  void writeMultiSim(Simulation&,const std::string&,const int);
+  void writeMultiCode(Simulation&,const std::string&,const int);
   void writeIndexSimPHITS(Simulation&,const std::string&,const int);
 
   template<typename T>
@@ -52,7 +55,7 @@ namespace SimProcess
 
   template<typename T>
   int getIndexVec(const FuncDataBase&,const std::string&,
-		  const int,const std::string&,const std::vector<T>&);
+		  const int,const std::string&,std::vector<T>&);
 
   template<typename T>
   std::vector<T> getVarVec(const FuncDataBase&,const std::string&);
@@ -0,0 +1,99 @@
+/********************************************************************* 
+  CombLayer : MCNP(X) Input builder
+ 
+ * File:   processInc/TrackBatch.h
+ *
+ * Copyright (c) 2004-2016 by Stuart Ansell
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>. 
+ *
+ ****************************************************************************/
+#ifndef ModelSupport_TrackBatch_h
+#define ModelSupport_TrackBatch_h
+
+class Simulation;
+
+namespace Geometry
+{
+  class Plane;
+}
+
+namespace ModelSupport
+{
+
+class QueryContext;
+
+/*!
+  \class TrackBatch
+  \version 1.0
+  \author S. Ansell
+  \date May 2016
+  \brief Attenuation of many tracks to a point / plane
+
+  Tracks each point to the target [point or closest point 
+  on a plane] over several threads. Only the attenuation
+  sum is kept rather than the LineTrack cell list. The 
+  segments are summed in track order with the same 
+  arithmetic as ObjectTrackAct::getAttnSum. Tracks in a 
+  block share the last-cell hint as the serial LineTrack 
+  loop does through SimTrack. A block is seeded by tracking
+  the point before it; blocks whose seed is not that of 
+  the serial chain are re-tracked after the join, so the
+  result is identical to ObjectTrackPoint/Plane for any
+  number of threads. A track that fails to find its next 
+  cell is re-run serially through LineTrack so that the 
+  error trace is kept.
+*/
+
+class TrackBatch
+{
+ private:
+
+  /// Material factors [pow(A,0.66) : density]
+  typedef std::map<int,std::pair<double,double>> matTYPE;
+
+  static const size_t blockSize;       ///< Tracks per thread block [threads>1]
+
+  size_t nThread;                      ///< Number of threads [0 : auto]
+  Geometry::Vec3D TargetPt;            ///< Target point
+  const Geometry::Plane* TargetPlane;  ///< Target plane [if set]
+
+  Geometry::Vec3D endPoint(const Geometry::Vec3D&) const;
+  static const std::pair<double,double>& matFactor(matTYPE&,const int);
+  int attnTrack(const Simulation&,QueryContext&,matTYPE&,
+		const Geometry::Vec3D&,double&) const;
+  void attnBlock(const Simulation&,QueryContext&,matTYPE&,
+		 const std::vector<Geometry::Vec3D>&,const size_t,
+		 const size_t,std::vector<double>&,
+		 std::vector<char>&) const;
+  double lineAttn(const Simulation&,const Geometry::Vec3D&) const;
+  
+ public:
+
+  TrackBatch(const Geometry::Vec3D&);
+  TrackBatch(const Geometry::Plane&);
+  TrackBatch(const TrackBatch&);
+  TrackBatch& operator=(const TrackBatch&);
+  ~TrackBatch() {}          ///< Destructor
+
+  /// Set the number of threads [0 : hardware]
+  void setThreads(const size_t N) { nThread=N; }
+
+  void calculate(const Simulation&,const std::vector<Geometry::Vec3D>&,
+		 std::vector<double>&) const;
+};
+
+}
+
+#endif
@@ -23,6 +23,8 @@
 #define ModelSupport_VolSum_h
 
 class Simulation;
+class SobolSeq;
+
 namespace MonteCarlo
 {
   class Object;
@@ -30,13 +32,20 @@ namespace MonteCarlo
 
 namespace ModelSupport
 {
-
+  class QueryContext;
+  
 /*!
   \class VolSum
   \brief Hold an official model number
   \date August 2010
   \author S. Ansell
   \version 1.0
+
+  adaptiveRun splits the points into fixed batches, each with
+  its own random stream [or block of the Sobol sequence], so 
+  the result does not depend on the number of threads.
+  If analytic is set, tally units made only of cells with an
+  exact volume [AnalyticVolume] inside the box are not sampled.
 */
 						
 class VolSum
@@ -45,6 +54,12 @@ class VolSum
   
   /// tally volume type
   typedef std::map<int,volUnit> tvTYPE; 
+  /// cell : tally units
+  typedef std::map<int,std::vector<size_t>> cuTYPE;
+
+  static const size_t batchSize;            ///< Points in a batch
+  static const size_t roundSize;            ///< Batches between tests
+  
   // Input data
   Geometry::Vec3D Origin;                   ///< Origin
   Geometry::Vec3D X;                        ///< Axis of box
@@ -56,11 +71,21 @@ class VolSum
   
   double fullVol;                           ///< Full volume  
   double totalDist;                         ///< Total distance
-  int nTracks;                              ///< Number of full tracks
+  size_t nTracks;                           ///< Number of full tracks
+
+  size_t nThread;                           ///< Threads [0 : all cores]
+  int sampleType;                           ///< random/stratified/sobol
+  int analytic;                             ///< Use exact cell volumes
    
   tvTYPE tallyVols;                         ///< TallyNum:Volumes
+  std::map<int,double> exactVol;            ///< TallyNum:Exact volume
 
   Geometry::Vec3D getCubePoint() const;
+  void endHistory();
+  void calcExact(const Simulation&);
+  void sampleBatch(const Simulation&,const cuTYPE&,const SobolSeq&,
+		   const unsigned long int,const size_t,const size_t,
+		   QueryContext&,std::vector<size_t>&) const;
   
  public:
   
@@ -77,9 +102,17 @@ class VolSum
 		const std::vector<int>&);
   void addTallyCell(const int,const int);
 
+  /// Set number of threads for adaptiveRun
+  void setThreads(const size_t N) { nThread=N; }
+  /// Use exact volumes where possible in adaptiveRun
+  void setAnalytic(const int A) { analytic=A; }
+  void setSampling(const std::string&);
+  
   void trackRun(const Simulation&,const size_t);
   void pointRun(const Simulation&,const size_t);
+  void adaptiveRun(const Simulation&,const size_t,const double);
   double calcVolume(const int) const;
+  double calcError(const int) const;
   void populateTally(const Simulation&);
   void populateAll(const Simulation&);
   void populateVSet(const Simulation&,const std::vector<int>&);
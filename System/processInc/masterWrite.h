@@ -37,8 +37,6 @@ class masterWrite
   double zeroTol;         ///< All numbers below this value are zero
   int sigFig;             ///< Number of significant figures
   
-  boost::format FMTdouble;       ///< Format statement for double output
-  boost::format FMTinteger;      ///< Format statement for integer
 
   masterWrite();
 
@@ -30,6 +30,8 @@ namespace attachSystem
 namespace ModelSupport
 {
 
+class QueryContext;
+
 /*!
   \class objectRegister 
   \version 1.0
@@ -65,6 +67,11 @@ class objectRegister
     getInternalObject(const std::string&) const;
   attachSystem::FixedComp*
     getInternalObject(const std::string&);
+
+  static std::string searchRange(const MTYPE&,const int,
+				 QueryContext&);
+  static void writeMap(std::ostream&,const MTYPE&);
+  static void readMap(std::istream&,MTYPE&);
   
  public:
   
@@ -78,12 +85,14 @@ class objectRegister
   int getRange(const std::string&) const;
   
   std::string inRange(const int) const;
+  std::string inRange(const int,QueryContext&) const;
 
   int getRenumberCell(const std::string&) const;
   int getRenumberLast(const std::string&) const;
   int getRenumberRange(const std::string&) const;
   
   std::string inRenumberRange(const int) const;
+  std::string inRenumberRange(const int,QueryContext&) const;
 
   int calcRenumber(const int) const;
     
@@ -98,6 +107,7 @@ class objectRegister
   template<typename T>  T*
     getObjectThrow(const std::string&,const std::string&);
   bool hasObject(const std::string&) const;
+  std::vector<std::string> getObjectNames() const;
   void setRenumber(const std::string&,const int,const int);
   
   void addActiveCell(const int);
@@ -111,6 +121,9 @@ class objectRegister
   void reset();
   void rotateMaster();
   void write(const std::string&) const;
+
+  void writeBinary(std::ostream&) const;
+  void readBinary(std::istream&);
   
 };
 
@@ -40,6 +40,8 @@ class volUnit
   int npts;              ///< Number of contributions
   std::set<int> cells;   ///< Cell units
   double lineSum;        ///< Sum of length
+  double lineSumSq;      ///< Sum of (length per history)^2
+  double histSum;        ///< Length in current history
 
   std::string comment;   ///< Description
   int matNum;            ///< Material number
@@ -55,11 +57,16 @@ class volUnit
   void setCells(const std::vector<int>&);
   void addCell(const int);
   void reset();
+  /// Access cells
+  const std::set<int>& getCells() const { return cells; }
   
   double calcVol(const double) const;
   double calcLine(const double) const;
+  double calcError(const double) const;
   void addUnit(const int,const double);
   void addFlux(const int,const double,const double);
+  void addPoints(const size_t);
+  void endHistory();
 
   /// access material number
   int getMat() const { return matNum; }
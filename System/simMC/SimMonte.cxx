@@ -72,6 +72,8 @@
 #include "ObjComponent.h"
 #include "Beam.h"
 #include "neutron.h"
+#include "Line.h"
+#include "LineIntersectVisit.h"
 #include "Detector.h"
 #include "DetGroup.h"
 #include "Simulation.h"
@@ -223,6 +225,8 @@ SimMonte::runMonte(const size_t Npts)
   const Geometry::Surface* surfPtr;
   MonteCarlo::neutron Nout(0,Geometry::Vec3D(0,0,0),
 			   Geometry::Vec3D(1,0,0));
+  // work space for all the cell tracks
+  MonteCarlo::LineIntersectVisit LI(Nout);
   const ModelSupport::ObjSurfMap* OSMPtr =getOSM();
 
   //  double tDist;  // Track disnace 
@@ -252,7 +256,7 @@ SimMonte::runMonte(const size_t Npts)
 	      double R=RNG.randExc();
 	      // Calculate forward Track:
 	      int surfN;
-	      surfN=Cell.trackWeight(n,R,surfPtr);   
+	      surfN=Cell.trackWeight(n,R,surfPtr,LI);   
 	      if (surfN)  
 		OPtr=OSMPtr->findNextObject(surfN,n.Pos,
 					    OPtr->getName());
@@ -0,0 +1,186 @@
+/********************************************************************* 
+  CombLayer : MCNP(X) Input builder
+ 
+ * File:   support/binaryIO.cxx
+ *
+ * Copyright (c) 2004-2016 by Stuart Ansell
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>. 
+ *
+ ****************************************************************************/
+#include <iostream>
+#include <cmath>
+#include <complex>
+#include <vector>
+#include <string>
+
+#include "Exception.h"
+#include "MatrixBase.h"
+#include "Matrix.h"
+#include "Vec3D.h"
+#include "binaryIO.h"
+
+namespace StrFunc
+{
+
+template<typename T>
+void
+writeBin(std::ostream& OX,const T& V)
+  /*!
+    Write a value to a binary stream [native byte order]
+    \param OX :: Output stream
+    \param V :: Value to write
+  */
+{
+  OX.write(reinterpret_cast<const char*>(&V),sizeof(T));
+  return;
+}
+
+template<>
+void
+writeBin(std::ostream& OX,const std::string& V)
+  /*!
+    Write a string to a binary stream as length : chars
+    \param OX :: Output stream
+    \param V :: String to write
+  */
+{
+  writeBin(OX,V.size());
+  OX.write(V.c_str(),static_cast<std::streamsize>(V.size()));
+  return;
+}
+
+template<>
+void
+writeBin(std::ostream& OX,const Geometry::Vec3D& V)
+  /*!
+    Write a Vec3D to a binary stream 
+    \param OX :: Output stream
+    \param V :: Vector to write
+  */
+{
+  for(size_t i=0;i<3;i++)
+    writeBin(OX,V[i]);
+  return;
+}
+
+template<typename T>
+void
+writeBin(std::ostream& OX,const std::vector<T>& V)
+  /*!
+    Write a vector to a binary stream as size : items
+    \param OX :: Output stream
+    \param V :: Vector to write
+  */
+{
+  writeBin(OX,V.size());
+  for(const T& item : V)
+    writeBin(OX,item);
+  return;
+}
+
+template<typename T>
+void
+readBin(std::istream& IX,T& V)
+  /*!
+    Read a value from a binary stream [native byte order]
+    \param IX :: Input stream
+    \param V :: Value to read
+    \throw FileError on a short read
+  */
+{
+  IX.read(reinterpret_cast<char*>(&V),sizeof(T));
+  if (!IX)
+    throw ColErr::FileError(0,"binary stream","readBin");
+  return;
+}
+
+template<>
+void
+readBin(std::istream& IX,std::string& V)
+  /*!
+    Read a string [length : chars] from a binary stream
+    \param IX :: Input stream
+    \param V :: String to read
+    \throw FileError on a short read
+  */
+{
+  size_t len;
+  readBin(IX,len);
+  V.resize(len);
+  if (len)
+    IX.read(&V[0],static_cast<std::streamsize>(len));
+  if (!IX)
+    throw ColErr::FileError(0,"binary stream","readBin<string>");
+  return;
+}
+
+template<>
+void
+readBin(std::istream& IX,Geometry::Vec3D& V)
+  /*!
+    Read a Vec3D from a binary stream 
+    \param IX :: Input stream
+    \param V :: Vector to read
+  */
+{
+  for(size_t i=0;i<3;i++)
+    readBin(IX,V[i]);
+  return;
+}
+
+template<typename T>
+void
+readBin(std::istream& IX,std::vector<T>& V)
+  /*!
+    Read a vector [size : items] from a binary stream 
+    \param IX :: Input stream
+    \param V :: Vector to read
+  */
+{
+  size_t len;
+  readBin(IX,len);
+  V.resize(len);
+  for(T& item : V)
+    readBin(IX,item);
+  return;
+}
+
+/// \cond TEMPLATE 
+
+template void writeBin(std::ostream&,const char&);
+template void writeBin(std::ostream&,const int&);
+template void writeBin(std::ostream&,const long int&);
+template void writeBin(std::ostream&,const size_t&);
+template void writeBin(std::ostream&,const double&);
+template void writeBin(std::ostream&,const std::vector<int>&);
+template void writeBin(std::ostream&,const std::vector<size_t>&);
+template void writeBin(std::ostream&,const std::vector<double>&);
+template void writeBin(std::ostream&,const std::vector<std::string>&);
+template void writeBin(std::ostream&,const std::vector<Geometry::Vec3D>&);
+
+template void readBin(std::istream&,char&);
+template void readBin(std::istream&,int&);
+template void readBin(std::istream&,long int&);
+template void readBin(std::istream&,size_t&);
+template void readBin(std::istream&,double&);
+template void readBin(std::istream&,std::vector<int>&);
+template void readBin(std::istream&,std::vector<size_t>&);
+template void readBin(std::istream&,std::vector<double>&);
+template void readBin(std::istream&,std::vector<std::string>&);
+template void readBin(std::istream&,std::vector<Geometry::Vec3D>&);
+
+/// \endcond TEMPLATE 
+
+}  // NAMESPACE StrFunc
@@ -0,0 +1,198 @@
+/********************************************************************* 
+  CombLayer : MCNP(X) Input builder
+ 
+ * File:   support/blockWrite.cxx
+ *
+ * Copyright (c) 2004-2016 by Stuart Ansell
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>. 
+ *
+ ****************************************************************************/
+#include <iostream>
+#include <sstream>
+#include <string>
+#include <vector>
+#include <algorithm>
+#include <functional>
+#include <atomic>
+#include <thread>
+#include <exception>
+
+#include "Exception.h"
+#include "blockWrite.h"
+
+namespace StrFunc
+{
+
+void
+writeBlocks(std::ostream& OX,const size_t nThread,
+	    const size_t nItem,const size_t blockSize,
+	    const itemWriter& WFunc)
+  /*!
+    Write a number of items to a stream. The items are 
+    formatted in blocks over several threads, each block into 
+    its own buffer, and the buffers are written in item order.
+    The output is the same as calling WFunc for each item in turn.
+    WFunc must be safe to call concurrently for different items.
+    \param OX :: Output stream
+    \param nThread :: Number of threads [0 : hardware / 1 : direct]
+    \param nItem :: Number of items
+    \param blockSize :: Items in each block [>0]
+    \param WFunc :: Write function for item index
+  */
+{
+  if (!blockSize)
+    throw ColErr::IndexError<size_t>(blockSize,0,"writeBlocks::blockSize");
+  const size_t nBlock((nItem+blockSize-1)/blockSize);
+
+  size_t NT(nThread);
+  if (!NT)
+    NT=static_cast<size_t>(std::thread::hardware_concurrency());
+  NT=std::max<size_t>(1,std::min(NT,nBlock));
+  if (NT==1)
+    {
+      for(size_t i=0;i<nItem;i++)
+	WFunc(i,OX);
+      return;
+    }
+
+  std::vector<std::string> Chunk(nBlock);
+  std::atomic<size_t> blockCnt(0);
+  std::vector<std::exception_ptr> TError(NT);
+  std::vector<std::thread> TUnit;
+  for(size_t i=0;i<NT;i++)
+    {
+      TUnit.push_back
+	(std::thread([&,i]()
+		     {
+		       try
+			 {
+			   for(size_t index=blockCnt++;index<nBlock;
+			       index=blockCnt++)
+			     {
+			       std::ostringstream cx;
+			       const size_t last=
+				 std::min(nItem,(index+1)*blockSize);
+			       for(size_t j=index*blockSize;j<last;j++)
+				 WFunc(j,cx);
+			       Chunk[index]=cx.str();
+			     }
+			 }
+		       catch (...)
+			 {
+			   TError[i]=std::current_exception();
+			 }
+		     }));
+    }
+  for(std::thread& TU : TUnit)
+    TU.join();
+  for(const std::exception_ptr& EP : TError)
+    if (EP) std::rethrow_exception(EP);
+
+  for(const std::string& CS : Chunk)
+    OX.write(CS.c_str(),static_cast<std::streamsize>(CS.size()));
+  return;
+}
+
+std::vector<std::string>
+formatBlocks(const size_t nThread,const size_t nItem,
+	     const size_t blockSize,const size_t nStream,
+	     const multiWriter& WFunc)
+  /*!
+    Format a number of items into several streams in one 
+    pass. Each item is given to WFunc once with all the
+    streams so that the different output forms of an item
+    are made together. The blocks are formatted over several
+    threads and each stream is joined in item order.
+    WFunc must be safe to call concurrently for different items.
+    \param nThread :: Number of threads [0 : hardware / 1 : serial]
+    \param nItem :: Number of items
+    \param blockSize :: Items in each block [>0]
+    \param nStream :: Number of output streams
+    \param WFunc :: Write function for item index
+    \return text of each stream
+  */
+{
+  if (!blockSize)
+    throw ColErr::IndexError<size_t>(blockSize,0,"formatBlocks::blockSize");
+  const size_t nBlock((nItem+blockSize-1)/blockSize);
+
+  size_t NT(nThread);
+  if (!NT)
+    NT=static_cast<size_t>(std::thread::hardware_concurrency());
+  NT=std::max<size_t>(1,std::min(NT,nBlock));
+
+  // Chunk[block][stream]
+  std::vector<std::vector<std::string>> 
+    Chunk(nBlock,std::vector<std::string>(nStream));
+  auto blockFormat=[&](const size_t index)
+    {
+      std::vector<std::ostringstream> cx(nStream);
+      std::vector<std::ostream*> OPtr;
+      for(std::ostringstream& OS : cx)
+	OPtr.push_back(&OS);
+      const size_t last=std::min(nItem,(index+1)*blockSize);
+      for(size_t j=index*blockSize;j<last;j++)
+	WFunc(j,OPtr);
+      for(size_t k=0;k<nStream;k++)
+	Chunk[index][k]=cx[k].str();
+    };
+
+  if (NT==1)
+    {
+      for(size_t index=0;index<nBlock;index++)
+	blockFormat(index);
+    }
+  else
+    {
+      std::atomic<size_t> blockCnt(0);
+      std::vector<std::exception_ptr> TError(NT);
+      std::vector<std::thread> TUnit;
+      for(size_t i=0;i<NT;i++)
+	{
+	  TUnit.push_back
+	    (std::thread([&,i]()
+			 {
+			   try
+			     {
+			       for(size_t index=blockCnt++;index<nBlock;
+				   index=blockCnt++)
+				 blockFormat(index);
+			     }
+			   catch (...)
+			     {
+			       TError[i]=std::current_exception();
+			     }
+			 }));
+	}
+      for(std::thread& TU : TUnit)
+	TU.join();
+      for(const std::exception_ptr& EP : TError)
+	if (EP) std::rethrow_exception(EP);
+    }
+
+  std::vector<std::string> Out(nStream);
+  for(size_t k=0;k<nStream;k++)
+    {
+      size_t len(0);
+      for(const std::vector<std::string>& CS : Chunk)
+	len+=CS[k].size();
+      Out[k].reserve(len);
+      for(const std::vector<std::string>& CS : Chunk)
+	Out[k]+=CS[k];
+    }
+  return Out;
+}
+
+}  // NAMESPACE StrFunc
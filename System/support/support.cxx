@@ -788,7 +788,9 @@ writeControl(const std::string& Line,std::ostream& OX,
 /*!
   Write out the line in the limited form for MCNPX
   ie initial line from 0::72 after that 8 to 72
-  (split on a space or comma)
+  (split on a space or comma). Single pass over the 
+  line : each block is trimmed in place and written 
+  directly without sub-strings.
   \param Line :: full MCNPX line
   \param OX :: ostream to write to
   \param LNmax :: Maximium char count in a line
@@ -802,27 +804,43 @@ writeControl(const std::string& Line,std::ostream& OX,
       insertDepth *= -1;
       spcLen=static_cast<size_t>(insertDepth);
     }
+  const char* LPtr=Line.c_str();
+  const size_t LSize(Line.size());
 
-  std::string::size_type pos(0);
-  std::string X=Line.substr(0,LNmax-spcLen);    
-  std::string::size_type posB=X.find_last_of(" ,");
-  while(X.length() == LNmax-spcLen &&
-	posB!=std::string::npos)
+  size_t pos(0);
+  while(1)
     {
-      pos+=posB+1;
-      if (!isspace(X[posB])) posB++;  // skip pass comma 
-      X=fullBlock(X.substr(0,posB));
-      if (!isEmpty(X))
-	OX<<std::string(spcLen,' ')<<X<<std::endl;
+      // block [pos : pos+xLen] and last split point in it
+      const size_t xLen(std::min(LNmax-spcLen,LSize-pos));
+      size_t posB(xLen);
+      for(size_t i=xLen;i>0;i--)
+	if (LPtr[pos+i-1]==' ' || LPtr[pos+i-1]==',')
+	  {
+	    posB=i-1;
+	    break;
+	  }
+      const bool splitFlag(xLen==LNmax-spcLen && posB!=xLen);
+
+      size_t endB(xLen);
+      if (splitFlag)
+	endB=(isspace(LPtr[pos+posB])) ? posB : posB+1; // keep comma
+
+      size_t startB(0);
+      while(startB<endB && isspace(LPtr[pos+startB])) startB++;
+      while(endB>startB && isspace(LPtr[pos+endB-1])) endB--;
+      if (startB!=endB)
+	{
+	  for(size_t i=0;i<spcLen;i++)
+	    OX.put(' ');
+	  OX.write(LPtr+pos+startB,
+		   static_cast<std::streamsize>(endB-startB));
+	  OX.put('\n');
+	}
+      if (!splitFlag) break;
 
+      pos+=posB+1;
       spcLen=static_cast<size_t>(insertDepth);
-      X=Line.substr(pos,LNmax-spcLen);
-      posB=X.find_last_of(" ,");
     }
-    
-  X=fullBlock(X);
-  if (!isEmpty(X))
-    OX<<std::string(spcLen,' ')<<X<<std::endl;
   return;
 }
 
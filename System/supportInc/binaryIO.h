@@ -0,0 +1,50 @@
+/********************************************************************* 
+  CombLayer : MCNP(X) Input builder
+ 
+ * File:   supportInc/binaryIO.h
+ *
+ * Copyright (c) 2004-2016 by Stuart Ansell
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>. 
+ *
+ ****************************************************************************/
+#ifndef StrFunc_binaryIO_h
+#define StrFunc_binaryIO_h
+
+namespace Geometry
+{
+  class Vec3D;
+}
+
+namespace StrFunc
+{
+
+  /// Write a value in native binary form
+  template<typename T> void writeBin(std::ostream&,const T&);
+  /// Read a value in native binary form
+  template<typename T> void readBin(std::istream&,T&);
+
+  template<> void writeBin(std::ostream&,const std::string&);
+  template<> void writeBin(std::ostream&,const Geometry::Vec3D&);
+  template<> void readBin(std::istream&,std::string&);
+  template<> void readBin(std::istream&,Geometry::Vec3D&);
+
+  template<typename T> 
+  void writeBin(std::ostream&,const std::vector<T>&);
+  template<typename T> 
+  void readBin(std::istream&,std::vector<T>&);
+
+}  // NAMESPACE StrFunc
+
+#endif
@@ -0,0 +1,43 @@
+/********************************************************************* 
+  CombLayer : MCNP(X) Input builder
+ 
+ * File:   supportInc/blockWrite.h
+ *
+ * Copyright (c) 2004-2016 by Stuart Ansell
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>. 
+ *
+ ****************************************************************************/
+#ifndef StrFunc_blockWrite_h
+#define StrFunc_blockWrite_h
+
+namespace StrFunc
+{
+
+  /// Writer of a single item to a stream
+  typedef std::function<void(const size_t,std::ostream&)> itemWriter;
+
+  /// Writer of a single item to a set of streams
+  typedef std::function<void(const size_t,
+			     const std::vector<std::ostream*>&)> multiWriter;
+
+  void writeBlocks(std::ostream&,const size_t,const size_t,
+		   const size_t,const itemWriter&);
+  std::vector<std::string>
+  formatBlocks(const size_t,const size_t,const size_t,
+	       const size_t,const multiWriter&);
+
+}  // NAMESPACE StrFunc
+
+#endif
@@ -3,7 +3,7 @@
  
  * File:   visit/MD5sum.cxx
  *
- * Copyright (c) 2004-2014 by Stuart Ansell
+ * Copyright (c) 2004-2016 by Stuart Ansell
  *
  * This program is free software: you can redistribute it and/or modify
  * it under the terms of the GNU General Public License as published by
@@ -31,6 +31,10 @@
 #include <set>
 #include <vector>
 #include <memory>
+#include <algorithm>
+#include <thread>
+#include <atomic>
+#include <exception>
 #include <boost/format.hpp>
 #include <boost/multi_array.hpp>
 
@@ -58,6 +62,7 @@
 #include "SimProcess.h"
 #include "SurInter.h"
 #include "Simulation.h"
+#include "QueryContext.h"
 #include "MatMD5.h"
 #include "MD5sum.h"
 
@@ -76,7 +81,7 @@ operator<<(std::ostream& OX,const MD5sum& A)
 }
 
 MD5sum::MD5sum(const size_t MaxN) : 
-  Results(MaxN)
+  nThread(0),Results(MaxN)
   /*!
     Constructor
     \param MaxN :: Maximum number of materials
@@ -84,7 +89,7 @@ MD5sum::MD5sum(const size_t MaxN) :
 {}
 
 MD5sum::MD5sum(const MD5sum& A) : 
-  Origin(A.Origin),XYZ(A.XYZ),nPts(A.nPts),
+  Origin(A.Origin),XYZ(A.XYZ),nPts(A.nPts),nThread(A.nThread),
   Results(A.Results)
   /*!
     Copy constructor
@@ -105,6 +110,7 @@ MD5sum::operator=(const MD5sum& A)
       Origin=A.Origin;
       XYZ=A.XYZ;
       nPts=A.nPts;
+      nThread=A.nThread;
       Results=A.Results;
     }
   return *this;
@@ -148,26 +154,66 @@ MD5sum::setIndex(const size_t A,const size_t B,const size_t C)
 }
 
 void
-MD5sum::populate(const Simulation* SimPtr)
+MD5sum::populateSlab(const Simulation& System,const size_t i,
+		     const size_t a,const size_t b,const size_t c,
+		     ModelSupport::QueryContext& QC,
+		     std::vector<size_t>& SlabMat) const
   /*!
-    The big population call
-    \param SimPtr :: Simulation system
+    Find the material of each point of one slab. The cell 
+    hint starts empty so the slab does not depend on the
+    slabs the thread did before.
+    \param System :: Simulation system
+    \param i :: Slab index [on axis a]
+    \param a :: Slab axis
+    \param b :: Row axis
+    \param c :: Point axis
+    \param QC :: Query context of thread
+    \param SlabMat :: Material of each point [j*nPts[c]+k]
    */
 {
-  ELog::RegMethod RegA("MD5sum","populate");
   const size_t RSize(Results.size());
   MonteCarlo::Object* ObjPtr(0);
   Geometry::Vec3D aVec;
+  QC.clearAll();
+
+  aVec[a]=XYZ[a]*((static_cast<double>(i)+0.5)/
+		  static_cast<double>(nPts[a]));
+  for(size_t j=0;j<nPts[b];j++)
+    {
+      aVec[1]=XYZ[b]*((static_cast<double>(j)+0.5)/
+		      static_cast<double>(nPts[b]));
+      for(size_t k=0;k<nPts[c];k++)
+	{
+	  aVec[c]=XYZ[c]*((static_cast<double>(k)+0.5)/
+			  static_cast<double>(nPts[c]));
+	  const Geometry::Vec3D Pt=Origin+aVec;
+	  ObjPtr=System.findCell(Pt,ObjPtr,QC);
+	  const size_t matN=(ObjPtr) ? 
+	    static_cast<size_t>(ObjPtr->getMat()) : 0;
+	  if (matN>=RSize)
+	    throw ColErr::IndexError<size_t>(matN,RSize,"RSize");
+	  SlabMat[j*nPts[c]+k]=matN;
+	}
+    }
+  return;
+}
+
+void
+MD5sum::populate(const Simulation* SimPtr)
+  /*!
+    The big population call. Slabs on the coarsest
+    axis are shared between the threads. The points are
+    added to the results in the order of the serial loop.
+    \param SimPtr :: Simulation system
+   */
+{
+  ELog::RegMethod RegA("MD5sum","populate");
 
-  size_t percent(0);
-  size_t cnt(0);
-  size_t reportTime(nPts[0]*nPts[1]*nPts[2] / 100);
-  
   std::vector<double> sizeXYZ(3);
   std::vector<size_t> index(3);
   for(size_t i=0;i<3;i++)
     {
-      sizeXYZ[i]=fabs(XYZ[i]/nPts[i]);
+      sizeXYZ[i]=fabs(XYZ[i]/static_cast<double>(nPts[i]));
       index[i]=i;
     }
   indexSort(sizeXYZ,index);
@@ -175,35 +221,60 @@ MD5sum::populate(const Simulation* SimPtr)
   const size_t a=index[2];  
   const size_t b=index[1];
   const size_t c=index[0];
+
+  size_t NT(nThread);
+  if (!NT)
+    NT=static_cast<size_t>(std::thread::hardware_concurrency());
+  NT=std::max<size_t>(1,std::min(NT,nPts[a]));
+
+  std::vector<std::vector<size_t>> SlabMat
+    (nPts[a],std::vector<size_t>(nPts[b]*nPts[c]));
+  std::atomic<size_t> slabCnt(0);
+  std::vector<std::exception_ptr> TError(NT);
+  std::vector<std::thread> TUnit;
+  for(size_t i=0;i<NT;i++)
+    {
+      TUnit.push_back
+	(std::thread([&,i]()
+		     {
+		       try
+			 {
+			   ModelSupport::QueryContext QC;
+			   for(size_t slab=slabCnt++;slab<nPts[a];
+			       slab=slabCnt++)
+			     populateSlab(*SimPtr,slab,a,b,c,QC,
+					  SlabMat[slab]);
+			 }
+		       catch (...)
+			 {
+			   TError[i]=std::current_exception();
+			 }
+		     }));
+    }
+  for(std::thread& TU : TUnit)
+    TU.join();
+  for(const std::exception_ptr& EP : TError)
+    if (EP) std::rethrow_exception(EP);
+
+  // Sum in point order
+  Geometry::Vec3D aVec;
   for(size_t i=0;i<nPts[a];i++)
     {
-      aVec[a]=XYZ[a]*((i+0.5)/nPts[a]);
+      aVec[a]=XYZ[a]*((static_cast<double>(i)+0.5)/
+		      static_cast<double>(nPts[a]));
       for(size_t j=0;j<nPts[b];j++)
-        {
-	  aVec[1]=XYZ[b]*((j+0.5)/nPts[b]);
+	{
+	  aVec[1]=XYZ[b]*((static_cast<double>(j)+0.5)/
+			  static_cast<double>(nPts[b]));
 	  for(size_t k=0;k<nPts[c];k++)
 	    {
-	      aVec[c]=XYZ[c]*((k+0.5)/nPts[c]);
-	      const Geometry::Vec3D Pt=Origin+aVec;
-	      ObjPtr=SimPtr->findCell(Pt,ObjPtr);
-	      const size_t matN=static_cast<size_t>(ObjPtr->getMat());
-	      if (matN>=RSize)
-		{
-		  ELog::EM<<"Error at point "<<aVec<<ELog::endCrit;
-		  throw ColErr::IndexError<size_t>(matN,RSize,"RSize");
-		}
-	      Results[matN].addUnit(aVec);
-	      if (cnt>reportTime)
-		{
-		  percent++;
-		  cnt=0;
-		  ELog::EM<<"On section "<<percent<<" ["
-			  <<reportTime*percent<<"]"<<ELog::endTrace;
-		}
-	      cnt++;
+	      aVec[c]=XYZ[c]*((static_cast<double>(k)+0.5)/
+			      static_cast<double>(nPts[c]));
+	      Results[SlabMat[i][j*nPts[c]+k]].addUnit(aVec);
 	    }
 	}
     }
+  
   return;
 }
 
@@ -30,8 +30,16 @@
 #include <map>
 #include <set>
 #include <vector>
+#include <algorithm>
+#include <thread>
+#include <atomic>
+#include <exception>
+#include <cstdint>
 #include <boost/format.hpp>
 #include <boost/multi_array.hpp>
+#ifndef NO_ZLIB
+#include <zlib.h>
+#endif
 
 #include "Exception.h"
 #include "FileReport.h"
@@ -44,6 +52,7 @@
 #include "MatrixBase.h"
 #include "Matrix.h"
 #include "Vec3D.h"
+#include "BoundBox.h"
 #include "Quaternion.h"
 #include "objectRegister.h"
 #include "localRotate.h"
@@ -61,17 +70,23 @@
 #include "SimProcess.h"
 #include "SurInter.h"
 #include "Simulation.h"
+#include "ObjBoxTree.h"
+#include "QueryContext.h"
+#include "neutron.h"
 #include "Visit.h"
 
 Visit::Visit() :
-  nPts(0,0,0)
+  outType(VISITenum::cellID),nPts(0,0,0),nThread(0),lineTrack(0),
+  format(VTKformat::ascii)
   /*!
     Constructor
   */
 {}
 
 Visit::Visit(const Visit& A) : 
-  Origin(A.Origin),XYZ(A.XYZ),nPts(A.nPts),mesh(A.mesh)
+  outType(A.outType),Origin(A.Origin),XYZ(A.XYZ),nPts(A.nPts),
+  mesh(A.mesh),nThread(A.nThread),lineTrack(A.lineTrack),
+  format(A.format)
   /*!
     Copy constructor
     \param A :: Visit to copy
@@ -88,10 +103,16 @@ Visit::operator=(const Visit& A)
 {
   if (this!=&A)
     {
+      outType=A.outType;
       Origin=A.Origin;
       XYZ=A.XYZ;
       nPts=A.nPts;
+      mesh.resize(boost::extents[A.mesh.shape()[0]]
+		  [A.mesh.shape()[1]][A.mesh.shape()[2]]);
       mesh=A.mesh;
+      nThread=A.nThread;
+      lineTrack=A.lineTrack;
+      format=A.format;
     }
   return *this;
 }
@@ -102,6 +123,55 @@ Visit::~Visit()
    */
 {}
 
+Visit::VTKformat
+Visit::formatType(const std::string& FName)
+  /*!
+    Convert a format name into a stream output format
+    \param FName :: ascii / binary / vti / vtiz
+    \return VTK format
+  */
+{
+  ELog::RegMethod RegA("Visit","formatType");
+
+  if (FName=="ascii") return VTKformat::ascii;
+  if (FName=="binary") return VTKformat::binary;
+  if (FName=="vti") return VTKformat::vti;
+  if (FName=="vtiz" || FName=="vtiZ") return VTKformat::vtiZ;
+  throw ColErr::InContainerError<std::string>(FName,"VTK format");
+}
+
+bool
+Visit::bigEndian()
+  /*!
+    Determine the byte order of the host
+    \return true if big endian
+  */
+{
+  const uint32_t A(1);
+  return (*reinterpret_cast<const unsigned char*>(&A)==0);
+}
+
+std::string
+Visit::typeName() const
+  /*!
+    Name of the output type for the data array
+    \return type name
+  */
+{
+  switch(outType)
+    {
+    case VISITenum::cellID:
+      return "cellID";
+    case VISITenum::material:
+      return "material";
+    case VISITenum::density:
+      return "density";
+    case VISITenum::weight:
+      return "weight";
+    }
+  return "cellID";
+}
+
 void 
 Visit::setBox(const Geometry::Vec3D& startPt,
 	      const Geometry::Vec3D& endPt)
@@ -120,7 +190,8 @@ void
 Visit::setIndex(const size_t A,const size_t B,const size_t C)
   /*!
     Set the index values , checks to ensure that 
-    they are greater than zero
+    they are greater than zero. The mesh is only
+    allocated by populate.
     \param A :: Xcoordinate division
     \param B :: Ycoordinate division
     \param C :: Zcoordinate division
@@ -129,7 +200,6 @@ Visit::setIndex(const size_t A,const size_t B,const size_t C)
   nPts=Triple<long int>(static_cast<long int>(A),
 			static_cast<long int>(B),
 			static_cast<long int>(C));
-  mesh.resize(boost::extents[nPts[0]][nPts[1]][nPts[2]]);
   return;
 }
 
@@ -168,63 +238,236 @@ Visit::getResult(const MonteCarlo::Object* ObjPtr) const
   return 0.0;
 }
 
+double
+Visit::getResult(const MonteCarlo::Object* ObjPtr,
+		 const std::set<std::string>& Active,
+		 ModelSupport::QueryContext& QC) const
+  /*!
+    Determine the result for an object only if 
+    the object is within the active set
+    \param ObjPtr :: object to calculate for
+    \param Active :: Active set [empty for all]
+    \param QC :: Query context [range hint]
+    \return result
+  */
+{
+  if (!ObjPtr) return 0.0;
+  if (!Active.empty())
+    {
+      const ModelSupport::objectRegister& OR=
+	ModelSupport::objectRegister::Instance();
+      const std::string rangeStr=OR.inRange(ObjPtr->getName(),QC);
+      if (Active.find(rangeStr)==Active.end())
+	return 0.0;
+    }
+  return getResult(ObjPtr);
+}
+
+void
+Visit::pointRow(const ModelSupport::ObjBoxTree& OBT,
+		const Geometry::Vec3D& RowPt,
+		const size_t axis,
+		MonteCarlo::Object*& ObjPtr,
+		std::vector<MonteCarlo::Object*>& RowObj) const
+  /*!
+    Find the cells on a row by locating each point
+    \param OBT :: Cell tree of the mesh region
+    \param RowPt :: First point on the row
+    \param axis :: Row direction [0-2]
+    \param ObjPtr :: Last cell found [hint/updated]
+    \param RowObj :: Cell at each point
+  */
+{
+  const double stepZ=XYZ[axis]/static_cast<double>(nPts[axis]);
+  Geometry::Vec3D Pt(RowPt);
+  for(long int k=0;k<nPts[axis];k++)
+    {
+      Pt[axis]=RowPt[axis]+stepZ*static_cast<double>(k);
+      if (!ObjPtr || !ObjPtr->isValid(Pt))
+	ObjPtr=OBT.findCell(Pt);
+      RowObj[static_cast<size_t>(k)]=ObjPtr;
+    }
+  return;
+}
+
+void
+Visit::trackRow(const ModelSupport::ObjBoxTree& OBT,
+		const Geometry::Vec3D& RowPt,
+		const size_t axis,
+		MonteCarlo::Object*& ObjPtr,
+		std::vector<MonteCarlo::Object*>& RowObj) const
+  /*!
+    Find the cells on a row by tracking along the row. 
+    A point is only located at the start of each cell 
+    and all points before the exit surface are given
+    that cell.
+    \param OBT :: Cell tree of the mesh region
+    \param RowPt :: First point on the row
+    \param axis :: Row direction [0-2]
+    \param ObjPtr :: Last cell found [hint/updated]
+    \param RowObj :: Cell at each point
+  */
+{
+  const long int NRow(nPts[axis]);
+  const double stepZ=XYZ[axis]/static_cast<double>(NRow);
+  const double absStep=std::abs(stepZ);
+  Geometry::Vec3D Axis;
+  Axis[axis]=(stepZ<0.0) ? -1.0 : 1.0;
+  const Geometry::Surface* SPtr;
+  double aDist;
+
+  Geometry::Vec3D Pt(RowPt);
+  long int k(0);
+  while(k<NRow)
+    {
+      Pt[axis]=RowPt[axis]+stepZ*static_cast<double>(k);
+      if (!ObjPtr || !ObjPtr->isValid(Pt))
+	ObjPtr=OBT.findCell(Pt);
+      long int kEnd(k+1);
+      if (ObjPtr)
+	{
+	  const MonteCarlo::neutron TNeut(1.0,Pt,Axis);
+	  ObjPtr->trackOutCell(TNeut,aDist,SPtr,0);
+	  // points before the exit [less tolerance]
+	  const double NStep=(aDist-Geometry::zeroTol)/absStep;
+	  if (NStep>=static_cast<double>(NRow-k))
+	    kEnd=NRow;
+	  else if (NStep>1.0)
+	    kEnd=k+static_cast<long int>(std::ceil(NStep));
+	}
+      for(;k<kEnd;k++)
+	RowObj[static_cast<size_t>(k)]=ObjPtr;
+    }
+  return;
+}
+
+void
+Visit::populateSlab(const ModelSupport::ObjBoxTree& OBT,
+		    const std::set<std::string>& Active,
+		    const long int i,
+		    ModelSupport::QueryContext& QC)
+  /*!
+    Populate one x-slab of the mesh
+    \param OBT :: Cell tree of the mesh region
+    \param Active :: Active set
+    \param i :: x-index of slab
+    \param QC :: Query context of thread
+   */
+{
+  MonteCarlo::Object* ObjPtr(0);
+  std::vector<MonteCarlo::Object*> RowObj(static_cast<size_t>(nPts[2]));
+
+  double stepXYZ[3];
+  for(size_t index=0;index<3;index++)
+    stepXYZ[index]=XYZ[index]/static_cast<double>(nPts[index]);
+
+  Geometry::Vec3D Pt(Origin[0]+stepXYZ[0]*(static_cast<double>(i)+0.5),
+		     0.0,Origin[2]+stepXYZ[2]*0.5);
+  for(long int j=0;j<nPts[1];j++)
+    {
+      Pt[1]=Origin[1]+stepXYZ[1]*(static_cast<double>(j)+0.5);
+      if (lineTrack)
+	trackRow(OBT,Pt,2,ObjPtr,RowObj);
+      else
+	pointRow(OBT,Pt,2,ObjPtr,RowObj);
+      for(long int k=0;k<nPts[2];k++)
+	mesh[i][j][k]=getResult(RowObj[static_cast<size_t>(k)],Active,QC);
+    }
+  return;
+}
+
+void
+Visit::populatePlane(const ModelSupport::ObjBoxTree& OBT,
+		     const std::set<std::string>& Active,
+		     const long int k,
+		     ModelSupport::QueryContext& QC,
+		     std::vector<double>& Plane) const
+  /*!
+    Populate one z-plane of the mesh in VTK order [x fastest]
+    \param OBT :: Cell tree of the mesh region
+    \param Active :: Active set
+    \param k :: z-index of plane
+    \param QC :: Query context of thread
+    \param Plane :: Results [nx*ny]
+   */
+{
+  const size_t NX(static_cast<size_t>(nPts[0]));
+  MonteCarlo::Object* ObjPtr(0);
+  std::vector<MonteCarlo::Object*> RowObj(NX);
+  Plane.resize(NX*static_cast<size_t>(nPts[1]));
+
+  double stepXYZ[3];
+  for(size_t index=0;index<3;index++)
+    stepXYZ[index]=XYZ[index]/static_cast<double>(nPts[index]);
+
+  Geometry::Vec3D Pt(Origin[0]+stepXYZ[0]*0.5,0.0,
+		     Origin[2]+stepXYZ[2]*(static_cast<double>(k)+0.5));
+  for(long int j=0;j<nPts[1];j++)
+    {
+      Pt[1]=Origin[1]+stepXYZ[1]*(static_cast<double>(j)+0.5);
+      if (lineTrack)
+	trackRow(OBT,Pt,0,ObjPtr,RowObj);
+      else
+	pointRow(OBT,Pt,0,ObjPtr,RowObj);
+      const size_t offset(static_cast<size_t>(j)*NX);
+      for(size_t i=0;i<NX;i++)
+	Plane[offset+i]=getResult(RowObj[i],Active,QC);
+    }
+  return;
+}
+
 void
 Visit::populate(const Simulation* SimPtr,
 		const std::set<std::string>& Active)
   /*!
-    The big population call
+    The big population call. The x-slabs are
+    shared between the threads.
     \param SimPtr :: Simulation system
     \param Active :: Active set
    */
 {
   ELog::RegMethod RegA("Visit","populate");
-  MonteCarlo::Object* ObjPtr(0);
-  Geometry::Vec3D aVec;
 
-  const ModelSupport::objectRegister& OR=
-    ModelSupport::objectRegister::Instance();
-  
-  const bool aEmptyFlag=Active.empty();
+  mesh.resize(boost::extents[nPts[0]][nPts[1]][nPts[2]]);
 
-  size_t beCnt(0);
-  double stepXYZ[3];
-  for(size_t i=0;i<3;i++)
-    stepXYZ[i]=XYZ[i]/nPts[i];
+  // Only cells that can reach the mesh are searched
+  Geometry::BoundBox Region=Geometry::BoundBox::emptyBox();
+  Region.addPoint(Origin);
+  Region.addPoint(Origin+XYZ);
+  ModelSupport::ObjBoxTree OBT;
+  OBT.build(SimPtr->getCells(),Region);
 
-  for(long int i=0;i<nPts[0];i++)
+  size_t NT(nThread);
+  if (!NT)
+    NT=static_cast<size_t>(std::thread::hardware_concurrency());
+  NT=std::max<size_t>(1,std::min(NT,static_cast<size_t>(nPts[0])));
+
+  std::atomic<long int> slabCnt(0);
+  std::vector<std::exception_ptr> TError(NT);
+  std::vector<std::thread> TUnit;
+  for(size_t i=0;i<NT;i++)
     {
-      aVec[0]=stepXYZ[0]*(i+0.5);
-      for(long int j=0;j<nPts[1];j++)
-        {
-	  aVec[1]=stepXYZ[1]*(0.5+j);
-	  for(long int k=0;k<nPts[2];k++)
-	    {
-	      aVec[2]=stepXYZ[2]*(0.5+k);
-	      const Geometry::Vec3D Pt=Origin+aVec;
-	      ObjPtr=SimPtr->findCell(Pt,ObjPtr);
-	      // Active Set Code:
-	      if (!aEmptyFlag)
-		{
-		  const std::string rangeStr=OR.inRange(ObjPtr->getName());
-		  if (Active.find(rangeStr)!=Active.end())
-		    {
-		      mesh[i][j][k]=getResult(ObjPtr);
-		    }
-		  else
-		    mesh[i][j][k]=0.0;
-		}
-	      // OLD Code:
-	      else
-		{
-		  mesh[i][j][k]=getResult(ObjPtr);
-		  if (outType==VISITenum::material && 
-		      fabs(mesh[i][j][k]-37)<1e-4)
-		    beCnt++;
-		}
-
-	    }
-	}
+      TUnit.push_back
+	(std::thread([&,i]()
+		     {
+		       try
+			 {
+			   ModelSupport::QueryContext QC;
+			   for(long int slab=slabCnt++;slab<nPts[0];
+			       slab=slabCnt++)
+			     populateSlab(OBT,Active,slab,QC);
+			 }
+		       catch (...)
+			 {
+			   TError[i]=std::current_exception();
+			 }
+		     }));
     }
+  for(std::thread& TU : TUnit)
+    TU.join();
+  for(const std::exception_ptr& EP : TError)
+    if (EP) std::rethrow_exception(EP);
+
   return;
 }
 
@@ -242,15 +485,12 @@ Visit::populate(const Simulation* SimPtr)
 
 
 void
-Visit::writeVTK(const std::string& FName) const
+Visit::writeASCIIHead(std::ostream& OX) const
   /*!
-    Write out a VTK cell
-    \param FName :: filename 
+    Write the ASCII legacy VTK header [up to the point data]
+    \param OX :: Output stream
   */
 {
-  if (FName.empty()) return;
-  std::ofstream OX(FName.c_str());
-  std::ostringstream cx;
   boost::format fFMT("%1$11.6g%|14t|");
 
   double stepXYZ[3];
@@ -280,7 +520,283 @@ Visit::writeVTK(const std::string& FName) const
   OX<<"POINT_DATA "<<nPts[0]*nPts[1]*nPts[2]<<std::endl;
   OX<<"SCALARS cellID float 1.0"<<std::endl;
   OX<<"LOOKUP_TABLE default"<<std::endl;
+  return;
+}
+
+void
+Visit::writeLegacyHead(std::ostream& OX) const
+  /*!
+    Write the binary legacy VTK header. The data
+    follows as big-endian floats.
+    \param OX :: Output stream
+  */
+{
+  OX<<"# vtk DataFile Version 2.0\n";
+  OX<<"chipIR Data\n";
+  OX<<"BINARY\n";
+  OX<<"DATASET STRUCTURED_POINTS\n";
+  OX<<"DIMENSIONS "<<nPts[0]<<" "<<nPts[1]<<" "<<nPts[2]<<"\n";
+  OX<<std::setprecision(12);
+  OX<<"ORIGIN";
+  for(size_t i=0;i<3;i++)
+    OX<<" "<<Origin[i]+0.5*XYZ[i]/static_cast<double>(nPts[i]);
+  OX<<"\nSPACING";
+  for(size_t i=0;i<3;i++)
+    OX<<" "<<XYZ[i]/static_cast<double>(nPts[i]);
+  OX<<"\n";
+  OX<<"POINT_DATA "<<nPts[0]*nPts[1]*nPts[2]<<"\n";
+  OX<<"SCALARS "<<typeName()<<" float 1\n";
+  OX<<"LOOKUP_TABLE default\n";
+  return;
+}
+
+void
+Visit::writeXMLHead(std::ostream& OX,const bool zFlag) const
+  /*!
+    Write the VTK XML ImageData header up to the start
+    of the appended data
+    \param OX :: Output stream
+    \param zFlag :: Data is zlib compressed
+  */
+{
+  std::ostringstream cx;
+  cx<<"0 "<<nPts[0]-1<<" 0 "<<nPts[1]-1<<" 0 "<<nPts[2]-1;
+  const std::string extent(cx.str());
+
+  OX<<"<?xml version=\"1.0\"?>\n";
+  OX<<"<VTKFile type=\"ImageData\" version=\"1.0\" byte_order=\""
+    <<((bigEndian()) ? "BigEndian" : "LittleEndian")
+    <<"\" header_type=\"UInt64\"";
+  if (zFlag)
+    OX<<" compressor=\"vtkZLibDataCompressor\"";
+  OX<<">\n";
+  
+  OX<<std::setprecision(12);
+  OX<<"  <ImageData WholeExtent=\""<<extent<<"\" Origin=\"";
+  for(size_t i=0;i<3;i++)
+    OX<<((i) ? " " : "")<<Origin[i]+0.5*XYZ[i]/static_cast<double>(nPts[i]);
+  OX<<"\" Spacing=\"";
+  for(size_t i=0;i<3;i++)
+    OX<<((i) ? " " : "")<<XYZ[i]/static_cast<double>(nPts[i]);
+  OX<<"\">\n";
+  OX<<"    <Piece Extent=\""<<extent<<"\">\n";
+  OX<<"      <PointData Scalars=\""<<typeName()<<"\">\n";
+  OX<<"        <DataArray type=\"Float32\" Name=\""<<typeName()
+    <<"\" format=\"appended\" offset=\"0\"/>\n";
+  OX<<"      </PointData>\n";
+  OX<<"    </Piece>\n";
+  OX<<"  </ImageData>\n";
+  OX<<"  <AppendedData encoding=\"raw\">\n   _";
+  return;
+}
+
+void
+Visit::packPlane(const std::vector<double>& Plane,
+		 const VTKformat outFormat,
+		 std::vector<char>& Block) const
+  /*!
+    Convert a z-plane into the bytes written to the file.
+    \param Plane :: Plane results [x fastest]
+    \param outFormat :: Output format
+    \param Block :: Output bytes
+  */
+{
+  if (outFormat==VTKformat::ascii)
+    {
+      std::ostringstream cx;
+      boost::format fFMT("%1$11.6g%|14t|");
+      const size_t NX(static_cast<size_t>(nPts[0]));
+      for(size_t index=0;index<Plane.size();index+=NX)
+	{
+	  for(size_t i=0;i<NX;i++)
+	    cx<<(fFMT % Plane[index+i]);
+	  cx<<std::endl;
+	}
+      const std::string Out(cx.str());
+      Block.assign(Out.begin(),Out.end());
+      return;
+    }
+
+  // legacy binary is always big-endian
+  const bool swapFlag(outFormat==VTKformat::binary && !bigEndian());
+  Block.resize(sizeof(float)*Plane.size());
+  char* BPtr(Block.data());
+  for(const double V : Plane)
+    {
+      const float F(static_cast<float>(V));
+      const char* FPtr(reinterpret_cast<const char*>(&F));
+      if (swapFlag)
+	std::reverse_copy(FPtr,FPtr+sizeof(float),BPtr);
+      else
+	std::copy(FPtr,FPtr+sizeof(float),BPtr);
+      BPtr+=sizeof(float);
+    }
+#ifndef NO_ZLIB
+  if (outFormat==VTKformat::vtiZ)
+    {
+      uLongf ZLen=compressBound(static_cast<uLong>(Block.size()));
+      std::vector<char> ZBlock(ZLen);
+      if (compress2(reinterpret_cast<Bytef*>(ZBlock.data()),&ZLen,
+		    reinterpret_cast<const Bytef*>(Block.data()),
+		    static_cast<uLong>(Block.size()),
+		    Z_DEFAULT_COMPRESSION)!=Z_OK)
+	throw ColErr::ExBase(0,"zlib compression failed");
+      ZBlock.resize(ZLen);
+      Block.swap(ZBlock);
+    }
+#endif
+  return;
+}
+
+void
+Visit::writeStream(const Simulation* SimPtr,
+		   const std::set<std::string>& Active,
+		   const std::string& FName) const
+  /*!
+    Populate and write the mesh one batch of z-planes
+    at a time so the full mesh is never held. The planes
+    of a batch are shared between the threads and then
+    written in order. Compressed vti files have one
+    zlib block per plane and the block table is 
+    written once all the planes are done.
+    \param SimPtr :: Simulation system
+    \param Active :: Active set
+    \param FName :: filename 
+   */
+{
+  ELog::RegMethod RegA("Visit","writeStream");
+
+  if (FName.empty()) return;
+
+  VTKformat outFormat(format);
+#ifdef NO_ZLIB
+  if (outFormat==VTKformat::vtiZ)
+    {
+      ELog::EM<<"No zlib support : writing uncompressed vti"<<ELog::endWarn;
+      outFormat=VTKformat::vti;
+    }
+#endif
+
+  std::ofstream OX(FName.c_str(),std::ios::out | std::ios::binary);
+  if (!OX.good())
+    throw ColErr::FileError(0,FName,"Visit::writeStream");
+
+  Geometry::BoundBox Region=Geometry::BoundBox::emptyBox();
+  Region.addPoint(Origin);
+  Region.addPoint(Origin+XYZ);
+  ModelSupport::ObjBoxTree OBT;
+  OBT.build(SimPtr->getCells(),Region);
+
+  const size_t NPlane(static_cast<size_t>(nPts[2]));
+  const uint64_t blockBytes(sizeof(float)*
+			    static_cast<uint64_t>(nPts[0]*nPts[1]));
+
+  size_t NT(nThread);
+  if (!NT)
+    NT=static_cast<size_t>(std::thread::hardware_concurrency());
+  NT=std::max<size_t>(1,std::min(NT,NPlane));
+  const size_t NBatch(2*NT);
+
+  std::streampos ZHead(0);
+  std::vector<uint64_t> ZHeader;   // nBlock : blockSize : lastSize : sizes
+  switch (outFormat)
+    {
+    case VTKformat::ascii:
+      writeASCIIHead(OX);
+      break;
+    case VTKformat::binary:
+      writeLegacyHead(OX);
+      break;
+    case VTKformat::vti:
+      {
+	writeXMLHead(OX,0);
+	const uint64_t NBytes(blockBytes*NPlane);
+	OX.write(reinterpret_cast<const char*>(&NBytes),sizeof(uint64_t));
+	break;
+      }
+    case VTKformat::vtiZ:
+      writeXMLHead(OX,1);
+      ZHeader.resize(3+NPlane,0);
+      ZHeader[0]=NPlane;
+      ZHeader[1]=blockBytes;
+      ZHead=OX.tellp();
+      OX.write(reinterpret_cast<const char*>(ZHeader.data()),
+	       static_cast<std::streamsize>(sizeof(uint64_t)*ZHeader.size()));
+      break;
+    }
+
+  std::vector<ModelSupport::QueryContext> QCVec(NT);
+  std::vector<std::vector<double>> Planes(NT);
+  std::vector<std::vector<char>> Blocks(NBatch);
+  for(size_t kStart=0;kStart<NPlane;kStart+=NBatch)
+    {
+      const size_t kEnd(std::min(NPlane,kStart+NBatch));
+      std::atomic<size_t> planeCnt(kStart);
+      std::vector<std::exception_ptr> TError(NT);
+      std::vector<std::thread> TUnit;
+      for(size_t i=0;i<NT;i++)
+	{
+	  TUnit.push_back
+	    (std::thread([&,i]()
+			 {
+			   try
+			     {
+			       for(size_t k=planeCnt++;k<kEnd;k=planeCnt++)
+				 {
+				   populatePlane(OBT,Active,
+						 static_cast<long int>(k),
+						 QCVec[i],Planes[i]);
+				   packPlane(Planes[i],outFormat,
+					     Blocks[k-kStart]);
+				 }
+			     }
+			   catch (...)
+			     {
+			       TError[i]=std::current_exception();
+			     }
+			 }));
+	}
+      for(std::thread& TU : TUnit)
+	TU.join();
+      for(const std::exception_ptr& EP : TError)
+	if (EP) std::rethrow_exception(EP);
+
+      for(size_t k=kStart;k<kEnd;k++)
+	{
+	  const std::vector<char>& Block(Blocks[k-kStart]);
+	  OX.write(Block.data(),static_cast<std::streamsize>(Block.size()));
+	  if (outFormat==VTKformat::vtiZ)
+	    ZHeader[3+k]=Block.size();
+	}
+    }
+
+  if (outFormat==VTKformat::vti || outFormat==VTKformat::vtiZ)
+    {
+      OX<<"\n  </AppendedData>\n";
+      OX<<"</VTKFile>\n";
+    }
+  if (outFormat==VTKformat::vtiZ)
+    {
+      OX.seekp(ZHead);
+      OX.write(reinterpret_cast<const char*>(ZHeader.data()),
+	       static_cast<std::streamsize>(sizeof(uint64_t)*ZHeader.size()));
+    }
+  OX.close();
+  return;
+}
+
+void
+Visit::writeVTK(const std::string& FName) const
+  /*!
+    Write out a VTK cell
+    \param FName :: filename 
+  */
+{
+  if (FName.empty()) return;
+  std::ofstream OX(FName.c_str());
+  boost::format fFMT("%1$11.6g%|14t|");
 
+  writeASCIIHead(OX);
   for(int k=0;k<nPts[2];k++)
     for(int j=0;j<nPts[1];j++)
       {
@@ -3,7 +3,7 @@
  
  * File:   visitInc/MD5sum.h
 *
- * Copyright (c) 2004-2013 by Stuart Ansell
+ * Copyright (c) 2004-2016 by Stuart Ansell
  *
  * This program is free software: you can redistribute it and/or modify
  * it under the terms of the GNU General Public License as published by
@@ -28,6 +28,11 @@ namespace MonteCarlo
 class Object;
 }
 
+namespace ModelSupport
+{
+  class QueryContext;
+}
+
 
 
 /*!
@@ -35,7 +40,12 @@ class Object;
   \brief Hold an official model number
   \date August 2010
   \author S. Ansell
-  \version 1.0
+  \version 1.1
+
+  The slabs of the mesh are shared between threads. Each 
+  slab finds its cells from an empty cell hint and the 
+  points are summed in the serial order, so the result 
+  does not depend on the thread count.
 */
 						
 class MD5sum
@@ -46,10 +56,15 @@ class MD5sum
   Geometry::Vec3D Origin;     ///< Origin
   Geometry::Vec3D XYZ;        ///< XYZ extent
   Triple<size_t> nPts;        ///< Number x points
+  size_t nThread;             ///< Number of threads [0 : hardware]
   
   /// Calc results:
   std::vector<MatMD5> Results;
 
+  void populateSlab(const Simulation&,const size_t,const size_t,
+		    const size_t,const size_t,ModelSupport::QueryContext&,
+		    std::vector<size_t>&) const;
+
  public:
 
   MD5sum(const size_t);
@@ -60,6 +75,8 @@ class MD5sum
   void setBox(const Geometry::Vec3D&,
               const Geometry::Vec3D&);
   void setIndex(const size_t,const size_t,const size_t);
+  /// Set the number of threads [0 : hardware]
+  void setThreads(const size_t N) { nThread=N; }
 
   void populate(const Simulation*);
   void write(std::ostream&) const;
@@ -28,16 +28,29 @@ namespace MonteCarlo
 class Object;
 }
 
+namespace ModelSupport
+{
+  class ObjBoxTree;
+  class QueryContext;
+}
+
 /*!
   \class Visit
   \brief Hold VTK output format 
   \date August 2010
   \author S. Ansell
   \version 1.0
-  \todo Move to a binary/xml output schema
 
   This allows comparison of the vector for removing non-unique
-  Vec3D from a list
+  Vec3D from a list. The mesh is filled in x-slabs shared
+  between threads. In line-track mode each z-row is walked 
+  by tracking out of the cells rather than by locating
+  every point.
+
+  writeStream fills and writes the mesh in z-planes so 
+  the full mesh is never held. It writes ASCII/binary legacy 
+  VTK or VTK XML ImageData (raw or zlib compressed appended 
+  data).
 */
 						
 class Visit
@@ -46,6 +59,10 @@ class Visit
 
   /// Types of information to plot
   enum class VISITenum : int { cellID=0,material=1,density=2,weight=3};
+  /// Output file formats
+  enum class VTKformat : int { ascii=0,binary=1,vti=2,vtiZ=3 };
+
+  static VTKformat formatType(const std::string&);
 
  private:
   
@@ -56,7 +73,39 @@ class Visit
   Triple<long int> nPts;        ///< Number x points
   boost::multi_array<double,3> mesh;  ///< results mesh
 
+  size_t nThread;             ///< Number of threads [0 : hardware]
+  int lineTrack;              ///< Walk rows by tracking
+  VTKformat format;           ///< Stream output format
+
+  static bool bigEndian();
+
   double getResult(const MonteCarlo::Object*) const;
+  double getResult(const MonteCarlo::Object*,
+		   const std::set<std::string>&,
+		   ModelSupport::QueryContext&) const;
+
+  std::string typeName() const;
+  
+  void pointRow(const ModelSupport::ObjBoxTree&,const Geometry::Vec3D&,
+		const size_t,MonteCarlo::Object*&,
+		std::vector<MonteCarlo::Object*>&) const;
+  void trackRow(const ModelSupport::ObjBoxTree&,const Geometry::Vec3D&,
+		const size_t,MonteCarlo::Object*&,
+		std::vector<MonteCarlo::Object*>&) const;
+  void populateSlab(const ModelSupport::ObjBoxTree&,
+		    const std::set<std::string>&,const long int,
+		    ModelSupport::QueryContext&);
+  void populatePlane(const ModelSupport::ObjBoxTree&,
+		     const std::set<std::string>&,const long int,
+		     ModelSupport::QueryContext&,
+		     std::vector<double>&) const;
+
+  void packPlane(const std::vector<double>&,const VTKformat,
+		 std::vector<char>&) const;
+
+  void writeASCIIHead(std::ostream&) const;
+  void writeLegacyHead(std::ostream&) const;
+  void writeXMLHead(std::ostream&,const bool) const;
 
  public:
 
@@ -66,13 +115,23 @@ class Visit
   ~Visit();
 
   void setType(const VISITenum&);
+  /// Set the number of threads [0 : hardware]
+  void setThreads(const size_t N) { nThread=N; }
+  /// Set row tracking
+  void setLineTrack(const int F) { lineTrack=F; }
+  /// Set the stream output format
+  void setFormat(const VTKformat& F) { format=F; }
   void setBox(const Geometry::Vec3D&,
               const Geometry::Vec3D&);
   void setIndex(const size_t,const size_t,const size_t);
 
   void populate(const Simulation*);
   void populate(const Simulation*,const std::set<std::string>&);
+  /// Access the results mesh
+  const boost::multi_array<double,3>& getMesh() const { return mesh; }
   void writeVTK(const std::string&) const;
+  void writeStream(const Simulation*,const std::set<std::string>&,
+		   const std::string&) const;
 };
 
 
@@ -74,14 +74,15 @@ operator<<(std::ostream& OX,const ItemWeight& A)
 }
 
 ItemWeight::ItemWeight()  :
-  sigmaScale(0.06914)
+  sigmaScale(0.06914),nDense(0)
   /*! 
     Constructor 
   */
 {}
 
 ItemWeight::ItemWeight(const ItemWeight& A)  :
-  sigmaScale(A.sigmaScale),Cells(A.Cells)
+  sigmaScale(A.sigmaScale),Cells(A.Cells),nDense(A.nDense),
+  DWeight(A.DWeight),DNumber(A.DNumber)
   /*! 
     Copy Constructor 
     \param A :: ItemWeight to copy
@@ -99,9 +100,46 @@ ItemWeight::operator=(const ItemWeight& A)
   if (this!=&A)
     {
       Cells=A.Cells;
+      nDense=A.nDense;
+      DWeight=A.DWeight;
+      DNumber=A.DNumber;
     }
   return *this;
 }
+
+void
+ItemWeight::setDense(const size_t N)
+  /*!
+    Hold items 1 to N in the contiguous arrays. Existing
+    items are moved between the map and the arrays.
+    \param N :: Number of dense items
+  */
+{
+  ELog::RegMethod RegA("ItemWeight","setDense");
+
+  if (N==nDense) return;
+  // move all to map
+  for(size_t i=0;i<nDense;i++)
+    if (DNumber[i]>0.0)
+      {
+	CellItem CI(DWeight[i]);
+	CI.number=DNumber[i];
+	Cells.emplace(static_cast<long int>(i+1),CI);
+      }
+
+  nDense=N;
+  DWeight.assign(N,0.0);
+  DNumber.assign(N,0.0);
+  CMapTYPE::iterator mc=Cells.lower_bound(1);
+  while(mc!=Cells.end() && mc->first<=static_cast<long int>(N))
+    {
+      const size_t index(static_cast<size_t>(mc->first-1));
+      DWeight[index]=mc->second.weight;
+      DNumber[index]=mc->second.number;
+      mc=Cells.erase(mc);
+    }
+  return;
+}
   
 void
 ItemWeight::addTracks(const long int cN,const double value)
@@ -112,6 +150,22 @@ ItemWeight::addTracks(const long int cN,const double value)
   */
 {
   ELog::RegMethod RegA("ItemWeight","addTracks");
+
+  if (cN>0 && cN<=static_cast<long int>(nDense))
+    {
+      const size_t index(static_cast<size_t>(cN-1));
+      if (DNumber[index]>0.0)
+	{
+	  DWeight[index]+=value;
+	  DNumber[index]+=1.0;
+	}
+      else
+	{
+	  DWeight[index]=value;
+	  DNumber[index]=1.0;
+	}
+      return;
+    }
   
   std::map<long int,CellItem>::iterator mc=Cells.find(cN);
   if (mc==Cells.end())
@@ -145,6 +199,16 @@ ItemWeight::calcMinWeight(const double scaleFactor,
           if (W<minW) minW=W;
         }
     }
+  for(size_t i=0;i<nDense;i++)
+    if (DNumber[i]>0.0)
+      {
+	double W=exp(-DWeight[i]*sigmaScale*scaleFactor);
+	if (W>1e-20)
+	  {
+	    W=std::pow(W,weightPower);
+	    if (W<minW) minW=W;
+	  }
+      }
   return minW;
 }
   
@@ -155,6 +219,8 @@ ItemWeight::clear()
    */
 {
   Cells.erase(Cells.begin(),Cells.end());
+  std::fill(DWeight.begin(),DWeight.end(),0.0);
+  std::fill(DNumber.begin(),DNumber.end(),0.0);
   return;
 }
   
@@ -165,8 +231,17 @@ ItemWeight::write(std::ostream& OX) const
     \param OX :: Output stream
   */
 {
-  for(const std::map<long int,CellItem>::value_type& cv : Cells)
-    OX<<cv.first<<" "<<cv.second.weight<<" "<<cv.second.number<<std::endl;
+  // dense items sit between the map items <1 and >nDense
+  CMapTYPE::const_iterator mc=Cells.begin();
+  for(;mc!=Cells.end() && mc->first<1;mc++)
+    OX<<mc->first<<" "<<mc->second.weight<<" "
+      <<mc->second.number<<std::endl;
+  for(size_t i=0;i<nDense;i++)
+    if (DNumber[i]>0.0)
+      OX<<i+1<<" "<<DWeight[i]<<" "<<DNumber[i]<<std::endl;
+  for(;mc!=Cells.end();mc++)
+    OX<<mc->first<<" "<<mc->second.weight<<" "
+      <<mc->second.number<<std::endl;
   return;
 } 
 
@@ -32,6 +32,7 @@
 #include <string>
 #include <algorithm>
 #include <memory>
+#include <cstdio>
 #include <boost/format.hpp>
 
 #include "Exception.h"
@@ -107,6 +108,32 @@ WWG::operator=(const WWG& A)
   return *this;
 }
 
+void
+WWG::writeLine(std::ostream& OX,const double V,size_t& itemCnt)
+  /*!
+    Write a value in the WWINP format [6 per line]. This is
+    StrFunc::writeLine without the boost::format cost.
+    \param OX :: Output stream
+    \param V :: Value
+    \param itemCnt :: Place in line
+  */
+{
+  char buffer[32];
+  const double AVal(std::fabs(V));
+  const int N=(AVal>9.9e4 || (AVal<1e-5 && AVal>1e-38)) ?
+    std::snprintf(buffer,sizeof(buffer),"%13.4e",V) :
+    std::snprintf(buffer,sizeof(buffer),"%13.4f",V);
+  OX.write(buffer,N);
+
+  itemCnt++;
+  if (itemCnt==6)
+    {
+      OX<<'\n';
+      itemCnt=0;
+    }
+  return;
+}
+
 void
 WWG::resetMesh(const std::vector<double>& W)
   /*!
@@ -119,15 +146,17 @@ WWG::resetMesh(const std::vector<double>& W)
   const size_t GSize=Grid.size();
   if (GSize && !EBin.empty())
     {
-      WMesh.resize(GSize);
       const size_t ESize(EBin.size());
+      WMesh.resize(GSize*ESize);
       std::vector<double>::const_iterator  vc=
         W.begin();
-      for(std::vector<double>& MUnit : WMesh)
+      for(size_t i=0;i<GSize;i++)
         {
           const double wVal=(vc!=W.end()) ? (*vc++) : 1.0;
-          MUnit.resize(ESize);
-          std::fill(MUnit.begin(),MUnit.end(),wVal);
+          std::fill(WMesh.begin()+
+		    static_cast<std::ptrdiff_t>(i*ESize),
+		    WMesh.begin()+
+		    static_cast<std::ptrdiff_t>((i+1)*ESize),wVal);
         }
     }
   else 
@@ -192,20 +221,55 @@ WWG::scaleMeshItem(const long int index,
   */
 {
   ELog::RegMethod RegA("WWG","scaleMeshItem");
-  
+
+  const size_t ESize(EBin.size());
   const size_t ID(static_cast<size_t>(index));
-  if (ID>=WMesh.size())
-    throw ColErr::IndexError<size_t>(ID,WMesh.size(),"WMesh!=ID");
-  if (DVec.size()!=WMesh[ID].size())
-    throw ColErr::IndexError<size_t>(WMesh[ID].size(),DVec.size(),
+  if (ID*ESize>=WMesh.size())
+    throw ColErr::IndexError<size_t>(ID,WMesh.size()/ESize,"WMesh!=ID");
+  if (DVec.size()!=ESize)
+    throw ColErr::IndexError<size_t>(ESize,DVec.size(),
                                          "DVec!=WMesh");
 
-  for(size_t i=0;i<DVec.size();i++)
-    WMesh[ID][i]*=DVec[i];
+  double* WPtr(&WMesh[ID*ESize]);
+  for(size_t i=0;i<ESize;i++)
+    WPtr[i]*=DVec[i];
   
   return;
 }
 
+void
+WWG::scaleMesh(const std::vector<double>& WVec,
+	       const std::vector<int>& EMask)
+  /*!
+    Scale the whole mesh : each voxel by its factor in 
+    those energy bins that are set in the mask. 
+    \param WVec :: scale factor for each voxel
+    \param EMask :: energy bins to scale [1] / keep [0]
+  */
+{
+  ELog::RegMethod RegA("WWG","scaleMesh");
+
+  const size_t ESize(EBin.size());
+  if (EMask.size()!=ESize)
+    throw ColErr::IndexError<size_t>(EMask.size(),ESize,"EMask!=EBin");
+  if (WVec.size()*ESize!=WMesh.size())
+    throw ColErr::IndexError<size_t>(WVec.size(),WMesh.size()/ESize,
+				     "WVec!=WMesh");
+
+  // energy mask as factors : one multiply per bin
+  std::vector<double> MFactor(ESize);
+  double* WPtr(WMesh.data());
+  for(const double W : WVec)
+    {
+      for(size_t i=0;i<ESize;i++)
+	MFactor[i]=(EMask[i]) ? W : 1.0;
+      for(size_t i=0;i<ESize;i++)
+	WPtr[i]*=MFactor[i];
+      WPtr+=ESize;
+    }
+  return;
+}
+
 void
 WWG::write(std::ostream& OX) const
   /*!
@@ -237,11 +301,10 @@ WWG::writeWWINP(const std::string& FName) const
   if (itemCnt!=0)
     OX<<std::endl;
 
-  // MESH:
+  // MESH: [direct from the array]
   itemCnt=0;
-  for(const std::vector<double>& CV : WMesh)
-    for(const double W : CV)
-      StrFunc::writeLine(OX,W,itemCnt,6);
+  for(const double W : WMesh)
+    writeLine(OX,W,itemCnt);
     
   OX.close();
 		       
@@ -87,14 +87,15 @@ WWGWeight::operator=(const WWGWeight& A)
 }
   
 void
-WWGWeight::updateWM(WWG& wwg,
-                    const double eCut,
-                    const double scaleFactor,
-                    const double minWeight,
-                    const double weightPower) const
+WWGWeight::scaleWM(WWG& wwg,
+                   const double eCut,
+                   const double scaleFactor,
+                   const double minWeight,
+                   const double weightPower) const
   /*!
-    Mulitiply the wwg:master mesh by factors in WWGWeight
-    It assumes that the mesh size and WWGWeight are compatable.
+    Mulitiply the wwg:master mesh by factors in WWGWeight.
+    The voxel factors are calculated as one array and
+    applied to the mesh in a single pass.
     \param wwg :: Weight window generator
     \param eCut :: Cut energy [MeV] (uses fractional if on boundary)
     \param scaleFactor :: Scale factor for weight track
@@ -102,13 +103,13 @@ WWGWeight::updateWM(WWG& wwg,
     \param weightPower :: power for final factor W**power
    */
 {
-  ELog::RegMethod RegA("WWGWeight","updateWM");
+  ELog::RegMethod RegA("WWGWeight","scaleWM");
 
-  // quick way to get length of array
-  // note that zero value is assumed but not infinity
-  std::vector<double> EBin=wwg.getEBin();    
-  std::vector<double> DVec=EBin;
-  std::fill(DVec.begin(),DVec.end(),1.0);
+  const std::vector<double>& EBin=wwg.getEBin();    
+  std::vector<int> EMask(EBin.size());
+  for(size_t i=0;i<EBin.size();i++)
+    EMask[i]=((eCut<-1e-10 && EBin[i] <= -eCut) ||
+	      EBin[i]>=eCut) ? 1 : 0;
 
     // Work on minW first:
   const double minW=calcMinWeight(scaleFactor,weightPower);
@@ -118,40 +119,57 @@ WWGWeight::updateWM(WWG& wwg,
   ELog::EM<<"Min W = "<<minW<<" "<<factor<<ELog::endDiag;
   
   const Geometry::Mesh3D& WGrid=wwg.getGrid();
+  const size_t NG=WGrid.getXSize()*WGrid.getYSize()*WGrid.getZSize();
 
-  const size_t NX=WGrid.getXSize();
-  const size_t NY=WGrid.getYSize();
-  const size_t NZ=WGrid.getZSize();
-  long int cN(1);
-
-  for(size_t i=0;i<NX;i++)
-    for(size_t j=0;j<NY;j++)
-      for(size_t k=0;k<NZ;k++)
+  // track sum for each voxel [mesh index : cN-1]
+  std::vector<double> WVec(NG);
+  for(size_t i=0;i<NG;i++)
+    {
+      if (i<nDense && DNumber[i]>0.0)
+	WVec[i]=DWeight[i];
+      else
 	{
-          CMapTYPE::const_iterator cv=Cells.find(cN);
-          if (cv==Cells.end())
-            throw ColErr::InContainerError<long int>(cN,"Cells");
+	  const long int cN(static_cast<long int>(i+1));
+	  CMapTYPE::const_iterator cv=Cells.find(cN);
+	  if (cv==Cells.end())
+	    throw ColErr::InContainerError<long int>(cN,"Cells");
+	  WVec[i]=cv->second.weight;
+	}
+    }
 
-          double W=(exp(-cv->second.weight*sigmaScale*scaleFactor*factor));
-          if (W<minWeight) W=1.0;    // avoid sqrt(-ve number etc)
-          W=std::pow(W,weightPower);
-          if (W>=minWeight)
-            {
-              for(size_t i=0;i<EBin.size();i++)
-                {
-                  if (eCut<-1e-10 && EBin[i] <= -eCut)
-                    DVec[i]=W;
-                  else if (EBin[i]>=eCut)
-                    DVec[i]=W;
-                }
-              wwg.scaleMeshItem(cN-1,DVec);              
-            }
-        }
+  // factor : voxels below minWeight are left unscaled [1.0]
+  for(double& W : WVec)
+    {
+      W=exp(-W*sigmaScale*scaleFactor*factor);
+      if (W<minWeight) W=1.0;    // avoid sqrt(-ve number etc)
+      W=std::pow(W,weightPower);
+      if (W<minWeight) W=1.0;
+    }
+  wwg.scaleMesh(WVec,EMask);
+  return;
+}
   
+void
+WWGWeight::updateWM(WWG& wwg,
+                    const double eCut,
+                    const double scaleFactor,
+                    const double minWeight,
+                    const double weightPower) const
+  /*!
+    Mulitiply the wwg:master mesh by factors in WWGWeight
+    It assumes that the mesh size and WWGWeight are compatable.
+    \param wwg :: Weight window generator
+    \param eCut :: Cut energy [MeV] (uses fractional if on boundary)
+    \param scaleFactor :: Scale factor for weight track
+    \param minWeight :: min weight scale factor
+    \param weightPower :: power for final factor W**power
+   */
+{
+  ELog::RegMethod RegA("WWGWeight","updateWM");
+  scaleWM(wwg,eCut,scaleFactor,minWeight,weightPower);
   return;
 }
 
-
 void
 WWGWeight::invertWM(WWG& wwg,
                     const double eCut,
@@ -160,7 +178,8 @@ WWGWeight::invertWM(WWG& wwg,
                     const double weightPower) const
   /*!
     Mulitiply the wwg:master mesh by factors in WWGWeight
-    Invertion [adjoint] system
+    Invertion [adjoint] system : currently the same 
+    factors as updateWM.
     It assumes that the mesh size and WWGWeight are compatable.
     \param wwg :: Weight window generator
     \param eCut :: Cut energy [MeV] (uses fractional if on boundary)
@@ -170,51 +189,7 @@ WWGWeight::invertWM(WWG& wwg,
    */
 {
   ELog::RegMethod RegA("WWGWeight","invertWM");
-
-  // quick way to get length of array
-  // note that zero value is assumed but not infinity
-  std::vector<double> EBin=wwg.getEBin();    
-  std::vector<double> DVec=EBin;
-  std::fill(DVec.begin(),DVec.end(),1.0);
-
-    // Work on minW first:
-  const double minW=calcMinWeight(scaleFactor,weightPower);
-  const double factor=(minW<minWeight) ?
-    log(minWeight)/log(minW) : 1.0;
-
-  ELog::EM<<"Min W = "<<minW<<" "<<factor<<ELog::endDiag;
-  
-  const Geometry::Mesh3D& WGrid=wwg.getGrid();
-
-  const size_t NX=WGrid.getXSize();
-  const size_t NY=WGrid.getYSize();
-  const size_t NZ=WGrid.getZSize();
-  long int cN(1);
-
-  for(size_t i=0;i<NX;i++)
-    for(size_t j=0;j<NY;j++)
-      for(size_t k=0;k<NZ;k++)
-	{
-          CMapTYPE::const_iterator cv=Cells.find(cN);
-          if (cv==Cells.end())
-            throw ColErr::InContainerError<long int>(cN,"Cells");
-
-          double W=(exp(-cv->second.weight*sigmaScale*scaleFactor*factor));
-          if (W<minWeight) W=1.0;    // avoid sqrt(-ve number etc)
-          W=std::pow(W,weightPower);
-          if (W>=minWeight)
-            {
-              for(size_t i=0;i<EBin.size();i++)
-                {
-                  if (eCut<-1e-10 && EBin[i] <= -eCut)
-                    DVec[i]=W;
-                  else if (EBin[i]>=eCut)
-                    DVec[i]=W;
-                }
-              wwg.scaleMeshItem(cN-1,DVec);              
-            }
-        }
-  
+  scaleWM(wwg,eCut,scaleFactor,minWeight,weightPower);
   return;
 }
 
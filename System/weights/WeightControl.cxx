@@ -77,6 +77,7 @@
 #include "ObjectTrackAct.h"
 #include "ObjectTrackPoint.h"
 #include "ObjectTrackPlane.h"
+#include "TrackBatch.h"
 #include "Mesh3D.h"
 #include "WWG.h"
 #include "WWGWeight.h"
@@ -87,7 +88,8 @@ namespace WeightSystem
   
 WeightControl::WeightControl() :
   scaleFactor(1.0),minWeight(0.0),weightPower(0.5),
-  activeAdjointFlag(0),activePtType("Void"),activePtIndex(0)
+  activeAdjointFlag(0),activePtType("Void"),activePtIndex(0),
+  nThread(0)
   /*
     Constructor
   */
@@ -100,7 +102,7 @@ WeightControl::WeightControl(const WeightControl& A) :
   weightPower(A.weightPower),EBand(A.EBand),WT(A.WT),
   objectList(A.objectList),activeAdjointFlag(A.activeAdjointFlag),
   activePtType(A.activePtType),activePtIndex(A.activePtIndex),
-  sourcePt(A.sourcePt)
+  nThread(A.nThread),sourcePt(A.sourcePt)
   /*!
     Copy constructor
     \param A :: WeightControl to copy
@@ -127,6 +129,7 @@ WeightControl::operator=(const WeightControl& A)
       activeAdjointFlag=A.activeAdjointFlag;
       activePtType=A.activePtType;
       activePtIndex=A.activePtIndex;
+      nThread=A.nThread;
       sourcePt=A.sourcePt;
     }
   return *this;      
@@ -473,15 +476,16 @@ WeightControl::cTrack(const Simulation& System,
   ELog::RegMethod RegA("WeightControl","cTrack");
   // SOURCE Point
 
-  ModelSupport::ObjectTrackPoint OTrack(initPt);
-  std::vector<double> WVec;
+  ModelSupport::TrackBatch TBatch(initPt);
+  TBatch.setThreads(nThread);
+  std::vector<double> Attn;
+  TBatch.calculate(System,Pts,Attn);
 
   long int cN(index.empty() ? 1 : index.back());
   for(size_t i=0;i<Pts.size();i++)
     {
       const long int unit(i>=index.size() ? cN++ : index[i]);
-      OTrack.addUnit(System,unit,Pts[i]);
-      CTrack.addTracks(unit,OTrack.getAttnSum(unit));
+      CTrack.addTracks(unit,Attn[i]);
     } 
   return;
 }
@@ -504,15 +508,16 @@ WeightControl::cTrack(const Simulation& System,
   ELog::RegMethod RegA("WeightControl","cTrack");
   // SOURCE Point
 
-  ModelSupport::ObjectTrackPlane OTrack(initPlane);
-  std::vector<double> WVec;
+  ModelSupport::TrackBatch TBatch(initPlane);
+  TBatch.setThreads(nThread);
+  std::vector<double> Attn;
+  TBatch.calculate(System,Pts,Attn);
 
   long int cN(index.empty() ? 1 : index.back());
   for(size_t i=0;i<Pts.size();i++)
     {
       const long int unit(i>=index.size() ? cN++ : index[i]);
-      OTrack.addUnit(System,unit,Pts[i]);
-      CTrack.addTracks(unit,OTrack.getAttnSum(unit));
+      CTrack.addTracks(unit,Attn[i]);
     } 
   return;
 }
@@ -533,7 +538,7 @@ WeightControl::calcWWGTrack(const Simulation& System,
   std::vector<Geometry::Vec3D> Pts;
   std::vector<long int> index;
   calcPoints(Pts,index);
-  
+  wSet.setDense(Pts.size());
   cTrack(System,initPt,Pts,index,wSet);
   return;
 }
@@ -554,6 +559,7 @@ WeightControl::calcWWGTrack(const Simulation& System,
   std::vector<Geometry::Vec3D> Pts;
   std::vector<long int> index;
   calcPoints(Pts,index);
+  wSet.setDense(Pts.size());
   cTrack(System,curPlane,Pts,index,wSet);
   
   return;
@@ -931,6 +937,7 @@ WeightControl::processWeights(Simulation& System,
 {
   ELog::RegMethod RegA("WeightControl","processWeights");
 
+  nThread=IParam.getValue<size_t>("threads");
   System.populateCells();
   System.createObjSurfMap();
 
@@ -942,7 +949,7 @@ WeightControl::processWeights(Simulation& System,
   // requirements for vertex:
   if (IParam.flag("weightObject") ||
       IParam.flag("tallyWeight") )
-    System.calcAllVertex();
+    System.calcAllVertex(IParam.getValue<size_t>("threads"));
   
   if (IParam.flag("weightSource"))
     procSourcePoint(IParam);
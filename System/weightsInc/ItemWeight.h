@@ -44,6 +44,9 @@ struct CellItem
   \author S. Ansell
   \date November 2015
   \brief Tracks cell weight in cells
+
+  Items 1 to nDense [mesh index] can be held in contiguous
+  arrays rather than the map.
 */
   
 class ItemWeight
@@ -56,6 +59,10 @@ class ItemWeight
   const double sigmaScale;             ///< Scale for sigma
   CMapTYPE Cells;                      ///< Cells and track info
 
+  size_t nDense;                       ///< Items [1-nDense] in arrays
+  std::vector<double> DWeight;         ///< Dense weight [index-1]
+  std::vector<double> DNumber;         ///< Dense track number [0 : none]
+
   double calcMinWeight
     (const double,const double)  const;
 
@@ -67,6 +74,7 @@ class ItemWeight
   virtual ~ItemWeight() {}          ///< Destructor
   
   void clear();
+  void setDense(const size_t);
   void addTracks(const long int,const double);
   void write(std::ostream&) const;
 };
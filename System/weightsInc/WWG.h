@@ -38,7 +38,6 @@ class WWG
  public:
 
   static void writeLine(std::ostream&,const double,size_t&);
-  static void writeLine(std::ostream&,const int,size_t&);
 
  private:
 
@@ -53,7 +52,8 @@ class WWG
   std::vector<double> EBin;      ///< Energy bins
   Geometry::Mesh3D Grid;         ///< Mesh Grid
 
-  std::vector<std::vector<double>> WMesh;     ///< linearized weight mesh
+  /// Weight mesh [voxel][energy] : voxel*EBin.size()+energy
+  std::vector<double> WMesh;
 
   void writeHead(std::ostream&) const;
   
@@ -75,7 +75,10 @@ class WWG
   void resetMesh(const std::vector<double>&);
 
 
+  /// Access to weight mesh [voxel][energy]
+  const std::vector<double>& getMesh() const { return WMesh; }
   void scaleMeshItem(const long int,const std::vector<double>&);
+  void scaleMesh(const std::vector<double>&,const std::vector<int>&);
   
   void write(std::ostream&) const;
   void writeWWINP(const std::string&) const;
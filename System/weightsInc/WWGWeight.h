@@ -36,6 +36,10 @@ namespace WeightSystem
   
 class WWGWeight : public ItemWeight
 {
+ private:
+
+  void scaleWM(WWG&,const double,const double,
+	       const double,const double) const;
 
  public:
 
@@ -68,6 +68,7 @@ class WeightControl
   bool activeAdjointFlag;                   ///< Active plane
   std::string activePtType;                 ///< ptType 
   size_t activePtIndex;                     ///< plant/source/track pt 
+  size_t nThread;                           ///< Track threads [0 : auto]
 
 
   std::vector<Geometry::Cone> conePt;         ///< Cone points
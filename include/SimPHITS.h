@@ -33,15 +33,15 @@ class SimPHITS : public Simulation
 {
  private:
 
-  // ALL THE sub-write stuff
-  void writeCells(std::ostream&) const;
-  void writeSurfaces(std::ostream&) const;
-  void writeMaterial(std::ostream&) const;
-  void writeWeights(std::ostream&) const;
-  void writeTransform(std::ostream&) const;
-  void writeTally(std::ostream&) const;
-  void writePhysics(std::ostream&) const;
-  void writeVariables(std::ostream&) const;
+  // ALL THE sub-write stuff [any Simulation]
+  static void writeCells(const Simulation&,std::ostream&,
+			 const std::string&);
+  static void writeSurfaces(std::ostream&,const std::string&);
+  static void writeMaterial(const Simulation&,std::ostream&);
+  static void writeWeights(std::ostream&);
+  static void writeTransform(const Simulation&,std::ostream&);
+  static void writeTally(const Simulation&,std::ostream&);
+  static void writePhysics(const Simulation&,std::ostream&);
   
  public:
   
@@ -50,7 +50,9 @@ class SimPHITS : public Simulation
   SimPHITS& operator=(const SimPHITS&);
   ~SimPHITS() {}           ///< Destructor
 
-  void write(const std::string&) const;
+  virtual void writeDeck(std::ostream&) const;
+  static void writePHITS(const Simulation&,std::ostream&,
+			 const std::string&,const std::string&);
 
 };
 
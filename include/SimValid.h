@@ -3,7 +3,7 @@
  
  * File:   include/SimValid.h
 *
- * Copyright (c) 2004-2013 by Stuart Ansell
+ * Copyright (c) 2004-2016 by Stuart Ansell
  *
  * This program is free software: you can redistribute it and/or modify
  * it under the terms of the GNU General Public License as published by
@@ -26,6 +26,8 @@
 namespace ModelSupport
 {
 
+class QueryContext;
+
 /*!
   \class simPoint
   \brief Simple storage for a point on a track
@@ -62,31 +64,101 @@ struct simPoint
 
 };
 
+/*!
+  \class simFail
+  \brief Storage for a failed validation track
+  \author S. Ansell
+  \version 1.0
+  \date May 2016
+ */
+
+struct simFail
+{
+  size_t centreIndex;              ///< Index of start point
+  size_t trackIndex;               ///< Track number from start point
+  Geometry::Vec3D Dir;             ///< Track direction
+  std::vector<simPoint> Pts;       ///< Points on track
+
+  simFail(const size_t CI,const size_t TI,const Geometry::Vec3D& D,
+	  const std::vector<simPoint>& P) :
+  centreIndex(CI),trackIndex(TI),Dir(D),Pts(P) {}
+
+  /// Ordering for a deterministic report
+  bool operator<(const simFail& A) const
+    {
+      return (centreIndex!=A.centreIndex) ?
+	(centreIndex<A.centreIndex) : (trackIndex<A.trackIndex);
+    }
+};
+
 /*!
   \class SimValid
   \brief Applies simple test to a simulation to check validity
   \author S. Ansell
-  \version 1.0
-  \date March 2013
+  \version 2.0
+  \date May 2016
+
+  Tracks are split into fixed blocks, each with its own
+  random stream, and the blocks are shared between the 
+  threads. The failures found are therefore independent
+  of the number of threads.
 */
 
 class SimValid
 {
  private:
 
-  Geometry::Vec3D Centre;  // Centre for tracks
+  static const size_t blockSize;       ///< Tracks in a random block
+
+  std::vector<Geometry::Vec3D> Centres;  ///< Start points for tracks
+  size_t nThread;                      ///< Number of threads [0 : auto]
+  unsigned long int seed;              ///< Base seed of random streams
+  size_t maxFail;                      ///< Max failures to keep
+
+  size_t nTotal;                       ///< Total failures [last run]
+  std::vector<simFail> Fails;          ///< Failed tracks [last run]
+
+  static int
+    trackLine(const ModelSupport::ObjSurfMap&,QueryContext&,
+	      MonteCarlo::Object*,const int,const Geometry::Vec3D&,
+	      const Geometry::Vec3D&,std::vector<simPoint>&);
+
+  void runBlocks(const ModelSupport::ObjSurfMap&,
+		 const std::vector<MonteCarlo::Object*>&,
+		 const std::vector<int>&,const size_t,
+		 const size_t,const size_t,size_t&,
+		 std::vector<simFail>&) const;
+  void diagnostics(const Simulation&,const simFail&) const;
   
  public:
   
   SimValid();
   SimValid(const SimValid&);
   SimValid& operator=(const SimValid&);
-  ~SimValid() {}        /// Destructor
+  ~SimValid() {}        ///< Destructor
 
   /// Set the centre
-  void setCentre(const Geometry::Vec3D C) { Centre=C;} 
+  void setCentre(const Geometry::Vec3D& C) { Centres=
+      std::vector<Geometry::Vec3D>(1,C); } 
+  /// Remove all centres
+  void clearCentres() { Centres.clear(); }
+  /// Add an extra centre
+  void addCentre(const Geometry::Vec3D& C) { Centres.push_back(C); }
+  void addFixedComps(const std::vector<std::string>&);
+  /// Set the number of threads [0 : hardware]
+  void setThreads(const size_t N) { nThread=N; }
+  /// Set the base seed
+  void setSeed(const unsigned long int S) { seed=S; }
+  /// Set the number of failures to keep
+  void setMaxFail(const size_t N) { maxFail=N; }
+
+  /// Access number of failures in last run
+  size_t getNFail() const { return nTotal; }
+  /// Access the failures kept from last run
+  const std::vector<simFail>& getFails() const { return Fails; }
+  
   // MAIN RUN:
-  int run(const Simulation&,const size_t) const;
+  int run(const Simulation&,const size_t);
 
 };
 
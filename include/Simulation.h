@@ -25,6 +25,7 @@
 namespace Geometry
 {
   class Transform;
+  class Surface;
 }
 
 namespace tallySystem
@@ -47,6 +48,8 @@ class RemoveCell;
 namespace ModelSupport
 {
   class ObjSurfMap;
+  class ObjBoxTree;
+  class QueryContext;
 }
 
 namespace WeightSystem
@@ -86,6 +89,14 @@ class Simulation
   typedef std::map<int,MonteCarlo::Qhull*> OTYPE;      ///< Object type
   typedef std::map<int,tallySystem::Tally*> TallyTYPE; ///< Tally type
 
+  /// Cell card writer [Object::write/writePHITS/writeFLUKA]
+  typedef void (MonteCarlo::Object::*cellWriter)(std::ostream&) const;
+  /// Surface card writer [Surface::write/writeFLUKA]
+  typedef void (Geometry::Surface::*surfWriter)(std::ostream&) const;
+
+  friend class SimPHITS;     ///< Section writers on a Simulation
+  friend class SimFLUKA;     ///< Section writers on a Simulation
+
  protected:
 
   int mcnpType;                         ///< MCNP(X) type
@@ -95,6 +106,9 @@ class Simulation
   int CNum;                             ///< Number of complementary components
   FuncDataBase DB;                      ///< DataBase of variables
   ModelSupport::ObjSurfMap* OSMPtr;     ///< Object surface map [if required]
+  ModelSupport::ObjBoxTree* OBTPtr;     ///< Cell box tree for findCell
+  size_t cellVersion;                   ///< Version of cell map [hints]
+  size_t writeThread;                   ///< Threads for write [1 : serial]
 
   TransTYPE TList;                      ///< Transforms List (key=Transform)
 
@@ -110,13 +124,17 @@ class Simulation
 
   void deleteObjects();
   void deleteTally();
+  void cellChange();
+  MonteCarlo::Object* searchCell(const Geometry::Vec3D&) const;
   
   int readTransform(std::istream&);    
   int readTally(std::istream&);        
 
   // ALL THE sub-write stuff
   void writeCells(std::ostream&) const;
+  void writeCells(std::ostream&,const std::string&) const;
   void writeSurfaces(std::ostream&) const;
+  void writeSurfaces(std::ostream&,const std::string&) const;
   void writeMaterial(std::ostream&) const;
   void writeWeights(std::ostream&) const;
   void writeTransform(std::ostream&) const;
@@ -156,7 +174,17 @@ class Simulation
   const MonteCarlo::Qhull* findQhull(const int) const; 
   MonteCarlo::Object* findCell(const Geometry::Vec3D&,
 			       MonteCarlo::Object*) const;
+  MonteCarlo::Object* findCell(const Geometry::Vec3D&,
+			       MonteCarlo::Object*,
+			       ModelSupport::QueryContext&) const;
   int findCellNumber(const Geometry::Vec3D&,const int) const;  
+  int findCellNumber(const Geometry::Vec3D&,const int,
+		     ModelSupport::QueryContext&) const;  
+  void setCellTree(const int);
+  void clearCellTree();
+  void buildCellTree();
+  /// Access cell map version [changes on any cell change]
+  size_t getCellVersion() const { return cellVersion; }
 
   int existCell(const int) const;              ///< check if cell exist
   int getCellMaterial(const int) const;        ///< return cell material
@@ -172,7 +200,7 @@ class Simulation
   physicsSystem::PhysicsCards& getPC() { return *PhysPtr; }
   /// Access weight control
   const OTYPE& getCells() const { return OList; } ///< Get cells
-  OTYPE& getCells() { return OList; } ///< Get cells
+  OTYPE& getCells();
   Geometry::Transform* createSourceTransform();
   
 
@@ -181,7 +209,7 @@ class Simulation
   int populateCells();  // SHOULD BE PROTECTED
 
   int calcVertex(const int); 
-  void calcAllVertex();
+  void calcAllVertex(const size_t =0);
   
   void masterRotation();
 
@@ -246,9 +274,17 @@ class Simulation
   void renumberCells(const std::vector<int>&,const std::vector<int>&);
   void renumberSurfaces(const std::vector<int>&,const std::vector<int>&);
   void prepareWrite();
+  /// Set the threads for formatting the output [0 : all cores]
+  void setWriteThreads(const size_t N) { writeThread=N; }
   void writeCinder() const;          
 
+  std::vector<std::string> formatCells(const std::vector<cellWriter>&) const;
+  std::vector<std::string>
+    formatSurfaces(const std::vector<surfWriter>&) const;
+
   virtual void write(const std::string&) const;  
+  virtual void writeDeck(std::ostream&) const;
+  void writeMCNP(std::ostream&,const std::string&,const std::string&) const;
     
   // Debug stuff
   
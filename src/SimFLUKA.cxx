@@ -138,10 +138,11 @@ SimFLUKA::operator=(const SimFLUKA& A)
 
 
 void
-SimFLUKA::writeTally(std::ostream& OX) const
+SimFLUKA::writeTally(const Simulation& Sim,std::ostream& OX)
   /*!
     Writes out the tallies using a nice boost binding
     construction.
+    \param Sim :: Simulation to write
     \param OX :: Output stream
    */
 {
@@ -152,17 +153,18 @@ SimFLUKA::writeTally(std::ostream& OX) const
   // It iterats over the Titems and since they are a map
   // uses the mathSupport:::PSecond
   // _1 refers back to the TItem pair<int,tally*>
-  for(const TallyTYPE::value_type& TI : TItem)
+  for(const TallyTYPE::value_type& TI : Sim.TItem)
     TI.second->write(OX);
 
   return;
 }
 
 void
-SimFLUKA::writeTransform(std::ostream& OX) const
+SimFLUKA::writeTransform(const Simulation& Sim,std::ostream& OX)
   /*!
     Write all the transforms in standard MCNPX output 
     type [These should now not be used].
+    \param Sim :: Simulation to write
     \param OX :: Output stream
   */
 
@@ -170,7 +172,7 @@ SimFLUKA::writeTransform(std::ostream& OX) const
   OX<<"[transform]"<<std::endl;
 
   TransTYPE::const_iterator vt;
-  for(vt=TList.begin();vt!=TList.end();vt++)
+  for(vt=Sim.TList.begin();vt!=Sim.TList.end();vt++)
     {
       vt->second.write(OX);
     }
@@ -179,44 +181,37 @@ SimFLUKA::writeTransform(std::ostream& OX) const
 
 
 void
-SimFLUKA::writeCells(std::ostream& OX) const
+SimFLUKA::writeCells(std::ostream& OX,const std::string& CellCards)
   /*!
     Write all the cells in standard FLUKA output 
     type.
     \param OX :: Output stream
+    \param CellCards :: Formated cells [formatCells : writeFLUKA]
   */
 {
   ELog::RegMethod RegA("SimFLUKA","writeCells");
   OX<<"* -------------------------------------------------------"<<std::endl;
   OX<<"* ------------------ CELL CARDS -------------------------"<<std::endl;
   OX<<"* -------------------------------------------------------"<<std::endl;
-  
-  
-  OTYPE::const_iterator mp;
-  for(mp=OList.begin();mp!=OList.end();mp++)
-    mp->second->writeFLUKA(OX);
+  OX<<CellCards;
   OX<<"END"<<std::endl;
   OX<<"* ++++++++++++++++++++++ END ++++++++++++++++++++++++++++"<<std::endl;
   return;
 }
 
 void
-SimFLUKA::writeSurfaces(std::ostream& OX) const
+SimFLUKA::writeSurfaces(std::ostream& OX,const std::string& SurfCards)
   /*!
     Write all the surfaces in standard MCNPX output 
     type.
     \param OX :: Output stream
+    \param SurfCards :: Formated surfaces [formatSurfaces : writeFLUKA]
   */
 {
   OX<<"* -------------------------------------------------------"<<std::endl;
   OX<<"* --------------- SURFACE CARDS -------------------------"<<std::endl;
   OX<<"* -------------------------------------------------------"<<std::endl;
-
-  const ModelSupport::surfIndex::STYPE& SurMap =
-    ModelSupport::surfIndex::Instance().surMap();
-
-  for(const ModelSupport::surfIndex::STYPE::value_type& sm : SurMap)
-    sm.second->writeFLUKA(OX);
+  OX<<SurfCards;
   OX<<"END"<<std::endl;
   OX<<"* ++++++++++++++++++++++ END ++++++++++++++++++++++++++++"<<std::endl;
   OX<<std::endl;
@@ -224,11 +219,14 @@ SimFLUKA::writeSurfaces(std::ostream& OX) const
 } 
 
 void
-SimFLUKA::writeMaterial(std::ostream& OX) const
+SimFLUKA::writeMaterial(const Simulation& Sim,std::ostream& OX,
+			const std::string& MatCards)
   /*!
     Write all the used Materials in standard MCNPX output 
     type.
+    \param Sim :: Simulation to write
     \param OX :: Output stream
+    \param MatCards :: Cell assignments [formatCells : writeFLUKAmat]
   */
 {
   ELog::RegMethod RegA("SimFLUKA","writeMaterial");
@@ -237,14 +235,13 @@ SimFLUKA::writeMaterial(std::ostream& OX) const
   OX<<"* --------------- MATERIAL CARDS ------------------------"<<std::endl;
   OX<<"* -------------------------------------------------------"<<std::endl;
   // WRITE OUT ASSIGNMENT:
-  for(const OTYPE::value_type& mp : OList)
-    mp.second->writeFLUKAmat(OX);
+  OX<<MatCards;
     
   ModelSupport::DBMaterial& DB=ModelSupport::DBMaterial::Instance();  
   DB.resetActive();
 
   OTYPE::const_iterator mp;
-  for(mp=OList.begin();mp!=OList.end();mp++)
+  for(mp=Sim.OList.begin();mp!=Sim.OList.end();mp++)
     DB.setActive(mp->second->getMat());
 
   DB.writeFLUKA(OX);
@@ -256,7 +253,7 @@ SimFLUKA::writeMaterial(std::ostream& OX) const
 
 
 void
-SimFLUKA::writeWeights(std::ostream& OX) const
+SimFLUKA::writeWeights(std::ostream& OX)
   /*!
     Write all the used Weight in standard MCNPX output 
     type.
@@ -274,11 +271,12 @@ SimFLUKA::writeWeights(std::ostream& OX) const
 
 
 void
-SimFLUKA::writePhysics(std::ostream& OX) const
+SimFLUKA::writePhysics(const Simulation& Sim,std::ostream& OX)
   /*!
     Write all the used Weight in standard MCNPX output 
     type. Note that it also has to add the rdum cards
     to the physics
+    \param Sim :: Simulation to write
     \param OX :: Output stream
   */
 
@@ -288,7 +286,7 @@ SimFLUKA::writePhysics(std::ostream& OX) const
   std::map<int,tallySystem::Tally*>::const_iterator mc;
   std::vector<int> Idum;
   std::vector<Geometry::Vec3D> Rdum;
-  for(mc=TItem.begin();mc!=TItem.end();mc++)
+  for(mc=Sim.TItem.begin();mc!=Sim.TItem.end();mc++)
     {
       const tallySystem::pointTally* Ptr=
 	dynamic_cast<const tallySystem::pointTally*>(mc->second);
@@ -310,35 +308,59 @@ SimFLUKA::writePhysics(std::ostream& OX) const
     }
 
   // Remaining Physics cards
-  PhysPtr->write(OX,cellOutOrder,voidCells);
+  Sim.PhysPtr->write(OX,Sim.cellOutOrder,Sim.voidCells);
   OX<<"c ++++++++++++++++++++++ END ++++++++++++++++++++++++++++"<<std::endl;
   OX<<std::endl;  // MCNPX requires a blank line to terminate
   return;
 }
 
 void
-SimFLUKA::write(const std::string& Fname) const
+SimFLUKA::writeDeck(std::ostream& OX) const
   /*!
-    Write out all the system (in PHITS output format)
-    \param Fname :: Output file 
+    Write out all the system (in FLUKA output format)
+    \param OX :: Output stream
+  */
+{
+  ELog::RegMethod RegA("SimFLUKA","writeDeck");
+
+  const std::vector<std::string> CellCards=
+    formatCells({&MonteCarlo::Object::writeFLUKA,
+	  &MonteCarlo::Object::writeFLUKAmat});
+  writeFLUKA(*this,OX,CellCards[0],
+	     formatSurfaces({&Geometry::Surface::writeFLUKA}).front(),
+	     CellCards[1]);
+  return;
+}
+
+void
+SimFLUKA::writeFLUKA(const Simulation& Sim,std::ostream& OX,
+		     const std::string& CellCards,
+		     const std::string& SurfCards,
+		     const std::string& MatCards)
+  /*!
+    Write out a simulation in FLUKA output format
+    with the cells/surfaces already formated. 
+    \param Sim :: Simulation to write
+    \param OX :: Output stream
+    \param CellCards :: Cells [formatCells : writeFLUKA]
+    \param SurfCards :: Surfaces [formatSurfaces : writeFLUKA]
+    \param MatCards :: Cell materials [formatCells : writeFLUKAmat]
   */
 {
-  ELog::RegMethod RegA("SimFLUKA","write");
+  ELog::RegMethod RegA("SimFLUKA","writeFLUKA");
   boost::format FmtStr("%1%%|71t|%2%\n");  
 
-  std::ofstream OX(Fname.c_str()); 
   OX<<"TITLE "<<std::endl;
   OX<<" Fluka model from CombLayer"<<std::endl;
-  Simulation::writeVariables(OX,'*');
+  Sim.writeVariables(OX,'*');
   OX<<FmtStr % "GEOBEGIN" % "COMBNAM";
-  writeSurfaces(OX);
-  writeCells(OX);
+  writeSurfaces(OX,SurfCards);
+  writeCells(OX,CellCards);
   OX<<"GEOEND"<<std::endl;
-  writeMaterial(OX);
-  writeTransform(OX);
+  writeMaterial(Sim,OX,MatCards);
+  writeTransform(Sim,OX);
   writeWeights(OX);
-  writeTally(OX);
-  writePhysics(OX);
-  OX.close();
+  writeTally(Sim,OX);
+  writePhysics(Sim,OX);
   return;
 }
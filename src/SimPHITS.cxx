@@ -138,10 +138,11 @@ SimPHITS::operator=(const SimPHITS& A)
 
 
 void
-SimPHITS::writeTally(std::ostream& OX) const
+SimPHITS::writeTally(const Simulation& Sim,std::ostream& OX)
   /*!
     Writes out the tallies using a nice boost binding
     construction.
+    \param Sim :: Simulation to write
     \param OX :: Output stream
    */
 {
@@ -152,17 +153,18 @@ SimPHITS::writeTally(std::ostream& OX) const
   // It iterats over the Titems and since they are a map
   // uses the mathSupport:::PSecond
   // _1 refers back to the TItem pair<int,tally*>
-  for(const TallyTYPE::value_type& TI : TItem)
+  for(const TallyTYPE::value_type& TI : Sim.TItem)
     TI.second->write(OX);
 
   return;
 }
 
 void
-SimPHITS::writeTransform(std::ostream& OX) const
+SimPHITS::writeTransform(const Simulation& Sim,std::ostream& OX)
   /*!
     Write all the transforms in standard MCNPX output 
     type [These should now not be used].
+    \param Sim :: Simulation to write
     \param OX :: Output stream
   */
 
@@ -170,7 +172,7 @@ SimPHITS::writeTransform(std::ostream& OX) const
   OX<<"[transform]"<<std::endl;
 
   TransTYPE::const_iterator vt;
-  for(vt=TList.begin();vt!=TList.end();vt++)
+  for(vt=Sim.TList.begin();vt!=Sim.TList.end();vt++)
     {
       vt->second.write(OX);
     }
@@ -179,23 +181,25 @@ SimPHITS::writeTransform(std::ostream& OX) const
 
 
 void
-SimPHITS::writeCells(std::ostream& OX) const
+SimPHITS::writeCells(const Simulation& Sim,std::ostream& OX,
+		     const std::string& CellCards)
   /*!
     Write all the cells in standard MCNPX output 
     type.
+    \param Sim :: Simulation to write
     \param OX :: Output stream
+    \param CellCards :: Formated cells [formatCells : writePHITS]
   */
 {
   boost::format FmtStr("  %1$d%|20t|%2$d\n");
   OX<<"[cell]"<<std::endl;
-  OTYPE::const_iterator mp;
-  for(mp=OList.begin();mp!=OList.end();mp++)
-    mp->second->writePHITS(OX);
+  OX<<CellCards;
 
   OX<<std::endl;  // Empty line manditory for MCNPX
 
   OX<<"[temperature]"<<std::endl;
-  for(mp=OList.begin();mp!=OList.end();mp++)
+  OTYPE::const_iterator mp;
+  for(mp=Sim.OList.begin();mp!=Sim.OList.end();mp++)
     {
       const double T=mp->second->getTemp();
       if (fabs(T-300.0)>1.0)
@@ -208,42 +212,44 @@ SimPHITS::writeCells(std::ostream& OX) const
 }
 
 void
-SimPHITS::writeSurfaces(std::ostream& OX) const
+SimPHITS::writeSurfaces(std::ostream& OX,const std::string& SurfCards)
   /*!
     Write all the surfaces in standard MCNPX output 
     type.
     \param OX :: Output stream
+    \param SurfCards :: Formated surfaces [formatSurfaces : write]
   */
 
 {
   OX<<"  [surface] " <<std::endl;
-
-  const ModelSupport::surfIndex::STYPE& SurMap=
-    ModelSupport::surfIndex::Instance().surMap();
-  std::map<int,Geometry::Surface*>::const_iterator mp;
-  for(mp=SurMap.begin();mp!=SurMap.end();mp++)
-    {
-      (mp->second)->write(OX);
-    }
+  OX<<SurfCards;
   return;
 } 
 
 void
-SimPHITS::writeMaterial(std::ostream& OX) const
+SimPHITS::writeMaterial(const Simulation& Sim,std::ostream& OX)
   /*!
     Write all the used Materials in standard MCNPX output 
     type.
+    \param Sim :: Simulation to write
     \param OX :: Output stream
   */
 {
   OX<<"    [material]"<<std::endl;
-  ModelSupport::DBMaterial::Instance().writeMCNPX(OX);
+  ModelSupport::DBMaterial& DB=ModelSupport::DBMaterial::Instance();  
+  DB.resetActive();
+
+  OTYPE::const_iterator mp;
+  for(mp=Sim.OList.begin();mp!=Sim.OList.end();mp++)
+    DB.setActive(mp->second->getMat());
+
+  DB.writeMCNPX(OX);
   return;
 }
 
 
 void
-SimPHITS::writeWeights(std::ostream& OX) const
+SimPHITS::writeWeights(std::ostream& OX)
   /*!
     Write all the used Weight in standard MCNPX output 
     type.
@@ -261,11 +267,12 @@ SimPHITS::writeWeights(std::ostream& OX) const
 
 
 void
-SimPHITS::writePhysics(std::ostream& OX) const
+SimPHITS::writePhysics(const Simulation& Sim,std::ostream& OX)
   /*!
     Write all the used Weight in standard MCNPX output 
     type. Note that it also has to add the rdum cards
     to the physics
+    \param Sim :: Simulation to write
     \param OX :: Output stream
   */
 
@@ -275,7 +282,7 @@ SimPHITS::writePhysics(std::ostream& OX) const
   std::map<int,tallySystem::Tally*>::const_iterator mc;
   std::vector<int> Idum;
   std::vector<Geometry::Vec3D> Rdum;
-  for(mc=TItem.begin();mc!=TItem.end();mc++)
+  for(mc=Sim.TItem.begin();mc!=Sim.TItem.end();mc++)
     {
       const tallySystem::pointTally* Ptr=
 	dynamic_cast<const tallySystem::pointTally*>(mc->second);
@@ -298,28 +305,45 @@ SimPHITS::writePhysics(std::ostream& OX) const
     }
 
   // Remaining Physics cards
-  PhysPtr->write(OX,cellOutOrder,voidCells);
+  Sim.PhysPtr->write(OX,Sim.cellOutOrder,Sim.voidCells);
   OX<<"c ++++++++++++++++++++++ END ++++++++++++++++++++++++++++"<<std::endl;
   OX<<std::endl;  // MCNPX requires a blank line to terminate
   return;
 }
 
 void
-SimPHITS::write(const std::string& Fname) const
+SimPHITS::writeDeck(std::ostream& OX) const
   /*!
     Write out all the system (in PHITS output format)
-    \param Fname :: Output file 
+    \param OX :: Output stream
+  */
+{
+  writePHITS(*this,OX,
+	     formatCells({&MonteCarlo::Object::writePHITS}).front(),
+	     formatSurfaces({&Geometry::Surface::write}).front());
+  return;
+}
+
+void
+SimPHITS::writePHITS(const Simulation& Sim,std::ostream& OX,
+		     const std::string& CellCards,
+		     const std::string& SurfCards)
+  /*!
+    Write out a simulation in PHITS output format
+    with the cells/surfaces already formated. 
+    \param Sim :: Simulation to write
+    \param OX :: Output stream
+    \param CellCards :: Cells [formatCells : writePHITS]
+    \param SurfCards :: Surfaces [formatSurfaces : write]
   */
 {
-  std::ofstream OX(Fname.c_str());
-  Simulation::writeVariables(OX);
-  writeCells(OX);
-  writeSurfaces(OX);
-  writeMaterial(OX);
-  writeTransform(OX);
+  Sim.writeVariables(OX);
+  writeCells(Sim,OX,CellCards);
+  writeSurfaces(OX,SurfCards);
+  writeMaterial(Sim,OX);
+  writeTransform(Sim,OX);
   writeWeights(OX);
-  writeTally(OX);
-  writePhysics(OX);
-  OX.close();
+  writeTally(Sim,OX);
+  writePhysics(Sim,OX);
   return;
 }
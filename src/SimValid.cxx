@@ -3,7 +3,7 @@
  
  * File:   src/SimValid.cxx
  *
- * Copyright (c) 2004-2014 by Stuart Ansell
+ * Copyright (c) 2004-2016 by Stuart Ansell
  *
  * This program is free software: you can redistribute it and/or modify
  * it under the terms of the GNU General Public License as published by
@@ -31,6 +31,9 @@
 #include <set>
 #include <vector>
 #include <memory>
+#include <algorithm>
+#include <thread>
+#include <exception>
 
 #include "Exception.h"
 #include "FileReport.h"
@@ -57,23 +60,33 @@
 #include "SurInter.h"
 #include "ObjSurfMap.h"
 #include "neutron.h"
+#include "Line.h"
+#include "LineIntersectVisit.h"
+#include "SenseTrack.h"
 #include "Simulation.h"
+#include "surfRegister.h"
+#include "objectRegister.h"
+#include "LinkUnit.h"
+#include "FixedComp.h"
+#include "QueryContext.h"
 #include "SimValid.h"
 
-extern MTRand RNG;
-
 namespace ModelSupport
 {
 
+const size_t SimValid::blockSize(4096);
+
 SimValid::SimValid() :
-  Centre(Geometry::Vec3D(0.15,-0.45,0.15))
+  Centres(1,Geometry::Vec3D(0.15,-0.45,0.15)),
+  nThread(0),seed(12345UL),maxFail(20),nTotal(0)
   /*!
     Constructor
   */
 {}
 
 SimValid::SimValid(const SimValid& A) : 
-  Centre(A.Centre)
+  Centres(A.Centres),nThread(A.nThread),seed(A.seed),
+  maxFail(A.maxFail),nTotal(A.nTotal),Fails(A.Fails)
   /*!
     Copy constructor
     \param A :: SimValid to copy
@@ -90,119 +103,294 @@ SimValid::operator=(const SimValid& A)
 {
   if (this!=&A)
     {
-      Centre=A.Centre;
+      Centres=A.Centres;
+      nThread=A.nThread;
+      seed=A.seed;
+      maxFail=A.maxFail;
+      nTotal=A.nTotal;
+      Fails=A.Fails;
     }
   return *this;
 }
 
+void
+SimValid::addFixedComps(const std::vector<std::string>& Names)
+  /*!
+    Add the origins of FixedComps as start points
+    \param Names :: FixedComp names [All : all registered]
+  */
+{
+  ELog::RegMethod RegA("SimValid","addFixedComps");
+
+  const ModelSupport::objectRegister& OR=
+    ModelSupport::objectRegister::Instance();
+
+  const std::vector<std::string> FCNames=
+    (Names.size()==1 && (Names[0]=="All" || Names[0]=="all")) ?
+    OR.getObjectNames() : Names;
+
+  for(const std::string& FCName : FCNames)
+    {
+      const attachSystem::FixedComp* FCPtr=
+	OR.getObjectThrow<attachSystem::FixedComp>(FCName,"FixedComp");
+      Centres.push_back(FCPtr->getCentre());
+    }
+  return;
+}
+
 int
-SimValid::run(const Simulation& System,const size_t N) const
+SimValid::trackLine(const ModelSupport::ObjSurfMap& OSM,
+		    QueryContext& QC,
+		    MonteCarlo::Object* InitObj,const int initSurfNum,
+		    const Geometry::Vec3D& C,const Geometry::Vec3D& D,
+		    std::vector<simPoint>& Pts)
   /*!
-    Calculate the tracking
-    \param System :: Simulation to use
-    \param N :: Number of points to test
-    \return true if valid
+    Track a line from the centre until it leaves the 
+    active cells. Only const access to the simulation is used.
+    \param OSM :: Object surface map
+    \param QC :: Query context of thread
+    \param InitObj :: Initial object
+    \param initSurfNum :: Surface that the centre is on [signed]
+    \param C :: Centre 
+    \param D :: Direction
+    \param Pts :: Points on the track [cleared]
+    \return 1 if the track is valid
   */
 {
-  ELog::RegMethod RegA("SimValid","run");
-  
-  const ModelSupport::ObjSurfMap* OSMPtr =System.getOSM();
-  MonteCarlo::Object* InitObj(0);
   const Geometry::Surface* SPtr;          // Output surface
   double aDist;       
 
-  // Note for sphere that you can use X,Y,Z in any orthogonal 
-  // directiron
-  double phi,theta;
+  Pts.clear();
+  MonteCarlo::neutron TNeut(1,C,D);
+  MonteCarlo::LineIntersectVisit LI(TNeut);   // work space for track
+  MonteCarlo::SenseTrack ST;                  // surface senses of track
 
-  // Find Initial cell [Store for next time]
-  //  Centre+=Geometry::Vec3D(0.001,0.001,0.001);
-  InitObj=System.findCell(Centre,InitObj);  
-  const int initSurfNum=InitObj->isOnSide(Centre);
+  MonteCarlo::Object* OPtr=InitObj;
+  int SN(-initSurfNum);
 
-  ELog::EM<<"Init Object nubmer == "<<InitObj->getName()<<ELog::endDiag;      
-  ELog::EM<<"Initial surface [if on surf] == "<<initSurfNum<<ELog::endDiag; 
-     
-  // check surfaces
-  for(size_t i=0;i<N;i++)
+  Pts.push_back(simPoint(TNeut.Pos,OPtr->getName(),SN,OPtr));
+  while(OPtr && OPtr->getImp())
     {
-      std::vector<simPoint> Pts;
-      // Get random starting point on edge of volume
-      phi=RNG.rand()*M_PI;
-      theta=2.0*RNG.rand()*M_PI;
-      Geometry::Vec3D D(cos(theta)*sin(phi),
-			sin(theta)*sin(phi),
-			cos(phi));
-      MonteCarlo::neutron TNeut(1,Centre,D);
-
-      MonteCarlo::Object* OPtr=InitObj;
-      int SN(-initSurfNum);
+      // Note: Need OPPOSITE Sign on exiting surface
+      SN= OPtr->trackOutCell(TNeut,aDist,SPtr,abs(SN),LI,ST);
+      // Step off a start point that only touches the cell
+      if (aDist>1e30 && Pts.size()<=1)
+	aDist=1e-5;
 
+      TNeut.moveForward(aDist);
       Pts.push_back(simPoint(TNeut.Pos,OPtr->getName(),SN,OPtr));
-      while(OPtr && OPtr->getImp())
-	{
-	  // Note: Need OPPOSITE Sign on exiting surface
-	  SN= OPtr->trackOutCell(TNeut,aDist,SPtr,abs(SN));
+      OPtr=(SN) ? 
+	OSM.findNextObject(SN,TNeut.Pos,OPtr->getName(),QC) : 0;
+    }
+  return (OPtr) ? 1 : 0;
+}
 
-	  if (aDist>1e30 && Pts.size()<=1)
-	    {
-	      ELog::EM<<"Fail on Pts==1 and aDist inf"<<ELog::endDiag;
-	      ELog::EM<<"Index == "<<Pts.size()-2<<ELog::endDiag;
-	      ELog::EM<<"Pts[0] == "<<Pts[0].Pt<<ELog::endDiag;
-	      ELog::EM<<"SN == "<<SN<<ELog::endDiag;
-	      aDist=1e-5;
-	    }
+void
+SimValid::runBlocks(const ModelSupport::ObjSurfMap& OSM,
+		    const std::vector<MonteCarlo::Object*>& InitObj,
+		    const std::vector<int>& InitSurf,
+		    const size_t N,const size_t threadIndex,
+		    const size_t threadCnt,size_t& failCnt,
+		    std::vector<simFail>& FailVec) const
+  /*!
+    Run the blocks of tracks given to one thread. Block B
+    is run by thread B % threadCnt. Each block has its own
+    random stream seeded from the block number.
+    \param OSM :: Object surface map
+    \param InitObj :: Initial object for each centre [0 : skip]
+    \param InitSurf :: Initial surface for each centre 
+    \param N :: Number of tracks per centre
+    \param threadIndex :: Index of this thread
+    \param threadCnt :: Number of threads
+    \param failCnt :: Number of failures [added to]
+    \param FailVec :: Failed tracks [maxFail per block kept]
+   */
+{
+  const size_t nBlockPerCentre=(N+blockSize-1)/blockSize;
+  const size_t nBlock=nBlockPerCentre*Centres.size();
 
-	  TNeut.moveForward(aDist);
-	  Pts.push_back(simPoint(TNeut.Pos,OPtr->getName(),SN,OPtr));
-	  OPtr=(SN) ?
-	    OSMPtr->findNextObject(SN,TNeut.Pos,OPtr->getName()) : 0;	    
-	}
+  QueryContext QC;          // quiet : failures are stored
+  std::vector<simPoint> Pts;
+  for(size_t BIndex=threadIndex;BIndex<nBlock;BIndex+=threadCnt)
+    {
+      const size_t CIndex=BIndex/nBlockPerCentre;
+      if (!InitObj[CIndex]) continue;
+      
+      const Geometry::Vec3D& C(Centres[CIndex]);
+      const size_t trackStart=(BIndex % nBlockPerCentre)*blockSize;
+      const size_t trackEnd=std::min(N,trackStart+blockSize);
+      MTRand BRNG(static_cast<MTRand::uint32>(seed+BIndex));
 
-      if (!OPtr)
+      size_t nKeep(0);
+      for(size_t i=trackStart;i<trackEnd;i++)
 	{
-	  ELog::EM<<"------------"<<ELog::endCrit;
-	  ELog::EM<<"I/SN == "<<i<<" "<<SN<<ELog::endCrit;
-	  for(size_t j=0;j<Pts.size();j++)
+	  // Note for sphere that you can use X,Y,Z in any orthogonal 
+	  // directiron
+	  const double phi=BRNG.rand()*M_PI;
+	  const double theta=2.0*BRNG.rand()*M_PI;
+	  const Geometry::Vec3D D(cos(theta)*sin(phi),
+				  sin(theta)*sin(phi),
+				  cos(phi));
+	  if (!trackLine(OSM,QC,InitObj[CIndex],InitSurf[CIndex],C,D,Pts))
 	    {
-	      ELog::EM<<"Pos["<<j<<"]=="<<Pts[j].Pt<<" :: "
-		      <<Pts[j].objN<<" "<<Pts[j].surfN<<ELog::endDiag;
+	      failCnt++;
+	      if (nKeep<maxFail)
+		{
+		  FailVec.push_back(simFail(CIndex,i,D,Pts));
+		  nKeep++;
+		}
 	    }
+	}
+    }
+  return;
+}
 
-	  const size_t index(Pts.size()-2);
-	  ELog::EM<<"Base Obj == "<<*Pts[index].OPtr
-		  <<ELog::endDiag;
-	  ELog::EM<<"Next Obj == "<<*Pts[index+1].OPtr
-		  <<ELog::endDiag;
-	  OPtr=Pts[index].OPtr;
-	  // RESET:
-	  TNeut.Pos=Pts[index].Pt;  // Reset point
-	  OPtr=Pts[index].OPtr;
-
-	  OPtr=OSMPtr->findNextObject(Pts[index].surfN,
-				      TNeut.Pos,OPtr->getName());	    
-	  if (OPtr)
-	    {
-	      ELog::EM<<"Found Obj == "<<*OPtr<<" :: "<<Pts[index].Pt<<" "
-		      <<OPtr->pointStr(Pts[index].Pt)<<ELog::endDiag;
-	      ELog::EM<<OPtr->isValid(Pts[index].Pt)<<ELog::endDiag;
-	    }
-	  else
-	    ELog::EM<<"No object "<<ELog::endDiag;
-	  TNeut.Pos+=D*0.00001;
+void
+SimValid::diagnostics(const Simulation& System,
+		      const simFail& FUnit) const
+  /*!
+    Write out the full diagnostics of a failed track
+    \param System :: Simulation to use
+    \param FUnit :: Failed track
+  */
+{
+  ELog::RegMethod RegA("SimValid","diagnostics");
+  
+  const ModelSupport::ObjSurfMap* OSMPtr =System.getOSM();
+  const std::vector<simPoint>& Pts(FUnit.Pts);
 
-	  MonteCarlo::Object* NOPtr=System.findCell(TNeut.Pos,0);
-	  if (NOPtr)
-	    {
-	      ELog::EM<<"Neutron == "<<TNeut<<ELog::endDiag;
-	      ELog::EM<<"Actual object == "<<*NOPtr<<ELog::endDiag;
-	      ELog::EM<<" IMP == "<<NOPtr->getImp()<<ELog::endDiag;
-	    }
-	  ELog::EM<<"Failed to calculate cell correctly: "<<i<<ELog::endCrit;
-	  return 0;
+  const size_t index(Pts.size()-2);
+  ELog::EM<<"Base Obj == "<<*Pts[index].OPtr
+	  <<ELog::endDiag;
+  ELog::EM<<"Next Obj == "<<*Pts[index+1].OPtr
+	  <<ELog::endDiag;
+
+  MonteCarlo::Object* OPtr=
+    OSMPtr->findNextObject(Pts[index].surfN,
+			   Pts[index].Pt,Pts[index].OPtr->getName());
+  if (OPtr)
+    {
+      ELog::EM<<"Found Obj == "<<*OPtr<<" :: "<<Pts[index].Pt<<" "
+	      <<OPtr->pointStr(Pts[index].Pt)<<ELog::endDiag;
+      ELog::EM<<OPtr->isValid(Pts[index].Pt)<<ELog::endDiag;
+    }
+  else
+    ELog::EM<<"No object "<<ELog::endDiag;
+  
+  const Geometry::Vec3D testPt(Pts[index].Pt+FUnit.Dir*0.00001);
+  MonteCarlo::Object* NOPtr=System.findCell(testPt,0);
+  if (NOPtr)
+    {
+      ELog::EM<<"Test Point == "<<testPt<<ELog::endDiag;
+      ELog::EM<<"Actual object == "<<*NOPtr<<ELog::endDiag;
+      ELog::EM<<" IMP == "<<NOPtr->getImp()<<ELog::endDiag;
+    }
+  return;
+}
+
+int
+SimValid::run(const Simulation& System,const size_t N) 
+  /*!
+    Calculate the tracking from each centre. The tracks
+    are run in parallel using only const access to the 
+    Simulation and ObjSurfMap.
+    \param System :: Simulation to use
+    \param N :: Number of points to test [per centre]
+    \return true if valid
+  */
+{
+  ELog::RegMethod RegA("SimValid","run");
+  
+  const ModelSupport::ObjSurfMap* OSMPtr =System.getOSM();
+
+  nTotal=0;
+  Fails.clear();
+  
+  // Find Initial cells [serial]:
+  std::vector<MonteCarlo::Object*> InitObj;
+  std::vector<int> InitSurf;
+  for(const Geometry::Vec3D& C : Centres)
+    {
+      MonteCarlo::Object* OPtr=System.findCell(C,0);
+      if (!OPtr || !OPtr->getImp())
+	{
+	  ELog::EM<<"Start point "<<C<<" not in active cell"<<ELog::endWarn;
+	  InitObj.push_back(0);
+	  InitSurf.push_back(0);
+	}
+      else
+	{
+	  InitObj.push_back(OPtr);
+	  InitSurf.push_back(OPtr->isOnSide(C));
+	  ELog::EM<<"Start point "<<C<<" : Object == "<<OPtr->getName()
+		  <<" : Surface == "<<InitSurf.back()<<ELog::endDiag;
 	}
     }
-  ELog::EM<<"Finished Validation check"<<ELog::endDiag;
+
+  const size_t nBlock=Centres.size()*((N+blockSize-1)/blockSize);
+  size_t NT(nThread);
+  if (!NT)
+    NT=static_cast<size_t>(std::thread::hardware_concurrency());
+  NT=std::max<size_t>(1,std::min(NT,nBlock));
+
+  std::vector<size_t> TCount(NT,0);
+  std::vector<std::vector<simFail>> TFail(NT);
+  std::vector<std::exception_ptr> TError(NT);
+  
+  std::vector<std::thread> TUnit;
+  for(size_t i=0;i<NT;i++)
+    {
+      TUnit.push_back
+	(std::thread([&,i]()
+		     {
+		       try
+			 {
+			   runBlocks(*OSMPtr,InitObj,InitSurf,N,i,NT,
+				     TCount[i],TFail[i]);
+			 }
+		       catch (...)
+			 {
+			   TError[i]=std::current_exception();
+			 }
+		     }));
+    }
+  for(std::thread& TU : TUnit)
+    TU.join();
+  for(const std::exception_ptr& EP : TError)
+    if (EP) std::rethrow_exception(EP);
+
+  // Deterministic report : order on centre/track
+  for(size_t i=0;i<NT;i++)
+    {
+      nTotal+=TCount[i];
+      Fails.insert(Fails.end(),TFail[i].begin(),TFail[i].end());
+    }
+  std::sort(Fails.begin(),Fails.end());
+  if (Fails.size()>maxFail)
+    Fails.erase(Fails.begin()+static_cast<long int>(maxFail),Fails.end());
+
+  for(const simFail& FUnit : Fails)
+    {
+      ELog::EM<<"------------"<<ELog::endCrit;
+      ELog::EM<<"Centre/Track == "<<Centres[FUnit.centreIndex]<<" : "
+	      <<FUnit.trackIndex<<" "<<FUnit.Dir<<ELog::endCrit;
+      for(size_t j=0;j<FUnit.Pts.size();j++)
+	{
+	  ELog::EM<<"Pos["<<j<<"]=="<<FUnit.Pts[j].Pt<<" :: "
+		  <<FUnit.Pts[j].objN<<" "<<FUnit.Pts[j].surfN<<ELog::endDiag;
+	}
+    }
+  if (!Fails.empty())
+    diagnostics(System,Fails.front());
+
+  ELog::EM<<"Finished Validation check : "<<Centres.size()<<" centres : "
+	  <<N<<" tracks : "<<NT<<" threads"<<ELog::endDiag;
+  if (nTotal)
+    {
+      ELog::EM<<"Failed to calculate cell correctly: "
+	      <<nTotal<<" tracks"<<ELog::endCrit;
+      return 0;
+    }
   return 1;
 }
 
@@ -22,6 +22,7 @@
 #include <fstream>
 #include <iomanip>
 #include <iostream>
+#include <sstream>
 #include <cmath>
 #include <complex> 
 #include <vector>
@@ -35,6 +36,9 @@
 #include <iterator>
 #include <memory>
 #include <array>
+#include <thread>
+#include <atomic>
+#include <exception>
 
 #include "Exception.h"
 #include "FileReport.h"
@@ -46,6 +50,7 @@
 #include "BaseModVisit.h"
 #include "mathSupport.h"
 #include "support.h"
+#include "blockWrite.h"
 #include "version.h"
 #include "Element.h"
 #include "MapSupport.h"
@@ -71,6 +76,7 @@
 #include "surfIndex.h"
 #include "surfEqual.h"
 #include "Quadratic.h"
+#include "NullSurface.h"
 #include "surfaceFactory.h"
 #include "objectRegister.h"
 #include "Rules.h"
@@ -94,15 +100,20 @@
 #include "Source.h"
 #include "KCode.h"
 #include "ObjSurfMap.h"
+#include "BoundBox.h"
+#include "ObjBoxTree.h"
 #include "PhysicsCards.h"
 #include "ReadFunctions.h"
 #include "BaseMap.h"
 #include "CellMap.h"
 #include "SimTrack.h"
+#include "QueryContext.h"
 #include "Simulation.h"
 
 Simulation::Simulation()  :
   mcnpType(0),CNum(100000),OSMPtr(new ModelSupport::ObjSurfMap),
+  OBTPtr(new ModelSupport::ObjBoxTree),
+  cellVersion(ModelSupport::QueryContext::newVersion()),writeThread(1),
   PhysPtr(new physicsSystem::PhysicsCards)
   /*!
     Start of simulation Object
@@ -115,7 +126,9 @@ Simulation::Simulation(const Simulation& A)  :
   mcnpType(A.mcnpType),inputFile(A.inputFile),
   CNum(A.CNum),DB(A.DB),
   OSMPtr(new ModelSupport::ObjSurfMap),
-  TList(A.TList),  cellOutOrder(A.cellOutOrder),
+  OBTPtr(new ModelSupport::ObjBoxTree(*A.OBTPtr)),
+  cellVersion(ModelSupport::QueryContext::newVersion()),
+  writeThread(A.writeThread),TList(A.TList),  cellOutOrder(A.cellOutOrder),
   PhysPtr(new physicsSystem::PhysicsCards(*A.PhysPtr))
   /*!
     Copy constructor:: makes a deep copy of the point objects
@@ -161,6 +174,8 @@ Simulation::operator=(const Simulation& A)
       DB=A.DB;
       TList=A.TList;
       cellOutOrder=A.cellOutOrder;
+      *OBTPtr=*A.OBTPtr;
+      writeThread=A.writeThread;
       delete PhysPtr;
       PhysPtr=new physicsSystem::PhysicsCards(*A.PhysPtr);
       deleteObjects();
@@ -196,6 +211,7 @@ Simulation::~Simulation()
   delete OSMPtr;
   deleteObjects();
   deleteTally();
+  delete OBTPtr;
   ModelSupport::SimTrack::Instance().clearSim(this);
 
 }
@@ -227,6 +243,7 @@ Simulation::deleteObjects()
 {
   ELog::RegMethod RegA("","del");
   ModelSupport::SimTrack::Instance().setCell(this,0);
+  cellChange();
   OTYPE::iterator mc;
   for(mc=OList.begin();mc!=OList.end();mc++)
     delete mc->second;
@@ -452,6 +469,7 @@ Simulation::addCell(const int cellNumber,const MonteCarlo::Qhull& A)
     }
 
   OList.insert(OTYPE::value_type(cellNumber,A.clone()));
+  cellChange();
   MonteCarlo::Qhull* QHptr=OList[cellNumber];
   QHptr->setName(cellNumber);
   if (setMaterialDensity(cellNumber))
@@ -673,6 +691,7 @@ Simulation::removeCells(const int startN,const int endN)
 {
   ELog::RegMethod RegItem("Simulation","removeCells");
   ModelSupport::SimTrack& ST(ModelSupport::SimTrack::Instance());
+  cellChange();
 
   // It seems quicker to create a new map and copy
   OTYPE newOList;
@@ -715,6 +734,7 @@ Simulation::removeCell(const int Index)
   
   ModelSupport::SimTrack& ST(ModelSupport::SimTrack::Instance());
   ST.checkDelete(this,vc->second);
+  cellChange();
   delete vc->second;
   OList.erase(vc);
   
@@ -734,6 +754,7 @@ Simulation::removeAllSurface(const int KeyN)
     \returns Number of surface removed (will do)
   */
 {
+  cellChange();
   OTYPE::iterator oc;
   for(oc=OList.begin();oc!=OList.end();oc++)
     {
@@ -758,6 +779,7 @@ Simulation::substituteAllSurface(const int KeyN,const int NsurfN)
   */
 {
   ELog::RegMethod RegA("Simulation","substituteAllSurface");
+  cellChange();
   const int NS(NsurfN>0 ? NsurfN : -NsurfN);
   Geometry::Surface* XPtr=ModelSupport::surfIndex::Instance().getSurf(NS);
   if (!XPtr)
@@ -954,6 +976,7 @@ Simulation::removeComplements()
   ELog::RegMethod RegA("Simulation","removeComplements");
 
   populateCells();
+  cellChange();
   int retVal(0);
   OTYPE::iterator vc;
   for(vc=OList.begin();vc!=OList.end();vc++)
@@ -1032,6 +1055,7 @@ Simulation::populateCells()
 {
   ELog::RegMethod RegA("Simulation","populateCells");
   
+  cellChange();
   OTYPE::iterator oc;
 
   int retVal(0);
@@ -1095,6 +1119,7 @@ Simulation::applyTransforms()
 	  return 1;
 	}
     }
+  ModelSupport::surfIndex::Instance().clearHash();
   return 0;
 }
 
@@ -1108,6 +1133,8 @@ Simulation::findQhull(const int CellN)
   */
 {
   ELog::RegMethod RegA("Simulation","findQhull");
+  // Cell can be modified :
+  cellChange();
   OTYPE::iterator mp=OList.find(CellN);
   return (mp==OList.end()) ? 0 : mp->second;
 }
@@ -1146,23 +1173,58 @@ Simulation::calcVertex(const int CellN)
 }
 
 void
-Simulation::calcAllVertex()
+Simulation::calcAllVertex(const size_t nThread)
   /*! 
      Calculates the vertexes in the Cell and stores
-     in the Qhull. The number of vertexes found are returned. 
+     in the Qhull. The cells are processed in parallel.
+     \param nThread :: Number of threads [0 : hardware]
   */
 {
   ELog::RegMethod RegA("Simulation","calcAllVertex");
 
-
-  OTYPE::iterator mc;
-
-  for(mc=OList.begin();mc!=OList.end();mc++)
+  // Cells can refer to other cells [#N] so all the rules
+  // are populated/compiled before the threads start
+  std::vector<MonteCarlo::Qhull*> QList;
+  for(OTYPE::value_type& OV : OList)
     {
-      // This point may be outside of the point
-      if (!mc->second->calcVertex())   
-	mc->second->calcMidVertex();
+      OV.second->populate();
+      QList.push_back(OV.second);
     }
+  
+  size_t NT(nThread);
+  if (!NT)
+    NT=static_cast<size_t>(std::thread::hardware_concurrency());
+  NT=std::max<size_t>(1,std::min(NT,QList.size()));
+
+  std::atomic<size_t> cellCnt(0);
+  std::vector<std::exception_ptr> TError(NT);
+  std::vector<std::thread> TUnit;
+  for(size_t i=0;i<NT;i++)
+    {
+      TUnit.push_back
+	(std::thread([&,i]()
+		     {
+		       try
+			 {
+			   for(size_t index=cellCnt++;index<QList.size();
+			       index=cellCnt++)
+			     {
+			       // This point may be outside of the point
+			       if (!QList[index]->calcVertex())   
+				 QList[index]->calcMidVertex();
+			     }
+			 }
+		       catch (...)
+			 {
+			   TError[i]=std::current_exception();
+			 }
+		     }));
+    }
+  for(std::thread& TU : TUnit)
+    TU.join();
+  for(const std::exception_ptr& EP : TError)
+    if (EP) std::rethrow_exception(EP);
+  
   return;
 }
 
@@ -1420,11 +1482,124 @@ Simulation::findCellNumber(const Geometry::Vec3D& Pt,
   return (Obj) ? Obj->getName() : 0;
 }
 
+int
+Simulation::findCellNumber(const Geometry::Vec3D& Pt,
+			   const int cellNumber,
+			   ModelSupport::QueryContext& QC) const
+  /*!
+    Find a cell based on Pt and old number
+    \param Pt :: Point to find in cell
+    \param cellNumber :: First guess search point
+    \param QC :: Query context [caller owned]
+    \return cell number / 0
+  */
+{
+  MonteCarlo::Object* Obj(0);
+  if (cellNumber)
+    {
+      OTYPE::const_iterator mpc=OList.find(cellNumber);
+      if (mpc!=OList.end())
+	Obj=mpc->second;
+    }
+  Obj=findCell(Pt,Obj,QC);
+  return (Obj) ? Obj->getName() : 0;
+}
+
+void
+Simulation::cellChange()
+  /*!
+    Register a change to the cell map: the box tree
+    is dropped [until buildCellTree] and all QueryContext 
+    hints become invalid
+  */
+{
+  OBTPtr->clearAll();
+  cellVersion=ModelSupport::QueryContext::newVersion();
+  return;
+}
+
+void
+Simulation::setCellTree(const int flag)
+  /*!
+    Set the use of the cell box tree in findCell
+    \param flag :: 1 to use the tree / 0 for linear search
+  */
+{
+  OBTPtr->setActive(flag);
+  return;
+}
+
+void
+Simulation::clearCellTree()
+  /*!
+    Drop the cell box tree [findCell is linear until the
+    next buildCellTree]. Must be called if a cell is changed 
+    directly rather than through the Simulation.
+  */
+{
+  cellChange();
+  return;
+}
+
+void
+Simulation::buildCellTree()
+  /*!
+    Build the cell box tree for findCell. Called once the
+    cells are set [masterRotation / before the output]; 
+    any later change to the cells drops the tree.
+  */
+{
+  ELog::RegMethod RegA("Simulation","buildCellTree");
+
+  if (OBTPtr->isActive() && !OBTPtr->isBuilt())
+    OBTPtr->build(OList);
+  return;
+}
+
+Simulation::OTYPE&
+Simulation::getCells()
+  /*!
+    Get the cells [modifiable]. This invalidates 
+    the cell box tree.
+    \return Cell map
+  */
+{
+  cellChange();
+  return OList;
+}
+
+MonteCarlo::Object*
+Simulation::searchCell(const Geometry::Vec3D& Pt) const
+  /*! 
+    Search all the cells for the point [no hints].
+    Uses the box tree if built, otherwise a linear search.
+    \param Pt :: Point to find
+    \retval Object ptr
+    \retval 0 :: No cell exists
+  */
+{
+  // use the box tree [if current]
+  if (OBTPtr->isActive() && OBTPtr->isBuilt())
+    return OBTPtr->findCell(Pt);
+
+  // now we need to search everthing
+  OTYPE::const_iterator mpc;
+  for(mpc=OList.begin();mpc!=OList.end();mpc++)
+    {
+      if (!mpc->second->isPlaceHold() &&
+	  mpc->second->isValid(Pt))
+	return mpc->second;
+    }
+  // Found NOTHING :-(
+  return 0;
+}
+
 MonteCarlo::Object*
 Simulation::findCell(const Geometry::Vec3D& Pt,
 		     MonteCarlo::Object* testCell) const
   /*! 
-    Object that a given the point is in.
+    Object that a given the point is in. Uses the 
+    SimTrack singleton as the last-cell cache.
     \param Pt :: Point to find
     \param testCell :: Last Cell (since points often are close together 
     \retval Object ptr
@@ -1443,21 +1618,42 @@ Simulation::findCell(const Geometry::Vec3D& Pt,
   if (curObjPtr && curObjPtr!=testCell 
       && curObjPtr->isValid(Pt))
     return curObjPtr;
-      
-  // now we need to search everthing
-  OTYPE::const_iterator mpc;
-  for(mpc=OList.begin();mpc!=OList.end();mpc++)
+
+  MonteCarlo::Object* OPtr=searchCell(Pt);
+  ST.setCell(this,OPtr);
+  return OPtr;
+}
+
+MonteCarlo::Object*
+Simulation::findCell(const Geometry::Vec3D& Pt,
+		     MonteCarlo::Object* testCell,
+		     ModelSupport::QueryContext& QC) const
+  /*! 
+    Object that a given the point is in. The last-cell 
+    hint is held in the caller's context, so this can be 
+    called from several threads [while the cells are fixed].
+    \param Pt :: Point to find
+    \param testCell :: Last Cell (since points often are close together 
+    \param QC :: Query context [caller owned]
+    \retval Object ptr
+    \retval 0 :: No cell exists
+  */
+{
+  // First test users guess:
+  if (testCell && testCell->isValid(Pt))
     {
-      if (!mpc->second->isPlaceHold() &&
-	  mpc->second->isValid(Pt))
-        {
-	  ST.setCell(this,mpc->second);
-	  return mpc->second;
-	}
+      QC.setCell(cellVersion,testCell);
+      return testCell;
     }
-  // Found NOTHING :-(
-  ST.setCell(this,0);
-  return 0;
+  // Ok how about our last find
+  MonteCarlo::Object* curObjPtr=QC.getCell(cellVersion);
+  if (curObjPtr && curObjPtr!=testCell 
+      && curObjPtr->isValid(Pt))
+    return curObjPtr;
+
+  MonteCarlo::Object* OPtr=searchCell(Pt);
+  QC.setCell(cellVersion,OPtr);
+  return OPtr;
 }
 
 void
@@ -1504,23 +1700,116 @@ Simulation::writeTransform(std::ostream& OX) const
 }
 
 
+std::vector<std::string>
+Simulation::formatCells(const std::vector<cellWriter>& WList) const
+  /*!
+    Format all the cells with each writer in one pass 
+    of the cell list. The formatting is threaded over
+    blocks of cells [writeThread].
+    \param WList :: Object write methods
+    \return text of all the cells for each writer
+  */
+{
+  ELog::RegMethod RegA("Simulation","formatCells");
+
+  std::vector<const MonteCarlo::Qhull*> QList;
+  for(const OTYPE::value_type& OV : OList)
+    QList.push_back(OV.second);
+  return StrFunc::formatBlocks
+    (writeThread,QList.size(),64,WList.size(),
+     [&QList,&WList](const size_t index,const std::vector<std::ostream*>& OS)
+     {
+       for(size_t i=0;i<WList.size();i++)
+	 (QList[index]->*WList[i])(*OS[i]);
+     });
+}
+
+std::vector<std::string>
+Simulation::formatSurfaces(const std::vector<surfWriter>& WList) const
+  /*!
+    Format all the surfaces with each writer in one pass
+    of the surface map. The formatting is threaded over
+    blocks of surfaces [writeThread].
+    \param WList :: Surface write methods
+    \return text of all the surfaces for each writer
+  */
+{
+  ELog::RegMethod RegA("Simulation","formatSurfaces");
+
+  const ModelSupport::surfIndex::STYPE& SurMap =
+    ModelSupport::surfIndex::Instance().surMap();
+
+  std::vector<const Geometry::Surface*> SList;
+  std::vector<int> NullSurf;
+  for(const ModelSupport::surfIndex::STYPE::value_type& SV : SurMap)
+    {
+      // null surfaces write nothing
+      if (dynamic_cast<const Geometry::NullSurface*>(SV.second))
+	NullSurf.push_back(SV.first);
+      else
+	SList.push_back(SV.second);
+    }
+  // surfaces without an output form : reported after the threads
+  std::vector<std::string> Errors(SList.size());
+  const std::vector<std::string> Out=StrFunc::formatBlocks
+    (writeThread,SList.size(),64,WList.size(),
+     [&SList,&WList,&Errors]
+     (const size_t index,const std::vector<std::ostream*>& OS)
+     {
+       for(size_t i=0;i<WList.size();i++)
+	 {
+	   try
+	     {
+	       (SList[index]->*WList[i])(*OS[i]);
+	     }
+	   catch (ColErr::AbsObjMethod& EA)
+	     {
+	       Errors[index]=EA.getErr();
+	     }
+	 }
+     });
+  for(size_t i=0;i<SList.size();i++)
+    if (!Errors[i].empty())
+      ELog::EM<<"Surface "<<SList[i]->getName()<<" : "
+	      <<Errors[i]<<ELog::endErr;
+  for(const int SN : NullSurf)
+    ELog::EM<<"Writing Null Surface: "<<SN<<ELog::endWarn;
+  return Out;
+}
+
 void
 Simulation::writeCells(std::ostream& OX) const
+  /*!
+    Write all the cells in standard MCNPX output 
+    type. Each cell is written directly to the stream.
+    \param OX :: Output stream
+  */
+
+{
+  OX<<"c -------------------------------------------------------"<<std::endl;
+  OX<<"c --------------- CELL CARDS --------------------------"<<std::endl;
+  OX<<"c -------------------------------------------------------"<<std::endl;
+  for(const OTYPE::value_type& OV : OList)
+    OV.second->write(OX);
+  OX<<"c ++++++++++++++++++++++ END ++++++++++++++++++++++++++++"<<std::endl;
+  OX<<std::endl;  // Empty line manditory for MCNPX
+  return;
+}
+
+void
+Simulation::writeCells(std::ostream& OX,const std::string& CellCards) const
   /*!
     Write all the cells in standard MCNPX output 
     type.
     \param OX :: Output stream
+    \param CellCards :: Formated cells [formatCells]
   */
 
 {
   OX<<"c -------------------------------------------------------"<<std::endl;
   OX<<"c --------------- CELL CARDS --------------------------"<<std::endl;
   OX<<"c -------------------------------------------------------"<<std::endl;
-  OTYPE::const_iterator mp;
-  for(mp=OList.begin();mp!=OList.end();mp++)
-    {
-      mp->second->write(OX);
-    }
+  OX<<CellCards;
   OX<<"c ++++++++++++++++++++++ END ++++++++++++++++++++++++++++"<<std::endl;
   OX<<std::endl;  // Empty line manditory for MCNPX
   return;
@@ -1531,7 +1820,7 @@ void
 Simulation::writeSurfaces(std::ostream& OX) const
   /*!
     Write all the surfaces in standard MCNPX output 
-    type.
+    type. Each surface is written directly to the stream.
     \param OX :: Output stream
   */
 
@@ -1542,12 +1831,29 @@ Simulation::writeSurfaces(std::ostream& OX) const
 
   const ModelSupport::surfIndex::STYPE& SurMap =
     ModelSupport::surfIndex::Instance().surMap();
+  for(const ModelSupport::surfIndex::STYPE::value_type& SV : SurMap)
+    SV.second->write(OX);
+
+  OX<<"c ++++++++++++++++++++++ END ++++++++++++++++++++++++++++"<<std::endl;
+  OX<<std::endl;
+  return;
+}
+
+void
+Simulation::writeSurfaces(std::ostream& OX,const std::string& SurfCards) const
+  /*!
+    Write all the surfaces in standard MCNPX output 
+    type.
+    \param OX :: Output stream
+    \param SurfCards :: Formated surfaces [formatSurfaces]
+  */
+
+{
+  OX<<"c -------------------------------------------------------"<<std::endl;
+  OX<<"c --------------- SURFACE CARDS -------------------------"<<std::endl;
+  OX<<"c -------------------------------------------------------"<<std::endl;
+  OX<<SurfCards;
 
-  std::map<int,Geometry::Surface*>::const_iterator mp;
-  for(mp=SurMap.begin();mp!=SurMap.end();mp++)
-    {
-      (mp->second)->write(OX);
-    }
   OX<<"c ++++++++++++++++++++++ END ++++++++++++++++++++++++++++"<<std::endl;
   OX<<std::endl;
   return;
@@ -1644,7 +1950,7 @@ Simulation::writePhysics(std::ostream& OX) const
 	}
     }
   // Remaining Physics cards
-  PhysPtr->write(OX,cellOutOrder,voidCells);
+  PhysPtr->write(OX,cellOutOrder,voidCells,writeThread);
   OX<<"c ++++++++++++++++++++++ END ++++++++++++++++++++++++++++"<<std::endl;
   OX<<std::endl;  // MCNPX requires a blank line to terminate
   return;
@@ -1727,11 +2033,44 @@ void
 Simulation::write(const std::string& Fname) const
   /*!
     Write out all the system (in MCNPX output format)
+    If the write is threaded the deck is formatted in memory
+    and written to the file in one block.
     \param Fname :: Output file 
   */
 {
+  ELog::RegMethod RegA("Simulation","write");
+
+  if (writeThread==1)
+    {
+      std::ofstream OX(Fname.c_str());
+      writeDeck(OX);
+      OX.close();
+      return;
+    }
+  std::ostringstream cx;
+  writeDeck(cx);
+  const std::string Buffer(cx.str());
   std::ofstream OX(Fname.c_str());
-  
+  OX.write(Buffer.c_str(),static_cast<std::streamsize>(Buffer.size()));
+  OX.close();
+  return;
+}
+
+void
+Simulation::writeDeck(std::ostream& OX) const
+  /*!
+    Write out all the system (in MCNPX output format)
+    to a stream. A single thread streams the cells/surfaces
+    rather than formating them in memory first.
+    \param OX :: Output stream
+  */
+{
+  if (writeThread!=1)
+    {
+      writeMCNP(OX,formatCells({&MonteCarlo::Object::write}).front(),
+		formatSurfaces({&Geometry::Surface::write}).front());
+      return;
+    }
   OX<<"Input File:"<<inputFile<<std::endl;
   StrFunc::writeMCNPXcomment("RunCmd:"+cmdLine,OX);
   writeVariables(OX);
@@ -1742,7 +2081,30 @@ Simulation::write(const std::string& Fname) const
   writeWeights(OX);
   writeTally(OX);
   writePhysics(OX);
-  OX.close();
+  return;
+}
+
+void
+Simulation::writeMCNP(std::ostream& OX,const std::string& CellCards,
+		      const std::string& SurfCards) const
+  /*!
+    Write out all the system (in MCNPX output format)
+    to a stream with the cells/surfaces already formated
+    \param OX :: Output stream
+    \param CellCards :: Cells [formatCells : Object::write]
+    \param SurfCards :: Surfaces [formatSurfaces : Surface::write]
+  */
+{
+  OX<<"Input File:"<<inputFile<<std::endl;
+  StrFunc::writeMCNPXcomment("RunCmd:"+cmdLine,OX);
+  writeVariables(OX);
+  writeCells(OX,CellCards);
+  writeSurfaces(OX,SurfCards);
+  writeMaterial(OX);
+  writeTransform(OX);
+  writeWeights(OX);
+  writeTally(OX);
+  writePhysics(OX);
   return;
 }
 
@@ -1998,6 +2360,7 @@ Simulation::renumberCells(const std::vector<int>& cOffset,
   */
 {
   ELog::RegMethod RegA("Simulation","renumberCells");
+  cellChange();
 
   ModelSupport::objectRegister& OR=
     ModelSupport::objectRegister::Instance();
@@ -2185,6 +2548,7 @@ Simulation::masterRotation()
   */
 {
   ELog::RegMethod RegA("Simulation","masterRotation");
+  cellChange();
 
   ModelSupport::objectRegister& OR=
     ModelSupport::objectRegister::Instance();
@@ -2197,6 +2561,7 @@ Simulation::masterRotation()
   std::map<int,Geometry::Surface*>::const_iterator sc;
   for(sc=SurMap.begin();sc!=SurMap.end();sc++)
     MR.applyFull(sc->second);
+  ModelSupport::surfIndex::Instance().clearHash();
 
   // Apply to QHull if calculated:
   OTYPE::iterator oc;
@@ -2224,7 +2589,8 @@ Simulation::masterRotation()
   OR.rotateMaster();
   
   MR.setGlobal();
-
+  // cells are now fixed
+  buildCellTree();
   return;
 }
 
@@ -106,6 +106,7 @@ createVTK(const mainSystem::inputParam& IParam,
 	{
 	  ELog::EM<<"Processing MD5:"<<ELog::endBasic;
 	  MD5sum MM(60);
+	  MM.setThreads(IParam.getValue<size_t>("threads"));
 	  MM.setBox(MeshA,MeshB);
 	  MM.setIndex(MPts[0],MPts[1],MPts[2]);
 	  MM.populate(SimPtr);
@@ -131,11 +132,13 @@ createVTK(const mainSystem::inputParam& IParam,
 	    }
 
 	  // PROCESS VTK:
+	  VTK.setThreads(IParam.getValue<size_t>("threads"));
+	  VTK.setLineTrack(IParam.flag("vtkTrack"));
 	  VTK.setBox(MeshA,MeshB);
 	  VTK.setIndex(MPts[0],MPts[1],MPts[2]);
-	  VTK.populate(SimPtr,Active);
-	  
-	  VTK.writeVTK(Oname);
+	  VTK.setFormat(Visit::formatType
+			(IParam.getValue<std::string>("vtkFormat")));
+	  VTK.writeStream(SimPtr,Active,Oname);
 	  return 2;
 	}
     }
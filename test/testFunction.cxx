@@ -46,6 +46,7 @@
 #include "funcList.h"
 #include "varList.h"
 #include "Code.h"
+#include "FItem.h"
 #include "FuncDataBase.h"
 
 #include "testFunc.h"
@@ -81,6 +82,8 @@ testFunction::applyTest(const int extra)
       &testFunction::testAnalyse,
       &testFunction::testBuiltIn,
       &testFunction::testEval,
+      &testFunction::testIndexVar,
+      &testFunction::testMemo,
       &testFunction::testString, 
       &testFunction::testVariable,
       &testFunction::testVec3D,
@@ -92,6 +95,8 @@ testFunction::applyTest(const int extra)
       "Analyse",
       "BuiltIn",
       "Eval",
+      "IndexVar",
+      "Memo",
       "String",
       "Variable",
       "Vec3D",
@@ -246,6 +251,160 @@ testFunction::testEval()
 }
 
 
+int
+testFunction::testIndexVar()
+  /*!
+    Test the hashed lookup of variables by full name 
+    and by prefix+index+suffix
+    \retval 0 :: success
+  */
+{
+  ELog::RegMethod RegA("testFunction","testIndexVar");
+
+  FuncDataBase XX;
+  // enough items to force several rehash
+  for(int i=0;i<500;i++)
+    {
+      std::ostringstream cx;
+      cx<<"pipe"<<i<<"Length";
+      XX.addVariable(cx.str(),static_cast<double>(i));
+    }
+  XX.addVariable("pipeLength",-1.0);
+  XX.addVariable("pipe-3Length",-3.0);
+  XX.addVariable("pipe7",7.0);
+
+  // prefix : index : suffix : found : value
+  typedef std::tuple<std::string,long int,std::string,int,double> TTYPE;
+  const std::vector<TTYPE> Tests=
+    {
+      TTYPE("pipe",0,"Length",1,0.0),
+      TTYPE("pipe",37,"Length",1,37.0),
+      TTYPE("pipe",499,"Length",1,499.0),
+      TTYPE("pipe",500,"Length",0,0.0),
+      TTYPE("pipe",-3,"Length",1,-3.0),
+      TTYPE("pipe",7,"",1,7.0),
+      TTYPE("pip",7,"",0,0.0),
+      TTYPE("pipe3",7,"Length",1,37.0),
+      TTYPE("pipe",3,"7Length",1,37.0),
+      TTYPE("pipe",37,"Len",0,0.0)
+    };
+
+  int cnt(1);
+  for(const TTYPE& tc : Tests)
+    {
+      std::ostringstream cx;
+      cx<<std::get<0>(tc)<<std::get<1>(tc)<<std::get<2>(tc);
+
+      double VA(0.0),VB(0.0);
+      const int flagA=XX.tryEval(std::get<0>(tc),std::get<1>(tc),
+				 std::get<2>(tc),VA);
+      const int flagB=XX.tryEval(cx.str(),VB);
+      if (flagA!=std::get<3>(tc) || flagB!=std::get<3>(tc) ||
+	  flagB!=XX.hasVariable(cx.str()) ||
+	  std::abs(VA-std::get<4>(tc))>1e-8 ||
+	  std::abs(VB-std::get<4>(tc))>1e-8)
+	{
+	  ELog::EM<<"Test "<<cnt<<" : "<<cx.str()<<ELog::endDiag;
+	  ELog::EM<<"Flag == "<<flagA<<" "<<flagB<<" ["
+		  <<std::get<3>(tc)<<"]"<<ELog::endDiag;
+	  ELog::EM<<"Value == "<<VA<<" "<<VB<<" ["
+		  <<std::get<4>(tc)<<"]"<<ELog::endDiag;
+	  return -1;
+	}
+      cnt++;
+    }
+
+  // Replace / copy must keep the lookup valid
+  XX.addVariable("pipe37Length",Geometry::Vec3D(1,2,3));
+  XX.copyVar("pipe38Length","pipe37Length");
+  FuncDataBase YY(XX);
+  Geometry::Vec3D Res;
+  if (!YY.tryEval("pipe",38,"Length",Res) ||
+      Res!=Geometry::Vec3D(1,2,3))
+    {
+      ELog::EM<<"Copy failed: "<<Res<<ELog::endDiag;
+      return -2;
+    }
+  return 0;
+}
+
+int
+testFunction::testMemo()
+  /*!
+    Test that cached function values follow a change
+    to the variables they depend on
+    \retval 0 :: success
+  */
+{
+  ELog::RegMethod RegA("testFunction","testMemo");
+
+  FuncDataBase XX;
+  XX.addVariable("V1",3.0);
+  XX.addVariable("V2",5.0);
+  XX.addVariable("unused",7.0);
+  XX.Parse("V1*2");
+  XX.addVariable("A");
+  XX.Parse("A+V2");
+  XX.addVariable("B");
+
+  // value : V1 : V2
+  typedef std::tuple<double,double,double> TTYPE;
+  const std::vector<TTYPE> Tests=
+    {
+      TTYPE(11.0,3.0,5.0),
+      TTYPE(13.0,4.0,5.0),
+      TTYPE(14.0,4.0,6.0),
+      TTYPE(14.0,4.0,6.0)
+    };
+
+  int cnt(1);
+  for(const TTYPE& tc : Tests)
+    {
+      XX.setVariable("V1",std::get<1>(tc));
+      XX.setVariable("V2",std::get<2>(tc));
+      // Second read must come from the cache
+      for(size_t i=0;i<2;i++)
+	{
+	  const double Res=XX.EvalVar<double>("B");
+	  if (std::abs(Res-std::get<0>(tc))>1e-8)
+	    {
+	      ELog::EM<<"Test "<<cnt<<" B == "<<Res<<" ["
+		      <<std::get<0>(tc)<<"]"<<ELog::endDiag;
+	      return -1;
+	    }
+	}
+      cnt++;
+    }
+
+  // Replace a function 
+  XX.Parse("V1*10");
+  XX.setVariable("A");
+  if (std::abs(XX.EvalVar<double>("B")-46.0)>1e-8)
+    {
+      ELog::EM<<"Replaced A: B == "<<XX.EvalVar<double>("B")<<ELog::endDiag;
+      return -2;
+    }
+
+  // Active flags must still cover all the variables read
+  typedef std::tuple<std::string,bool> ATYPE;
+  const std::vector<ATYPE> ATests=
+    {
+      ATYPE("A",1),ATYPE("B",1),ATYPE("V1",1),
+      ATYPE("V2",1),ATYPE("unused",0)
+    };
+  for(const ATYPE& tc : ATests)
+    {
+      const FItem* FPtr=XX.findItem(std::get<0>(tc));
+      if (!FPtr || (FPtr->isActive()!=0)!=std::get<1>(tc))
+	{
+	  ELog::EM<<"Active variable "<<std::get<0>(tc)<<" != "
+		  <<std::get<1>(tc)<<ELog::endDiag;
+	  return -3;
+	}
+    }
+  return 0;
+}
+
 int
 testFunction::testString()
   /*!
@@ -401,7 +560,7 @@ testFunction::testVec3DFunctions()
   Tests.push_back(TTYPE("abs(V1+vec3d(1,2,3))",0,Geometry::Vec3D(0,0,0),
 			sqrt(16+36+64)));
   Tests.push_back(TTYPE("dot(V1,vec3d(1,2,3))",0,Geometry::Vec3D(0,0,0),
-			sqrt(16+36+64)));
+			26.0));
 
   for(const VTYPE& vc : TestVar)
     XX.addVariable(std::get<0>(vc),std::get<1>(vc));
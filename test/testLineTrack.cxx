@@ -72,6 +72,9 @@
 #include "neutron.h"
 #include "Simulation.h"
 #include "LineTrack.h"
+#include "ObjectTrackAct.h"
+#include "ObjectTrackPoint.h"
+#include "QueryServer.h"
 #include "Cone.h"
 
 #include "testFunc.h"
@@ -196,11 +199,13 @@ testLineTrack::applyTest(const int extra)
   typedef int (testLineTrack::*testPtr)();
   testPtr TPtr[]=
     {
-      &testLineTrack::testLine
+      &testLineTrack::testLine,
+      &testLineTrack::testQuery
     };
   const std::string TestName[]=
     {
-      "Line"
+      "Line",
+      "Query"
     };
   
   const int TSize(sizeof(TPtr)/sizeof(testPtr));
@@ -275,6 +280,128 @@ testLineTrack::testLine()
   return 0;
 }
 
+int
+testLineTrack::testQuery()
+  /*!
+    Run a request script through the query server
+    [local client] and check the batched responses
+    match the single requests and the serial tracks
+    \return 0 on success and -1 on error
+  */
+{
+  ELog::RegMethod RegA("testLineTrack","testQuery");
+
+  initSim();
+
+  const std::vector<std::string> Requests=
+    {
+      "findCell 0 0 0",
+      "findCell 0 0 2",
+      "findCell 0 0 5",
+      "findCell 0 0 20",
+      "findCell 0 0 40",
+      "lineTrack 0 0 -10 0 0 10",
+      "lineTrack -10 0 6 10 0 6",
+      "attnSum 0 0 -10 0 0 10",
+      "attnSum 0 0 30 0 0 0",
+      "cell 3",
+      "cell 99",
+      "material 5",
+      "unknown 1 2 3"
+    };
+  const std::vector<std::string> Cells=
+    { "ok 2 3","ok 3 5","ok 4 4","ok 5 0","ok 1 0" };
+
+  std::ostringstream cx;
+  for(const std::string& R : Requests)
+    cx<<R<<"\n";
+  cx<<"# batch of the same\nbatch\n";
+  for(const std::string& R : Requests)
+    cx<<R<<"\n";
+  cx<<"end\nquit\nfindCell 0 0 0\n";
+
+  std::istringstream IX(cx.str());
+  std::ostringstream OX;
+  ModelSupport::QueryServer QS(ASim);
+  QS.setThreads(3);
+  QS.serve(IX,OX);
+
+  std::vector<std::string> Out;
+  std::istringstream RX(OX.str());
+  std::string Line;
+  while(std::getline(RX,Line))
+    Out.push_back(Line);
+
+  const size_t NR(Requests.size());
+  if (Out.size()!=2*NR)
+    {
+      ELog::EM<<"Responses "<<Out.size()<<" not "<<2*NR<<ELog::endDiag;
+      ELog::EM<<OX.str()<<ELog::endDiag;
+      return -1;
+    }
+  for(size_t i=0;i<NR;i++)
+    if (Out[i]!=Out[i+NR])
+      {
+	ELog::EM<<"Batch mismatch "<<Requests[i]<<ELog::endDiag;
+	ELog::EM<<Out[i]<<" :: "<<Out[i+NR]<<ELog::endDiag;
+	return -1;
+      }
+  for(size_t i=0;i<Cells.size();i++)
+    if (Out[i]!=Cells[i])
+      {
+	ELog::EM<<"Failed on "<<Requests[i]<<" : "<<Out[i]<<ELog::endDiag;
+	return -1;
+      }
+
+  // tracks against the serial LineTrack / ObjectTrackPoint
+  LineTrack LT(Geometry::Vec3D(0,0,-10),Geometry::Vec3D(0,0,10));
+  LT.calculate(ASim);
+  std::string TLine(Out[5]);
+  std::string Key;
+  size_t NCell;
+  if (!StrFunc::section(TLine,Key) || Key!="ok" ||
+      !StrFunc::section(TLine,NCell) || NCell!=LT.getCells().size())
+    {
+      ELog::EM<<"Track failed : "<<Out[5]<<ELog::endDiag;
+      return -1;
+    }
+  for(size_t i=0;i<NCell;i++)
+    {
+      long int CN;
+      int MN;
+      double T;
+      if (!StrFunc::section(TLine,CN) || !StrFunc::section(TLine,MN) ||
+	  !StrFunc::section(TLine,T) || CN!=LT.getCells()[i] ||
+	  std::abs(T-LT.getTrack()[i])>1e-6)
+	{
+	  ELog::EM<<"Track failed : "<<Out[5]<<ELog::endDiag;
+	  return -1;
+	}
+    }
+  
+  ObjectTrackPoint OTP(Geometry::Vec3D(0,0,0));
+  OTP.addUnit(ASim,1,Geometry::Vec3D(0,0,30));
+  std::string ALine(Out[8]);
+  double ASum;
+  if (!StrFunc::section(ALine,Key) || Key!="ok" ||
+      !StrFunc::section(ALine,ASum) ||
+      std::abs(ASum-OTP.getAttnSum(1))>1e-6*(1.0+ASum))
+    {
+      ELog::EM<<"AttnSum failed : "<<Out[8]<<" :: "
+	      <<OTP.getAttnSum(1)<<ELog::endDiag;
+      return -1;
+    }
+
+  if (Out[9].substr(0,5)!="ok 5 " || Out[10].substr(0,5)!="error" ||
+      Out[11].substr(0,3)!="ok " || Out[12].substr(0,5)!="error")
+    {
+      ELog::EM<<"Lookup failed :\n"<<Out[9]<<"\n"<<Out[10]<<"\n"
+	      <<Out[11]<<"\n"<<Out[12]<<ELog::endDiag;
+      return -1;
+    }
+  return 0;
+}
+
 int
 testLineTrack::checkResult(const LineTrack& LT,
 			   const long int CSum,const double TSum) const
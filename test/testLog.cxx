@@ -65,11 +65,13 @@ testLog::applyTest(const int extra)
   typedef int (testLog::*testPtr)();
   testPtr TPtr[]=
     {
-      &testLog::testENDL
+      &testLog::testENDL,
+      &testLog::testRegMethod
     };
   const std::string TestName[]=
     {
-      "ENDL"
+      "ENDL",
+      "RegMethod"
     };
   
   const int TSize(sizeof(TPtr)/sizeof(testPtr));
@@ -122,3 +124,73 @@ testLog::testENDL()
   ELog::EM<<"END of  ::3 EMPTY LINE:"<<ELog::endDebug;
   return 0;
 }
+
+int
+testLog::testRegMethod()
+  /*!
+    Test of the RegMethod stack and the code stack
+    held by an exception
+    \return 0 on success / -ve on failure
+   */
+{
+  ELog::RegMethod RegA("testLog","testRegMethod");
+
+#ifndef NO_NAMESTACK
+  const size_t depth=RegA.getBasePtr()->getDepth();
+  const std::string subName("Inner");
+  {
+    ELog::RegMethod RegB("testLog",subName+"<1>");
+    if (ELog::RegMethod::getBase()!="testLog::Inner<1>" ||
+	ELog::RegMethod::getItem(-1)!="testLog::testRegMethod" ||
+	RegA.getBasePtr()->getDepth()!=depth+1)
+      {
+	ELog::EM<<"Base == "<<ELog::RegMethod::getBase()<<ELog::endDiag;
+	ELog::EM<<"Item(-1) == "<<ELog::RegMethod::getItem(-1)<<ELog::endDiag;
+	return -1;
+      }
+    try
+      {
+	ELog::RegMethod RegC("testLog","throwPoint");
+	throw ColErr::EmptyValue<int>("testRegMethod");
+      }
+    catch (ColErr::ExBase& A)
+      {
+	const std::string Out(A.what());
+	if (Out.find("testLog::testRegMethod")==std::string::npos ||
+	    Out.find("testLog::Inner<1>")==std::string::npos ||
+	    Out.find("testLog::throwPoint")==std::string::npos)
+	  {
+	    ELog::EM<<"Exception == "<<Out<<ELog::endDiag;
+	    return -2;
+	  }
+      }
+  }
+  if (ELog::RegMethod::getBase()!="testLog::testRegMethod" ||
+      RegA.getBasePtr()->getDepth()!=depth)
+    {
+      ELog::EM<<"Base == "<<ELog::RegMethod::getBase()<<ELog::endDiag;
+      return -3;
+    }
+#else
+  // only the top levels are registered
+  const size_t depth=RegA.getBasePtr()->getDepth();
+  {
+    ELog::RegMethod RegB("testLog","InnerA");
+    ELog::RegMethod RegC("testLog",std::string("InnerB"));
+    ELog::RegMethod RegD("testLog","InnerC",1);
+    ELog::RegMethod RegE("testLog","InnerD");
+    ELog::RegMethod RegF("testLog","InnerE");
+    if (RegA.getBasePtr()->getDepth()!=4)
+      {
+	ELog::EM<<"Depth == "<<RegA.getBasePtr()->getDepth()<<ELog::endDiag;
+	return -4;
+      }
+  }
+  if (RegA.getBasePtr()->getDepth()!=depth)
+    {
+      ELog::EM<<"Depth == "<<RegA.getBasePtr()->getDepth()<<ELog::endDiag;
+      return -5;
+    }
+#endif
+  return 0;
+}
@@ -29,7 +29,7 @@
 #include <map>
 #include <string>
 #include <algorithm>
-
+#include <cstdint>
 
 #include "Exception.h"
 #include "FileReport.h"
@@ -40,6 +40,7 @@
 #include "BaseVisit.h"
 #include "BaseModVisit.h"
 #include "MersenneTwister.h"
+#include "SobolSeq.h"
 
 #include "testFunc.h"
 #include "testMersenne.h"
@@ -74,13 +75,15 @@ testMersenne::applyTest(const int extra)
   testPtr TPtr[]=
     {
       &testMersenne::testRand,
-      &testMersenne::testRandom
+      &testMersenne::testRandom,
+      &testMersenne::testSobol
     };
 
   const std::string TestName[]=
     {
       "Rand",
-      "Random"
+      "Random",
+      "Sobol"
     };
 
   const int TSize(sizeof(TPtr)/sizeof(testPtr));
@@ -153,5 +156,65 @@ testMersenne::testRand()
   
   return 0;
 }
+
+int
+testMersenne::testSobol()
+  /*!
+    Test the Sobol sequence: known first points and
+    one point per 1/2^m interval in each dimension 
+    for the first 2^m points.
+    \retval -1 :: failed to get correct numbers
+    \retval 0 :: All passed
+  */
+{
+  ELog::RegMethod RegA("testMersenne","testSobol");
+
+  SobolSeq SS;
+  const double Known[][3]=
+    {
+      {0.0,0.0,0.0},
+      {0.5,0.5,0.5},
+      {0.75,0.25,0.25},
+      {0.25,0.75,0.75}
+    };
+  for(size_t i=0;i<4;i++)
+    {
+      double P[3];
+      SS.getPoint(i,P[0],P[1],P[2]);
+      for(size_t j=0;j<3;j++)
+	if (fabs(P[j]-Known[i][j])>1e-12)
+	  {
+	    ELog::EM<<"Point "<<i<<" : "<<P[0]<<" "<<P[1]<<" "<<P[2]
+		    <<ELog::endDiag;
+	    return -1;
+	  }
+    }
+
+  // shifted sequence : still one point per interval
+  SS.setShift(12345678U,87654321U,55555555U);
+  const size_t NBin(1024);
+  std::vector<size_t> Bin(3*NBin,0);
+  for(size_t i=0;i<NBin;i++)
+    {
+      double P[3];
+      SS.getPoint(i,P[0],P[1],P[2]);
+      for(size_t j=0;j<3;j++)
+	{
+	  if (P[j]<0.0 || P[j]>=1.0)
+	    {
+	      ELog::EM<<"Point "<<i<<" out of range: "<<P[j]<<ELog::endDiag;
+	      return -2;
+	    }
+	  Bin[j*NBin+static_cast<size_t>(P[j]*NBin)]++;
+	}
+    }
+  for(size_t i=0;i<3*NBin;i++)
+    if (Bin[i]!=1)
+      {
+	ELog::EM<<"Bin "<<i<<" == "<<Bin[i]<<ELog::endDiag;
+	return -3;
+      }
+  return 0;
+}
   
   
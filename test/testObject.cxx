@@ -23,6 +23,7 @@
 #include <iomanip>
 #include <iostream>
 #include <cmath>
+#include <complex>
 #include <vector>
 #include <list>
 #include <deque>
@@ -48,6 +49,7 @@
 #include "Vec3D.h"
 #include "Transform.h"
 #include "Surface.h"
+#include "BoundBox.h"
 #include "Rules.h"
 #include "Debug.h"
 #include "BnId.h"
@@ -57,7 +59,11 @@
 #include "HeadRule.h"
 #include "Object.h"
 #include "Qhull.h"
+#include "SurInter.h"
 #include "neutron.h"
+#include "Line.h"
+#include "LineIntersectVisit.h"
+#include "SenseTrack.h"
 
 #include "Debug.h"
 
@@ -112,6 +118,11 @@ testObject::createSurfaces()
 
   // Sphere :
   SurI.createSurface(100,"so 25");
+
+  // General plane / cylinder / cone :
+  SurI.createSurface(31,"p 1 1 0 -1");
+  SurI.createSurface(32,"cz 2");
+  SurI.createSurface(33,"kz 0 1");
   
   return;
 }
@@ -179,27 +190,37 @@ testObject::applyTest(const int extra)
   typedef int (testObject::*testPtr)();
   testPtr TPtr[]=
     {
+      &testObject::testAddSurfString,
+      &testObject::testBoundBox,
+      &testObject::testCalcVertex,
       &testObject::testCellStr,
       &testObject::testComplement,
+      &testObject::testFlatRule,
       &testObject::testIsValid,
       &testObject::testIsOnSide,
       &testObject::testMakeComplement,
       &testObject::testRemoveComplement,
       &testObject::testSetObject,
       &testObject::testSetObjectExtra,
-      &testObject::testTrackCell
+      &testObject::testTrackCell,
+      &testObject::testTrackSense
     };
   const std::string TestName[]=
     {
+      "AddSurfString",
+      "BoundBox",
+      "CalcVertex",
       "CellStr",
       "Complement",
+      "FlatRule",
       "IsValid",
       "IsOnSide",
       "MakeComplement",
       "RemoveComplement",
       "SetObject",
       "SetObjectExtra",
-      "TrackCell"
+      "TrackCell",
+      "TrackSense"
     };
   
   const int TSize(sizeof(TPtr)/sizeof(testPtr));
@@ -409,6 +430,321 @@ testObject::testComplement()
   return 0;
 }
 
+int
+testObject::testBoundBox() 
+  /*!
+    Test the bounding box of an object, including the
+    box of an unpopulated object and of an added rule
+    \retval -ve :: failed to get box
+    \retval 0 :: success
+  */
+{
+  ELog::RegMethod RegA("testObject","testBoundBox");
+
+  createSurfaces();
+  Qhull A;
+
+  // Object : Low point : High point 
+  typedef std::tuple<std::string,Geometry::Vec3D,Geometry::Vec3D> TTYPE;
+  const double bI(Geometry::BoundBox::boxInf);
+  std::vector<TTYPE> Tests;
+  Tests.push_back(TTYPE("4 10 0.05524655  1 -2 3 -4 5 -6",
+			Geometry::Vec3D(-1,-1,-1),Geometry::Vec3D(1,1,1)));
+  Tests.push_back(TTYPE("5 10 0.05524655 -100",
+			Geometry::Vec3D(-25,-25,-25),
+			Geometry::Vec3D(25,25,25)));
+  Tests.push_back(TTYPE("6 10 0.05524655 (1 -2 : 11 -1) 3 -4 5 -6",
+			Geometry::Vec3D(-3,-1,-1),Geometry::Vec3D(1,1,1)));
+  Tests.push_back(TTYPE("7 10 0.05524655 -2 3 -4 5 -6",
+			Geometry::Vec3D(-bI,-1,-1),Geometry::Vec3D(1,1,1)));
+  Tests.push_back(TTYPE("8 10 0.05524655 11 -12 13 -14 15 -16 -31",
+			Geometry::Vec3D(-3,-3,-3),Geometry::Vec3D(2,2,3)));
+  Tests.push_back(TTYPE("9 10 0.05524655 -32 5 -6",
+			Geometry::Vec3D(-2,-2,-1),Geometry::Vec3D(2,2,1)));
+  Tests.push_back(TTYPE("10 10 0.05524655 -33 5 -6",
+			Geometry::Vec3D(-1,-1,-1),Geometry::Vec3D(1,1,1)));
+  Tests.push_back(TTYPE("11 10 0.05524655 -33 -32 15 -16",
+			Geometry::Vec3D(-2,-2,-3),Geometry::Vec3D(2,2,3)));
+  Tests.push_back(TTYPE("12 10 0.05524655 1 -2 3 -4 21 -22",
+			Geometry::Vec3D(bI,bI,bI),Geometry::Vec3D(-bI,-bI,-bI)));
+
+  int cnt(1);
+  for(const TTYPE& tc : Tests)
+    {
+      A.setObject(std::get<0>(tc));
+      A.populate();
+      const Geometry::BoundBox& BBox=A.getBoundBox();
+      const Geometry::Vec3D& LP(std::get<1>(tc));
+      const Geometry::Vec3D& HP(std::get<2>(tc));
+      const bool emptyFlag(LP[0]>HP[0]);
+      if ((emptyFlag && !BBox.isEmpty()) ||
+	  (!emptyFlag && (BBox.getLow().Distance(LP)>1e-3 ||
+			  BBox.getHigh().Distance(HP)>1e-3)))
+	{
+	  ELog::EM<<"Failed on test "<<cnt<<ELog::endDiag;
+	  ELog::EM<<"Object == "<<std::get<0>(tc)<<ELog::endDiag;
+	  ELog::EM<<"Box == "<<BBox<<ELog::endDiag;
+	  ELog::EM<<"Expect == "<<LP<<" : "<<HP<<ELog::endDiag;
+	  return -1;
+	}
+      cnt++;
+    }
+
+  // box is set by populate and cut by an added rule
+  A.setObject("13 10 0.05524655 -100");
+  if (A.getBoundBox().isFinite())
+    {
+      ELog::EM<<"Unpopulated box == "<<A.getBoundBox()<<ELog::endDiag;
+      return -2;
+    }
+  A.populate();
+  A.addSurfString(" 1 -2 3 -4 5 -6");
+  const Qhull B(A);                   // copy keeps the box
+  const std::vector<const Qhull*> QVec={&A,&B};
+  for(const Qhull* QPtr : QVec)
+    {
+      const Geometry::BoundBox& BBox=QPtr->getBoundBox();
+      if (BBox.getLow().Distance(Geometry::Vec3D(-1,-1,-1))>1e-3 ||
+	  BBox.getHigh().Distance(Geometry::Vec3D(1,1,1))>1e-3)
+	{
+	  ELog::EM<<"Added rule box == "<<BBox<<ELog::endDiag;
+	  return -3;
+	}
+    }
+  return 0;
+}
+
+int
+testObject::testAddSurfString() 
+  /*!
+    Test the addition of a rule to a populated cell 
+    gives the same cell as the full string and writes
+    the same as re-processing the cell string
+    \retval -1 :: failed 
+    \retval 0 :: success
+  */
+{
+  ELog::RegMethod RegA("testObject","testAddSurfString");
+
+  createSurfaces();
+
+  typedef std::tuple<std::string,std::string,std::string> TTYPE;
+  const std::vector<TTYPE> Tests=
+    {
+      TTYPE("4 10 0.05524655 11 -12 13 -14 15 -16"," #(1 -2 3 -4 5 -6)",
+	    "4 10 0.05524655 11 -12 13 -14 15 -16 #(1 -2 3 -4 5 -6)"),
+      TTYPE("5 10 0.05524655 1 -2 : 11 -1"," 3 -4 5 -6",
+	    "5 10 0.05524655 (1 -2 : 11 -1) 3 -4 5 -6"),
+      TTYPE("6 10 0.05524655 -100 (-31 : -32 : 2)"," 15 -2",
+	    "6 10 0.05524655 -100 (-31 : -32 : 2) 15 -2"),
+      TTYPE("7 10 0.05524655 11 -12 (13 : -14 (15 -16))"," #(1 -2 3) -100",
+	    "7 10 0.05524655 11 -12 (13 : -14 (15 -16)) #(1 -2 3) -100")
+    };
+
+  int cnt(1);
+  for(const TTYPE& tc : Tests)
+    {
+      Qhull A;
+      Qhull B;
+      Qhull C;
+      A.setObject(std::get<0>(tc));
+      A.createSurfaceList();
+      A.isValid(Geometry::Vec3D(0,0,0));
+      C.setObject(A.getHeadRule().isUnion() ?
+		  A.headStr()+" ("+A.cellCompStr()+")"+std::get<1>(tc) :
+		  A.str()+std::get<1>(tc));
+      A.addSurfString(std::get<1>(tc));
+      A.populate();
+      B.setObject(std::get<2>(tc));
+      B.createSurfaceList();
+
+      int flag(A.getDensity()!=B.getDensity());
+      flag+=(A.cellCompStr()!=C.cellCompStr());
+      flag+=(A.getSurfSet()!=B.getSurfSet());
+      flag+=(A.getSurList()!=B.getSurList());
+      for(double x=-4.0;x<4.1;x+=0.5)
+	for(double y=-4.0;y<4.1;y+=0.5)
+	  for(double z=-4.0;z<4.1;z+=1.0)
+	    {
+	      const Geometry::Vec3D Pt(x,y,z);
+	      flag+=(A.isValid(Pt)!=B.isValid(Pt));
+	      flag+=(A.isValid(Pt)!=A.getHeadRule().isValid(Pt));
+	    }
+      if (flag)
+	{
+	  ELog::EM<<"Failed on test "<<cnt<<ELog::endDiag;
+	  ELog::EM<<"A == "<<A.cellCompStr()<<ELog::endDiag;
+	  ELog::EM<<"B == "<<B.cellCompStr()<<ELog::endDiag;
+	  ELog::EM<<"C == "<<C.cellCompStr()<<ELog::endDiag;
+	  return -1;
+	}
+      cnt++;
+    }
+
+  // Repeated inserts against re-processing after each one
+  const std::string Cell("8 10 0.05524655 11 -12 (13 : -14 (15 -16))");
+  const std::vector<std::string> Adds=
+    {
+      " #(1 -2 3 -4 5 -6)"," -100"," (-31 : -32 : 2)",
+      " 15 -16 #(1 -2 3)"," 11 -12"
+    };
+  for(size_t NA=1;NA<=Adds.size();NA++)
+    {
+      Qhull A;
+      Qhull R;
+      A.setObject(Cell);
+      A.createSurfaceList();
+      R.setObject(Cell);
+      for(size_t i=0;i<NA;i++)
+	{
+	  A.addSurfString(Adds[i]);
+	  R.setObject(R.getHeadRule().isUnion() ?
+		      R.headStr()+" ("+R.cellCompStr()+")"+Adds[i] :
+		      R.str()+Adds[i]);
+	}
+      R.createSurfaceList();
+      if (A.cellCompStr()!=R.cellCompStr() ||
+	  A.getSurList()!=R.getSurList())
+	{
+	  ELog::EM<<"Failed on insert "<<NA<<ELog::endDiag;
+	  ELog::EM<<"A == "<<A.cellCompStr()<<ELog::endDiag;
+	  ELog::EM<<"R == "<<R.cellCompStr()<<ELog::endDiag;
+	  return -1;
+	}
+    }
+  return 0;
+}
+
+int
+testObject::testCalcVertex() 
+  /*!
+    Test the vertex calculation against all the
+    surface triples. The points must be the same
+    to the last bit [not the Vec3D tolerance].
+    \retval -1 :: failed 
+    \retval 0 :: success
+  */
+{
+  ELog::RegMethod RegA("testObject","testCalcVertex");
+
+  createSurfaces();
+  // oblique planes : rounding in the plane triples
+  ModelSupport::surfIndex& SurI=ModelSupport::surfIndex::Instance();
+  SurI.createSurface(41,"p 1 0.3 0.1 2.2");
+  SurI.createSurface(42,"p -0.2 1 0.4 1.7");
+  SurI.createSurface(43,"p 0.35 -0.25 1 1.3");
+
+  // cell : number of vertex [0 : not checked]
+  typedef std::tuple<std::string,size_t> TTYPE;
+  const std::vector<TTYPE> Tests=
+    {
+      TTYPE("4 10 0.05524655  1 -2 3 -4 5 -6",8),
+      TTYPE("5 10 0.05524655 11 -12 13 -14 15 -16 #(1 -2 3 -4 5 -6)",56),
+      TTYPE("6 10 0.05524655 -32 15 -16 (-31 : 6)",0),
+      TTYPE("7 10 0.05524655 -100 (-31 : -32 : 2) 15 #(-33 -6)",0),
+      TTYPE("8 10 0.05524655 11 -12 13 -14 15 -16 (21 : -22)",8),
+      TTYPE("9 10 0.05524655 -41 -42 -43 11 13 15",0),
+      TTYPE("10 10 0.05524655 -41 -42 -32 15 -16",0)
+    };
+  
+  int cnt(1);
+  for(const TTYPE& tc : Tests)
+    {
+      Qhull A;
+      A.setObject(std::get<0>(tc));
+      A.calcVertex();
+      const std::vector<Geometry::Vec3D> Out=A.getVertex();
+
+      // all triples
+      std::vector<Geometry::Vec3D> Ref;
+      const std::vector<const Geometry::Surface*>& SL=A.getSurList();
+      for(size_t i=0;i<SL.size();i++)
+	for(size_t j=i+1;j<SL.size();j++)
+	  for(size_t k=j+1;k<SL.size();k++)
+	    {
+	      const std::set<int> ExSN=
+		{SL[i]->getName(),SL[j]->getName(),SL[k]->getName()};
+	      for(const Geometry::Vec3D& Pt : 
+		    SurInter::processPoint(SL[i],SL[j],SL[k]))
+		if (A.getHeadRule().isValid(Pt,ExSN) && Pt.abs()<1e8)
+		  Ref.push_back(Pt);
+	    }
+      int flag(Ref.size()!=Out.size() || 
+	       (std::get<1>(tc) && std::get<1>(tc)!=Out.size()));
+      size_t index;
+      for(index=0;!flag && index<Out.size();index++)
+	flag=(Out[index].X()!=Ref[index].X() ||
+	      Out[index].Y()!=Ref[index].Y() ||
+	      Out[index].Z()!=Ref[index].Z());
+      if (flag)
+	{
+	  ELog::EM<<"Failed on test "<<cnt<<ELog::endDiag;
+	  ELog::EM<<"Vertex == "<<Out.size()<<" "<<Ref.size()<<ELog::endDiag;
+	  if (index && index<=Out.size())
+	    ELog::EM<<std::setprecision(17)<<"Point["<<index-1<<"] "
+		    <<Out[index-1]<<" != "<<Ref[index-1]<<ELog::endDiag;
+	  return -1;
+	}
+      cnt++;
+    }
+  return 0;
+}
+
+int
+testObject::testFlatRule() 
+  /*!
+    Test the compiled rule gives the same results as
+    the rule tree
+    \retval -1 :: failed 
+    \retval 0 :: success
+  */
+{
+  ELog::RegMethod RegA("testObject","testFlatRule");
+
+  createSurfaces();
+  Qhull A;
+
+  const std::vector<std::string> Tests=
+    {
+      "4 10 0.05524655  1 -2 3 -4 5 -6",
+      "5 10 0.05524655 (1 -2 : 11 -1) 3 -4 5 -6",
+      "6 10 0.05524655 11 -12 13 -14 15 -16 #(1 -2 3 -4 5 -6)",
+      "7 10 0.05524655 -100 (-31 : -32 : 2) 15 #(-33 -6)"
+    };
+  const std::vector<int> SNum({1,-2,11,31,-33,100,4});
+  
+  int cnt(1);
+  for(const std::string& tc : Tests)
+    {
+      A.setObject(tc);
+      A.populate();
+      const HeadRule& HR=A.getHeadRule();
+      for(double x=-4.0;x<4.1;x+=0.5)
+	for(double y=-4.0;y<4.1;y+=0.5)
+	  for(double z=-4.0;z<4.1;z+=1.0)
+	    {
+	      const Geometry::Vec3D Pt(x,y,z);
+	      int flag(A.isValid(Pt)!=HR.isValid(Pt));
+	      for(const int SN : SNum)
+		{
+		  flag+=(A.isValid(Pt,SN)!=HR.isValid(Pt,SN));
+		  flag+=(A.isDirectionValid(Pt,SN)!=
+			 HR.isDirectionValid(Pt,SN));
+		  flag+=(A.pairValid(SN,Pt)!=HR.pairValid(SN,Pt));
+		}
+	      if (flag)
+		{
+		  ELog::EM<<"Failed on test "<<cnt<<ELog::endDiag;
+		  ELog::EM<<"Object == "<<tc<<ELog::endDiag;
+		  ELog::EM<<"Point == "<<Pt<<ELog::endDiag;
+		  return -1;
+		}
+	    }
+      cnt++;
+    }
+  return 0;
+}
+
 int
 testObject::testIsValid() 
   /*!
@@ -532,8 +868,10 @@ testObject::testIsOnSide()
 int
 testObject::testTrackCell() 
   /*!
-    Test the track through a cell
+    Test the track through a cell. Also checks that
+    a re-used line visitor gives the same track.
     \retval -1 :: Unable to track
+    \retval -2 :: Re-used visitor differs
     \retval 0 :: success
   */
 {
@@ -569,6 +907,8 @@ testObject::testTrackCell()
   double aDist;
   const Geometry::Surface* SPtr;          // Output surface
   Qhull A;
+  // shared work space [deliberately started on another line]
+  LineIntersectVisit LI(Geometry::Vec3D(10,10,10),Geometry::Vec3D(0,1,0));
 
   int cnt(1);
   for(const TTYPE& tc : Tests)
@@ -593,8 +933,110 @@ testObject::testTrackCell()
 	  ELog::EM<<"Display= "<<TR->display(TNeut.Pos)<<ELog::endDiag;
 	  return -1;
 	}
+      // repeat with the visitor: second pass re-uses the buffers
+      for(size_t i=0;i<2;i++)
+	{
+	  double bDist;
+	  const Geometry::Surface* BPtr;
+	  neutron BNeut(1,std::get<2>(tc),std::get<3>(tc));
+	  const int BN= -A.trackOutCell(BNeut,bDist,BPtr,0,LI);
+	  if (BN!=SN || BPtr!=SPtr ||
+	      std::abs(bDist-aDist)>Geometry::zeroTol)
+	    {
+	      ELog::EM<<"Failed on test "<<cnt<<" pass "<<i<<ELog::endDiag;
+	      ELog::EM<<"Dist= "<<bDist<<" ["<<aDist<<"]"<<ELog::endDiag;
+	      ELog::EM<<"SN= "<<BN<<" ["<<SN<<"]"<<ELog::endDiag;
+	      return -2;
+	    }
+	}
+      cnt++;
+    }
+  return 0;
+}
+
+int
+testObject::testTrackSense() 
+  /*!
+    Test the exit of a cell from tracked surface senses
+    against the point tests
+    \retval -1 :: Different exit
+    \retval 0 :: success
+  */
+{
+  ELog::RegMethod RegA("testObject","testTrackSense");
+
+  createSurfaces();
+
+  // Object : startSurf : Start point
+  typedef std::tuple<std::string,int,Geometry::Vec3D> TTYPE;
+  const std::vector<TTYPE> Tests=
+    {
+      TTYPE("4 10 0.05 11 -12 13 -14 15 -16 (-1:2:-3:4:-5:6)",0,
+	    Geometry::Vec3D(-2,0,0)),
+      TTYPE("4 10 0.05 11 -12 13 -14 15 -16 (-1:2:-3:4:-5:6)",0,
+	    Geometry::Vec3D(2.5,2.5,2.5)),
+      TTYPE("4 10 0.05 11 -12 13 -14 15 -16 (-1:2:-3:4:-5:6)",1,
+	    Geometry::Vec3D(-1,0,0)),
+      TTYPE("5 10 0.05 -32 15 -16",0,Geometry::Vec3D(0.5,0,0)),
+      TTYPE("6 10 0.05 -100 (-11:12:-13:14:-15:16)",0,
+	    Geometry::Vec3D(0,0,10)),
+      TTYPE("6 10 0.05 -100 (-11:12:-13:14:-15:16)",100,
+	    Geometry::Vec3D(0,0,25)),
+      // tangent to 32 along +y
+      TTYPE("7 10 0.05 11 -12 13 -14 15 -16 (32 : -4)",0,
+	    Geometry::Vec3D(2,-2.5,0))
+    };
+  const std::vector<Geometry::Vec3D> Dirs=
+    {
+      Geometry::Vec3D(1,0,0),Geometry::Vec3D(0,1,0),
+      Geometry::Vec3D(0,0,-1),Geometry::Vec3D(-1,0,0),
+      Geometry::Vec3D(1,1,0),Geometry::Vec3D(1,2,3),
+      Geometry::Vec3D(-1,-1,1),Geometry::Vec3D(0.3,-0.7,0.2)
+    };
+
+  LineIntersectVisit LI(Geometry::Vec3D(0,0,0),Geometry::Vec3D(1,0,0));
+  SenseTrack ST;
+  Qhull A;
+
+  int cnt(1);
+  for(const TTYPE& tc : Tests)
+    {
+      A.setObject(std::get<0>(tc));
+      A.createSurfaceList();
+      const int startSurf(std::get<1>(tc));
+      for(const Geometry::Vec3D& D : Dirs)
+	{
+	  const neutron TNeut(1,std::get<2>(tc),D);
+	  double aDist,bDist;
+	  const Geometry::Surface* APtr;
+	  const Geometry::Surface* BPtr;
+	  const int SA=A.trackOutCell(TNeut,aDist,APtr,startSurf,LI);
+	  const int SB=A.trackOutCell(TNeut,bDist,BPtr,startSurf,LI,ST);
+	  if (SA!=SB || APtr!=BPtr || std::abs(aDist-bDist)>1e-12)
+	    {
+	      ELog::EM<<"Failed on test "<<cnt<<" : "<<D<<ELog::endDiag;
+	      ELog::EM<<"Point = "<<TNeut.Pos<<ELog::endDiag;
+	      ELog::EM<<"Dist= "<<bDist<<" ["<<aDist<<"]"<<ELog::endDiag;
+	      ELog::EM<<"SN= "<<SB<<" ["<<SA<<"]"<<ELog::endDiag;
+	      return -1;
+	    }
+	}
       cnt++;
     }
+
+  // Surfaces inserted after the surface list is made
+  const neutron TNeut(1,Geometry::Vec3D(-2,0,0),Geometry::Vec3D(1,0,0));
+  A.setObject("8 10 0.05 11 -12 13 -14 15 -16");
+  A.createSurfaceList();
+  A.addSurfString(" (-1:2:-3:4:-5:6)");
+  double aDist;
+  const Geometry::Surface* APtr;
+  const int SA=A.trackOutCell(TNeut,aDist,APtr,0,LI,ST);
+  if (!APtr || APtr->getName()!=1 || std::abs(aDist-1.0)>1e-12)
+    {
+      ELog::EM<<"Failed on insert : "<<SA<<" "<<aDist<<ELog::endDiag;
+      return -1;
+    }
   return 0;
 }
 
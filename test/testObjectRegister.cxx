@@ -33,6 +33,7 @@
 #include <sstream>
 #include <algorithm>
 #include <memory>
+#include <tuple>
 
 #include "Exception.h"
 #include "FileReport.h"
@@ -53,6 +54,7 @@
 #include "LinkUnit.h"
 #include "FixedComp.h"
 #include "objectRegister.h"
+#include "QueryContext.h"
 
 #include "testFunc.h"
 #include "testObjectRegister.h"
@@ -89,12 +91,14 @@ testObjectRegister::applyTest(const int extra)
   testPtr TPtr[]=
     {
       &testObjectRegister::testExcludeItem,
-      &testObjectRegister::testGetObject
+      &testObjectRegister::testGetObject,
+      &testObjectRegister::testInRange
     };
   const std::string TestName[]=
     {
       "ExcludeItem",
-      "GetObject"
+      "GetObject",
+      "InRange"
     };
   
   const int TSize(sizeof(TPtr)/sizeof(testPtr));
@@ -160,5 +164,68 @@ testObjectRegister::testGetObject()
   return 0;
 }
 
+int
+testObjectRegister::testInRange()
+  /*!
+    Test that the cached range searches and the 
+    query context searches give the same range
+    \retval 0 :: success
+  */
+{
+  ELog::RegMethod RegA("testObjectRegister","testInRange");
+
+  ModelSupport::objectRegister& OR=
+    ModelSupport::objectRegister::Instance();
+
+  // name : size : renumber start
+  typedef std::tuple<std::string,int,int> TTYPE;
+  const std::vector<TTYPE> Units=
+    {
+      TTYPE("testRangeA",100,5000),
+      TTYPE("testRangeB",50,3000),
+      TTYPE("testRangeC",200,7000)
+    };
+  std::vector<int> Start;
+  for(const TTYPE& tc : Units)
+    {
+      Start.push_back(OR.cell(std::get<0>(tc),std::get<1>(tc)));
+      OR.setRenumber(std::get<0>(tc),std::get<2>(tc),
+		     std::get<2>(tc)+std::get<1>(tc));
+    }
+
+  // interior points [ends are shared with the next range]
+  QueryContext QC;
+  QueryContext RQC;
+  for(int i=1;i<50;i++)
+    for(const size_t index : {0,2,0,1,2,2})
+      {
+	const TTYPE& tc=Units[index];
+	const int offset((i*7) % (std::get<1>(tc)-1)+1);
+	const int CN(Start[index]+offset);
+	const int RN(std::get<2>(tc)+offset);
+	if (OR.inRange(CN)!=std::get<0>(tc) ||
+	    OR.inRange(CN,QC)!=std::get<0>(tc) ||
+	    OR.inRenumberRange(RN)!=std::get<0>(tc) ||
+	    OR.inRenumberRange(RN,RQC)!=std::get<0>(tc))
+	  {
+	    ELog::EM<<"Unit "<<std::get<0>(tc)<<" : "<<CN<<" "<<RN
+		    <<ELog::endDiag;
+	    ELog::EM<<"Range "<<OR.inRange(CN)<<" "<<OR.inRange(CN,QC)
+		    <<ELog::endDiag;
+	    ELog::EM<<"Renumber "<<OR.inRenumberRange(RN)<<" "
+		    <<OR.inRenumberRange(RN,RQC)<<ELog::endDiag;
+	    return -1;
+	  }
+      }
+  if (!OR.inRange(-5).empty() || !OR.inRange(-5,QC).empty() ||
+      !OR.inRenumberRange(-5).empty() ||
+      !OR.inRenumberRange(-5,RQC).empty())
+    {
+      ELog::EM<<"Found range for -5"<<ELog::endDiag;
+      return -1;
+    }
+  return 0;
+}
+
 
 
@@ -66,6 +66,8 @@
 #include "LineTrack.h"
 #include "ObjectTrackAct.h"
 #include "ObjectTrackPoint.h"
+#include "SimTrack.h"
+#include "TrackBatch.h"
 
 #include "testFunc.h"
 #include "testObjectTrackAct.h"
@@ -183,10 +185,12 @@ testObjectTrackAct::applyTest(const int extra)
   typedef int (testObjectTrackAct::*testPtr)();
   testPtr TPtr[]=
     {
+      &testObjectTrackAct::testBatch,
       &testObjectTrackAct::testPointDet
     };
   const std::string TestName[]=
     {
+      "Batch",
       "PointDet"
     };
   
@@ -215,6 +219,111 @@ testObjectTrackAct::applyTest(const int extra)
   return 0;
 }
 
+int
+testObjectTrackAct::testBatch()
+  /*!
+    Tests the threaded attenuation tracks are identical
+    to the serial ObjectTrackPoint. The second and third 
+    sets start on cell boundaries : the third runs in
+    the boundary [py 1] so the start cell is set by the
+    cell hint. The fourth repeats the third over several
+    thread blocks, each block starting on the boundary
+    after a point in the Al container. The fifth ends in
+    the boundary [no cell change on the way] and has 
+    boundary points either side of each block start, so 
+    the block seed must be re-tracked.
+    \return 0 on success and -1 on error
+  */
+{
+  ELog::RegMethod RegA("testObjectTrackAct","testBatch");
+
+  SimTrack& ST(SimTrack::Instance());
+
+  typedef std::tuple<Geometry::Vec3D,std::vector<Geometry::Vec3D>> TTYPE;
+  std::vector<TTYPE> Tests;
+
+  std::vector<Geometry::Vec3D> Pts;
+  for(int i=0;i<7;i++)
+    for(int j=0;j<5;j++)
+      for(int k=0;k<5;k++)
+	Pts.push_back(Geometry::Vec3D(-4.1+2.05*i,-3.2+1.55*j,-2.7+1.3*k));
+  Tests.push_back(TTYPE(Geometry::Vec3D(20,0,0),Pts));
+
+  Pts.clear();
+  for(const double X : {-3.0,-1.0,1.0,3.0,10.0})
+    for(int j=0;j<4;j++)
+      Pts.push_back(Geometry::Vec3D(X,-0.9+0.6*j,0.3*j-0.4));
+  Tests.push_back(TTYPE(Geometry::Vec3D(20,0,0),Pts));
+
+  Pts.clear();
+  for(int i=0;i<5;i++)
+    {
+      Pts.push_back(Geometry::Vec3D(-0.8+0.4*i,1,0.2*i-0.5));
+      Pts.push_back(Geometry::Vec3D(-2.5+0.3*i,0.5,0.1*i));
+    }
+  Tests.push_back(TTYPE(Geometry::Vec3D(20,1,0),Pts));
+
+  Pts.clear();
+  for(int i=0;i<80;i++)
+    {
+      const double D(static_cast<double>(i % 5));
+      Pts.push_back(Geometry::Vec3D(-0.8+0.4*D,1,0.2*D-0.5));
+      Pts.push_back(Geometry::Vec3D(-2.5+0.3*D,1.5,0.1*D));
+    }
+  Tests.push_back(TTYPE(Geometry::Vec3D(20,1,0),Pts));
+
+  Pts.clear();
+  for(int i=0;i<160;i++)
+    {
+      const double D(static_cast<double>(i % 5));
+      if (!(i % 2) || (i % 64)==63)
+	Pts.push_back(Geometry::Vec3D(-0.8+0.3*D,1,0.2*D-0.5));
+      else
+	Pts.push_back(Geometry::Vec3D(-2.5+0.3*D,1.5,0.1*D));
+    }
+  Tests.push_back(TTYPE(Geometry::Vec3D(0.9,1,0),Pts));
+
+  int cnt(1);
+  for(const TTYPE& tc : Tests)
+    {
+      const Geometry::Vec3D& TPt(std::get<0>(tc));
+      const std::vector<Geometry::Vec3D>& TP(std::get<1>(tc));
+
+      ST.setCell(&ASim,0);
+      ObjectTrackPoint OA(TPt);
+      std::vector<double> Serial;
+      for(size_t i=0;i<TP.size();i++)
+	{
+	  OA.addUnit(ASim,static_cast<long int>(i),TP[i]);
+	  Serial.push_back(OA.getAttnSum(static_cast<long int>(i)));
+	}
+
+      TrackBatch TB(TPt);
+      for(const size_t NT : {1,4,0})
+	{
+	  std::vector<double> Attn;
+	  ST.setCell(&ASim,0);
+	  TB.setThreads(NT);
+	  TB.calculate(ASim,TP,Attn);
+	  if (Attn.size()!=TP.size())
+	    {
+	      ELog::EM<<"Size "<<Attn.size()<<" != "<<TP.size()<<ELog::endCrit;
+	      return -1;
+	    }
+	  for(size_t i=0;i<TP.size();i++)
+	    if (Attn[i]!=Serial[i])
+	      {
+		ELog::EM<<"Test "<<cnt<<" Threads "<<NT
+			<<" Pt["<<i<<"] "<<TP[i]<<ELog::endDiag;
+		ELog::EM<<"Batch "<<Attn[i]<<" != "<<Serial[i]<<ELog::endCrit;
+		return -1;
+	      }
+	}
+      cnt++;
+    }
+  return 0;
+}
+  
 int
 testObjectTrackAct::testPointDet()
   /*!
@@ -35,6 +35,13 @@
 #include <iterator>
 #include <memory>
 #include <tuple>
+#include <cstdint>
+#include <cstdio>
+#include <sstream>
+#include <boost/multi_array.hpp>
+#ifndef NO_ZLIB
+#include <zlib.h>
+#endif
 
 #include "Exception.h"
 #include "FileReport.h"
@@ -55,6 +62,8 @@
 #include "Surface.h"
 #include "surfIndex.h"
 #include "Quadratic.h"
+#include "Ellipsoid.h"
+#include "Torus.h"
 #include "surfaceFactory.h"
 #include "Rules.h"
 #include "varList.h"
@@ -69,11 +78,24 @@
 #include "Object.h"
 #include "Qhull.h"
 #include "ObjSurfMap.h"
+#include "BoundBox.h"
+#include "ObjBoxTree.h"
+#include "QueryContext.h"
 #include "ReadFunctions.h"
 #include "surfRegister.h"
 #include "ModelSupport.h"
 #include "neutron.h"
+#include "Zaid.h"
+#include "MXcards.h"
+#include "Material.h"
+#include "DBMaterial.h"
 #include "Simulation.h"
+#include "SimValid.h"
+#include "SimSnapShot.h"
+#include "Triple.h"
+#include "Visit.h"
+#include "MatMD5.h"
+#include "MD5sum.h"
 
 #include "testFunc.h"
 #include "testSimulation.h"
@@ -187,15 +209,29 @@ testSimulation::applyTest(const int extra)
   typedef int (testSimulation::*testPtr)();
   testPtr TPtr[]=
     {
+      &testSimulation::testCellTree,
       &testSimulation::testCreateObjSurfMap,
       &testSimulation::testInCell,
-      &testSimulation::testTrackNeutron
+      &testSimulation::testMD5sum,
+      &testSimulation::testQueryContext,
+      &testSimulation::testSimValid,
+      &testSimulation::testSnapShot,
+      &testSimulation::testTrackNeutron,
+      &testSimulation::testVisit,
+      &testSimulation::testVisitStream
     };
   const std::string TestName[]=
     {
+      "CellTree",
       "CreateObjSurfMap",
       "InCell",
-      "TrackNeutron"
+      "MD5sum",
+      "QueryContext",
+      "SimValid",
+      "SnapShot",
+      "TrackNeutron",
+      "Visit",
+      "VisitStream"
     };
   
   const int TSize(sizeof(TPtr)/sizeof(testPtr));
@@ -280,6 +316,50 @@ testSimulation::testTrackNeutron()
             
 }
 
+int
+testSimulation::testCellTree()
+  /*!
+    Test the cell box tree gives the same cell
+    as a linear search [including points on surfaces]
+    \return 0 on success and -ve on error
+  */
+{
+  ELog::RegMethod RegA("testSimulation","testCellTree");
+
+  const Simulation::OTYPE& OMap=
+    static_cast<const Simulation&>(ASim).getCells();
+
+  ModelSupport::ObjBoxTree OBT;
+  OBT.build(OMap);
+
+  for(double x=-27.0;x<27.5;x+=1.0)
+    for(double y=-27.0;y<27.5;y+=1.0)
+      for(double z=-4.0;z<4.5;z+=1.0)
+	{
+	  const Geometry::Vec3D Pt(x,y,z);
+	  MonteCarlo::Object* linearPtr(0);
+	  for(const Simulation::OTYPE::value_type& MC : OMap)
+	    if (!MC.second->isPlaceHold() && MC.second->isValid(Pt))
+	      {
+		linearPtr=MC.second;
+		break;
+	      }
+	  MonteCarlo::Object* treePtr=OBT.findCell(Pt);
+	  if (treePtr!=linearPtr)
+	    {
+	      ELog::EM<<"Failed on point:"<<Pt<<ELog::endDiag;
+	      ELog::EM<<"Linear == "<<((linearPtr) ? linearPtr->getName() : 0)
+		      <<" Tree == "<<((treePtr) ? treePtr->getName() : 0)
+		      <<ELog::endDiag;
+	      ELog::EM<<"Tree == ";
+	      OBT.write(ELog::EM.Estream());
+	      ELog::EM<<ELog::endDiag;
+	      return -1;
+	    }
+	}
+  return 0;
+}
+
 int
 testSimulation::testCreateObjSurfMap()
   /*!
@@ -361,3 +441,474 @@ testSimulation::testInCell()
       
   return 0;
 }
+
+int
+testSimulation::testMD5sum()
+  /*!
+    Test that the MD5sum is the same for different numbers
+    of threads and the same as the serial loop. Each slab 
+    ends in the Al and starts on an edge of the steel box.
+    \return 0 on success and -ve on error
+  */
+{
+  ELog::RegMethod RegA("testSimulation","testMD5sum");
+
+  // slab on x, row on y, point on z
+  const Geometry::Vec3D Origin(-1.75,-1.5,-1.25);
+  const Geometry::Vec3D XYZ(4.5,4.0,3.5);
+  const size_t NX(3),NY(4),NZ(7);
+
+  // serial loop : empty hint at each slab
+  std::vector<MatMD5> Results(60);
+  Geometry::Vec3D aVec;
+  for(size_t i=0;i<NX;i++)
+    {
+      ModelSupport::QueryContext QC;
+      MonteCarlo::Object* ObjPtr(0);
+      aVec[0]=XYZ[0]*((static_cast<double>(i)+0.5)/
+		      static_cast<double>(NX));
+      for(size_t j=0;j<NY;j++)
+	{
+	  aVec[1]=XYZ[1]*((static_cast<double>(j)+0.5)/
+			  static_cast<double>(NY));
+	  for(size_t k=0;k<NZ;k++)
+	    {
+	      aVec[2]=XYZ[2]*((static_cast<double>(k)+0.5)/
+			      static_cast<double>(NZ));
+	      ObjPtr=ASim.findCell(Origin+aVec,ObjPtr,QC);
+	      const size_t matN=(ObjPtr) ? 
+		static_cast<size_t>(ObjPtr->getMat()) : 0;
+	      Results[matN].addUnit(aVec);
+	    }
+	}
+    }
+  std::ostringstream Expect;
+  for(size_t i=0;i<Results.size();i++)
+    if (!Results[i].isEmpty())
+      Expect<<"Mat "<<i<<" "<<Results[i]<<std::endl;
+
+  for(const size_t NT : {1,2,3,0})
+    {
+      MD5sum MTest(60);
+      MTest.setBox(Origin,Origin+XYZ);
+      MTest.setIndex(NX,NY,NZ);
+      MTest.setThreads(NT);
+      MTest.populate(&ASim);
+      std::ostringstream cx;
+      MTest.write(cx);
+      if (cx.str()!=Expect.str())
+	{
+	  ELog::EM<<"Threads : "<<NT<<ELog::endDiag;
+	  ELog::EM<<"Result ==\n"<<cx.str()<<ELog::endDiag;
+	  ELog::EM<<"Expect ==\n"<<Expect.str()<<ELog::endDiag;
+	  return -1;
+	}
+    }
+  return 0;
+}
+
+int
+testSimulation::testQueryContext()
+  /*!
+    Test that findCell with separate contexts gives
+    the same cells as the singleton version, and that
+    a cell change removes the hint
+    \return 0 on success and -ve on error
+  */
+{
+  ELog::RegMethod RegA("testSimulation","testQueryContext");
+
+  std::vector<Geometry::Vec3D> Pts;
+  Pts.push_back(Geometry::Vec3D(0,0,0));
+  Pts.push_back(Geometry::Vec3D(0,26,0));
+  Pts.push_back(Geometry::Vec3D(0,2,0));
+  Pts.push_back(Geometry::Vec3D(12.5,0.3,0));
+  Pts.push_back(Geometry::Vec3D(0,5,0));
+  Pts.push_back(Geometry::Vec3D(0.5,0.5,0.5));
+
+  ModelSupport::QueryContext QCA;
+  ModelSupport::QueryContext QCB;
+  for(size_t i=0;i<Pts.size();i++)
+    {
+      const size_t j(Pts.size()-1-i);
+      const MonteCarlo::Object* APtr=ASim.findCell(Pts[i],0,QCA);
+      const MonteCarlo::Object* BPtr=ASim.findCell(Pts[j],0,QCB);
+      if (APtr!=ASim.findCell(Pts[i],0) ||
+	  BPtr!=ASim.findCell(Pts[j],0) ||
+	  QCA.getCell(ASim.getCellVersion())!=APtr)
+	{
+	  ELog::EM<<"Failed on point:"<<Pts[i]<<" / "<<Pts[j]<<ELog::endDiag;
+	  return -1;
+	}
+    }
+  // Change of cell map removes hint
+  ASim.clearCellTree();
+  if (QCA.getCell(ASim.getCellVersion()))
+    {
+      ELog::EM<<"Hint not cleared on cell change"<<ELog::endDiag;
+      return -2;
+    }
+  return 0;
+}
+
+int
+testSimulation::testSimValid()
+  /*!
+    Test the threaded validation tracking from 
+    several start points
+    \return 0 on success and -ve on error
+  */
+{
+  ELog::RegMethod RegA("testSimulation","testSimValid");
+
+  MonteCarlo::Qhull* OuterPtr=ASim.findQhull(1);
+  OuterPtr->setImp(0);
+  ASim.createObjSurfMap();
+
+  ModelSupport::SimValid SV;
+  SV.setCentre(Geometry::Vec3D(0.1,0.2,0.3));
+  SV.addCentre(Geometry::Vec3D(0,5,0));
+  SV.addCentre(Geometry::Vec3D(12.5,0.3,0));
+
+  // Single / Multi thread
+  const size_t NThread[]={1,4};
+  for(const size_t NT : NThread)
+    {
+      SV.setThreads(NT);
+      if (!SV.run(ASim,5000) || SV.getNFail())
+	{
+	  ELog::EM<<"Failed on threads == "<<NT<<ELog::endDiag;
+	  ELog::EM<<"Number of fails == "<<SV.getNFail()<<ELog::endDiag;
+	  OuterPtr->setImp(1);
+	  return -1;
+	}
+    }
+  OuterPtr->setImp(1);
+  return 0;
+}
+
+int
+testSimulation::testSnapShot()
+  /*!
+    Write the geometry to a snapshot and read it into
+    a new simulation. The surfaces, cell rules and 
+    materials must be unchanged. An ellipsoid has no
+    snapshot form and must throw.
+    \return 0 on success and -ve on error
+  */
+{
+  ELog::RegMethod RegA("testSimulation","testSnapShot");
+
+  ModelSupport::surfIndex& SurI=ModelSupport::surfIndex::Instance();
+  ModelSupport::DBMaterial& DB=ModelSupport::DBMaterial::Instance();
+  const std::string FName("testSnapShot.bin");
+
+  // one of each surface with a snapshot form
+  const std::vector<std::string> SurfExtra=
+    {
+      "c/y 1 2 3","k/z 0 0 4 0.3","gq 1 2 3 0 0 0 0 0 0 -10",
+      "e/z 1 1 2 1","rcc 0 0 0 0 0 5 2",
+      "rpp -1 1 -2 2 -3 3",
+      "arb -1 -1 -1 1 -1 -1 1 1 -1 -1 1 -1 "
+      "-1 -1 1 1 -1 1 1 1 1 -1 1 1 1234 5678 1265 2376 3487 4158"
+    };
+  int SN(200);
+  for(const std::string& SL : SurfExtra)
+    if (SurI.createSurface(SN++,SL))
+      {
+	ELog::EM<<"Failed to create "<<SL<<ELog::endDiag;
+	return -1;
+      }
+  // torus string is not read : set directly
+  Geometry::Torus* TPtr=new Geometry::Torus();
+  TPtr->setName(SN);
+  TPtr->setCentre(Geometry::Vec3D(0,0,1));
+  TPtr->setNormal(Geometry::Vec3D(0,0,1));
+  TPtr->setIRad(5.0);
+  TPtr->setORad(1.0);
+  SurI.insertSurface(TPtr);
+  ASim.addCell(MonteCarlo::Qhull(6,0,0.0," 201 -202 203 -204 205"));
+  
+  const std::vector<int> MatN({3,5,8});
+  std::map<int,std::string> SurfOut;
+  std::map<int,std::string> CellOut;
+  std::map<int,std::string> MatOut;
+  for(const ModelSupport::surfIndex::STYPE::value_type& SV : SurI.surMap())
+    {
+      std::ostringstream cx;
+      SV.second->write(cx);
+      SurfOut.emplace(SV.first,SV.second->className()+" "+cx.str());
+    }
+  for(const Simulation::OTYPE::value_type& OV : ASim.getCells())
+    CellOut.emplace(OV.first,OV.second->getHeadRule().display());
+  for(const int MN : MatN)
+    {
+      std::ostringstream cx;
+      DB.getMaterial(MN).write(cx);
+      MatOut.emplace(MN,cx.str());
+    }
+
+  SimProcess::writeSnapShot(ASim,FName);
+
+  // the load must replace a changed material
+  MonteCarlo::Material MChange(DB.getMaterial(5));
+  MChange*=0.5;
+  DB.resetMaterial(MChange);
+
+  Simulation BSim;
+  SimProcess::readSnapShot(BSim,FName);
+  std::remove(FName.c_str());
+
+  int retVal(0);
+  if (SurI.surMap().size()!=SurfOut.size() ||
+      BSim.getCells().size()!=CellOut.size())
+    {
+      ELog::EM<<"Surfaces "<<SurI.surMap().size()<<" : "
+	      <<SurfOut.size()<<ELog::endDiag;
+      ELog::EM<<"Cells "<<BSim.getCells().size()<<" : "
+	      <<CellOut.size()<<ELog::endDiag;
+      retVal=-1;
+    }
+  for(const ModelSupport::surfIndex::STYPE::value_type& SV : SurI.surMap())
+    {
+      std::ostringstream cx;
+      SV.second->write(cx);
+      const std::string Out(SV.second->className()+" "+cx.str());
+      if (!retVal && SurfOut[SV.first]!=Out)
+	{
+	  ELog::EM<<"Surface "<<SV.first<<ELog::endDiag;
+	  ELog::EM<<"Expect == "<<SurfOut[SV.first]<<ELog::endDiag;
+	  ELog::EM<<"Result == "<<Out<<ELog::endDiag;
+	  retVal=-2;
+	}
+    }
+  for(const Simulation::OTYPE::value_type& OV : BSim.getCells())
+    if (!retVal && CellOut[OV.first]!=OV.second->getHeadRule().display())
+      {
+	ELog::EM<<"Cell "<<OV.first<<ELog::endDiag;
+	ELog::EM<<"Expect == "<<CellOut[OV.first]<<ELog::endDiag;
+	ELog::EM<<"Result == "<<OV.second->getHeadRule().display()
+		<<ELog::endDiag;
+	retVal=-3;
+      }
+  for(const int MN : MatN)
+    {
+      std::ostringstream cx;
+      DB.getMaterial(MN).write(cx);
+      if (!retVal && MatOut[MN]!=cx.str())
+	{
+	  ELog::EM<<"Material "<<MN<<ELog::endDiag;
+	  ELog::EM<<"Expect == "<<MatOut[MN]<<ELog::endDiag;
+	  ELog::EM<<"Result == "<<cx.str()<<ELog::endDiag;
+	  retVal=-4;
+	}
+    }
+
+  if (!retVal)
+    {
+      Geometry::Ellipsoid* EPtr=new Geometry::Ellipsoid(300,0);
+      EPtr->setEllipsoid(Geometry::Vec3D(0,0,0),Geometry::Vec3D(1,0,0),
+			 Geometry::Vec3D(0,1,0),3.0,2.0,1.0);
+      SurI.insertSurface(EPtr);
+      try
+	{
+	  SimProcess::writeSnapShot(BSim,FName);
+	  ELog::EM<<"Ellipsoid written to snapshot"<<ELog::endDiag;
+	  retVal=-5;
+	}
+      catch (ColErr::AbsObjMethod&)
+	{ }
+      std::remove(FName.c_str());
+    }
+  // the surface index now holds the BSim surfaces
+  initSim();
+  return retVal;
+}
+
+int
+testSimulation::testVisit()
+  /*!
+    Test that the VTK mesh is the same in point and
+    line-track mode and for different numbers of threads
+    \return 0 on success and -ve on error
+  */
+{
+  ELog::RegMethod RegA("testSimulation","testVisit");
+
+  // half-integer points : not on any surface
+  Visit VBase;
+  VBase.setType(Visit::VISITenum::cellID);
+  VBase.setBox(Geometry::Vec3D(-26.5,-26.5,-26.5),
+	       Geometry::Vec3D(25.5,25.5,25.5));
+  VBase.setIndex(26,26,26);
+  VBase.setThreads(1);
+  VBase.populate(&ASim);
+  const boost::multi_array<double,3>& BMesh=VBase.getMesh();
+
+  typedef std::tuple<size_t,int> TTYPE;
+  const std::vector<TTYPE> Tests=
+    {
+      TTYPE(3,0),TTYPE(1,1),TTYPE(3,1)
+    };
+
+  for(const TTYPE& tc : Tests)
+    {
+      Visit VTest(VBase);
+      VTest.setThreads(std::get<0>(tc));
+      VTest.setLineTrack(std::get<1>(tc));
+      VTest.populate(&ASim);
+      const boost::multi_array<double,3>& TMesh=VTest.getMesh();
+      for(size_t i=0;i<26;i++)
+	for(size_t j=0;j<26;j++)
+	  for(size_t k=0;k<26;k++)
+	    if (std::abs(BMesh[i][j][k]-TMesh[i][j][k])>1e-5)
+	      {
+		ELog::EM<<"Test : "<<std::get<0>(tc)<<" "
+			<<std::get<1>(tc)<<ELog::endDiag;
+		ELog::EM<<"Index : "<<i<<" "<<j<<" "<<k<<" :: "
+			<<BMesh[i][j][k]<<" != "<<TMesh[i][j][k]
+			<<ELog::endDiag;
+		return -1;
+	      }
+    }
+  return 0;
+}
+
+int
+testSimulation::testVisitStream()
+  /*!
+    Test that the streamed VTK output [ascii/binary/vti]
+    holds the same values as the populated mesh
+    \return 0 on success and -ve on error
+  */
+{
+  ELog::RegMethod RegA("testSimulation","testVisitStream");
+
+  const size_t NX(26),NY(13),NZ(2);
+  Visit VBase;
+  VBase.setType(Visit::VISITenum::cellID);
+  VBase.setBox(Geometry::Vec3D(-26.5,-26.5,-26.5),
+	       Geometry::Vec3D(25.5,25.5,25.5));
+  VBase.setIndex(NX,NY,NZ);
+  VBase.setThreads(1);
+  VBase.populate(&ASim);
+  const boost::multi_array<double,3>& BMesh=VBase.getMesh();
+
+  const std::string FName("testVisitStream.vtk");
+  auto readFile=[&FName]() -> std::string
+    {
+      std::ifstream IX(FName.c_str(),std::ios::in | std::ios::binary);
+      std::ostringstream cx;
+      cx<<IX.rdbuf();
+      return cx.str();
+    };
+  // compare floats [x fastest] with the mesh
+  auto checkMesh=[&](const char* DPtr,const bool swapFlag) -> int
+    {
+      for(size_t k=0;k<NZ;k++)
+	for(size_t j=0;j<NY;j++)
+	  for(size_t i=0;i<NX;i++)
+	    {
+	      float F;
+	      char* FPtr(reinterpret_cast<char*>(&F));
+	      if (swapFlag)
+		std::reverse_copy(DPtr,DPtr+sizeof(float),FPtr);
+	      else
+		std::copy(DPtr,DPtr+sizeof(float),FPtr);
+	      DPtr+=sizeof(float);
+	      if (std::abs(F-BMesh[i][j][k])>1e-5)
+		{
+		  ELog::EM<<"Index : "<<i<<" "<<j<<" "<<k<<" :: "
+			  <<BMesh[i][j][k]<<" != "<<F<<ELog::endDiag;
+		  return -1;
+		}
+	    }
+      return 0;
+    };
+  const uint32_t one(1);
+  const bool bigHost(*reinterpret_cast<const unsigned char*>(&one)==0);
+  const size_t NBytes(sizeof(float)*NX*NY*NZ);
+  const std::set<std::string> Empty;
+
+  Visit VTest(VBase);
+  VTest.setThreads(3);
+
+  // ASCII : identical to writeVTK
+  VBase.writeVTK(FName);
+  const std::string ABase=readFile();
+  VTest.setFormat(Visit::VTKformat::ascii);
+  VTest.writeStream(&ASim,Empty,FName);
+  if (readFile()!=ABase)
+    {
+      ELog::EM<<"ASCII stream differs from writeVTK"<<ELog::endDiag;
+      return -1;
+    }
+
+  // legacy binary : big-endian floats after the header
+  VTest.setFormat(Visit::VTKformat::binary);
+  VTest.writeStream(&ASim,Empty,FName);
+  std::string Out=readFile();
+  const std::string LTable("LOOKUP_TABLE default\n");
+  size_t pos=Out.find(LTable);
+  if (pos==std::string::npos || Out.size()!=pos+LTable.size()+NBytes ||
+      checkMesh(Out.data()+pos+LTable.size(),!bigHost))
+    {
+      ELog::EM<<"Binary VTK failed"<<ELog::endDiag;
+      return -1;
+    }
+
+  // vti : UInt64 byte count and native floats after '_'
+  VTest.setFormat(Visit::VTKformat::vti);
+  VTest.writeStream(&ASim,Empty,FName);
+  Out=readFile();
+  pos=Out.find("   _");
+  uint64_t NCount(0);
+  if (pos!=std::string::npos)
+    std::copy(Out.data()+pos+4,Out.data()+pos+4+sizeof(uint64_t),
+	      reinterpret_cast<char*>(&NCount));
+  if (pos==std::string::npos || NCount!=NBytes ||
+      checkMesh(Out.data()+pos+4+sizeof(uint64_t),0))
+    {
+      ELog::EM<<"VTI failed : "<<NCount<<ELog::endDiag;
+      return -1;
+    }
+
+#ifndef NO_ZLIB
+  // compressed vti : one zlib block per z-plane
+  VTest.setFormat(Visit::VTKformat::vtiZ);
+  VTest.writeStream(&ASim,Empty,FName);
+  Out=readFile();
+  pos=Out.find("   _");
+  if (pos==std::string::npos)
+    {
+      ELog::EM<<"VTI [zlib] : no appended data"<<ELog::endDiag;
+      return -1;
+    }
+  std::vector<uint64_t> ZHead(3+NZ);
+  const char* ZPtr(Out.data()+pos+4);
+  std::copy(ZPtr,ZPtr+sizeof(uint64_t)*ZHead.size(),
+	    reinterpret_cast<char*>(ZHead.data()));
+  ZPtr+=sizeof(uint64_t)*ZHead.size();
+  std::vector<char> Data(NBytes);
+  for(size_t k=0;k<NZ;k++)
+    {
+      uLongf DLen(static_cast<uLongf>(ZHead[1]));
+      if (uncompress(reinterpret_cast<Bytef*>(Data.data()+k*ZHead[1]),
+		     &DLen,reinterpret_cast<const Bytef*>(ZPtr),
+		     static_cast<uLong>(ZHead[3+k]))!=Z_OK)
+	{
+	  ELog::EM<<"VTI [zlib] : bad block "<<k<<ELog::endDiag;
+	  return -1;
+	}
+      ZPtr+=ZHead[3+k];
+    }
+  if (ZHead[0]!=NZ || ZHead[1]*NZ!=NBytes || checkMesh(Data.data(),0))
+    {
+      ELog::EM<<"VTI [zlib] failed"<<ELog::endDiag;
+      return -1;
+    }
+#endif
+
+  std::remove(FName.c_str());
+  return 0;
+}
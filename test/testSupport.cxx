@@ -31,6 +31,8 @@
 #include <string>
 #include <algorithm>
 #include <tuple>
+#include <sstream>
+#include <functional>
 
 #ifndef NO_REGEX
 #include <boost/regex.hpp>
@@ -46,6 +48,7 @@
 #include "support.h"
 #include "stringCombine.h"
 #include "regexSupport.h"
+#include "blockWrite.h"
 
 #include "testFunc.h"
 #include "testSupport.h"
@@ -91,7 +94,9 @@ testSupport::applyTest(const int extra)
       &testSupport::testStrFullCut,
       &testSupport::testStrParts,
       &testSupport::testStrRemove,
-      &testSupport::testStrSplit
+      &testSupport::testStrSplit,
+      &testSupport::testWriteBlocks,
+      &testSupport::testWriteControl
     };
 
   const std::string TestName[]=
@@ -109,7 +114,9 @@ testSupport::applyTest(const int extra)
       "StrFullCut",
       "StrParts",
       "StrRemove",
-      "StrSplit"
+      "StrSplit",
+      "WriteBlocks",
+      "WriteControl"
     };
 
   const int TSize(sizeof(TPtr)/sizeof(testPtr));
@@ -853,3 +860,166 @@ testSupport::testStrSplit()
 
   return 0;
 }
+
+void
+testSupport::substrControl(const std::string& Line,std::ostream& OX,
+			   const size_t LNmax,int insertDepth)
+  /*!
+    The sub-string form of StrFunc::writeControl that 
+    the single pass version replaced [reference output]
+    \param Line :: full MCNPX line
+    \param OX :: ostream to write to
+    \param LNmax :: Maximium char count in a line
+    \param insertDepth :: second line insert depth [-ve to include first line]
+  */
+{
+  size_t spcLen(0);
+  if (insertDepth<0)
+    {
+      insertDepth *= -1;
+      spcLen=static_cast<size_t>(insertDepth);
+    }
+
+  std::string::size_type pos(0);
+  std::string X=Line.substr(0,LNmax-spcLen);    
+  std::string::size_type posB=X.find_last_of(" ,");
+  while(X.length() == LNmax-spcLen &&
+	posB!=std::string::npos)
+    {
+      pos+=posB+1;
+      if (!isspace(X[posB])) posB++;  // skip pass comma 
+      X=fullBlock(X.substr(0,posB));
+      if (!isEmpty(X))
+	OX<<std::string(spcLen,' ')<<X<<std::endl;
+
+      spcLen=static_cast<size_t>(insertDepth);
+      X=Line.substr(pos,LNmax-spcLen);
+      posB=X.find_last_of(" ,");
+    }
+    
+  X=fullBlock(X);
+  if (!isEmpty(X))
+    OX<<std::string(spcLen,' ')<<X<<std::endl;
+  return;
+}
+
+int
+testSupport::testWriteBlocks()
+  /*!
+    Test that the threaded block writer gives the
+    same output as writing each item in turn
+    \return -1 on error 
+  */
+{
+  ELog::RegMethod RegA("testSupport","testWriteBlocks");  
+
+  // items of varying length : long ones wrap
+  const StrFunc::itemWriter WFunc=
+    [](const size_t index,std::ostream& OS)
+    {
+      std::ostringstream cx;
+      cx<<index<<" 0 ";
+      for(size_t i=0;i<(index*7) % 40;i++)
+	cx<<" "<<index*i;
+      StrFunc::writeMCNPX(cx.str(),OS);
+    };
+
+  // nItem : blockSize
+  typedef std::tuple<size_t,size_t> TTYPE;
+  const std::vector<TTYPE> Tests=
+    {
+      TTYPE(0,64),TTYPE(1,64),TTYPE(5,1),TTYPE(130,3),
+      TTYPE(130,64),TTYPE(200,200)
+    };
+  
+  int cnt(1);
+  for(const TTYPE& tc : Tests)
+    {
+      const size_t nItem(std::get<0>(tc));
+      const size_t blockSize(std::get<1>(tc));
+      std::ostringstream Serial;
+      for(size_t i=0;i<nItem;i++)
+	WFunc(i,Serial);
+
+      for(const size_t NT : {1,2,4,0})
+	{
+	  std::ostringstream cx;
+	  StrFunc::writeBlocks(cx,NT,nItem,blockSize,WFunc);
+	  const std::vector<std::string> Out=StrFunc::formatBlocks
+	    (NT,nItem,blockSize,2,
+	     [&WFunc](const size_t index,const std::vector<std::ostream*>& OS)
+	     {
+	       WFunc(index,*OS[0]);
+	       *OS[1]<<index<<"\n";
+	     });
+	  if (cx.str()!=Serial.str() || Out.size()!=2 ||
+	      Out[0]!=Serial.str())
+	    {
+	      ELog::EM<<"Test "<<cnt<<" Threads "<<NT<<ELog::endDiag;
+	      ELog::EM<<"Serial ==\n"<<Serial.str()<<ELog::endDiag;
+	      ELog::EM<<"Blocks ==\n"<<cx.str()<<ELog::endDiag;
+	      return -1;
+	    }
+	}
+      cnt++;
+    }
+  return 0;
+}
+
+int
+testSupport::testWriteControl()
+  /*!
+    Test the single pass writeControl against the 
+    sub-string version at the line length edges
+    \return -1 on error 
+  */
+{
+  ELog::RegMethod RegA("testSupport","testWriteControl");  
+
+  const std::string A70(70,'a');
+  const std::string A72(72,'a');
+  std::vector<std::string> Lines=
+    {
+      "","   "," 1 2 3 ",A72,A72+" ",A72+"b",A72+",b",
+      A70+" b",A70+"b c",A70+"bc d",A70+",,",A70+", x",
+      " "+A72+" ",A70+"  \t  x",A72+A72+" 1",
+      "1 "+A72+A72,A70+"b "+A70+"c "+A70
+    };
+  // runs of words/commas/spaces of every length 
+  unsigned int seed(7);
+  for(size_t i=0;i<300;i++)
+    {
+      std::string Line;
+      const size_t len(60+i % 200);
+      while(Line.size()<len)
+	{
+	  seed=seed*1103515245U+12345U;
+	  const unsigned int R((seed>>16) % 10);
+	  Line+= (R<6) ? 'x' : ((R<8) ? ' ' : ((R<9) ? ',' : '\t'));
+	}
+      Lines.push_back(Line);
+    }
+
+  int cnt(1);
+  for(const std::string& Line : Lines)
+    {
+      for(const int depth : {-8,-5,5,8})
+	for(const size_t LNmax : {72,80})
+	  {
+	    std::ostringstream Res;
+	    std::ostringstream Expect;
+	    StrFunc::writeControl(Line,Res,LNmax,depth);
+	    substrControl(Line,Expect,LNmax,depth);
+	    if (Res.str()!=Expect.str())
+	      {
+		ELog::EM<<"Line "<<cnt<<" :: "<<depth<<" "
+			<<LNmax<<"\n"<<Line<<ELog::endDiag;
+		ELog::EM<<"Result ==\n"<<Res.str()<<ELog::endDiag;
+		ELog::EM<<"Expect ==\n"<<Expect.str()<<ELog::endDiag;
+		return -1;
+	      }
+	  }
+      cnt++;
+    }
+  return 0;
+}
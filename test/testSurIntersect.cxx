@@ -97,7 +97,8 @@ testSurIntersect::applyTest(const int extra)
       &testSurIntersect::testCylPlaneIntersect,
       &testSurIntersect::testMakePoint_Quad,
       &testSurIntersect::testNearPoint,
-      &testSurIntersect::testProcessPoint
+      &testSurIntersect::testProcessPoint,
+      &testSurIntersect::testSpecialPoint
     };
 
   const std::string TestName[]=
@@ -105,7 +106,8 @@ testSurIntersect::applyTest(const int extra)
       "CylPlaneIntersect",
       "MakePoint(quadratic)",
       "nearPoint",
-      "ProcessPoint"
+      "ProcessPoint",
+      "SpecialPoint"
     };
 
   const int TSize(sizeof(TPtr)/sizeof(testPtr));
@@ -390,6 +392,81 @@ testSurIntersect::testProcessPoint()
   return 0;
 }
 
+int
+testSurIntersect::testSpecialPoint()
+  /*!
+    Test the closed form intersections of three surfaces
+    against the general solver
+    \retval 0 :: success
+  */
+{
+  ELog::RegMethod RegA("testSurInterSect","testSpecialPoint");
+
+  Geometry::Plane TA(1,0),TB(2,0);
+  Geometry::Sphere SA(11,0),SB(12,0),SC(13,0);
+  Geometry::Cylinder CX(21,0),CY(22,0),CZ(23,0),CZA(24,0),CZB(25,0);
+  TA.setSurface("pz 1");
+  TB.setSurface("px 0.5");
+  SA.setSurface("so 5");
+  SB.setSurface("s 3 0 0 4");
+  SC.setSurface("s 0 3 0 4.5");
+  CX.setSurface("cx 4");
+  CY.setSurface("cy 4");
+  CZ.setSurface("cz 4");
+  CZA.setSurface("c/z 2 0 4");
+  CZB.setSurface("cz 3");
+
+  typedef std::tuple<const Geometry::Quadratic*,const Geometry::Quadratic*,
+		     const Geometry::Quadratic*,size_t> TTYPE;
+  const std::vector<TTYPE> Tests=
+    {
+      TTYPE(&TA,&SA,&SB,2),      // plane/sphere/sphere
+      TTYPE(&SA,&SB,&SC,2),      // sphere/sphere/sphere
+      TTYPE(&TA,&CX,&CY,4),      // orthogonal cylinders
+      TTYPE(&TA,&CZ,&CZA,2),     // parallel cylinders
+      TTYPE(&TA,&CZ,&CZB,0),     // coaxial cylinders
+      TTYPE(&TB,&CY,&SA,4)       // cylinder in plane + sphere
+    };
+
+  int cnt(1);
+  for(const TTYPE& tc : Tests)
+    {
+      const Geometry::Quadratic* QVec[3]=
+	{ std::get<0>(tc),std::get<1>(tc),std::get<2>(tc) };
+      std::vector<Geometry::Vec3D> Out;
+      if (!SurInter::specialPoint(QVec[0],QVec[1],QVec[2],Out))
+	{
+	  ELog::EM<<"Test "<<cnt<<" not processed as special"<<ELog::endDiag;
+	  return -cnt;
+	}
+      const std::vector<Geometry::Vec3D> GOut=
+	SurInter::makePoint(QVec[0],QVec[1],QVec[2]);
+      int flag(Out.size()!=std::get<3>(tc) || GOut.size()!=Out.size());
+      for(const Geometry::Vec3D& Pt : Out)
+	{
+	  for(size_t i=0;i<3;i++)
+	    if (std::abs(QVec[i]->distance(Pt))>1e-8)
+	      flag++;
+	  if (std::find_if(GOut.begin(),GOut.end(),
+			   [&Pt](const Geometry::Vec3D& GPt)
+			   { return Pt.Distance(GPt)<1e-6; })==GOut.end())
+	    flag++;
+	}
+      if (flag)
+	{
+	  ELog::EM<<"Test "<<cnt<<ELog::endDiag;
+	  for(const Geometry::Vec3D& Pt : Out)
+	    ELog::EM<<"Pt == "<<Pt<<ELog::endDiag;
+	  for(const Geometry::Vec3D& Pt : GOut)
+	    ELog::EM<<"makePoint == "<<Pt<<ELog::endDiag;
+	  return -cnt;
+	}
+      cnt++;
+    }
+
+  return 0;
+}
+
 int
 testSurIntersect::testCylPlaneIntersect()
   /*!
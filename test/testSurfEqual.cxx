@@ -112,13 +112,15 @@ testSurfEqual::applyTest(const int extra)
   testPtr TPtr[]=
     {
       &testSurfEqual::testBasicPair,
-      &testSurfEqual::testEqualSurfNum
+      &testSurfEqual::testEqualSurfNum,
+      &testSurfEqual::testHashEqual
     };
 
   const std::string TestName[]=
     {
       "BasicPair",
-      "EqualSurfNum"
+      "EqualSurfNum",
+      "HashEqual"
     };
 
   const int TSize(sizeof(TPtr)/sizeof(testPtr));
@@ -208,3 +210,66 @@ testSurfEqual::testEqualSurfNum()
   return 0;
 }
 
+
+int
+testSurfEqual::testHashEqual()
+  /*!
+    Test the hashed equal/opposite search. Includes
+    surfaces that are pending and values that are 
+    on the edge of a hash cell.
+    \return -ve on error 
+  */
+{
+  ELog::RegMethod RegA("testSurfEqual","testHashEqual");
+
+  ModelSupport::surfIndex& SurI=ModelSupport::surfIndex::Instance();
+  Geometry::surfaceFactory& SF=Geometry::surfaceFactory::Instance();
+
+  // not indexed until the next search
+  SurI.createSurface(21,"cz 5");
+  SurI.createSurface(22,"so 4");
+  SurI.createSurface(23,"px 0.0019999999999");
+  // indexed on insertion
+  Geometry::Surface* APtr=SF.processLine("c/z 0 3 5");
+  APtr->setName(31);
+  if (SurI.addSurface(APtr)!=APtr)
+    {
+      ELog::EM<<"Failed to add c/z 0 3 5"<<ELog::endDiag;
+      return -1;
+    }
+
+  // surface : equal surface : opposite surface [0 none]
+  typedef std::tuple<std::string,int,int> TTYPE;
+  const std::vector<TTYPE> Tests=
+    {
+      TTYPE("px -1",1,11),
+      TTYPE("px 1.000000000001",2,0),
+      TTYPE("p -1 0 0 1",11,1),
+      TTYPE("cz 5",21,0),
+      TTYPE("c/z 0 0 5",21,0),
+      TTYPE("cz 5.1",0,0),
+      TTYPE("so 4",22,0),
+      TTYPE("px 0.002",23,0),
+      TTYPE("c/z 0 3 5",31,0),
+      TTYPE("c/z 0 3.1 5",0,0)
+    };
+
+  for(const TTYPE& tc : Tests)
+    {
+      std::unique_ptr<Geometry::Surface> 
+	SPtr(SF.processLine(std::get<0>(tc)));
+      SPtr->setName(9999);
+      const int eqN=ModelSupport::equalSurfNum(SPtr.get());
+      const int oppN=SurI.findOpposite(SPtr.get());
+      const int expectN=(std::get<1>(tc)) ? std::get<1>(tc) : 9999;
+      if (eqN!=expectN || oppN!=std::get<2>(tc))
+	{
+	  ELog::EM<<"Surface : "<<std::get<0>(tc)<<ELog::endDiag;
+	  ELog::EM<<"Equal : "<<eqN<<" ("<<expectN<<")"<<ELog::endDiag;
+	  ELog::EM<<"Opposite : "<<oppN<<" ("
+		  <<std::get<2>(tc)<<")"<<ELog::endDiag;
+	  return -1;
+	}
+    }
+  return 0;
+}
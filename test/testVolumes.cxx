@@ -34,6 +34,7 @@
 #include <numeric>
 #include <iterator>
 #include <memory>
+#include <tuple>
 
 #include "Exception.h"
 #include "FileReport.h"
@@ -41,6 +42,7 @@
 #include "NameStack.h"
 #include "RegMethod.h"
 #include "OutputLog.h"
+#include "MersenneTwister.h"
 #include "BaseVisit.h"
 #include "BaseModVisit.h"
 #include "mathSupport.h"
@@ -70,10 +72,13 @@
 #include "volUnit.h"
 #include "VolSum.h"
 #include "Volumes.h"
+#include "AnalyticVolume.h"
 
 #include "testFunc.h"
 #include "testVolumes.h"
 
+extern MTRand RNG;
+
 using namespace ModelSupport;
 
 testVolumes::testVolumes() 
@@ -138,6 +143,11 @@ testVolumes::createSurfaces()
   // Sphere :
   SurI.createSurface(101,"so 6.0");
   SurI.createSurface(102,"s 7.0 0.0 0.0 3.0");
+
+  // Cylinders / oblique plane :
+  SurI.createSurface(201,"cx 2.0");
+  SurI.createSurface(202,"cx 1.0");
+  SurI.createSurface(203,"p 1 1 0 0");
   
   return;
 }
@@ -206,11 +216,15 @@ testVolumes::applyTest(const int extra)
   typedef int (testVolumes::*testPtr)();
   testPtr TPtr[]=
     {
+      &testVolumes::testAdaptiveRun,
+      &testVolumes::testAnalyticVolume,
       &testVolumes::testPointVolume,
       &testVolumes::testVolume
     };
   const std::string TestName[]=
     {
+      "AdaptiveRun",
+      "AnalyticVolume",
       "PointVolume",
       "Volume"
     };
@@ -238,6 +252,127 @@ testVolumes::applyTest(const int extra)
   return 0;
 }
 
+int
+testVolumes::testAdaptiveRun()
+  /*!
+    Test the threaded point volume for each sampling type
+    \return 0 on success and -ve on error
+  */
+{
+  ELog::RegMethod RegA("testVolumes","testAdaptiveRun");
+
+  const double sphereVol(4.0*M_PI*6.0*6.0*6.0/3.0);
+  // tally : cell : volume
+  typedef std::tuple<int,int,double> TTYPE;
+  const std::vector<TTYPE> Tests=
+    {
+      TTYPE(4,2,sphereVol),
+      TTYPE(5,3,16.0*16.0*16.0-sphereVol)
+    };
+
+  const std::vector<std::string> SampleType=
+    {"random","stratified","sobol"};
+
+  for(const std::string& ST : SampleType)
+    {
+      std::vector<double> VolOut[2];
+      for(size_t NT=1;NT<4;NT+=2)
+	{
+	  VolSum VTally(Geometry::Vec3D(0,0,0),Geometry::Vec3D(16.0,16.0,16.0));
+	  for(const TTYPE& tc : Tests)
+	    VTally.addTallyCell(std::get<0>(tc),std::get<1>(tc));
+	  VTally.setThreads(NT);
+	  VTally.setSampling(ST);
+	  RNG.seed(123456U);
+	  VTally.adaptiveRun(ASim,2000000,0.005);
+	  
+	  for(const TTYPE& tc : Tests)
+	    {
+	      const double V=VTally.calcVolume(std::get<0>(tc));
+	      const double E=VTally.calcError(std::get<0>(tc));
+	      if (E>0.005 || 
+		  std::abs(V-std::get<2>(tc))>4.0*E*std::get<2>(tc))
+		{
+		  ELog::EM<<"Sample "<<ST<<" Threads "<<NT<<ELog::endDiag;
+		  ELog::EM<<"Volume["<<std::get<0>(tc)<<"] == "<<V
+			  <<" +/- "<<V*E<<" ["<<std::get<2>(tc)<<"]"
+			  <<ELog::endDiag;
+		  return -1;
+		}
+	      VolOut[NT/2].push_back(V);
+	    }
+	}
+      if (VolOut[0]!=VolOut[1])
+	{
+	  ELog::EM<<"Sample "<<ST<<" depends on thread count"<<ELog::endDiag;
+	  return -2;
+	}
+    }
+  return 0;
+}
+
+int
+testVolumes::testAnalyticVolume()
+  /*!
+    Test the exact volume of plane / cylinder cells
+    \return 0 on success and -ve on error
+  */
+{
+  ELog::RegMethod RegA("testVolumes","testAnalyticVolume");
+
+  // cell string : exact flag : volume
+  typedef std::tuple<std::string,int,double> TTYPE;
+  const std::vector<TTYPE> Tests=
+    {
+      TTYPE("1 -2 3 -4 5 -6",1,16.0),
+      TTYPE("21 -22 3 -4 5 -6",1,20.0),
+      TTYPE("1 -2 3 -4 5 -6 -203",1,8.0),
+      TTYPE("1 -2 3 -4 5 -6 -12 11",1,16.0),
+      TTYPE("-201 1 -2",1,M_PI*16.0),
+      TTYPE("-201 202 -2 1",1,M_PI*12.0),
+      TTYPE("-201 1",0,0.0),
+      TTYPE("1 -2 3 -4",0,0.0),
+      TTYPE("1 -2 3 -4 5 -6 (-11:12)",0,0.0),
+      TTYPE("-101",0,0.0)
+    };
+
+  int cnt(1);
+  for(const TTYPE& tc : Tests)
+    {
+      MonteCarlo::Qhull A(1000,0,0.0,std::get<0>(tc));
+      A.populate();
+      double V(-1.0);
+      const int flag=ModelSupport::analyticVolume(A,V);
+      if (flag!=std::get<1>(tc) ||
+	  (flag && std::abs(V-std::get<2>(tc))>1e-8))
+	{
+	  ELog::EM<<"Test "<<cnt<<" : "<<std::get<0>(tc)<<ELog::endDiag;
+	  ELog::EM<<"Flag/Vol == "<<flag<<" "<<V<<" ["
+		  <<std::get<1>(tc)<<" "<<std::get<2>(tc)<<"]"<<ELog::endDiag;
+	  return -1;
+	}
+      cnt++;
+    }
+
+  // Tally with an exact cell [5] and a sampled cell [2]
+  VolSum VTally(Geometry::Vec3D(0,0,0),Geometry::Vec3D(40.0,40.0,40.0));
+  VTally.addTallyCell(4,5);
+  VTally.addTallyCell(5,2);
+  VTally.setAnalytic(1);
+  VTally.adaptiveRun(ASim,100000,0.0);
+  if (std::abs(VTally.calcVolume(4)-20.0)>1e-8 ||
+      VTally.calcError(4)!=0.0 ||
+      VTally.calcError(5)<=0.0)
+    {
+      ELog::EM<<"Volume[4] == "<<VTally.calcVolume(4)<<" +/- "
+	      <<VTally.calcError(4)<<ELog::endDiag;
+      ELog::EM<<"Volume[5] == "<<VTally.calcVolume(5)<<" +/- "
+	      <<VTally.calcError(5)<<ELog::endDiag;
+      return -2;
+    }
+  return 0;
+}
+
 int
 testVolumes::testVolume()
   /*!
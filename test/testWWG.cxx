@@ -0,0 +1,359 @@
+/*********************************************************************
+  CombLayer : MCNP(X) Input builder
+
+ * File:   test/testWWG.cxx
+ *
+ * Copyright (c) 2004-2016 by Stuart Ansell
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ *
+ ****************************************************************************/
+#include <fstream>
+#include <iomanip>
+#include <iostream>
+#include <sstream>
+#include <cstdio>
+#include <cmath>
+#include <list>
+#include <vector>
+#include <map>
+#include <string>
+#include <tuple>
+#include <algorithm>
+
+#include "Exception.h"
+#include "FileReport.h"
+#include "NameStack.h"
+#include "RegMethod.h"
+#include "GTKreport.h"
+#include "OutputLog.h"
+#include "BaseVisit.h"
+#include "BaseModVisit.h"
+#include "support.h"
+#include "MatrixBase.h"
+#include "Matrix.h"
+#include "Vec3D.h"
+#include "Mesh3D.h"
+#include "WWG.h"
+#include "ItemWeight.h"
+#include "WWGWeight.h"
+
+#include "testFunc.h"
+#include "testWWG.h"
+
+testWWG::testWWG()
+  /*!
+    Constructor
+  */
+{}
+
+testWWG::~testWWG()
+  /*!
+    Destructor
+  */
+{}
+
+int
+testWWG::applyTest(const int extra)
+  /*!
+    Applies all the tests and returns
+    the error number
+    \param extra :: index of test
+    \retval -1 Distance failed
+    \retval 0 All succeeded
+  */
+{
+  ELog::RegMethod RegA("testWWG","applyTest");
+  TestFunc::regSector("testWWG");
+
+  typedef int (testWWG::*testPtr)();
+  testPtr TPtr[]=
+    {
+      &testWWG::testScaleMesh,
+      &testWWG::testSetDense,
+      &testWWG::testWriteWWINP
+    };
+  const std::string TestName[]=
+    {
+      "ScaleMesh",
+      "SetDense",
+      "WriteWWINP"
+    };
+  const int TSize(sizeof(TPtr)/sizeof(testPtr));
+  if (!extra)
+    {
+      TestFunc::Instance().reportTest(std::cout);
+      std::ios::fmtflags flagIO=std::cout.setf(std::ios::left);
+      for(int i=0;i<TSize;i++)
+        {
+	  std::cout<<std::setw(30)<<TestName[i]<<"("<<i+1<<")"<<std::endl;
+	}
+      std::cout.flags(flagIO);
+      return 0;
+    }
+
+  for(int i=0;i<TSize;i++)
+    {
+      if (extra<0 || extra==i+1)
+        {
+	  TestFunc::regTest(TestName[i]);
+	  const int retValue= (this->*TPtr[i])();
+	  if (retValue || extra>0)
+	    return retValue;
+	}
+    }
+  return 0;
+}
+
+void
+testWWG::initWWG(WeightSystem::WWG& wwg,const size_t NX,
+		 const std::vector<double>& EB,
+		 const std::vector<double>& W)
+  /*!
+    Set a NX x 1 x 1 grid and its energy bins
+    \param wwg :: WWG to set
+    \param NX :: Number of voxels
+    \param EB :: Energy bins [1e5 is added]
+    \param W :: Weight for each voxel
+  */
+{
+  ELog::RegMethod RegA("testWWG","initWWG");
+
+  wwg.getGrid().setMesh({0.0,static_cast<double>(NX)},{NX},
+			{0.0,1.0},{1},{0.0,1.0},{1});
+  wwg.setEnergyBin(EB,W);
+  return;
+}
+
+testWWG::NMeshTYPE
+testWWG::nestedMesh(const WeightSystem::WWG& wwg)
+  /*!
+    Copy the flat mesh into the nested [voxel][energy]
+    layout that the flat array replaced
+    \param wwg :: WWG to copy
+    \return nested mesh
+  */
+{
+  const size_t ESize(wwg.getEBin().size());
+  const std::vector<double>& WMesh=wwg.getMesh();
+
+  NMeshTYPE Out(WMesh.size()/ESize);
+  for(size_t i=0;i<Out.size();i++)
+    Out[i].assign(WMesh.begin()+static_cast<std::ptrdiff_t>(i*ESize),
+		  WMesh.begin()+static_cast<std::ptrdiff_t>((i+1)*ESize));
+  return Out;
+}
+
+void
+testWWG::nestedWWINP(std::ostream& OX,const WeightSystem::WWG& wwg,
+		     const NMeshTYPE& NMesh)
+  /*!
+    The WWINP writer of the nested mesh [reference output]
+    \param OX :: Output stream
+    \param wwg :: WWG for grid/energy bins
+    \param NMesh :: nested mesh
+  */
+{
+  const std::vector<double>& EBin=wwg.getEBin();
+  wwg.getGrid().writeWWINP(OX,1,EBin.size());
+  size_t itemCnt=0;
+  for(const double& E : EBin)
+    StrFunc::writeLine(OX,E,itemCnt,6);
+  if (itemCnt!=0)
+    OX<<std::endl;
+
+  itemCnt=0;
+  for(const std::vector<double>& CV : NMesh)
+    for(const double W : CV)
+      StrFunc::writeLine(OX,W,itemCnt,6);
+  return;
+}
+
+int
+testWWG::testScaleMesh()
+  /*!
+    Test that scaleMesh gives the same mesh as
+    scaleMeshItem and the nested per-voxel scaling
+    \return -1 on error
+  */
+{
+  ELog::RegMethod RegA("testWWG","testScaleMesh");
+
+  WeightSystem::WWG A;
+  initWWG(A,7,{1e-7,0.5,20.0},{1.0,2.0,3.0,4.0,5.0,6.0,7.0});
+  WeightSystem::WWG B(A);
+  NMeshTYPE NMesh=nestedMesh(A);
+
+  const std::vector<double> WVec=
+    {0.5,2.0,1.0,1e-3,3.7,0.25,10.0};
+  const std::vector<std::vector<int>> MaskVec=
+    { {1,1,1,1},{0,1,0,1},{0,0,0,0},{1,0,0,0} };
+
+  int cnt(1);
+  for(const std::vector<int>& EMask : MaskVec)
+    {
+      A.scaleMesh(WVec,EMask);
+      for(size_t i=0;i<WVec.size();i++)
+	{
+	  std::vector<double> DVec(EMask.size(),1.0);
+	  for(size_t j=0;j<EMask.size();j++)
+	    if (EMask[j]) DVec[j]=WVec[i];
+	  B.scaleMeshItem(static_cast<long int>(i),DVec);
+	  for(size_t j=0;j<DVec.size();j++)
+	    NMesh[i][j]*=DVec[j];
+	}
+      if (A.getMesh()!=B.getMesh() || nestedMesh(A)!=NMesh)
+	{
+	  ELog::EM<<"Test "<<cnt<<ELog::endDiag;
+	  for(size_t i=0;i<NMesh.size();i++)
+	    for(size_t j=0;j<NMesh[i].size();j++)
+	      ELog::EM<<"Mesh["<<i<<"]["<<j<<"] "
+		      <<A.getMesh()[i*NMesh[i].size()+j]<<" "
+		      <<B.getMesh()[i*NMesh[i].size()+j]<<" "
+		      <<NMesh[i][j]<<ELog::endDiag;
+	  return -1;
+	}
+      cnt++;
+    }
+
+  // size mismatch must throw
+  try
+    {
+      A.scaleMesh(std::vector<double>(WVec.size()-1,1.0),MaskVec[0]);
+      ELog::EM<<"No throw on short WVec"<<ELog::endDiag;
+      return -1;
+    }
+  catch (ColErr::IndexError<size_t>&)
+    { }
+
+  return 0;
+}
+
+int
+testWWG::testSetDense()
+  /*!
+    Test that the dense track arrays give the same output
+    and mesh scaling as the cell map
+    \return -1 on error
+  */
+{
+  ELog::RegMethod RegA("testWWG","testSetDense");
+
+  const size_t NG(7);
+
+  // cell : value [0 and >NG stay in the map]
+  typedef std::tuple<long int,double> TTYPE;
+  std::vector<TTYPE> Tracks;
+  for(long int cN=0;cN<static_cast<long int>(NG)+3;cN++)
+    for(long int k=0;k<=(cN % 3);k++)
+      Tracks.push_back(TTYPE(cN,1.3*static_cast<double>(cN)+
+			     0.7*static_cast<double>(k)));
+
+  // map only : reference
+  WeightSystem::WWGWeight A;
+  for(const TTYPE& tc : Tracks)
+    A.addTracks(std::get<0>(tc),std::get<1>(tc));
+
+  // dense before / after the tracks, dense then back to
+  // the map, and part dense then extended
+  std::vector<WeightSystem::WWGWeight> Items(4);
+  Items[0].setDense(NG);
+  Items[2].setDense(NG);
+  Items[3].setDense(NG/2);
+  for(WeightSystem::WWGWeight& WW : Items)
+    for(const TTYPE& tc : Tracks)
+      WW.addTracks(std::get<0>(tc),std::get<1>(tc));
+  Items[1].setDense(NG);
+  Items[2].setDense(0);
+  Items[3].setDense(NG);
+
+  std::ostringstream AX;
+  A.write(AX);
+
+  WeightSystem::WWG AMesh;
+  initWWG(AMesh,NG,{1e-7,0.5,20.0},{1.0,2.0,3.0,4.0,5.0,6.0,7.0});
+  const WeightSystem::WWG InitMesh(AMesh);
+  A.updateWM(AMesh,0.5,1.0,0.5,0.5);
+
+  for(size_t i=0;i<Items.size();i++)
+    {
+      std::ostringstream cx;
+      Items[i].write(cx);
+      WeightSystem::WWG BMesh(InitMesh);
+      Items[i].updateWM(BMesh,0.5,1.0,0.5,0.5);
+      if (cx.str()!=AX.str() || BMesh.getMesh()!=AMesh.getMesh())
+	{
+	  ELog::EM<<"Test "<<i+1<<ELog::endDiag;
+	  ELog::EM<<"Map ==\n"<<AX.str()<<ELog::endDiag;
+	  ELog::EM<<"Dense ==\n"<<cx.str()<<ELog::endDiag;
+	  for(size_t j=0;j<AMesh.getMesh().size();j++)
+	    ELog::EM<<"Mesh["<<j<<"] "<<AMesh.getMesh()[j]<<" "
+		    <<BMesh.getMesh()[j]<<ELog::endDiag;
+	  return -1;
+	}
+    }
+
+  // clear empties both stores
+  Items[0].clear();
+  std::ostringstream cx;
+  Items[0].write(cx);
+  if (!cx.str().empty())
+    {
+      ELog::EM<<"Clear ==\n"<<cx.str()<<ELog::endDiag;
+      return -1;
+    }
+  return 0;
+}
+
+int
+testWWG::testWriteWWINP()
+  /*!
+    Test that writeWWINP gives the same file as the
+    nested mesh writer
+    \return -1 on error
+  */
+{
+  ELog::RegMethod RegA("testWWG","testWriteWWINP");
+
+  const std::string FName("testWWG.wwinp");
+  const std::vector<double> W=
+    {1.0,2.5e5,3e-7,0.0,-1.25,12345.678,1e-40};
+
+  // full lines / part lines of mesh
+  for(const size_t NX : {1,6,7})
+    {
+      WeightSystem::WWG A;
+      initWWG(A,NX,{1e-7,0.5,20.0},W);
+      A.scaleMesh(std::vector<double>(NX,3.3e-2),{0,1,0,1});
+
+      std::ostringstream Expect;
+      nestedWWINP(Expect,A,nestedMesh(A));
+
+      A.writeWWINP(FName);
+      std::ifstream IX(FName.c_str());
+      std::ostringstream Res;
+      Res<<IX.rdbuf();
+      IX.close();
+      std::remove(FName.c_str());
+
+      if (Res.str()!=Expect.str())
+	{
+	  ELog::EM<<"NX "<<NX<<ELog::endDiag;
+	  ELog::EM<<"Result ==\n"<<Res.str()<<ELog::endDiag;
+	  ELog::EM<<"Expect ==\n"<<Expect.str()<<ELog::endDiag;
+	  return -1;
+	}
+    }
+  return 0;
+}
@@ -39,6 +39,8 @@ private:
   int testAnalyse();
   int testBuiltIn();
   int testEval();
+  int testIndexVar();
+  int testMemo();
   int testString();
   int testVariable();
   int testVec3D();
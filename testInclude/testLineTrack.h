@@ -51,6 +51,7 @@ private:
 
   //Tests 
   int testLine();
+  int testQuery();
   
 
 public:
@@ -40,6 +40,7 @@ private:
 
   int testRandom();
   int testRand();
+  int testSobol();
  
 public:
 
@@ -46,8 +46,12 @@ private:
   void createSurfaces();
 
   //Tests 
+  int testAddSurfString();
+  int testBoundBox();
+  int testCalcVertex();
   int testCellStr();
   int testComplement();
+  int testFlatRule();
   int testIntersect();
   int testIsValid();
   int testIsOnSide();
@@ -56,6 +60,7 @@ private:
   int testSetObject();
   int testSetObjectExtra();
   int testTrackCell();
+  int testTrackSense();
 
 public:
   
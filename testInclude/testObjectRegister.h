@@ -39,6 +39,7 @@ private:
   //Tests 
   int testExcludeItem();
   int testGetObject();
+  int testInRange();
 
 public:
   
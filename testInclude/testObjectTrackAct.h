@@ -43,6 +43,7 @@ private:
   void createObjects();
 
   //Tests 
+  int testBatch();
   int testPointDet();
 
 public:
@@ -43,9 +43,16 @@ private:
   void createObjects();
 
   //Tests 
+  int testCellTree();
   int testCreateObjSurfMap();
   int testInCell();
+  int testMD5sum();
+  int testQueryContext();
+  int testSimValid();
+  int testSnapShot();
   int testTrackNeutron();
+  int testVisit();
+  int testVisitStream();
 
 public:
   
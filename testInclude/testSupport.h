@@ -38,6 +38,9 @@ class testSupport
 {
 private:
 
+  static void substrControl(const std::string&,std::ostream&,
+			    const size_t,int);
+
   //Tests 
   int testConvert();   
   int testConvPartNum();   
@@ -53,6 +56,8 @@ private:
   int testStrParts();   
   int testStrRemove();  
   int testStrSplit();   
+  int testWriteBlocks();
+  int testWriteControl();
 
 public:
 
@@ -40,6 +40,7 @@ private:
   int testMakePoint_Quad();
   int testNearPoint();
   int testProcessPoint();
+  int testSpecialPoint();
 
 
 public:
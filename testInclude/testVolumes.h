@@ -43,6 +43,8 @@ private:
   void createObjects();
 
   //Tests 
+  int testAdaptiveRun();
+  int testAnalyticVolume();
   int testPointVolume();
   int testVolume();
 
@@ -0,0 +1,69 @@
+/*********************************************************************
+  CombLayer : MCNP(X) Input builder
+
+ * File:   testInclude/testWWG.h
+ *
+ * Copyright (c) 2004-2016 by Stuart Ansell
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ *
+ ****************************************************************************/
+#ifndef testWWG_h
+#define testWWG_h
+
+namespace WeightSystem
+{
+  class WWG;
+}
+
+/*!
+  \class testWWG
+  \brief Tests the WWG mesh and the track weight store
+  \author S. Ansell
+  \date October 2016
+  \version 1.0
+
+  The flat mesh and the dense track arrays are checked
+  against the [voxel][energy] nested layout and the map
+*/
+
+class testWWG
+{
+private:
+
+  /// nested [voxel][energy] mesh
+  typedef std::vector<std::vector<double>> NMeshTYPE;
+
+  static void initWWG(WeightSystem::WWG&,const size_t,
+		      const std::vector<double>&,
+		      const std::vector<double>&);
+  static NMeshTYPE nestedMesh(const WeightSystem::WWG&);
+  static void nestedWWINP(std::ostream&,const WeightSystem::WWG&,
+			  const NMeshTYPE&);
+
+  //Tests
+  int testScaleMesh();
+  int testSetDense();
+  int testWriteWWINP();
+
+public:
+
+  testWWG();
+  ~testWWG();
+
+  int applyTest(const int);
+
+};
+
+#endif
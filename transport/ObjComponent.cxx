@@ -245,9 +245,30 @@ ObjComponent::trackWeight(MonteCarlo::neutron& N,
   */
 {
   ELog::RegMethod RegA("ObjComponent","trackWeight");
+
+  MonteCarlo::LineIntersectVisit LI(N);
+  return trackWeight(N,R,surfPtr,LI);
+}
+
+int
+ObjComponent::trackWeight(MonteCarlo::neutron& N,
+			  double& R,
+			  const Geometry::Surface*& surfPtr,
+			  MonteCarlo::LineIntersectVisit& LI) const
+  /*!
+    This tracks a neutron through object and determines the 
+    the track modification to a scattering point.
+    \param N :: neutron to move forward:change weight:new direction
+    \param R :: Random number exponent step
+    \param surfPtr :: surface that track ended on
+    \param LI :: Work space line visitor [re-used by caller]
+    \return surface number that it exited at /  0
+  */
+{
+  ELog::RegMethod RegA("ObjComponent","trackWeight(LI)");
   double aDist(0);
       
-  const int SN=ObjPtr->trackOutCell(N,aDist,surfPtr);
+  const int SN=ObjPtr->trackOutCell(N,aDist,surfPtr,0,LI);
   //  ELog::EM<<"Nutron Track"<<N.weight<<ELog::endDiag;
   if (MatPtr)    // not-void
     {
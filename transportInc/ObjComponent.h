@@ -22,6 +22,11 @@
 #ifndef Transport_ObjCompnent_h
 #define Transport_ObjCompnent_h
 
+namespace MonteCarlo
+{
+  class LineIntersectVisit;
+}
+
 namespace Transport
 {
   //forward declaration
@@ -69,6 +74,9 @@ class ObjComponent
 
   int trackWeight(MonteCarlo::neutron&,double&,
 		  const Geometry::Surface*&) const;
+  int trackWeight(MonteCarlo::neutron&,double&,
+		  const Geometry::Surface*&,
+		  MonteCarlo::LineIntersectVisit&) const;
   int trackAttn(MonteCarlo::neutron&,const Geometry::Surface*&) const;
 
   void attenuate(const double,MonteCarlo::neutron&) const;